@@ -69,6 +69,14 @@ DLLEXPORT void PVR_transfer_epg_entry(void *hdl, void* cb, const ADDON_HANDLE ha
   ((CB_PVRLib*)cb)->TransferEpgEntry(((AddonCB*)hdl)->addonData, handle, epgentry);
 }
 
+DLLEXPORT void PVR_transfer_epg_entries(void *hdl, void* cb, const ADDON_HANDLE handle, const EPG_TAG *epgentries, unsigned int iEntries)
+{
+  if (cb == NULL)
+    return;
+
+  ((CB_PVRLib*)cb)->TransferEpgEntries(((AddonCB*)hdl)->addonData, handle, epgentries, iEntries);
+}
+
 DLLEXPORT void PVR_transfer_channel_entry(void *hdl, void* cb, const ADDON_HANDLE handle, const PVR_CHANNEL *chan)
 {
   if (cb == NULL)
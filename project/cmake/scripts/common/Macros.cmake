@@ -149,6 +149,23 @@ function(core_add_test_library name)
   endforeach()
 endfunction()
 
+# Add a benchmark library, and add sources to list for the benchmark executable
+# Benchmarks are gtest tests that measure rather than check, they are built
+# into their own executable so they never run with the unit tests.
+function(core_add_benchmark_library name)
+  if(ENABLE_STATIC_LIBS)
+    add_library(${name} STATIC ${SOURCES} ${SUPPORTED_SOURCES} ${HEADERS} ${OTHERS})
+    set_target_properties(${name} PROPERTIES PREFIX ""
+                                             EXCLUDE_FROM_ALL 1
+                                             FOLDER "Build Utilities/benchmarks")
+    add_dependencies(${name} libcpluff ffmpeg dvdnav crossguid)
+  endif()
+  foreach(src IN LISTS SOURCES)
+    get_filename_component(src_path "${src}" ABSOLUTE)
+    set(benchmark_sources "${src_path}" ${benchmark_sources} CACHE STRING "" FORCE)
+  endforeach()
+endfunction()
+
 # Add an addon callback library
 # Arguments:
 #   name name of the library to add
@@ -0,0 +1,166 @@
+#!/usr/bin/env python
+#
+#      Copyright (C) 2017 Team Kodi
+#      http://kodi.tv
+#
+#  This Program is free software; you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation; either version 2, or (at your option)
+#  any later version.
+#
+#  This Program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this Program; see the file COPYING.  If not, see
+#  <http://www.gnu.org/licenses/>.
+#
+
+"""
+Load test for the JSON-RPC TCP server (port 9090).
+
+Opens many concurrent connections to Kodi, some of which never read from
+their socket, and broadcasts notifications through JSONRPC.NotifyAll. For
+every notification the time until each reading client received it is
+measured, so a slow client holding up the others shows up as a latency
+spike, e.g. 500 connections of which 50 never read:
+
+  tcp_notification_load.py --clients 500 --stalled 50 --notifications 200
+
+Stalled clients are expected to be disconnected by Kodi once their send
+buffer is full, which is reported at the end.
+
+Kodi has to allow remote control from applications on this system.
+"""
+
+import json
+import optparse
+import select
+import socket
+import sys
+import time
+
+
+def percentile(values, pct):
+  values = sorted(values)
+  index = int(round((len(values) - 1) * pct / 100.0))
+  return values[index]
+
+
+def connect(host, port, count):
+  sockets = []
+  for _ in range(count):
+    s = socket.create_connection((host, port))
+    s.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4096)
+    sockets.append(s)
+  return sockets
+
+
+def split_objects(buffer):
+  """Split a stream of concatenated JSON objects into complete ones and the rest."""
+  objects = []
+  depth = 0
+  start = 0
+  in_string = False
+  escaped = False
+  for i, c in enumerate(buffer):
+    if in_string:
+      if escaped:
+        escaped = False
+      elif c == "\\":
+        escaped = True
+      elif c == '"':
+        in_string = False
+    elif c == '"':
+      in_string = True
+    elif c == "{":
+      depth += 1
+    elif c == "}":
+      depth -= 1
+      if depth == 0:
+        objects.append(buffer[start:i + 1])
+        start = i + 1
+  return objects, buffer[start:]
+
+
+def main():
+  parser = optparse.OptionParser(usage="%prog [options]")
+  parser.add_option("--host", default="localhost", help="host Kodi is running on [%default]")
+  parser.add_option("--port", type="int", default=9090, help="JSON-RPC TCP port [%default]")
+  parser.add_option("--clients", type="int", default=500, help="concurrent connections [%default]")
+  parser.add_option("--stalled", type="int", default=50, help="connections which never read [%default]")
+  parser.add_option("--notifications", type="int", default=200, help="notifications to send [%default]")
+  parser.add_option("--size", type="int", default=4096, help="payload size of a notification [%default]")
+  parser.add_option("--interval", type="float", default=0.05, help="seconds between notifications [%default]")
+  options, _ = parser.parse_args()
+
+  if options.stalled >= options.clients:
+    parser.error("at least one connection has to read")
+
+  readers = connect(options.host, options.port, options.clients - options.stalled)
+  stalled = connect(options.host, options.port, options.stalled)
+  control = socket.create_connection((options.host, options.port))
+
+  buffers = dict((s, "") for s in readers)
+  sent = {}
+  latencies = []
+  missing = 0
+  payload = "x" * options.size
+
+  for n in range(options.notifications):
+    sent[n] = time.time()
+    control.sendall(json.dumps({
+      "jsonrpc": "2.0",
+      "method": "JSONRPC.NotifyAll",
+      "params": {"sender": "loadtest", "message": "n%d" % n, "data": payload}
+    }).encode("utf-8"))
+
+    deadline = time.time() + options.interval
+    while True:
+      timeout = deadline - time.time()
+      if timeout <= 0:
+        break
+      ready, _, _ = select.select(readers, [], [], timeout)
+      now = time.time()
+      for s in ready:
+        data = s.recv(65536)
+        if not data:
+          readers.remove(s)
+          missing += 1
+          continue
+        objects, buffers[s] = split_objects(buffers[s] + data.decode("utf-8"))
+        for obj in objects:
+          notification = json.loads(obj)
+          method = notification.get("method", "")
+          if notification.get("params", {}).get("sender") == "loadtest" and method.startswith("Other.n"):
+            latencies.append((now - sent[int(method[len("Other.n"):])]) * 1000.0)
+
+  # count the stalled connections Kodi gave up on
+  disconnected = 0
+  for s in stalled:
+    s.setblocking(False)
+    try:
+      while True:
+        data = s.recv(1024 * 1024)
+        if not data:
+          disconnected += 1
+          break
+    except (socket.error, IOError):
+      pass
+
+  expected = options.notifications * (options.clients - options.stalled)
+  print("%d connections (%d stalled), %d notifications of %d bytes" %
+        (options.clients, options.stalled, options.notifications, options.size))
+  if latencies:
+    print("delivered %d of %d  min %.1f ms  median %.1f ms  p99 %.1f ms  max %.1f ms" %
+          (len(latencies), expected, min(latencies), percentile(latencies, 50),
+           percentile(latencies, 99), max(latencies)))
+  print("reading connections lost: %d, stalled connections disconnected: %d" % (missing, disconnected))
+
+  return 0 if latencies and missing == 0 else 1
+
+
+if __name__ == "__main__":
+  sys.exit(main())
@@ -0,0 +1,50 @@
+#
+#      Copyright (C) 2017 Team Kodi
+#      http://kodi.tv
+#
+#  This Program is free software; you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation; either version 2, or (at your option)
+#  any later version.
+#
+#  This Program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this Program; see the file COPYING.  If not, see
+#  <http://www.gnu.org/licenses/>.
+#
+
+# Lists ?items=N generated items with labels, art, properties and video info,
+# handed to Kodi in chunks of ?chunk=M items (0 for a single call).
+
+import sys
+import urlparse
+
+import xbmcgui
+import xbmcplugin
+
+handle = int(sys.argv[1])
+params = dict(urlparse.parse_qsl(sys.argv[2].lstrip('?')))
+count = int(params.get('items', 5000))
+chunk = int(params.get('chunk', 0)) or count
+
+xbmcplugin.setContent(handle, 'movies')
+
+items = []
+for i in range(count):
+  li = xbmcgui.ListItem('Item %d' % i, 'Label2 %d' % i)
+  li.setArt({'thumb': 'special://xbmc/media/icon256x256.png', 'fanart': 'special://xbmc/media/Splash.png'})
+  li.setInfo('video', {'title': 'Item %d' % i, 'year': 2000 + i % 17, 'plot': 'Plot of item %d ' % i * 4,
+                       'genre': 'Genre %d' % (i % 10), 'duration': 60 * (i % 120)})
+  li.setProperty('IsPlayable', 'true')
+  items.append(('%s?play=%d' % (sys.argv[0], i), li, False))
+  if len(items) == chunk:
+    xbmcplugin.addDirectoryItems(handle, items, count)
+    items = []
+
+if items:
+  xbmcplugin.addDirectoryItems(handle, items, count)
+xbmcplugin.endOfDirectory(handle)
@@ -0,0 +1,144 @@
+#!/usr/bin/env python
+#
+#      Copyright (C) 2017 Team Kodi
+#      http://kodi.tv
+#
+#  This Program is free software; you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation; either version 2, or (at your option)
+#  any later version.
+#
+#  This Program is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with this Program; see the file COPYING.  If not, see
+#  <http://www.gnu.org/licenses/>.
+#
+
+"""
+Measures how long Kodi takes to list a plugin:// directory.
+
+The listing is requested repeatedly through JSON-RPC (Files.GetDirectory) and
+the latency of every request is reported. To compare the listing latency with
+and without a warm interpreter, run it once with
+
+  <reuseinterpreter>true</reuseinterpreter>
+
+in the xbmc.python.pluginsource extension of the plugin's addon.xml, save the
+results and run it again without it:
+
+  plugin_listing_benchmark.py plugin://plugin.video.foo/ --save warm.json
+  (remove <reuseinterpreter> and restart Kodi)
+  plugin_listing_benchmark.py plugin://plugin.video.foo/ --baseline warm.json
+
+The plugin.benchmark.listing add-on next to this script is a synthetic plugin
+listing any number of items, e.g. 5000 handed over in chunks of 500:
+
+  plugin_listing_benchmark.py "plugin://plugin.benchmark.listing/?items=5000&chunk=500"
+
+Kodi's web server has to be enabled and allow remote control via HTTP.
+"""
+
+import base64
+import json
+import optparse
+import sys
+import time
+
+try:
+  from urllib.request import Request, urlopen
+except ImportError:
+  from urllib2 import Request, urlopen
+
+
+def get_directory(url, auth, path):
+  request = Request(url, json.dumps({
+    "jsonrpc": "2.0",
+    "id": 1,
+    "method": "Files.GetDirectory",
+    "params": {"directory": path, "media": "files"}
+  }).encode("utf-8"), {"Content-Type": "application/json"})
+  if auth:
+    request.add_header("Authorization", "Basic " + base64.b64encode(auth.encode("utf-8")).decode("ascii"))
+
+  start = time.time()
+  response = json.loads(urlopen(request).read().decode("utf-8"))
+  elapsed = (time.time() - start) * 1000.0
+
+  if "error" in response:
+    raise RuntimeError("listing %s failed: %s" % (path, response["error"]))
+  return elapsed, len(response["result"].get("files") or [])
+
+
+def percentile(values, pct):
+  values = sorted(values)
+  index = int(round((len(values) - 1) * pct / 100.0))
+  return values[index]
+
+
+def summarize(latencies):
+  return {
+    "runs": len(latencies),
+    "min": min(latencies),
+    "median": percentile(latencies, 50),
+    "p90": percentile(latencies, 90),
+    "max": max(latencies),
+  }
+
+
+def print_summary(title, summary):
+  print("%-10s runs %3d  min %7.1f ms  median %7.1f ms  p90 %7.1f ms  max %7.1f ms" %
+        (title, summary["runs"], summary["min"], summary["median"], summary["p90"], summary["max"]))
+
+
+def main():
+  parser = optparse.OptionParser(usage="%prog [options] plugin://path")
+  parser.add_option("--host", default="localhost", help="host Kodi is running on [%default]")
+  parser.add_option("--port", type="int", default=8080, help="web server port [%default]")
+  parser.add_option("--auth", default="", help="user:password for the web server")
+  parser.add_option("--runs", type="int", default=20, help="number of measured listings [%default]")
+  parser.add_option("--warmup", type="int", default=1, help="listings before measuring [%default]")
+  parser.add_option("--delay", type="float", default=0.5, help="seconds between listings [%default]")
+  parser.add_option("--save", help="write the results to this file")
+  parser.add_option("--baseline", help="compare against results saved with --save")
+  options, args = parser.parse_args()
+
+  if len(args) != 1 or not args[0].startswith("plugin://"):
+    parser.error("a plugin:// path is required")
+
+  url = "http://%s:%d/jsonrpc" % (options.host, options.port)
+  path = args[0]
+
+  for _ in range(options.warmup):
+    get_directory(url, options.auth, path)
+    time.sleep(options.delay)
+
+  latencies = []
+  items = 0
+  for _ in range(options.runs):
+    elapsed, items = get_directory(url, options.auth, path)
+    latencies.append(elapsed)
+    time.sleep(options.delay)
+
+  summary = summarize(latencies)
+  print("%s (%d items)" % (path, items))
+  print_summary("current", summary)
+
+  if options.baseline:
+    with open(options.baseline) as f:
+      baseline = json.load(f)
+    print_summary("baseline", baseline)
+    print("median change: %+.1f ms" % (summary["median"] - baseline["median"]))
+
+  if options.save:
+    with open(options.save, "w") as f:
+      json.dump(summary, f)
+
+  return 0
+
+
+if __name__ == "__main__":
+  sys.exit(main())
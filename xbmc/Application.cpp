@@ -3659,6 +3659,18 @@ void CApplication::OnQueueNextItem()
   g_windowManager.SendThreadMessage(msg);
 }
 
+void CApplication::OnPrefetchNextItem()
+{
+  CSingleLock lock(m_playStateMutex);
+  if(m_bPlaybackStarting)
+    return;
+
+  // param1 marks a prefetch: the player only opens the likely next item,
+  // the playlist is not advanced until it asks for the next item for real
+  CGUIMessage msg(GUI_MSG_QUEUE_NEXT_ITEM, 0, 0, 1);
+  g_windowManager.SendThreadMessage(msg);
+}
+
 void CApplication::OnPlayBackStopped()
 {
   CSingleLock lock(m_playStateMutex);
@@ -4291,16 +4303,30 @@ bool CApplication::OnMessage(CGUIMessage& message)
     {
       // Check to see if our playlist player has a new item for us,
       // and if so, we check whether our current player wants the file
+      bool prefetch = message.GetParam1() == 1;
       int iNext = g_playlistPlayer.GetNextSong();
       CPlayList& playlist = g_playlistPlayer.GetPlaylist(g_playlistPlayer.GetCurrentPlaylist());
       if (iNext < 0 || iNext >= playlist.size())
       {
-        m_pPlayer->OnNothingToQueueNotify();
+        if (!prefetch)
+          m_pPlayer->OnNothingToQueueNotify();
         return true; // nothing to do
       }
 
       // ok, grab the next song
       CFileItem file(*playlist[iNext]);
+
+      // a prefetch is only a hint, the playlist may still change before the
+      // player queues the next item. don't resolve anything for it.
+      if (prefetch)
+      {
+        CURL url(file.GetPath());
+        if (!url.IsProtocol("plugin") && !URIUtils::IsUPnP(file.GetPath()) &&
+            file.IsAudio() && !file.IsVideo() && m_pPlayer->IsPlayingAudio())
+          m_pPlayer->PrefetchNextFile(file);
+        return true;
+      }
+
       // handle plugin://
       CURL url(file.GetPath());
       if (url.IsProtocol("plugin"))
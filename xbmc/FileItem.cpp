@@ -60,9 +60,23 @@
 #include "utils/Mime.h"
 #include "utils/Random.h"
 #include "events/IEvent.h"
+#include "filesystem/SpecialProtocol.h"
+#include "threads/Event.h"
+#include "utils/auto_buffer.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
 
 #include <assert.h>
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#ifdef TARGET_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace XFILE;
 using namespace PLAYLIST;
@@ -333,14 +347,29 @@ CFileItem::CFileItem(const EventPtr& eventLogEntry)
     SetIconImage(eventLogEntry->GetIcon());
 }
 
+namespace
+{
+/*!
+ \brief Take over the tag of another item. A tag the item doesn't share is
+ assigned to instead of replaced, so pointers returned by the non-const
+ getters stay valid, as they did before tags were shared.
+ */
+template<typename T>
+void AssignTag(std::shared_ptr<T> &tag, const std::shared_ptr<T> &other)
+{
+  if (tag == other)
+    return;
+
+  if (tag && other && tag.unique())
+    *tag = *other;
+  else
+    tag = other;
+}
+}
+
 CFileItem::~CFileItem(void)
 {
-  delete m_musicInfoTag;
-  delete m_videoInfoTag;
   delete m_pictureInfoTag;
-
-  m_musicInfoTag = NULL;
-  m_videoInfoTag = NULL;
   m_pictureInfoTag = NULL;
 }
 
@@ -359,31 +388,8 @@ const CFileItem& CFileItem::operator=(const CFileItem& item)
   m_dateTime = item.m_dateTime;
   m_dwSize = item.m_dwSize;
 
-  if (item.m_musicInfoTag)
-  {
-    if (m_musicInfoTag)
-      *m_musicInfoTag = *item.m_musicInfoTag;
-    else
-      m_musicInfoTag = new MUSIC_INFO::CMusicInfoTag(*item.m_musicInfoTag);
-  }
-  else
-  {
-    delete m_musicInfoTag;
-    m_musicInfoTag = NULL;
-  }
-
-  if (item.m_videoInfoTag)
-  {
-    if (m_videoInfoTag)
-      *m_videoInfoTag = *item.m_videoInfoTag;
-    else
-      m_videoInfoTag = new CVideoInfoTag(*item.m_videoInfoTag);
-  }
-  else
-  {
-    delete m_videoInfoTag;
-    m_videoInfoTag = NULL;
-  }
+  AssignTag(m_musicInfoTag, item.m_musicInfoTag);
+  AssignTag(m_videoInfoTag, item.m_videoInfoTag);
 
   if (item.m_pictureInfoTag)
   {
@@ -428,8 +434,8 @@ const CFileItem& CFileItem::operator=(const CFileItem& item)
 
 void CFileItem::Initialize()
 {
-  m_musicInfoTag = NULL;
-  m_videoInfoTag = NULL;
+  m_musicInfoTag.reset();
+  m_videoInfoTag.reset();
   m_pictureInfoTag = NULL;
   m_bLabelPreformated = false;
   m_bIsAlbum = false;
@@ -466,10 +472,8 @@ void CFileItem::Reset()
   m_dateTime.Reset();
   m_strLockCode.clear();
   m_mimetype.clear();
-  delete m_musicInfoTag;
-  m_musicInfoTag=NULL;
-  delete m_videoInfoTag;
-  m_videoInfoTag=NULL;
+  m_musicInfoTag.reset();
+  m_videoInfoTag.reset();
   m_epgInfoTag.reset();
   m_pvrChannelInfoTag.reset();
   m_pvrRecordingInfoTag.reset();
@@ -2118,31 +2122,9 @@ void CFileItemList::Archive(CArchive& ar)
 
     ar << (int)(m_items.size() - i);
 
-    ar << m_ignoreURLOptions;
-
-    ar << m_fastLookup;
-
-    ar << (int)m_sortDescription.sortBy;
-    ar << (int)m_sortDescription.sortOrder;
-    ar << (int)m_sortDescription.sortAttributes;
-    ar << m_sortIgnoreFolders;
-    ar << (int)m_cacheToDisc;
-
-    ar << (int)m_sortDetails.size();
-    for (unsigned int j = 0; j < m_sortDetails.size(); ++j)
-    {
-      const GUIViewSortDetails &details = m_sortDetails[j];
-      ar << (int)details.m_sortDescription.sortBy;
-      ar << (int)details.m_sortDescription.sortOrder;
-      ar << (int)details.m_sortDescription.sortAttributes;
-      ar << details.m_buttonLabel;
-      ar << details.m_labelMasks.m_strLabelFile;
-      ar << details.m_labelMasks.m_strLabelFolder;
-      ar << details.m_labelMasks.m_strLabel2File;
-      ar << details.m_labelMasks.m_strLabel2Folder;
-    }
-
-    ar << m_content;
+    bool ignoreURLOptions = m_ignoreURLOptions;
+    bool fastLookup = m_fastLookup;
+    ArchiveProperties(ar, ignoreURLOptions, fastLookup);
 
     for (; i < (int)m_items.size(); ++i)
     {
@@ -2180,9 +2162,55 @@ void CFileItemList::Archive(CArchive& ar)
       m_items.reserve(iSize);
 
     bool ignoreURLOptions = false;
+    bool fastLookup = false;
+    ArchiveProperties(ar, ignoreURLOptions, fastLookup);
+
+    for (int i = 0; i < iSize; ++i)
+    {
+      CFileItemPtr pItem(new CFileItem);
+      ar >> *pItem;
+      Add(pItem);
+    }
+
+    SetIgnoreURLOptions(ignoreURLOptions);
+    SetFastLookup(fastLookup);
+  }
+}
+
+void CFileItemList::ArchiveProperties(CArchive& ar, bool &ignoreURLOptions, bool &fastLookup)
+{
+  if (ar.IsStoring())
+  {
+    ar << ignoreURLOptions;
+
+    ar << fastLookup;
+
+    ar << (int)m_sortDescription.sortBy;
+    ar << (int)m_sortDescription.sortOrder;
+    ar << (int)m_sortDescription.sortAttributes;
+    ar << m_sortIgnoreFolders;
+    ar << (int)m_cacheToDisc;
+
+    ar << (int)m_sortDetails.size();
+    for (unsigned int j = 0; j < m_sortDetails.size(); ++j)
+    {
+      const GUIViewSortDetails &details = m_sortDetails[j];
+      ar << (int)details.m_sortDescription.sortBy;
+      ar << (int)details.m_sortDescription.sortOrder;
+      ar << (int)details.m_sortDescription.sortAttributes;
+      ar << details.m_buttonLabel;
+      ar << details.m_labelMasks.m_strLabelFile;
+      ar << details.m_labelMasks.m_strLabelFolder;
+      ar << details.m_labelMasks.m_strLabel2File;
+      ar << details.m_labelMasks.m_strLabel2Folder;
+    }
+
+    ar << m_content;
+  }
+  else
+  {
     ar >> ignoreURLOptions;
 
-    bool fastLookup = false;
     ar >> fastLookup;
 
     int tempint;
@@ -2216,16 +2244,6 @@ void CFileItemList::Archive(CArchive& ar)
     }
 
     ar >> m_content;
-
-    for (int i = 0; i < iSize; ++i)
-    {
-      CFileItemPtr pItem(new CFileItem);
-      ar >> *pItem;
-      Add(pItem);
-    }
-
-    SetIgnoreURLOptions(ignoreURLOptions);
-    SetFastLookup(fastLookup);
   }
 }
 
@@ -2688,29 +2706,255 @@ void CFileItemList::StackFiles()
   }
 }
 
+namespace
+{
+/*
+ The window caches are a magic, the version and length prefixed records: one
+ for the properties of the list, followed by the number of items and a record
+ for every item. The records themselves are written by Archive().
+ */
+const char DISC_CACHE_MAGIC[4] = { 'K', 'F', 'I', 'L' };
+// bump whenever the Archive() of the list, an item or one of its tags changes
+const uint32_t DISC_CACHE_VERSION = 1;
+// decoding fewer items than that on another thread isn't worth it
+const size_t DISC_CACHE_ITEMS_PER_JOB = 1000;
+
+typedef std::pair<const uint8_t*, uint32_t> DiscCacheRecord;
+
+void AppendUInt32(std::vector<uint8_t> &buffer, uint32_t value)
+{
+  const uint8_t *bytes = reinterpret_cast<const uint8_t*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(value));
+}
+
+void AppendRecord(std::vector<uint8_t> &buffer, const std::function<void(CArchive&)> &archive)
+{
+  size_t start = buffer.size();
+  AppendUInt32(buffer, 0);
+  {
+    CArchive ar(buffer);
+    archive(ar);
+  }
+  uint32_t size = static_cast<uint32_t>(buffer.size() - start - sizeof(size));
+  memcpy(&buffer[start], &size, sizeof(size));
+}
+
+bool ReadUInt32(const uint8_t *&pos, const uint8_t *end, uint32_t &value)
+{
+  if (static_cast<size_t>(end - pos) < sizeof(value))
+    return false;
+  memcpy(&value, pos, sizeof(value));
+  pos += sizeof(value);
+  return true;
+}
+
+bool ReadRecord(const uint8_t *&pos, const uint8_t *end, DiscCacheRecord &record)
+{
+  uint32_t size = 0;
+  if (!ReadUInt32(pos, end, size) || static_cast<size_t>(end - pos) < size)
+    return false;
+  record = DiscCacheRecord(pos, size);
+  pos += size;
+  return true;
+}
+
+/*!
+ * Decodes the items of a window cache, large lists on several threads.
+ * Returns false if one of the items is corrupt.
+ */
+bool DecodeItems(const std::vector<DiscCacheRecord> &records, std::vector<CFileItemPtr> &items)
+{
+  items.resize(records.size());
+
+  std::atomic<bool> corrupt(false);
+  auto decode = [&records, &items, &corrupt](size_t begin, size_t end) {
+    try
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        CArchive ar(records[i].first, records[i].second);
+        items[i].reset(new CFileItem);
+        ar >> *items[i];
+      }
+    }
+    catch(std::out_of_range ex)
+    {
+      corrupt = true;
+    }
+  };
+
+  size_t jobs = std::min<size_t>(std::max(g_cpuInfo.getCPUCount(), 1), records.size() / DISC_CACHE_ITEMS_PER_JOB);
+  size_t chunk = jobs > 1 ? (records.size() + jobs - 1) / jobs : records.size();
+
+  // the first chunk is decoded by this thread
+  std::vector<std::shared_ptr<CEvent>> done;
+  for (size_t begin = chunk; begin < records.size(); begin += chunk)
+  {
+    size_t end = std::min(begin + chunk, records.size());
+    std::shared_ptr<CEvent> event = std::make_shared<CEvent>();
+    done.push_back(event);
+    CJobManager::GetInstance().Submit([decode, begin, end, event]() {
+      decode(begin, end);
+      event->Set();
+    }, CJob::PRIORITY_DEDICATED);
+  }
+  decode(0, chunk);
+
+  for (const auto &event : done)
+    event->Wait();
+
+  return !corrupt;
+}
+
+/*!
+ * The contents of a window cache, mapped into memory if possible.
+ */
+class CDiscCacheFile
+{
+public:
+  CDiscCacheFile() :
+    m_mapping(NULL),
+    m_data(NULL),
+    m_size(0)
+  {
+  }
+
+  ~CDiscCacheFile()
+  {
+#ifdef TARGET_POSIX
+    if (m_mapping)
+      munmap(m_mapping, m_size);
+#endif
+  }
+
+  bool Open(const std::string &path)
+  {
+#ifdef TARGET_POSIX
+    // the caches are local, no need to go through CFile
+    int fd = open(CSpecialProtocol::TranslatePath(path).c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      void *mapping = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping != MAP_FAILED)
+      {
+        m_mapping = mapping;
+        m_data = static_cast<const uint8_t*>(mapping);
+        m_size = st.st_size;
+      }
+    }
+    close(fd);
+    if (m_mapping)
+      return true;
+#endif
+
+    CFile file;
+    if (file.LoadFile(path, m_buffer) <= 0)
+      return false;
+    m_data = reinterpret_cast<const uint8_t*>(m_buffer.get());
+    m_size = m_buffer.size();
+    return true;
+  }
+
+  const uint8_t *Data() const { return m_data; }
+  size_t Size() const { return m_size; }
+
+private:
+  void *m_mapping;
+  XUTILS::auto_buffer m_buffer;
+  const uint8_t *m_data;
+  size_t m_size;
+};
+}
+
 bool CFileItemList::Load(int windowID)
 {
-  CFile file;
   auto path = GetDiscFileCache(windowID);
-  try
+  CDiscCacheFile file;
+  if (!file.Open(path))
+    return false;
+
+  const uint8_t *pos = file.Data() + sizeof(DISC_CACHE_MAGIC);
+  const uint8_t *end = file.Data() + file.Size();
+  uint32_t version = 0;
+  if (file.Size() < sizeof(DISC_CACHE_MAGIC) || memcmp(file.Data(), DISC_CACHE_MAGIC, sizeof(DISC_CACHE_MAGIC)) != 0 ||
+      !ReadUInt32(pos, end, version) || version != DISC_CACHE_VERSION)
   {
-    if (file.Open(path))
+    CLog::Log(LOGDEBUG, "Ignoring outdated cache: %s", CURL::GetRedacted(path).c_str());
+    return false;
+  }
+
+  DiscCacheRecord header;
+  uint32_t count = 0;
+  std::vector<DiscCacheRecord> records;
+  bool corrupt = !ReadRecord(pos, end, header) || !ReadUInt32(pos, end, count);
+  if (!corrupt)
+  {
+    // every record has at least its length
+    records.reserve(std::min<size_t>(count, (end - pos) / sizeof(uint32_t)));
+    for (uint32_t i = 0; i < count && !corrupt; ++i)
     {
-      CArchive ar(&file, CArchive::load);
-      ar >> *this;
-      CLog::Log(LOGDEBUG,"Loading items: %i, directory: %s sort method: %i, ascending: %s", Size(), CURL::GetRedacted(GetPath()).c_str(), m_sortDescription.sortBy,
-        m_sortDescription.sortOrder == SortOrderAscending ? "true" : "false");
-      ar.Close();
-      file.Close();
-      return true;
+      DiscCacheRecord record;
+      corrupt = !ReadRecord(pos, end, record);
+      records.push_back(record);
     }
   }
+  if (corrupt)
+  {
+    CLog::Log(LOGERROR, "Corrupt archive: %s", CURL::GetRedacted(path).c_str());
+    return false;
+  }
+
+  CSingleLock lock(m_lock);
+
+  CFileItemPtr pParent;
+  if (!IsEmpty())
+  {
+    CFileItemPtr pItem=m_items[0];
+    if (pItem->IsParentFolder())
+      pParent.reset(new CFileItem(*pItem));
+  }
+
+  SetIgnoreURLOptions(false);
+  SetFastLookup(false);
+  Clear();
+
+  bool ignoreURLOptions = false;
+  bool fastLookup = false;
+  std::vector<CFileItemPtr> items;
+  try
+  {
+    CArchive ar(header.first, header.second);
+    CFileItem::Archive(ar);
+    ArchiveProperties(ar, ignoreURLOptions, fastLookup);
+    corrupt = !DecodeItems(records, items);
+  }
   catch(std::out_of_range ex)
+  {
+    corrupt = true;
+  }
+  if (corrupt)
   {
     CLog::Log(LOGERROR, "Corrupt archive: %s", CURL::GetRedacted(path).c_str());
+    Clear();
+    return false;
   }
 
-  return false;
+  m_items.reserve(items.size() + (pParent ? 1 : 0));
+  if (pParent)
+    m_items.push_back(pParent);
+  for (const auto &pItem : items)
+    Add(pItem);
+
+  SetIgnoreURLOptions(ignoreURLOptions);
+  SetFastLookup(fastLookup);
+
+  CLog::Log(LOGDEBUG,"Loading items: %i, directory: %s sort method: %i, ascending: %s", Size(), CURL::GetRedacted(GetPath()).c_str(), m_sortDescription.sortBy,
+    m_sortDescription.sortOrder == SortOrderAscending ? "true" : "false");
+  return true;
 }
 
 bool CFileItemList::Save(int windowID)
@@ -2721,18 +2965,54 @@ bool CFileItemList::Save(int windowID)
 
   CLog::Log(LOGDEBUG,"Saving fileitems [%s]", CURL::GetRedacted(GetPath()).c_str());
 
+  std::vector<uint8_t> buffer;
+  {
+    CSingleLock lock(m_lock);
+
+    buffer.insert(buffer.end(), DISC_CACHE_MAGIC, DISC_CACHE_MAGIC + sizeof(DISC_CACHE_MAGIC));
+    AppendUInt32(buffer, DISC_CACHE_VERSION);
+
+    AppendRecord(buffer, [this](CArchive &ar) {
+      bool ignoreURLOptions = m_ignoreURLOptions;
+      bool fastLookup = m_fastLookup;
+      CFileItem::Archive(ar);
+      ArchiveProperties(ar, ignoreURLOptions, fastLookup);
+    });
+
+    // the parent folder item isn't cached, Load keeps the current one
+    size_t first = (!m_items.empty() && m_items[0]->IsParentFolder()) ? 1 : 0;
+    AppendUInt32(buffer, static_cast<uint32_t>(m_items.size() - first));
+    for (size_t i = first; i < m_items.size(); ++i)
+    {
+      CFileItem &item = *m_items[i];
+      AppendRecord(buffer, [&item](CArchive &ar) { ar << item; });
+    }
+  }
+
+  // Load() may have the cache mapped, so it's replaced instead of overwritten in place
+  std::string cacheFile(GetDiscFileCache(windowID));
+  std::string tempFile(cacheFile + ".tmp");
   CFile file;
-  if (file.OpenForWrite(GetDiscFileCache(windowID), true)) // overwrite always
+  if (!file.OpenForWrite(tempFile, true))
+    return false;
+
+  bool written = file.Write(buffer.data(), buffer.size()) == static_cast<ssize_t>(buffer.size());
+  file.Close();
+  if (written && !CFile::Rename(tempFile, cacheFile))
   {
-    CArchive ar(&file, CArchive::store);
-    ar << *this;
-    CLog::Log(LOGDEBUG,"  -- items: %i, sort method: %i, ascending: %s", iSize, m_sortDescription.sortBy, m_sortDescription.sortOrder == SortOrderAscending ? "true" : "false");
-    ar.Close();
-    file.Close();
-    return true;
+    // not every filesystem replaces the target of a rename
+    CFile::Delete(cacheFile);
+    written = CFile::Rename(tempFile, cacheFile);
+  }
+  if (!written)
+  {
+    CLog::Log(LOGERROR, "%s - failed to write cache for %s", __FUNCTION__, CURL::GetRedacted(GetPath()).c_str());
+    CFile::Delete(tempFile);
+    return false;
   }
 
-  return false;
+  CLog::Log(LOGDEBUG,"  -- items: %i, sort method: %i, ascending: %s", iSize, m_sortDescription.sortBy, m_sortDescription.sortOrder == SortOrderAscending ? "true" : "false");
+  return true;
 }
 
 void CFileItemList::RemoveDiscCache(int windowID) const
@@ -3261,9 +3541,11 @@ void CFileItemList::ClearSortState()
 CVideoInfoTag* CFileItem::GetVideoInfoTag()
 {
   if (!m_videoInfoTag)
-    m_videoInfoTag = new CVideoInfoTag;
+    m_videoInfoTag = std::make_shared<CVideoInfoTag>();
+  else if (!m_videoInfoTag.unique())
+    m_videoInfoTag = std::make_shared<CVideoInfoTag>(*m_videoInfoTag);
 
-  return m_videoInfoTag;
+  return m_videoInfoTag.get();
 }
 
 CPictureInfoTag* CFileItem::GetPictureInfoTag()
@@ -3277,9 +3559,11 @@ CPictureInfoTag* CFileItem::GetPictureInfoTag()
 MUSIC_INFO::CMusicInfoTag* CFileItem::GetMusicInfoTag()
 {
   if (!m_musicInfoTag)
-    m_musicInfoTag = new MUSIC_INFO::CMusicInfoTag;
+    m_musicInfoTag = std::make_shared<MUSIC_INFO::CMusicInfoTag>();
+  else if (!m_musicInfoTag.unique())
+    m_musicInfoTag = std::make_shared<MUSIC_INFO::CMusicInfoTag>(*m_musicInfoTag);
 
-  return m_musicInfoTag;
+  return m_musicInfoTag.get();
 }
 
 std::string CFileItem::FindTrailer() const
@@ -250,26 +250,26 @@ public:
 
   inline bool HasMusicInfoTag() const
   {
-    return m_musicInfoTag != NULL;
+    return m_musicInfoTag.get() != NULL;
   }
 
   MUSIC_INFO::CMusicInfoTag* GetMusicInfoTag();
 
   inline const MUSIC_INFO::CMusicInfoTag* GetMusicInfoTag() const
   {
-    return m_musicInfoTag;
+    return m_musicInfoTag.get();
   }
 
   inline bool HasVideoInfoTag() const
   {
-    return m_videoInfoTag != NULL;
+    return m_videoInfoTag.get() != NULL;
   }
 
   CVideoInfoTag* GetVideoInfoTag();
 
   inline const CVideoInfoTag* GetVideoInfoTag() const
   {
-    return m_videoInfoTag;
+    return m_videoInfoTag.get();
   }
 
   inline bool HasEPGInfoTag() const
@@ -538,8 +538,14 @@ private:
   std::string m_mimetype;
   std::string m_extrainfo;
   bool m_doContentLookup;
-  MUSIC_INFO::CMusicInfoTag* m_musicInfoTag;
-  CVideoInfoTag* m_videoInfoTag;
+  /*! Copies of an item share their music and video tags, which makes copying
+   library items cheap. The non-const getters give the item its own copy of a
+   shared tag before returning it, so a pointer they returned must not be
+   used to change the tag after the item was copied. Code that only reads a
+   tag should use the const getters, which never copy it.
+   */
+  std::shared_ptr<MUSIC_INFO::CMusicInfoTag> m_musicInfoTag;
+  std::shared_ptr<CVideoInfoTag> m_videoInfoTag;
   EPG::CEpgInfoTagPtr m_epgInfoTag;
   PVR::CPVRChannelPtr m_pvrChannelInfoTag;
   PVR::CPVRRecordingPtr m_pvrRecordingInfoTag;
@@ -664,6 +670,9 @@ public:
    windows will be listing different portions of the same URL (eg viewing music files
    versus viewing video files)
 
+   Caches written by an older version of the format are ignored, the caller then
+   fetches the directory again.
+
    \param windowID id of the window that's loading this list (defaults to 0)
    \return true if we loaded from the cache, false otherwise.
    \sa Save,RemoveDiscCache
@@ -676,6 +685,9 @@ public:
    windows will be listing different portions of the same URL (eg viewing music files
    versus viewing video files)
 
+   The items are written as length prefixed records, so Load can map the file
+   and decode them in parallel.
+
    \param windowID id of the window that's saving this list (defaults to 0)
    \return true if successful, false otherwise.
    \sa Load,RemoveDiscCache
@@ -723,10 +735,15 @@ public:
   const std::string &GetContent() const { return m_content; };
 
   void ClearSortState();
+
+  /*! \brief Get the path of the disc cache Save() writes for this list.
+   \param windowID id of the window the list is shown in.
+   */
+  std::string GetDiscFileCache(int windowID) const;
 private:
   void Sort(FILEITEMLISTCOMPARISONFUNC func);
   void FillSortFields(FILEITEMFILLFUNC func);
-  std::string GetDiscFileCache(int windowID) const;
+  void ArchiveProperties(CArchive& ar, bool &ignoreURLOptions, bool &fastLookup);
 
   /*!
    \brief stack files in a CFileItemList
@@ -99,6 +99,7 @@
 #include "cores/AudioEngine/Engines/ActiveAE/AudioDSPAddons/ActiveAEDSP.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/VideoPlayer/VideoRenderers/BaseRenderer.h"
+#include "cores/VideoPlayer/DVDDemuxers/KeyframeIndex.h"
 #include "interfaces/info/InfoExpression.h"
 
 #if defined(TARGET_DARWIN_OSX)
@@ -139,6 +140,8 @@ CGUIInfoManager::CGUIInfoManager(void) :
   m_fanSpeed = 0;
   m_AfterSeekTimeout = 0;
   m_seekOffset = 0;
+  m_seekPreviewIndex = -1;
+  m_seekPreviewChecked = 0;
   m_nextWindowID = WINDOW_INVALID;
   m_prevWindowID = WINDOW_INVALID;
   m_stringParameters.push_back("__ZZZZ__");   // to offset the string parameters by 1 to assure that all entries are non-zero
@@ -458,6 +461,13 @@ const infomap integer_bools[] =  {{ "isequal",          INTEGER_IS_EQUAL },
 ///     Returns true if pvr channel preview is active (used channel tag different
 ///     from played tag)
 ///   }
+///   \table_row3{   <b>`Player.SeekPreview`</b>,
+///                  \anchor Player_SeekPreview
+///                  _string_,
+///     Picture of the video at the time the user is seeking to. Only available
+///     when seek previews are enabled in advancedsettings.xml and once they have
+///     been extracted from the playing file.
+///   }
 /// \table_end
 /// @}
 const infomap player_labels[] =  {{ "hasmedia",         PLAYER_HAS_MEDIA },           // bools from here
@@ -508,7 +518,8 @@ const infomap player_labels[] =  {{ "hasmedia",         PLAYER_HAS_MEDIA },
                                   { "channelpreviewactive", PLAYER_IS_CHANNEL_PREVIEW_ACTIVE},
                                   { "tempoenabled", PLAYER_SUPPORTS_TEMPO},
                                   { "istempo", PLAYER_IS_TEMPO},
-                                  { "playspeed", PLAYER_PLAYSPEED}};
+                                  { "playspeed", PLAYER_PLAYSPEED},
+                                  { "seekpreview",      PLAYER_SEEKPREVIEW }};
 
 /// \page modules__General__List_of_gui_access
 /// @{
@@ -8223,6 +8234,8 @@ std::string CGUIInfoManager::GetImage(int info, int contextWindow, std::string *
       *fallback = "DefaultAlbumCover.png";
     return m_currentFile->HasArt("thumb") ? m_currentFile->GetArt("thumb") : "DefaultAlbumCover.png";
   }
+  else if (info == PLAYER_SEEKPREVIEW)
+    return GetSeekPreview();
   else if (info == VIDEOPLAYER_COVER)
   {
     if (!g_application.m_pPlayer->IsPlayingVideo()) return "";
@@ -9192,6 +9205,32 @@ std::string CGUIInfoManager::GetCurrentSeekTime(TIME_FORMAT format) const
   return StringUtils::SecondsToTimeString(g_application.GetTime() + CSeekHandler::GetInstance().GetSeekSize(), format);
 }
 
+std::string CGUIInfoManager::GetSeekPreview()
+{
+  int count = g_advancedSettings.m_videoSeekPreviews;
+  double totalTime = g_application.GetTotalTime();
+  if (count <= 0 || totalTime <= 0 || !g_application.m_pPlayer->IsPlayingVideo())
+    return "";
+
+  double seekTime = g_application.GetTime() + CSeekHandler::GetInstance().GetSeekSize();
+  int index = std::max(0, std::min(count - 1, (int)(seekTime * count / totalTime)));
+
+  CSingleLock lock(m_seekPreviewSection);
+  if (m_seekPreviewFile.empty())
+    return "";
+
+  // the previews may still be extracted, look for a missing one once a second
+  unsigned int now = CTimeUtils::GetFrameTime();
+  if (index != m_seekPreviewIndex || (m_seekPreviewImage.empty() && now - m_seekPreviewChecked >= 1000))
+  {
+    std::string image = CKeyframeIndex::GetPreviewPath(m_seekPreviewFile, index);
+    m_seekPreviewImage = CFile::Exists(image) ? image : "";
+    m_seekPreviewIndex = index;
+    m_seekPreviewChecked = now;
+  }
+  return m_seekPreviewImage;
+}
+
 int CGUIInfoManager::GetTotalPlayTime() const
 {
   int iTotalTime = MathUtils::round_int(g_application.GetTotalTime());
@@ -9236,6 +9275,11 @@ void CGUIInfoManager::ResetCurrentItem()
   m_currentFile->Reset();
   m_currentMovieThumb = "";
   m_currentMovieDuration = "";
+
+  CSingleLock lock(m_seekPreviewSection);
+  m_seekPreviewFile.clear();
+  m_seekPreviewImage.clear();
+  m_seekPreviewIndex = -1;
 }
 
 void CGUIInfoManager::SetCurrentItem(const CFileItemPtr item)
@@ -9367,6 +9411,17 @@ void CGUIInfoManager::SetCurrentMovie(CFileItem &item)
 
   item.FillInDefaultIcon();
   m_currentMovieThumb = item.GetArt("thumb");
+
+  if (g_advancedSettings.m_videoSeekPreviews > 0 && !item.IsInternetStream())
+  {
+    CSeekPreviewExtractor *job = new CSeekPreviewExtractor(item, g_advancedSettings.m_videoSeekPreviews,
+                                                           g_advancedSettings.m_videoSeekPreviewWidth);
+    {
+      CSingleLock lock(m_seekPreviewSection);
+      m_seekPreviewFile = job->m_item.GetPath();
+    }
+    CJobManager::GetInstance().AddJob(job, NULL, CJob::PRIORITY_LOW);
+  }
 }
 
 std::string CGUIInfoManager::GetSystemHeatInfo(int info)
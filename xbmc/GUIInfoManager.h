@@ -190,6 +190,7 @@ public:
   int64_t GetPlayTime() const;  // in ms
   std::string GetCurrentPlayTime(TIME_FORMAT format = TIME_FORMAT_GUESS) const;
   std::string GetCurrentSeekTime(TIME_FORMAT format = TIME_FORMAT_GUESS) const;
+  std::string GetSeekPreview();
   int GetPlayTimeRemaining() const;
   int GetTotalPlayTime() const;
   float GetSeekPercent() const;
@@ -324,6 +325,13 @@ protected:
   //Fullscreen OSD Stuff
   unsigned int m_AfterSeekTimeout;
   int m_seekOffset;
+
+  // seek bar previews of the playing video
+  CCriticalSection m_seekPreviewSection;
+  std::string m_seekPreviewFile;
+  std::string m_seekPreviewImage;
+  int m_seekPreviewIndex;
+  unsigned int m_seekPreviewChecked;
   std::atomic_bool m_playerShowTime;
   std::atomic_bool m_playerShowInfo;
 
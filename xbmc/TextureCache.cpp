@@ -176,6 +176,43 @@ bool CTextureCache::CacheImage(const std::string &image, CTextureDetails &detail
   return !path.empty();
 }
 
+bool CTextureCache::CacheResizedImage(const std::string &image, CTextureDetails &details)
+{
+  // a non-empty hash means the source should be checked for changes
+  CTextureDetails cached;
+  if (!GetCachedImage(image, cached, true).empty() && cached.hash.empty())
+  {
+    details = cached;
+    return true;
+  }
+
+  CSingleLock lock(m_processingSection);
+  if (m_processinglist.find(image) == m_processinglist.end())
+  {
+    m_processinglist.insert(image);
+    lock.Leave();
+    CTextureCacheJob job(image, cached.hash);
+    bool success = job.CacheResizedTexture();
+    OnCachingComplete(success, &job);
+    if (success)
+      details = job.m_details.hash == cached.hash ? cached : job.m_details;
+    return success;
+  }
+  lock.Leave();
+
+  // wait for the request resizing the same image
+  while (true)
+  {
+    m_completeEvent.WaitMSec(1000);
+    {
+      CSingleLock lock(m_processingSection);
+      if (m_processinglist.find(image) == m_processinglist.end())
+        break;
+    }
+  }
+  return !GetCachedImage(image, details, true).empty();
+}
+
 void CTextureCache::ClearCachedImage(const std::string &url, bool deleteSource /*= false */)
 {
   //! @todo This can be removed when the texture cache covers everything.
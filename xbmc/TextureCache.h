@@ -99,6 +99,16 @@ public:
    \sa CTextureCacheJob::CacheTexture
    */
   bool CacheImage(const std::string &image, CTextureDetails &details);
+  /*! \brief Cache a resized copy of an image if not already cached, returning the image details.
+   The resized image keeps the format of the original and isn't limited to the
+   GUI texture resolution. Concurrent calls for the same image wait for the one
+   resizing it instead of resizing it again.
+   \param image image:// url of the image, including the width/height options.
+   \param details [out] the image details.
+   \return true if the image is in the cache, false otherwise.
+   \sa CTextureCacheJob::CacheResizedTexture
+   */
+  bool CacheResizedImage(const std::string &image, CTextureDetails &details);
 
   /*! \brief Check whether an image is in the cache
    Note: If the image url won't normally be cached (eg a skin image) this function will return false.
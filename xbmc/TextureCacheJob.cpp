@@ -153,6 +153,56 @@ bool CTextureCacheJob::ResizeTexture(const std::string &url, uint8_t* &result, s
   return success;
 }
 
+bool CTextureCacheJob::CacheResizedTexture()
+{
+  std::string additional_info;
+  unsigned int width, height;
+  CPictureScalingAlgorithm::Algorithm scalingAlgorithm;
+  std::string image = DecodeImageURL(m_url, width, height, scalingAlgorithm, additional_info);
+  if (image.empty())
+    return false;
+
+  m_details.updateable = additional_info != "music" && UpdateableURL(image);
+
+  // nothing to do if the source image hasn't changed since it was cached
+  m_details.hash = GetImageHash(image);
+  if (m_details.hash.empty())
+    return false;
+  else if (m_details.hash == m_oldHash)
+    return true;
+
+  CBaseTexture *texture = LoadImage(image, width, height, additional_info, true);
+  if (texture == NULL)
+    return false;
+
+  uint8_t *buffer = NULL;
+  size_t bufferSize = 0;
+  bool success = CPicture::ResizeTexture(image, texture, width, height, buffer, bufferSize, scalingAlgorithm);
+  delete texture;
+  if (!success)
+    return false;
+
+  // the resized image is encoded in the format of the source image
+  std::string extension = URIUtils::GetExtension(image);
+  StringUtils::ToLower(extension);
+  m_details.file = m_cachePath + extension;
+  m_details.width = width;
+  m_details.height = height;
+
+  XFILE::CFile file;
+  success = file.OpenForWrite(CTextureCache::GetCachedPath(m_details.file), true) &&
+            file.Write(buffer, bufferSize) == static_cast<ssize_t>(bufferSize);
+  file.Close();
+  delete[] buffer;
+
+  if (success)
+    CLog::Log(LOGDEBUG, "%s resized image '%s' to '%s'", m_oldHash.empty() ? "Caching" : "Recaching", CURL::GetRedacted(image).c_str(), m_details.file.c_str());
+  else
+    CLog::Log(LOGERROR, "Unable to cache resized image '%s' to '%s'", CURL::GetRedacted(image).c_str(), m_details.file.c_str());
+
+  return success;
+}
+
 std::string CTextureCacheJob::DecodeImageURL(const std::string &url, unsigned int &width, unsigned int &height, CPictureScalingAlgorithm::Algorithm& scalingAlgorithm, std::string &additional_info)
 {
   // unwrap the URL as required
@@ -81,6 +81,14 @@ public:
 
   static bool ResizeTexture(const std::string &url, uint8_t* &result, size_t &result_size);
 
+  /*! \brief Resize the image and store the result in the texture cache
+   Unlike CacheTexture() the image keeps its format and isn't limited to the
+   resolution of GUI textures, which is what clients of the web server expect
+   when they ask for a transformed image (see ResizeTexture()).
+   \return true if the image was cached or the cached version is still up to date
+   */
+  bool CacheResizedTexture();
+
   std::string m_url;
   std::string m_oldHash;
   CTextureDetails m_details;
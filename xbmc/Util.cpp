@@ -1371,6 +1371,27 @@ void CUtil::DeleteDirectoryCache(const std::string &prefix)
   }
 }
 
+void CUtil::DeleteOldFiles(const std::string &path, const std::string &mask, unsigned int maxAgeDays, unsigned int maxFiles)
+{
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(path, items, mask, DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE))
+    return;
+
+  items.Sort(SortByDate, SortOrderDescending);
+  CDateTime oldest = CDateTime::GetCurrentDateTime() - CDateTimeSpan(maxAgeDays, 0, 0, 0);
+  unsigned int kept = 0;
+  for (int i = 0; i < items.Size(); ++i)
+  {
+    if (items[i]->m_bIsFolder)
+      continue;
+
+    if ((maxFiles > 0 && kept >= maxFiles) ||
+        (maxAgeDays > 0 && items[i]->m_dateTime.IsValid() && items[i]->m_dateTime < oldest))
+      XFILE::CFile::Delete(items[i]->GetPath());
+    else
+      kept++;
+  }
+}
 
 void CUtil::GetRecursiveListing(const std::string& strPath, CFileItemList& items, const std::string& strMask, unsigned int flags /* = DIR_FLAG_DEFAULTS */)
 {
@@ -145,6 +145,13 @@ public:
   static int GetMatchingSource(const std::string& strPath, VECSOURCES& VECSOURCES, bool& bIsSourceName);
   static std::string TranslateSpecialSource(const std::string &strSpecial);
   static void DeleteDirectoryCache(const std::string &prefix = "");
+  /*! \brief Delete the oldest files of a cache folder
+   \param path the folder to clean up
+   \param mask extensions of the files to look at, e.g. ".kfi|.jpg"
+   \param maxAgeDays files not modified for more days are deleted, 0 for no age limit
+   \param maxFiles only this many of the most recently modified files are kept, 0 for no limit
+   */
+  static void DeleteOldFiles(const std::string &path, const std::string &mask, unsigned int maxAgeDays, unsigned int maxFiles);
   static void DeleteMusicDatabaseDirectoryCache();
   static void DeleteVideoDatabaseDirectoryCache();
   static std::string MusicPlaylistsLocation();
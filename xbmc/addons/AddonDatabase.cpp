@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <map>
 #include <utility>
 
 #include "addons/AddonBuilder.h"
@@ -32,6 +33,7 @@
 #include "utils/JSONVariantWriter.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "DllLibCPluff.h"
 #include "XBDateTime.h"
@@ -133,7 +135,7 @@ int CAddonDatabase::GetMinSchemaVersion() const
 
 int CAddonDatabase::GetSchemaVersion() const
 {
-  return 27;
+  return 28;
 }
 
 void CAddonDatabase::CreateTables()
@@ -169,6 +171,10 @@ void CAddonDatabase::CreateTables()
   m_pDS->exec("CREATE TABLE installed (id INTEGER PRIMARY KEY, addonID TEXT UNIQUE, "
       "enabled BOOLEAN, installDate TEXT, lastUpdated TEXT, lastUsed TEXT, "
       "origin TEXT NOT NULL DEFAULT '') \n");
+
+  CLog::Log(LOGINFO, "create manifest table");
+  m_pDS->exec("CREATE TABLE manifest (id INTEGER PRIMARY KEY, path TEXT UNIQUE, addonID TEXT, "
+      "mtime INTEGER, version TEXT, extensions TEXT)\n");
 }
 
 void CAddonDatabase::CreateAnalytics()
@@ -306,6 +312,11 @@ void CAddonDatabase::UpdateTables(int version)
   {
     m_pDS->exec("ALTER TABLE addons ADD news TEXT NOT NULL DEFAULT ''");
   }
+  if (version < 28)
+  {
+    m_pDS->exec("CREATE TABLE manifest (id INTEGER PRIMARY KEY, path TEXT UNIQUE, addonID TEXT, "
+        "mtime INTEGER, version TEXT, extensions TEXT)\n");
+  }
 }
 
 void CAddonDatabase::SyncInstalled(const std::set<std::string>& ids,
@@ -400,6 +411,79 @@ void CAddonDatabase::GetInstalled(std::vector<CAddonBuilder>& addons)
   }
 }
 
+bool ManifestEntry::Provides(const TYPE& type) const
+{
+  if (type == ADDON_UNKNOWN)
+    return true;
+  return std::any_of(extensions.begin(), extensions.end(),
+      [&type](const std::string& ext){ return TranslateType(ext) == type; });
+}
+
+bool CAddonDatabase::GetManifest(std::vector<ManifestEntry>& entries)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    m_pDS->query(PrepareSQL("SELECT path, addonID, mtime, version, extensions FROM manifest"));
+    while (!m_pDS->eof())
+    {
+      ManifestEntry entry;
+      entry.path = m_pDS->fv(0).get_asString();
+      entry.id = m_pDS->fv(1).get_asString();
+      entry.mtime = m_pDS->fv(2).get_asInt64();
+      entry.version = AddonVersion(m_pDS->fv(3).get_asString());
+      entry.extensions = StringUtils::Split(m_pDS->fv(4).get_asString(), ",");
+      entries.push_back(std::move(entry));
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return false;
+}
+
+bool CAddonDatabase::UpdateManifest(const std::vector<ManifestEntry>& changed, const std::vector<std::string>& removed)
+{
+  if (changed.empty() && removed.empty())
+    return true;
+
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    BeginTransaction();
+    for (const auto& path : removed)
+      m_pDS->exec(PrepareSQL("DELETE FROM manifest WHERE path='%s'", path.c_str()));
+
+    for (const auto& entry : changed)
+    {
+      m_pDS->exec(PrepareSQL("DELETE FROM manifest WHERE path='%s'", entry.path.c_str()));
+      m_pDS->exec(PrepareSQL("INSERT INTO manifest (path, addonID, mtime, version, extensions) "
+          "VALUES ('%s', '%s', %s, '%s', '%s')",
+          entry.path.c_str(),
+          entry.id.c_str(),
+          StringUtils::Format("%" PRId64, entry.mtime).c_str(),
+          entry.version.asString().c_str(),
+          StringUtils::Join(entry.extensions, ",").c_str()));
+    }
+    CommitTransaction();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+    RollbackTransaction();
+  }
+  return false;
+}
+
 bool CAddonDatabase::SetLastUpdated(const std::string& addonId, const CDateTime& dateTime)
 {
   try
@@ -777,29 +861,83 @@ void CAddonDatabase::DeleteRepository(const std::string& id)
 }
 
 bool CAddonDatabase::UpdateRepositoryContent(const std::string& repository, const AddonVersion& version,
-    const std::string& checksum, const std::vector<AddonPtr>& addons)
+    const std::string& checksum, const std::vector<AddonPtr>& addons, const std::vector<std::string>& unchangedDirs)
 {
   try
   {
     if (NULL == m_pDB.get()) return false;
     if (NULL == m_pDS.get()) return false;
 
-    DeleteRepository(repository);
-
     if (!SetLastChecked(repository, version, CDateTime::GetCurrentDateTime().GetAsDBDateTime()))
       return false;
 
-    int idRepo = static_cast<int>(m_pDS->lastinsertid());
-    assert(idRepo > 0);
+    m_pDS->query(PrepareSQL("SELECT id FROM repo WHERE addonID='%s'", repository.c_str()));
+    if (m_pDS->eof())
+      return false;
+    int idRepo = m_pDS->fv(0).get_asInt();
+    m_pDS->close();
+
+    struct StoredAddon
+    {
+      int id;
+      std::string metadata;
+      std::string name;
+      std::string summary;
+      std::string description;
+      std::string news;
+    };
+
+    // Index what is currently stored for this repository by addon id and version
+    std::map<std::pair<std::string, std::string>, StoredAddon> stored;
+    m_pDS->query(PrepareSQL(
+        "SELECT addons.id, addons.addonID, addons.version, addons.metadata, addons.name, "
+        "addons.summary, addons.description, addons.news FROM addons "
+        "JOIN addonlinkrepo ON addonlinkrepo.idAddon=addons.id "
+        "WHERE addonlinkrepo.idRepo=%i", idRepo));
+    while (!m_pDS->eof())
+    {
+      StoredAddon addon{m_pDS->fv(0).get_asInt(), m_pDS->fv(3).get_asString(), m_pDS->fv(4).get_asString(),
+          m_pDS->fv(5).get_asString(), m_pDS->fv(6).get_asString(), m_pDS->fv(7).get_asString()};
+      stored.emplace(std::make_pair(m_pDS->fv(1).get_asString(), m_pDS->fv(2).get_asString()), std::move(addon));
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    unsigned int inserted = 0;
+    unsigned int updated = 0;
+    unsigned int deleted = 0;
 
     m_pDB->start_transaction();
     m_pDS->exec(PrepareSQL("UPDATE repo SET checksum='%s' WHERE id='%d'", checksum.c_str(), idRepo));
     for (const auto& addon : addons)
     {
+      const auto metadata = SerializeMetadata(*addon);
+      auto it = stored.find(std::make_pair(addon->ID(), addon->Version().asString()));
+      if (it != stored.end())
+      {
+        const auto& row = it->second;
+        if (row.metadata != metadata || row.name != addon->Name() || row.summary != addon->Summary() ||
+            row.description != addon->Description() || row.news != addon->ChangeLog())
+        {
+          m_pDS->exec(PrepareSQL(
+              "UPDATE addons SET metadata='%s', name='%s', summary='%s', description='%s', news='%s' "
+              "WHERE id=%i",
+              metadata.c_str(),
+              addon->Name().c_str(),
+              addon->Summary().c_str(),
+              addon->Description().c_str(),
+              addon->ChangeLog().c_str(),
+              row.id));
+          ++updated;
+        }
+        stored.erase(it);
+        continue;
+      }
+
       m_pDS->exec(PrepareSQL(
           "INSERT INTO addons (id, metadata, addonID, version, name, summary, description, news) "
           "VALUES (NULL, '%s', '%s', '%s', '%s','%s', '%s','%s')",
-          SerializeMetadata(*addon).c_str(),
+          metadata.c_str(),
           addon->ID().c_str(),
           addon->Version().asString().c_str(),
           addon->Name().c_str(),
@@ -816,9 +954,29 @@ bool CAddonDatabase::UpdateRepositoryContent(const std::string& repository, cons
       }
 
       m_pDS->exec(PrepareSQL("INSERT INTO addonlinkrepo (idRepo, idAddon) VALUES (%i, %i)", idRepo, idAddon));
+      ++inserted;
+    }
+
+    // Whatever is left is no longer listed, unless it belongs to an index that wasn't fetched
+    for (const auto& kv : stored)
+    {
+      if (!unchangedDirs.empty())
+      {
+        const std::string path = CJSONVariantParser::Parse(kv.second.metadata)["path"].asString();
+        if (std::any_of(unchangedDirs.begin(), unchangedDirs.end(),
+            [&path](const std::string& dir){ return URIUtils::PathHasParent(path, dir, true); }))
+          continue;
+      }
+
+      m_pDS->exec(PrepareSQL("DELETE FROM addonlinkrepo WHERE idAddon=%i", kv.second.id));
+      m_pDS->exec(PrepareSQL("DELETE FROM addons WHERE id=%i", kv.second.id));
+      ++deleted;
     }
 
     m_pDB->commit_transaction();
+
+    CLog::Log(LOGDEBUG, "CAddonDatabase: updated repository '%s': %u inserted, %u updated, %u deleted",
+        repository.c_str(), inserted, updated, deleted);
     return true;
   }
   catch (...)
@@ -27,6 +27,29 @@
 #include "FileItem.h"
 #include "AddonBuilder.h"
 
+namespace ADDON
+{
+  /*!
+   \brief Cached outcome of parsing an installed addon.xml.
+   Allows the addon manager to skip parsing descriptors that did not change since the last start.
+   */
+  struct ManifestEntry
+  {
+    ManifestEntry() : mtime(0), version("0.0.0") {}
+    std::string id;
+    std::string path;
+    int64_t mtime;
+    AddonVersion version;
+    std::vector<std::string> extensions; //!< extension point ids, excluding the metadata one
+
+    /*!
+     \brief Whether the addon can be requested as the given type.
+     Every addon is of ADDON_UNKNOWN, also the ones without an extension point like xbmc.python.
+     */
+    bool Provides(const TYPE& type) const;
+  };
+}
+
 class CAddonDatabase : public CDatabase
 {
 public:
@@ -53,8 +76,19 @@ public:
   /*! Returns all addons in the repositories with id `addonId`. */
   bool FindByAddonId(const std::string& addonId, ADDON::VECADDONS& addons);
 
+  /*!
+   \brief Update the stored content of a repository.
+   Only the difference to the currently stored content is written: addons with an unchanged id,
+   version and metadata are left untouched, new ones are inserted and vanished ones are removed.
+   \param repositoryId id of the repository
+   \param version version of the repository addon
+   \param checksum the checksum of the repository index
+   \param addons the addons listed by the fetched indexes of the repository
+   \param unchangedDirs datadirs of indexes that were not fetched. Stored addons located in these are kept.
+   */
   bool UpdateRepositoryContent(const std::string& repositoryId, const ADDON::AddonVersion& version,
-      const std::string& checksum, const std::vector<ADDON::AddonPtr>& addons);
+      const std::string& checksum, const std::vector<ADDON::AddonPtr>& addons,
+      const std::vector<std::string>& unchangedDirs = std::vector<std::string>());
 
   int GetRepoChecksum(const std::string& id, std::string& checksum);
 
@@ -140,6 +174,15 @@ public:
 
   void GetInstalled(std::vector<ADDON::CAddonBuilder>& addons);
 
+  /*! \brief Get the stored manifest of all addon descriptors parsed so far */
+  bool GetManifest(std::vector<ADDON::ManifestEntry>& entries);
+
+  /*! \brief Store changed manifest entries and remove the entries of vanished addon folders
+   \param changed entries that were (re)parsed, replacing any stored entry with the same path
+   \param removed paths of addon folders that no longer exist
+   */
+  bool UpdateManifest(const std::vector<ADDON::ManifestEntry>& changed, const std::vector<std::string>& removed);
+
   bool SetLastUpdated(const std::string& addonId, const CDateTime& dateTime);
   bool SetOrigin(const std::string& addonId, const std::string& origin);
   bool SetLastUsed(const std::string& addonId, const CDateTime& dateTime);
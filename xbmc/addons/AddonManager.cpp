@@ -40,6 +40,10 @@
 #include "DllLibCPluff.h"
 #include "events/AddonManagementEvent.h"
 #include "events/EventLog.h"
+#include "FileItem.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "LangInfo.h"
 #include "PluginSource.h"
 #include "Repository.h"
@@ -74,12 +78,23 @@ void cp_logger(cp_log_severity_t level, const char *msg, const char *apid, void
 
 std::map<TYPE, IAddonMgrCallback*> CAddonMgr::m_managers;
 
+static const char* const ADDON_FOLDERS[] = {
+  "special://home/addons",
+  "special://xbmc/addons",
+  "special://xbmcbin/addons"
+};
+
+static bool IsMetadataExtPoint(const char* id)
+{
+  return strcmp(id, "kodi.addon.metadata") == 0 || strcmp(id, "xbmc.addon.metadata") == 0;
+}
+
 static cp_extension_t* GetFirstExtPoint(const cp_plugin_info_t* addon, TYPE type)
 {
   for (unsigned int i = 0; i < addon->num_extensions; ++i)
   {
     cp_extension_t* ext = &addon->extensions[i];
-    if (strcmp(ext->ext_point_id, "kodi.addon.metadata") == 0 || strcmp(ext->ext_point_id, "xbmc.addon.metadata") == 0)
+    if (IsMetadataExtPoint(ext->ext_point_id))
       continue;
 
     if (type == ADDON_UNKNOWN)
@@ -321,25 +336,14 @@ bool CAddonMgr::Init()
   //! @todo could separate addons into different contexts would allow partial unloading of addon framework
   m_cp_context = m_cpluff->create_context(&status);
   assert(m_cp_context);
-  status = m_cpluff->register_pcollection(m_cp_context, CSpecialProtocol::TranslatePath("special://home/addons").c_str());
-  if (status != CP_OK)
-  {
-    CLog::Log(LOGERROR, "ADDONS: Fatal Error, cp_register_pcollection() returned status: %i", status);
-    return false;
-  }
-
-  status = m_cpluff->register_pcollection(m_cp_context, CSpecialProtocol::TranslatePath("special://xbmc/addons").c_str());
-  if (status != CP_OK)
-  {
-    CLog::Log(LOGERROR, "ADDONS: Fatal Error, cp_register_pcollection() returned status: %i", status);
-    return false;
-  }
-
-  status = m_cpluff->register_pcollection(m_cp_context, CSpecialProtocol::TranslatePath("special://xbmcbin/addons").c_str());
-  if (status != CP_OK)
+  for (const auto folder : ADDON_FOLDERS)
   {
-    CLog::Log(LOGERROR, "ADDONS: Fatal Error, cp_register_pcollection() returned status: %i", status);
-    return false;
+    status = m_cpluff->register_pcollection(m_cp_context, CSpecialProtocol::TranslatePath(folder).c_str());
+    if (status != CP_OK)
+    {
+      CLog::Log(LOGERROR, "ADDONS: Fatal Error, cp_register_pcollection() returned status: %i", status);
+      return false;
+    }
   }
 
   status = m_cpluff->register_logger(m_cp_context, cp_logger,
@@ -385,6 +389,7 @@ bool CAddonMgr::Init()
 
 void CAddonMgr::DeInit()
 {
+  m_deferred.clear();
   m_cpluff->destroy_context(m_cp_context);
   m_cpluff.reset();
   m_database.Close();
@@ -563,16 +568,22 @@ bool CAddonMgr::GetAddonsInternal(const TYPE &type, VECADDONS &addons, bool enab
 
   for (auto& builder : builders)
   {
+    if (enabledOnly && IsAddonDisabled(builder.GetId()))
+      continue;
+
+    // Addons without an extension point are skipped below, there is no need to load them for that.
+    // Every other addon has to be loaded to be listed as ADDON_UNKNOWN.
+    auto deferred = m_deferred.find(builder.GetId());
+    if (deferred != m_deferred.end() && deferred->second.extensions.empty())
+      continue;
+
+    if (!LoadDeferred(builder.GetId(), type))
+      continue;
+
     cp_status_t status;
     cp_plugin_info_t* cp_addon = m_cpluff->get_plugin_info(m_cp_context, builder.GetId().c_str(), &status);
     if (status == CP_OK && cp_addon)
     {
-      if (enabledOnly && IsAddonDisabled(cp_addon->identifier))
-      {
-        m_cpluff->release_info(m_cp_context, cp_addon);
-        continue;
-      }
-
       //FIXME: hack for skipping special dependency addons (xbmc.python etc.).
       //Will break if any extension point is added to them
       cp_extension_t *props = GetFirstExtPoint(cp_addon, type);
@@ -604,6 +615,9 @@ bool CAddonMgr::GetAddon(const std::string &str, AddonPtr &addon, const TYPE &ty
 {
   CSingleLock lock(m_critSection);
 
+  if (!LoadDeferred(str, type))
+    return false;
+
   cp_status_t status;
   cp_plugin_info_t *cpaddon = m_cpluff->get_plugin_info(m_cp_context, str.c_str(), &status);
   if (status == CP_OK && cpaddon)
@@ -629,6 +643,162 @@ bool CAddonMgr::GetAddon(const std::string &str, AddonPtr &addon, const TYPE &ty
   return false;
 }
 
+void CAddonMgr::ScanAddonFolders()
+{
+  auto start = XbmcThreads::SystemClockMillis();
+
+  std::map<std::string, ManifestEntry> manifest;
+  {
+    std::vector<ManifestEntry> entries;
+    m_database.GetManifest(entries);
+    for (auto& entry : entries)
+      manifest.emplace(entry.path, std::move(entry));
+  }
+
+  // highest version of every addon found, along with its descriptor if it had to be parsed
+  std::map<std::string, std::pair<ManifestEntry, cp_plugin_info_t*>> available;
+  std::vector<ManifestEntry> changed;
+  std::vector<std::string> removed;
+  std::set<std::string> visited;
+  unsigned int total = 0;
+
+  for (const auto folder : ADDON_FOLDERS)
+  {
+    CFileItemList items;
+    CDirectory::GetDirectory(CSpecialProtocol::TranslatePath(folder), items, "",
+        DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO | DIR_FLAG_BYPASS_CACHE);
+
+    for (int i = 0; i < items.Size(); ++i)
+    {
+      const CFileItemPtr item = items[i];
+      if (!item->m_bIsFolder)
+        continue;
+
+      std::string path = item->GetPath();
+      URIUtils::RemoveSlashAtEnd(path);
+      if (!visited.insert(path).second)
+        continue;
+
+      struct __stat64 st;
+      if (CFile::Stat(URIUtils::AddFileToFolder(path, "addon.xml"), &st) != 0)
+        continue;
+
+      auto stored = manifest.find(path);
+      ManifestEntry entry;
+      cp_plugin_info_t* info = nullptr;
+      if (stored != manifest.end() && stored->second.mtime == static_cast<int64_t>(st.st_mtime))
+        entry = stored->second;
+      else
+      {
+        cp_status_t status;
+        info = m_cpluff->load_plugin_descriptor(m_cp_context, path.c_str(), &status);
+        if (!info)
+          continue;
+
+        entry.id = info->identifier;
+        entry.path = path;
+        entry.mtime = st.st_mtime;
+        entry.version = AddonVersion(info->version ? info->version : "0.0.0");
+        for (unsigned int i = 0; i < info->num_extensions; ++i)
+        {
+          if (!IsMetadataExtPoint(info->extensions[i].ext_point_id))
+            entry.extensions.emplace_back(info->extensions[i].ext_point_id);
+        }
+        changed.push_back(entry);
+      }
+      if (stored != manifest.end())
+        manifest.erase(stored);
+      ++total;
+
+      auto it = available.find(entry.id);
+      if (it == available.end())
+      {
+        std::string id = entry.id;
+        available.emplace(std::move(id), std::make_pair(std::move(entry), info));
+      }
+      else if (it->second.first.version < entry.version)
+      {
+        if (it->second.second)
+          m_cpluff->release_info(m_cp_context, it->second.second);
+        it->second = std::make_pair(std::move(entry), info);
+      }
+      else if (info)
+        m_cpluff->release_info(m_cp_context, info);
+    }
+  }
+
+  for (const auto& kv : manifest)
+    removed.push_back(kv.first);
+
+  unsigned int deferred = 0;
+  for (auto& kv : available)
+  {
+    auto& entry = kv.second.first;
+    auto info = kv.second.second;
+
+    // Same as cp_scan_plugins with CP_SP_UPGRADE: replace installed addons by newer versions only
+    cp_status_t status;
+    cp_plugin_info_t* installed = m_cpluff->get_plugin_info(m_cp_context, kv.first.c_str(), &status);
+    if (installed)
+    {
+      bool upgrade = AddonVersion(installed->version ? installed->version : "0.0.0") < entry.version;
+      m_cpluff->release_info(m_cp_context, installed);
+      if (!upgrade)
+      {
+        if (info)
+          m_cpluff->release_info(m_cp_context, info);
+        continue;
+      }
+      m_cpluff->uninstall_plugin(m_cp_context, kv.first.c_str());
+    }
+
+    if (info)
+    {
+      m_deferred.erase(kv.first);
+      if (m_cpluff->install_plugin(m_cp_context, info) != CP_OK)
+        CLog::Log(LOGERROR, "ADDONS: failed to install %s", kv.first.c_str());
+      m_cpluff->release_info(m_cp_context, info);
+    }
+    else
+    {
+      auto it = m_deferred.find(kv.first);
+      if (it == m_deferred.end() || it->second.version < entry.version)
+      {
+        m_deferred[kv.first] = std::move(entry);
+        ++deferred;
+      }
+    }
+  }
+
+  m_database.UpdateManifest(changed, removed);
+
+  CLog::Log(LOGNOTICE, "ADDONS: scanned %u addon folders in %u ms (%u parsed, %u deferred)",
+      total, XbmcThreads::SystemClockMillis() - start, static_cast<unsigned int>(changed.size()), deferred);
+}
+
+bool CAddonMgr::LoadDeferred(const std::string& id, const TYPE& type)
+{
+  auto it = m_deferred.find(id);
+  if (it == m_deferred.end())
+    return true;
+
+  if (!it->second.Provides(type))
+    return false;
+
+  cp_status_t status;
+  cp_plugin_info_t* info = m_cpluff->load_plugin_descriptor(m_cp_context, it->second.path.c_str(), &status);
+  m_deferred.erase(it);
+  if (!info)
+  {
+    CLog::Log(LOGERROR, "ADDONS: failed to load deferred addon %s", id.c_str());
+    return false;
+  }
+
+  status = m_cpluff->install_plugin(m_cp_context, info);
+  m_cpluff->release_info(m_cp_context, info);
+  return status == CP_OK;
+}
+
 bool CAddonMgr::FindAddons()
 {
   bool result = false;
@@ -636,7 +806,7 @@ bool CAddonMgr::FindAddons()
   if (m_cpluff && m_cp_context)
   {
     result = true;
-    m_cpluff->scan_plugins(m_cp_context, CP_SP_UPGRADE);
+    ScanAddonFolders();
 
     //Sync with db
     {
@@ -647,6 +817,8 @@ bool CAddonMgr::FindAddons()
       for (int i = 0; i < n; ++i)
         installed.insert(cp_addons[i]->identifier);
       m_cpluff->release_info(m_cp_context, cp_addons);
+      for (const auto& kv : m_deferred)
+        installed.insert(kv.first);
       m_database.SyncInstalled(installed, m_systemAddons, m_optionalAddons);
     }
 
@@ -668,6 +840,12 @@ bool CAddonMgr::FindAddons()
 bool CAddonMgr::UnloadAddon(const AddonPtr& addon)
 {
   CSingleLock lock(m_critSection);
+  if (m_deferred.erase(addon->ID()) > 0)
+  {
+    m_events.Publish(AddonEvents::InstalledChanged());
+    return true;
+  }
+
   if (m_cpluff && m_cp_context)
   {
     if (m_cpluff->uninstall_plugin(m_cp_context, addon->ID().c_str()) == CP_OK)
@@ -685,6 +863,7 @@ bool CAddonMgr::ReloadAddon(AddonPtr& addon)
   if (!addon ||!m_cpluff || !m_cp_context)
     return false;
 
+  m_deferred.erase(addon->ID());
   m_cpluff->uninstall_plugin(m_cp_context, addon->ID().c_str());
   return FindAddons()
       && GetAddon(addon->ID(), addon, ADDON_UNKNOWN, false)
@@ -269,8 +269,22 @@ namespace ADDON
     bool GetAddonsInternal(const TYPE &type, VECADDONS &addons, bool enabledOnly);
     bool EnableSingle(const std::string& id);
 
+    /*! \brief Scan the addon folders and install changed descriptors into the cpluff context.
+     Descriptors that did not change since they were recorded in the manifest are not parsed,
+     they are deferred until the addon is first requested.
+     */
+    void ScanAddonFolders();
+
+    /*! \brief Install the descriptor of an addon that was deferred by ScanAddonFolders.
+     \param id id of the addon
+     \param type the type the addon is requested as
+     \return false if the addon is deferred and cannot satisfy the type, or failed to load. true otherwise.
+     */
+    bool LoadDeferred(const std::string& id, const TYPE& type);
+
     std::set<std::string> m_disabled;
     std::set<std::string> m_updateBlacklist;
+    std::map<std::string, ManifestEntry> m_deferred;
     static std::map<TYPE, IAddonMgrCallback*> m_managers;
     CCriticalSection m_critSection;
     CAddonDatabase m_database;
@@ -30,6 +30,7 @@
 #include "utils/Variant.h"
 
 #include "pvr/PVRManager.h"
+#include "pvr/addons/PVRClientCalls.h"
 #include "pvr/addons/PVRClients.h"
 #include "pvr/channels/PVRChannelGroupsContainer.h"
 #include "pvr/recordings/PVRRecordings.h"
@@ -212,6 +213,10 @@ void CPVRClient::Destroy(void)
   /* reset 'ready to use' to false */
   CLog::Log(LOGDEBUG, "PVR - %s - destroying PVR add-on '%s'", __FUNCTION__, GetFriendlyName().c_str());
 
+  /* a call that timed out may still execute in the add-on, it mustn't be unloaded under it */
+  while (!CPVRClientCalls::WaitForClient(m_iClientId, 5000))
+    CLog::Log(LOGWARNING, "PVR - %s - waiting for PVR add-on '%s' to answer a call", __FUNCTION__, GetFriendlyName().c_str());
+
   /* destroy the add-on */
   try { CAddonDll<DllPVRClient, PVRClient, PVR_PROPERTIES>::Destroy(); }
   catch (std::exception &e) { LogException(e, __FUNCTION__); }
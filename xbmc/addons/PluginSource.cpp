@@ -20,6 +20,7 @@
 
 #include "PluginSource.h"
 
+#include <cstdlib>
 #include <utility>
 
 #include "AddonManager.h"
@@ -33,6 +34,11 @@ std::unique_ptr<CPluginSource> CPluginSource::FromExtension(AddonProps props, co
   std::string provides = CAddonMgr::GetInstance().GetExtValue(ext->configuration, "provides");
   if (!provides.empty())
     props.extrainfo.insert(make_pair("provides", provides));
+  if (CAddonMgr::GetInstance().GetExtValue(ext->configuration, "reuseinterpreter") == "true")
+  {
+    std::string timeout = CAddonMgr::GetInstance().GetExtValue(ext->configuration, "reuseinterpreter@idletimeout");
+    props.extrainfo.insert(make_pair("reuseinterpreter", timeout.empty() ? "300" : timeout));
+  }
   return std::unique_ptr<CPluginSource>(new CPluginSource(std::move(props), provides));
 }
 
@@ -51,6 +57,15 @@ CPluginSource::CPluginSource(AddonProps props, const std::string& provides)
   SetProvides(provides);
 }
 
+unsigned int CPluginSource::GetInterpreterIdleTimeout() const
+{
+  InfoMap::const_iterator i = m_props.extrainfo.find("reuseinterpreter");
+  if (i == m_props.extrainfo.end())
+    return 0;
+  int timeout = atoi(i->second.c_str());
+  return timeout > 0 ? timeout : 0;
+}
+
 void CPluginSource::SetProvides(const std::string &content)
 {
   if (!content.empty())
@@ -47,6 +47,13 @@ public:
     return m_providedContent.size() > 1;
   }
 
+  /*! \brief Seconds an interpreter running this add-on is kept alive for the next invocation
+   Add-ons opt in with <reuseinterpreter idletimeout="300">true</reuseinterpreter>
+   in their xbmc.python.pluginsource extension.
+   \return the idle timeout, 0 if every invocation gets a fresh interpreter
+   */
+  unsigned int GetInterpreterIdleTimeout() const;
+
   static Content Translate(const std::string &content);
 private:
   /*! \brief Set the provided content for this plugin
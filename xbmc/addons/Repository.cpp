@@ -42,6 +42,7 @@
 #include "URL.h"
 #include "utils/JobManager.h"
 #include "utils/log.h"
+#include "utils/md5.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -171,31 +172,77 @@ bool CRepository::FetchIndex(const DirInfo& repo, VECADDONS& addons) noexcept
   return CAddonMgr::GetInstance().AddonsFromRepoXML(repo, response, addons);
 }
 
+std::string CRepository::JoinDigests(const DigestMap& digests)
+{
+  // The map is ordered by path, so reordering the dirs doesn't change the checksum
+  std::string checksum;
+  for (const auto& digest : digests)
+    checksum += digest.second + " " + digest.first + "\n";
+  return checksum;
+}
+
+CRepository::DigestMap CRepository::SplitDigests(const std::string& checksum)
+{
+  // Every line is the md5 digest of a dir's checksum file, i.e. exactly 32 characters, and the path of its index
+  static const size_t digestLength = 32;
+  DigestMap digests;
+  for (const auto& line : StringUtils::Split(checksum, "\n"))
+  {
+    if (line.empty())
+      continue;
+    if (line.size() <= digestLength + 1 || line[digestLength] != ' ')
+      return DigestMap();
+    digests[line.substr(digestLength + 1)] = line.substr(0, digestLength);
+  }
+  return digests;
+}
+
 CRepository::FetchStatus CRepository::FetchIfChanged(const std::string& oldChecksum,
-    std::string& checksum, VECADDONS& addons) const
+    std::string& checksum, VECADDONS& addons, std::vector<std::string>& unchangedDirs) const
 {
   checksum = "";
+  bool hasChecksum = false;
+  DigestMap digests;
   for (const auto& dir : m_dirs)
   {
+    std::string part;
     if (!dir.checksum.empty())
     {
-      std::string part;
       if (!FetchChecksum(dir.checksum, part))
       {
         CLog::Log(LOGERROR, "CRepository: failed read '%s'", dir.checksum.c_str());
         return STATUS_ERROR;
       }
-      checksum += part;
+      hasChecksum = true;
     }
+    digests[dir.info] = XBMC::XBMC_MD5::GetMD5(part);
   }
 
+  // Keep the old behaviour of an empty checksum for repositories without any checksum files
+  if (hasChecksum)
+    checksum = JoinDigests(digests);
+
   if (oldChecksum == checksum && !oldChecksum.empty())
     return STATUS_NOT_MODIFIED;
 
+  const DigestMap oldDigests = SplitDigests(oldChecksum);
+  std::vector<const DirInfo*> changedDirs;
   for (const auto& dir : m_dirs)
+  {
+    auto oldDigest = oldDigests.find(dir.info);
+    if (!dir.checksum.empty() && oldDigest != oldDigests.end() && oldDigest->second == digests[dir.info])
+    {
+      CLog::Log(LOGDEBUG, "CRepository: index '%s' not modified", dir.info.c_str());
+      unchangedDirs.push_back(dir.datadir);
+    }
+    else
+      changedDirs.push_back(&dir);
+  }
+
+  for (const auto& dir : changedDirs)
   {
     VECADDONS tmp;
-    if (!FetchIndex(dir, tmp))
+    if (!FetchIndex(*dir, tmp))
       return STATUS_ERROR;
     addons.insert(addons.end(), tmp.begin(), tmp.end());
   }
@@ -216,7 +263,8 @@ bool CRepositoryUpdateJob::DoWork()
 
   std::string newChecksum;
   VECADDONS addons;
-  auto status = m_repo->FetchIfChanged(oldChecksum, newChecksum, addons);
+  std::vector<std::string> unchangedDirs;
+  auto status = m_repo->FetchIfChanged(oldChecksum, newChecksum, addons, unchangedDirs);
 
   database.SetLastChecked(m_repo->ID(), m_repo->Version(),
       CDateTime::GetCurrentDateTime().GetAsDBDateTime());
@@ -232,7 +280,7 @@ bool CRepositoryUpdateJob::DoWork()
     return true;
   }
 
-  //Invalidate art.
+  //Invalidate art. Only addons from indexes that were fetched can have changed.
   {
     CTextureDatabase textureDB;
     textureDB.Open();
@@ -256,6 +304,6 @@ bool CRepositoryUpdateJob::DoWork()
     textureDB.CommitMultipleExecute();
   }
 
-  database.UpdateRepositoryContent(m_repo->ID(), m_repo->Version(), newChecksum, addons);
+  database.UpdateRepositoryContent(m_repo->ID(), m_repo->Version(), newChecksum, addons, unchangedDirs);
   return true;
 }
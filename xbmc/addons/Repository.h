@@ -19,6 +19,7 @@
  *
  */
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -61,7 +62,28 @@ namespace ADDON
       STATUS_ERROR
     };
 
-    FetchStatus FetchIfChanged(const std::string& oldChecksum, std::string& checksum, VECADDONS& addons) const;
+    /*! \brief Fetch the index of every directory whose checksum changed since the last update.
+     \param oldChecksum the checksum stored after the previous successful update
+     \param checksum [out] the new checksum of the repository
+     \param addons [out] the addons listed by the directories that changed
+     \param unchangedDirs [out] the datadirs of directories whose index did not change and was not fetched
+     \return STATUS_NOT_MODIFIED if no directory changed, STATUS_OK if at least one index was fetched
+     */
+    FetchStatus FetchIfChanged(const std::string& oldChecksum, std::string& checksum, VECADDONS& addons,
+        std::vector<std::string>& unchangedDirs) const;
+
+    /*! \brief The md5 digests of the checksum files of the dirs, by the path of their index. */
+    typedef std::map<std::string, std::string> DigestMap;
+
+    /*! \brief Create the checksum of a repository from the digests of its dirs.
+     The digests are ordered by path, so reordering the dirs doesn't change the checksum.
+     */
+    static std::string JoinDigests(const DigestMap& digests);
+
+    /*! \brief Split a checksum created by JoinDigests into the digests of the individual dirs.
+     Returns an empty map if the checksum is in an older format.
+     */
+    static DigestMap SplitDigests(const std::string& checksum);
 
   private:
     static bool FetchChecksum(const std::string& url, std::string& checksum) noexcept;
@@ -29,6 +29,7 @@
 #include "events/NotificationEvent.h"
 #include "pvr/PVRManager.h"
 #include "addons/PVRClient.h"
+#include "pvr/addons/PVRClientCalls.h"
 #include "pvr/channels/PVRChannelGroupsContainer.h"
 #include "pvr/channels/PVRChannelGroupInternal.h"
 #include "pvr/recordings/PVRRecordings.h"
@@ -72,6 +73,7 @@ CAddonCallbacksPVR::CAddonCallbacksPVR(CAddon* addon)
   m_callbacks->TransferChannelGroupMember = PVRTransferChannelGroupMember;
   m_callbacks->ConnectionStateChange      = PVRConnectionStateChange;
   m_callbacks->EpgEventStateChange        = PVREpgEventStateChange;
+  m_callbacks->TransferEpgEntries         = PVRTransferEpgEntries;
 }
 
 CAddonCallbacksPVR::~CAddonCallbacksPVR()
@@ -114,8 +116,11 @@ void CAddonCallbacksPVR::PVRTransferChannelGroup(void *addonData, const ADDON_HA
   }
 
   /* transfer this entry to the groups container */
-  CPVRChannelGroup transferGroup(*group);
-  xbmcGroups->UpdateFromClient(transferGroup);
+  PVR_CHANNEL_GROUP entry(*group);
+  CPVRClientCalls::Transfer([xbmcGroups, entry]() {
+    CPVRChannelGroup transferGroup(entry);
+    xbmcGroups->UpdateFromClient(transferGroup);
+  });
 }
 
 void CAddonCallbacksPVR::PVRTransferChannelGroupMember(void *addonData, const ADDON_HANDLE handle, const PVR_CHANNEL_GROUP_MEMBER *member)
@@ -134,16 +139,20 @@ void CAddonCallbacksPVR::PVRTransferChannelGroupMember(void *addonData, const AD
     return;
   }
 
-  CPVRChannelPtr channel  = g_PVRChannelGroups->GetByUniqueID(member->iChannelUniqueId, client->GetID());
-  if (!channel)
-  {
-    CLog::Log(LOGERROR, "PVR - %s - cannot find group '%s' or channel '%d'", __FUNCTION__, member->strGroupName, member->iChannelUniqueId);
-  }
-  else if (group->IsRadio() == channel->IsRadio())
-  {
-    /* transfer this entry to the group */
-    group->AddToGroup(channel, member->iChannelNumber);
-  }
+  PVR_CHANNEL_GROUP_MEMBER entry(*member);
+  int iClientId = client->GetID();
+  CPVRClientCalls::Transfer([group, entry, iClientId]() {
+    CPVRChannelPtr channel  = g_PVRChannelGroups->GetByUniqueID(entry.iChannelUniqueId, iClientId);
+    if (!channel)
+    {
+      CLog::Log(LOGERROR, "PVR - %s - cannot find group '%s' or channel '%d'", __FUNCTION__, entry.strGroupName, entry.iChannelUniqueId);
+    }
+    else if (group->IsRadio() == channel->IsRadio())
+    {
+      /* transfer this entry to the group */
+      group->AddToGroup(channel, entry.iChannelNumber);
+    }
+  });
 }
 
 void CAddonCallbacksPVR::PVRTransferEpgEntry(void *addonData, const ADDON_HANDLE handle, const EPG_TAG *epgentry)
@@ -165,6 +174,25 @@ void CAddonCallbacksPVR::PVRTransferEpgEntry(void *addonData, const ADDON_HANDLE
   xbmcEpg->UpdateEntry(epgentry, handle->dataIdentifier == 1 /* update db */);
 }
 
+void CAddonCallbacksPVR::PVRTransferEpgEntries(void *addonData, const ADDON_HANDLE handle, const EPG_TAG *epgentries, unsigned int iEntries)
+{
+  if (!handle)
+  {
+    CLog::Log(LOGERROR, "PVR - %s - invalid handler data", __FUNCTION__);
+    return;
+  }
+
+  CEpg *xbmcEpg = static_cast<CEpg *>(handle->dataAddress);
+  if (!xbmcEpg || (!epgentries && iEntries > 0))
+  {
+    CLog::Log(LOGERROR, "PVR - %s - invalid handler data", __FUNCTION__);
+    return;
+  }
+
+  /* transfer these entries to the epg */
+  xbmcEpg->UpdateEntries(epgentries, iEntries, handle->dataIdentifier == 1 /* update db */);
+}
+
 void CAddonCallbacksPVR::PVRTransferChannelEntry(void *addonData, const ADDON_HANDLE handle, const PVR_CHANNEL *channel)
 {
   if (!handle)
@@ -183,7 +211,9 @@ void CAddonCallbacksPVR::PVRTransferChannelEntry(void *addonData, const ADDON_HA
 
   /* transfer this entry to the internal channels group */
   CPVRChannelPtr transferChannel(new CPVRChannel(*channel, client->GetID()));
-  xbmcChannels->UpdateFromClient(transferChannel);
+  CPVRClientCalls::Transfer([xbmcChannels, transferChannel]() {
+    xbmcChannels->UpdateFromClient(transferChannel);
+  });
 }
 
 void CAddonCallbacksPVR::PVRTransferRecordingEntry(void *addonData, const ADDON_HANDLE handle, const PVR_RECORDING *recording)
@@ -204,7 +234,9 @@ void CAddonCallbacksPVR::PVRTransferRecordingEntry(void *addonData, const ADDON_
 
   /* transfer this entry to the recordings container */
   CPVRRecordingPtr transferRecording(new CPVRRecording(*recording, client->GetID()));
-  xbmcRecordings->UpdateFromClient(transferRecording);
+  CPVRClientCalls::Transfer([xbmcRecordings, transferRecording]() {
+    xbmcRecordings->UpdateFromClient(transferRecording);
+  });
 }
 
 void CAddonCallbacksPVR::PVRTransferTimerEntry(void *addonData, const ADDON_HANDLE handle, const PVR_TIMER *timer)
@@ -223,12 +255,15 @@ void CAddonCallbacksPVR::PVRTransferTimerEntry(void *addonData, const ADDON_HAND
     return;
   }
 
-  /* Note: channel can be NULL here, for instance for epg-based timer rules ("record on any channel" condition). */
-  CPVRChannelPtr channel = g_PVRChannelGroups->GetByUniqueID(timer->iClientChannelUid, client->GetID());
-
   /* transfer this entry to the timers container */
-  CPVRTimerInfoTagPtr transferTimer(new CPVRTimerInfoTag(*timer, channel, client->GetID()));
-  xbmcTimers->UpdateFromClient(transferTimer);
+  PVR_TIMER entry(*timer);
+  int iClientId = client->GetID();
+  CPVRClientCalls::Transfer([xbmcTimers, entry, iClientId]() {
+    /* Note: channel can be NULL here, for instance for epg-based timer rules ("record on any channel" condition). */
+    CPVRChannelPtr channel = g_PVRChannelGroups->GetByUniqueID(entry.iClientChannelUid, iClientId);
+    CPVRTimerInfoTagPtr transferTimer(new CPVRTimerInfoTag(entry, channel, iClientId));
+    xbmcTimers->UpdateFromClient(transferTimer);
+  });
 }
 
 void CAddonCallbacksPVR::PVRAddMenuHook(void *addonData, PVR_MENUHOOK *hook)
@@ -61,6 +61,7 @@ typedef DemuxPacket* (*PVRAllocateDemuxPacket)(void *addonData, int iDataSize);
 
 typedef void (*PVRConnectionStateChange)(void* addonData, const char* strConnectionString, PVR_CONNECTION_STATE newState, const char *strMessage);
 typedef void (*PVREpgEventStateChange)(void* addonData, EPG_TAG* tag, unsigned int iUniqueChannelId, EPG_EVENT_STATE newState);
+typedef void (*PVRTransferEpgEntries)(void *userData, const ADDON_HANDLE handle, const EPG_TAG *epgentries, unsigned int iEntries);
 
 typedef struct CB_PVRLib
 {
@@ -81,6 +82,7 @@ typedef struct CB_PVRLib
   PVRTransferChannelGroupMember TransferChannelGroupMember;
   PVRConnectionStateChange      ConnectionStateChange;
   PVREpgEventStateChange        EpgEventStateChange;
+  PVRTransferEpgEntries         TransferEpgEntries;
 } CB_PVRLib;
 
 struct EpgEventStateChange;
@@ -125,6 +127,15 @@ public:
    */
   static void PVRTransferEpgEntry(void* addonData, const ADDON_HANDLE handle, const EPG_TAG* entry);
 
+  /*!
+   * @brief Transfer several EPG tags from the add-on to XBMC at once
+   * @param addonData A pointer to the add-on.
+   * @param handle The handle parameter that XBMC used when requesting the EPG data
+   * @param entries The entries to transfer to XBMC
+   * @param iEntries The number of entries
+   */
+  static void PVRTransferEpgEntries(void* addonData, const ADDON_HANDLE handle, const EPG_TAG* entries, unsigned int iEntries);
+
   /*!
    * @brief Transfer a channel entry from the add-on to XBMC
    * @param addonData A pointer to the add-on.
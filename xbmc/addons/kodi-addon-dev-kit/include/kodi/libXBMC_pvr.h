@@ -19,6 +19,7 @@
  *
  */
 
+#include <deque>
 #include <string>
 #include <vector>
 #include <string.h>
@@ -42,6 +43,7 @@ public:
   {
     m_libXBMC_pvr = NULL;
     m_Handle      = NULL;
+    PVR_transfer_epg_entries = NULL;
   }
 
   ~CHelper_libXBMC_pvr(void)
@@ -151,6 +153,10 @@ public:
       dlsym(m_libXBMC_pvr, "PVR_epg_event_state_change");
     if (PVR_epg_event_state_change == NULL) { fprintf(stderr, "Unable to assign function %s\n", dlerror()); return false; }
 
+    // optional, older versions of Kodi don't provide it and get the entries one by one
+    PVR_transfer_epg_entries = (void (*)(void* HANDLE, void* CB, const ADDON_HANDLE handle, const EPG_TAG *epgentries, unsigned int iEntries))
+      dlsym(m_libXBMC_pvr, "PVR_transfer_epg_entries");
+
     m_Callbacks = PVR_register_me(m_Handle);
     return m_Callbacks != NULL;
   }
@@ -165,6 +171,22 @@ public:
     return PVR_transfer_epg_entry(m_Handle, m_Callbacks, handle, entry);
   }
 
+  /*!
+   * @brief Transfer several EPG tags from the add-on to XBMC at once
+   * @param handle The handle parameter that XBMC used when requesting the EPG data
+   * @param entries The entries to transfer to XBMC. They are copied, the add-on keeps ownership.
+   * @param iEntries The number of entries
+   * @sa CEpgTagBatch
+   */
+  void TransferEpgEntries(const ADDON_HANDLE handle, const EPG_TAG* entries, unsigned int iEntries)
+  {
+    if (PVR_transfer_epg_entries)
+      return PVR_transfer_epg_entries(m_Handle, m_Callbacks, handle, entries, iEntries);
+
+    for (unsigned int i = 0; i < iEntries; ++i)
+      PVR_transfer_epg_entry(m_Handle, m_Callbacks, handle, &entries[i]);
+  }
+
   /*!
    * @brief Transfer a channel entry from the add-on to XBMC
    * @param handle The handle parameter that XBMC used when requesting the channel list
@@ -343,6 +365,7 @@ protected:
 #endif
   void (*PVR_connection_state_change)(void*, void*, const char*, PVR_CONNECTION_STATE, const char*);
   void (*PVR_epg_event_state_change)(void*, void*, EPG_TAG*, unsigned int, EPG_EVENT_STATE);
+  void (*PVR_transfer_epg_entries)(void*, void*, const ADDON_HANDLE, const EPG_TAG*, unsigned int);
 
 private:
   void* m_libXBMC_pvr;
@@ -353,3 +376,100 @@ private:
     const char* libPath;
   };
 };
+
+/*!
+ * @brief Collects EPG tags and transfers them to XBMC in batches instead of one by one.
+ *
+ * The strings of the added tags are copied into the batch, so the add-on may
+ * free or reuse its buffers right after Add(). The handle is only valid while
+ * XBMC requests the EPG data, so Flush() must be called before returning from
+ * GetEPGForChannel(). Tags that weren't flushed are dropped with the batch.
+ */
+class CEpgTagBatch
+{
+public:
+  /*!
+   * @param pvr The helper to transfer the tags with
+   * @param handle The handle parameter that XBMC used when requesting the EPG data
+   * @param iMaxEntries Transfer the tags every time this many were added
+   */
+  CEpgTagBatch(CHelper_libXBMC_pvr *pvr, const ADDON_HANDLE handle, unsigned int iMaxEntries = 1000)
+    : m_pvr(pvr),
+      m_handle(handle),
+      m_iMaxEntries(iMaxEntries)
+  {
+  }
+
+  CEpgTagBatch(const CEpgTagBatch &) = delete;
+  CEpgTagBatch &operator=(const CEpgTagBatch &) = delete;
+
+  /*!
+   * @brief Add a copy of an EPG tag to the batch
+   * @param tag The tag
+   */
+  void Add(const EPG_TAG &tag)
+  {
+    EPG_TAG entry(tag);
+    entry.strTitle            = Copy(tag.strTitle);
+    entry.strPlotOutline      = Copy(tag.strPlotOutline);
+    entry.strPlot             = Copy(tag.strPlot);
+    entry.strOriginalTitle    = Copy(tag.strOriginalTitle);
+    entry.strCast             = Copy(tag.strCast);
+    entry.strDirector         = Copy(tag.strDirector);
+    entry.strWriter           = Copy(tag.strWriter);
+    entry.strIMDBNumber       = Copy(tag.strIMDBNumber);
+    entry.strIconPath         = Copy(tag.strIconPath);
+    entry.strGenreDescription = Copy(tag.strGenreDescription);
+    entry.strEpisodeName      = Copy(tag.strEpisodeName);
+    m_entries.push_back(entry);
+
+    if (m_entries.size() >= m_iMaxEntries)
+      Flush();
+  }
+
+  /*!
+   * @brief Transfer the collected tags to XBMC and empty the batch
+   */
+  void Flush(void)
+  {
+    if (m_pvr && !m_entries.empty())
+      m_pvr->TransferEpgEntries(m_handle, &m_entries[0], static_cast<unsigned int>(m_entries.size()));
+    Clear();
+  }
+
+  /*!
+   * @brief Empty the batch without transferring the tags
+   */
+  void Clear(void)
+  {
+    m_entries.clear();
+    m_strings.clear();
+  }
+
+  /*!
+   * @return The collected tags
+   */
+  const EPG_TAG *Entries(void) const { return m_entries.empty() ? NULL : &m_entries[0]; }
+
+  /*!
+   * @return The number of collected tags
+   */
+  unsigned int Size(void) const { return static_cast<unsigned int>(m_entries.size()); }
+
+private:
+  const char *Copy(const char *str)
+  {
+    if (!str)
+      return NULL;
+
+    // a deque never moves its elements, the pointers stay valid until Clear()
+    m_strings.push_back(str);
+    return m_strings.back().c_str();
+  }
+
+  CHelper_libXBMC_pvr *m_pvr;
+  ADDON_HANDLE m_handle;
+  unsigned int m_iMaxEntries;
+  std::vector<EPG_TAG> m_entries;
+  std::deque<std::string> m_strings;
+};
@@ -122,7 +122,7 @@ extern "C"
   //@{
   /*!
    * Request the EPG for a channel from the backend.
-   * EPG entries are added to XBMC by calling TransferEpgEntry() on the callback.
+   * EPG entries are added to XBMC by calling TransferEpgEntry() or, for many entries, TransferEpgEntries() on the callback.
    * @param handle Handle to pass to the callback method.
    * @param channel The channel to get the EPG table for.
    * @param iStart Get events after this time (UTC).
@@ -78,7 +78,7 @@ struct DemuxPacket;
 #define PVR_STREAM_MAX_STREAMS 20
 
 /* current PVR API version */
-#define XBMC_PVR_API_VERSION "5.2.1"
+#define XBMC_PVR_API_VERSION "5.3.0"
 
 /* min. PVR API version */
 #define XBMC_PVR_MIN_API_VERSION "5.2.1"
@@ -80,3 +80,89 @@ TEST_F(AddonDatabaseTest, TestFindByNonExistingId)
   EXPECT_TRUE(database.FindByAddonId("does.not.exist", addons));
   EXPECT_EQ(0, addons.size());
 }
+
+TEST_F(AddonDatabaseTest, TestUpdateRepositoryContentKeepsUnchanged)
+{
+  VECADDONS addons;
+  CreateAddon(addons, "foo.bar", "1.0.0");
+  CreateAddon(addons, "foo.qux", "2.0.0");
+  EXPECT_TRUE(database.UpdateRepositoryContent("repository.a", AddonVersion("1.0.0"), "test2", addons));
+
+  EXPECT_TRUE(database.FindByAddonId("foo.bar", addons));
+  EXPECT_EQ(1, addons.size());
+  EXPECT_TRUE(database.FindByAddonId("foo.qux", addons));
+  EXPECT_EQ(1, addons.size());
+  EXPECT_EQ(addons.at(0)->Origin(), "repository.a");
+}
+
+TEST_F(AddonDatabaseTest, TestUpdateRepositoryContentRemovesVanished)
+{
+  VECADDONS addons;
+  CreateAddon(addons, "foo.bar", "1.0.1");
+  EXPECT_TRUE(database.UpdateRepositoryContent("repository.a", AddonVersion("1.0.0"), "test2", addons));
+
+  EXPECT_TRUE(database.FindByAddonId("foo.bar", addons));
+  EXPECT_EQ(1, addons.size());
+  EXPECT_EQ(addons.at(0)->Version().asString(), "1.0.1");
+}
+
+TEST_F(AddonDatabaseTest, TestUpdateRepositoryContentKeepsUnchangedDirs)
+{
+  VECADDONS addons;
+  CAddonBuilder builder;
+  builder.SetId("foo.qux");
+  builder.SetVersion(AddonVersion("1.0.0"));
+  builder.SetPath("http://localhost/a/foo.qux/foo.qux-1.0.0.zip");
+  addons.push_back(builder.Build());
+  EXPECT_TRUE(database.UpdateRepositoryContent("repository.a", AddonVersion("1.0.0"), "test2", addons));
+
+  // foo.qux was not part of the fetched indexes but lives in a dir whose index did not change
+  addons.clear();
+  EXPECT_TRUE(database.UpdateRepositoryContent("repository.a", AddonVersion("1.0.0"), "test3", addons,
+      std::vector<std::string>{"http://localhost/a/"}));
+
+  EXPECT_TRUE(database.FindByAddonId("foo.qux", addons));
+  EXPECT_EQ(1, addons.size());
+  EXPECT_TRUE(database.FindByAddonId("foo.bar", addons));
+  EXPECT_EQ(0, addons.size());
+}
+
+TEST_F(AddonDatabaseTest, TestManifestKeepsAddonsWithoutExtensionPoint)
+{
+  ManifestEntry python;
+  python.id = "xbmc.python";
+  python.path = "/usr/share/kodi/addons/xbmc.python";
+  python.mtime = 1483228800;
+  python.version = AddonVersion("2.25.0");
+
+  ManifestEntry plugin;
+  plugin.id = "plugin.video.foo";
+  plugin.path = "/home/kodi/.kodi/addons/plugin.video.foo";
+  plugin.mtime = 1483228801;
+  plugin.version = AddonVersion("1.0.0");
+  plugin.extensions.push_back("xbmc.python.pluginsource");
+
+  EXPECT_TRUE(database.UpdateManifest(std::vector<ManifestEntry>{python, plugin}, std::vector<std::string>()));
+
+  std::vector<ManifestEntry> entries;
+  EXPECT_TRUE(database.GetManifest(entries));
+  ASSERT_EQ(2U, entries.size());
+
+  // as on the next start, when both are deferred
+  for (const auto& entry : entries)
+  {
+    if (entry.id == "xbmc.python")
+    {
+      EXPECT_TRUE(entry.extensions.empty());
+      EXPECT_TRUE(entry.Provides(ADDON_UNKNOWN));
+      EXPECT_FALSE(entry.Provides(ADDON_PLUGIN));
+    }
+    else
+    {
+      EXPECT_EQ("plugin.video.foo", entry.id);
+      EXPECT_TRUE(entry.Provides(ADDON_UNKNOWN));
+      EXPECT_TRUE(entry.Provides(ADDON_PLUGIN));
+      EXPECT_FALSE(entry.Provides(ADDON_REPOSITORY));
+    }
+  }
+}
@@ -0,0 +1,205 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "addons/Repository.h"
+#include "filesystem/File.h"
+#include "network/WebServer.h"
+#include "network/httprequesthandler/HTTPVfsHandler.h"
+#include "settings/MediaSourceSettings.h"
+#include "test/TestUtils.h"
+#include "URL.h"
+#include "utils/md5.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+using namespace ADDON;
+
+#define REPOSITORY_PORT 23457
+
+// Serves the checksum of the test repository through a local web server. The index itself is
+// deliberately missing so that any attempt to fetch it makes FetchIfChanged fail.
+class TestRepository : public ::testing::Test
+{
+protected:
+  TestRepository()
+    : sourcePath(XBMC_REF_FILE_PATH("xbmc/addons/test/data/repository/"))
+  { }
+
+  void SetUp() override
+  {
+    CMediaSource source;
+    source.strName = "Repository Share";
+    source.strPath = sourcePath;
+    source.vecPaths.push_back(sourcePath);
+    source.m_allowSharing = true;
+    source.m_iDriveType = CMediaSource::SOURCE_TYPE_LOCAL;
+    source.m_iLockMode = LOCK_MODE_EVERYONE;
+    source.m_ignore = true;
+    CMediaSourceSettings::GetInstance().AddShare("videos", source);
+
+    webserver.Start(REPOSITORY_PORT, "", "");
+    webserver.RegisterRequestHandler(&vfsHandler);
+  }
+
+  void TearDown() override
+  {
+    if (webserver.IsStarted())
+      webserver.Stop();
+    webserver.UnregisterRequestHandler(&vfsHandler);
+    CMediaSourceSettings::GetInstance().Clear();
+  }
+
+  std::string GetUrl(const std::string& file)
+  {
+    std::string path = CURL::Encode(URIUtils::AddFileToFolder(sourcePath, file));
+    return StringUtils::Format("http://localhost:%d/vfs/%s", REPOSITORY_PORT, path.c_str());
+  }
+
+  CRepository::DirInfo CreateDir(const std::string& datadir, const std::string& index)
+  {
+    CRepository::DirInfo dir;
+    dir.checksum = GetUrl("addons.xml.md5");
+    dir.info = GetUrl(index);
+    dir.datadir = datadir;
+    return dir;
+  }
+
+  std::string GetDigest()
+  {
+    XFILE::CFile file;
+    std::string content;
+    if (file.Open(URIUtils::AddFileToFolder(sourcePath, "addons.xml.md5")))
+    {
+      char buffer[1024];
+      ssize_t read;
+      while ((read = file.Read(buffer, sizeof(buffer))) > 0)
+        content.append(buffer, read);
+    }
+    return XBMC::XBMC_MD5::GetMD5(content);
+  }
+
+  std::string sourcePath;
+  CWebServer webserver;
+  CHTTPVfsHandler vfsHandler;
+};
+
+TEST_F(TestRepository, UnchangedIndexOnlyFetchesChecksum)
+{
+  CRepository repo(AddonProps("repository.test", ADDON_REPOSITORY),
+      CRepository::DirList{CreateDir("http://localhost/a/", "a.xml")});
+
+  CRepository::DigestMap digests;
+  digests[GetUrl("a.xml")] = GetDigest();
+
+  std::string checksum;
+  VECADDONS addons;
+  std::vector<std::string> unchangedDirs;
+  EXPECT_EQ(CRepository::STATUS_NOT_MODIFIED, repo.FetchIfChanged(CRepository::JoinDigests(digests),
+      checksum, addons, unchangedDirs));
+  EXPECT_EQ(CRepository::JoinDigests(digests), checksum);
+  EXPECT_TRUE(addons.empty());
+}
+
+TEST_F(TestRepository, ChangedDirIsRefetched)
+{
+  CRepository repo(AddonProps("repository.test", ADDON_REPOSITORY),
+      CRepository::DirList{CreateDir("http://localhost/a/", "a.xml"), CreateDir("http://localhost/b/", "b.xml"),
+          CreateDir("http://localhost/c/", "c.xml")});
+
+  // only b changed, so only its (missing) index has to be fetched
+  CRepository::DigestMap digests;
+  digests[GetUrl("a.xml")] = GetDigest();
+  digests[GetUrl("b.xml")] = XBMC::XBMC_MD5::GetMD5("stale");
+  digests[GetUrl("c.xml")] = GetDigest();
+
+  std::string checksum;
+  VECADDONS addons;
+  std::vector<std::string> unchangedDirs;
+  EXPECT_EQ(CRepository::STATUS_ERROR, repo.FetchIfChanged(CRepository::JoinDigests(digests),
+      checksum, addons, unchangedDirs));
+  EXPECT_EQ((std::vector<std::string>{"http://localhost/a/", "http://localhost/c/"}), unchangedDirs);
+}
+
+TEST_F(TestRepository, ReorderedDirsAreNotRefetched)
+{
+  CRepository repo(AddonProps("repository.test", ADDON_REPOSITORY),
+      CRepository::DirList{CreateDir("http://localhost/b/", "b.xml"), CreateDir("http://localhost/a/", "a.xml")});
+
+  CRepository::DigestMap digests;
+  digests[GetUrl("a.xml")] = GetDigest();
+  digests[GetUrl("b.xml")] = GetDigest();
+
+  std::string checksum;
+  VECADDONS addons;
+  std::vector<std::string> unchangedDirs;
+  EXPECT_EQ(CRepository::STATUS_NOT_MODIFIED, repo.FetchIfChanged(CRepository::JoinDigests(digests),
+      checksum, addons, unchangedDirs));
+  EXPECT_TRUE(addons.empty());
+}
+
+TEST_F(TestRepository, InsertedDirIsFetchedAlone)
+{
+  CRepository repo(AddonProps("repository.test", ADDON_REPOSITORY),
+      CRepository::DirList{CreateDir("http://localhost/a/", "a.xml"), CreateDir("http://localhost/new/", "new.xml"),
+          CreateDir("http://localhost/b/", "b.xml")});
+
+  CRepository::DigestMap digests;
+  digests[GetUrl("a.xml")] = GetDigest();
+  digests[GetUrl("b.xml")] = GetDigest();
+
+  // the dirs after the inserted one are still skipped, only the new index is fetched and fails
+  std::string checksum;
+  VECADDONS addons;
+  std::vector<std::string> unchangedDirs;
+  EXPECT_EQ(CRepository::STATUS_ERROR, repo.FetchIfChanged(CRepository::JoinDigests(digests),
+      checksum, addons, unchangedDirs));
+  EXPECT_EQ((std::vector<std::string>{"http://localhost/a/", "http://localhost/b/"}), unchangedDirs);
+}
+
+TEST_F(TestRepository, LegacyChecksumIsRefetched)
+{
+  CRepository repo(AddonProps("repository.test", ADDON_REPOSITORY),
+      CRepository::DirList{CreateDir("http://localhost/a/", "a.xml")});
+
+  std::string checksum;
+  VECADDONS addons;
+  std::vector<std::string> unchangedDirs;
+  EXPECT_EQ(CRepository::STATUS_ERROR, repo.FetchIfChanged("e0ab5b58b5a7a7fd4f9e5ae3bf6b2d6a\n",
+      checksum, addons, unchangedDirs));
+  EXPECT_TRUE(unchangedDirs.empty());
+}
+
+TEST(TestRepositoryDigests, JoinAndSplit)
+{
+  CRepository::DigestMap digests;
+  digests["http://localhost/b/addons.xml"] = "0123456789abcdef0123456789abcdef";
+  digests["http://localhost/a/addons.xml"] = "fedcba9876543210fedcba9876543210";
+
+  std::string checksum = CRepository::JoinDigests(digests);
+  EXPECT_EQ("fedcba9876543210fedcba9876543210 http://localhost/a/addons.xml\n"
+            "0123456789abcdef0123456789abcdef http://localhost/b/addons.xml\n", checksum);
+  EXPECT_EQ(digests, CRepository::SplitDigests(checksum));
+
+  // checksums of older versions
+  EXPECT_TRUE(CRepository::SplitDigests("e0ab5b58b5a7a7fd4f9e5ae3bf6b2d6a\n").empty());
+  EXPECT_TRUE(CRepository::SplitDigests("e0ab5b58b5a7a7fd4f9e5ae3bf6b2d6ae0ab5b58b5a7a7fd4f9e5ae3bf6b2d6a").empty());
+}
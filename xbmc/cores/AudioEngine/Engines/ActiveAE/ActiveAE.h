@@ -33,6 +33,7 @@
 #include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
 
 #include "guilib/DispResource.h"
+#include "settings/SettingRef.h"
 #include <queue>
 
 // ffmpeg
@@ -398,5 +399,13 @@ protected:
   float m_aeVolume;
   bool m_aeMuted;
   bool m_aeGUISoundForce;
+
+  // queried by players and the settings dialog, set up by Initialize()
+  CSettingRef<int> m_configSetting;
+  CSettingRef<int> m_channelsSetting;
+  CSettingRef<bool> m_passthroughSetting;
+  CSettingRef<bool> m_ac3PassthroughSetting;
+  CSettingRef<bool> m_ac3TranscodeSetting;
+  CSettingRef<bool> m_dspAddonsEnabledSetting;
 };
 };
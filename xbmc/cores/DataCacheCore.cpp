@@ -19,8 +19,22 @@
 */
 
 #include "cores/DataCacheCore.h"
-#include "threads/SingleLock.h"
 #include "ServiceBroker.h"
+#include "utils/log.h"
+
+#include <cstring>
+
+namespace
+{
+template<size_t N>
+void CopyString(char (&dest)[N], const std::string &src)
+{
+  if (src.size() >= N)
+    CLog::Log(LOGWARNING, "CDataCacheCore: '%s' is cut to %u characters", src.c_str(), static_cast<unsigned int>(N - 1));
+  strncpy(dest, src.c_str(), N - 1);
+  dest[N - 1] = '\0';
+}
+}
 
 CDataCacheCore::CDataCacheCore()
 {
@@ -51,187 +65,171 @@ void CDataCacheCore::SignalAudioInfoChange()
 
 void CDataCacheCore::SetVideoDecoderName(std::string name, bool isHw)
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  m_playerVideoInfo.decoderName = name;
-  m_playerVideoInfo.isHwDecoder = isHw;
+  m_playerVideoInfo.Update([&](SPlayerVideoInfo &info)
+  {
+    CopyString(info.decoderName, name);
+    info.isHwDecoder = isHw;
+  });
 }
 
 std::string CDataCacheCore::GetVideoDecoderName()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.decoderName;
+  return m_playerVideoInfo.Get().decoderName;
 }
 
 bool CDataCacheCore::IsVideoHwDecoder()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.isHwDecoder;
+  return m_playerVideoInfo.Get().isHwDecoder;
 }
 
 
 void CDataCacheCore::SetVideoDeintMethod(std::string method)
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  m_playerVideoInfo.deintMethod = method;
+  m_playerVideoInfo.Update([&](SPlayerVideoInfo &info)
+  {
+    CopyString(info.deintMethod, method);
+  });
 }
 
 std::string CDataCacheCore::GetVideoDeintMethod()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.deintMethod;
+  return m_playerVideoInfo.Get().deintMethod;
 }
 
 void CDataCacheCore::SetVideoPixelFormat(std::string pixFormat)
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  m_playerVideoInfo.pixFormat = pixFormat;
+  m_playerVideoInfo.Update([&](SPlayerVideoInfo &info)
+  {
+    CopyString(info.pixFormat, pixFormat);
+  });
 }
 
 std::string CDataCacheCore::GetVideoPixelFormat()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.pixFormat;
+  return m_playerVideoInfo.Get().pixFormat;
 }
 
 void CDataCacheCore::SetVideoDimensions(int width, int height)
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  m_playerVideoInfo.width = width;
-  m_playerVideoInfo.height = height;
+  m_playerVideoInfo.Update([&](SPlayerVideoInfo &info)
+  {
+    info.width = width;
+    info.height = height;
+  });
 }
 
 int CDataCacheCore::GetVideoWidth()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.width;
+  return m_playerVideoInfo.Get().width;
 }
 
 int CDataCacheCore::GetVideoHeight()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.height;
+  return m_playerVideoInfo.Get().height;
 }
 
 void CDataCacheCore::SetVideoFps(float fps)
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  m_playerVideoInfo.fps = fps;
+  m_playerVideoInfo.Update([&](SPlayerVideoInfo &info)
+  {
+    info.fps = fps;
+  });
 }
 
 float CDataCacheCore::GetVideoFps()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.fps;
+  return m_playerVideoInfo.Get().fps;
 }
 
 void CDataCacheCore::SetVideoDAR(float dar)
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  m_playerVideoInfo.dar = dar;
+  m_playerVideoInfo.Update([&](SPlayerVideoInfo &info)
+  {
+    info.dar = dar;
+  });
 }
 
 float CDataCacheCore::GetVideoDAR()
 {
-  CSingleLock lock(m_videoPlayerSection);
-
-  return m_playerVideoInfo.dar;
+  return m_playerVideoInfo.Get().dar;
 }
 
 // player audio info
 void CDataCacheCore::SetAudioDecoderName(std::string name)
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  m_playerAudioInfo.decoderName = name;
+  m_playerAudioInfo.Update([&](SPlayerAudioInfo &info)
+  {
+    CopyString(info.decoderName, name);
+  });
 }
 
 std::string CDataCacheCore::GetAudioDecoderName()
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  return m_playerAudioInfo.decoderName;
+  return m_playerAudioInfo.Get().decoderName;
 }
 
 void CDataCacheCore::SetAudioChannels(std::string channels)
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  m_playerAudioInfo.channels = channels;
+  m_playerAudioInfo.Update([&](SPlayerAudioInfo &info)
+  {
+    CopyString(info.channels, channels);
+  });
 }
 
 std::string CDataCacheCore::GetAudioChannels()
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  return m_playerAudioInfo.channels;
+  return m_playerAudioInfo.Get().channels;
 }
 
 void CDataCacheCore::SetAudioSampleRate(int sampleRate)
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  m_playerAudioInfo.sampleRate = sampleRate;
+  m_playerAudioInfo.Update([&](SPlayerAudioInfo &info)
+  {
+    info.sampleRate = sampleRate;
+  });
 }
 
 int CDataCacheCore::GetAudioSampleRate()
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  return m_playerAudioInfo.sampleRate;
+  return m_playerAudioInfo.Get().sampleRate;
 }
 
 void CDataCacheCore::SetAudioBitsPerSample(int bitsPerSample)
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  m_playerAudioInfo.bitsPerSample = bitsPerSample;
+  m_playerAudioInfo.Update([&](SPlayerAudioInfo &info)
+  {
+    info.bitsPerSample = bitsPerSample;
+  });
 }
 
 int CDataCacheCore::GetAudioBitsPerSample()
 {
-  CSingleLock lock(m_audioPlayerSection);
-
-  return m_playerAudioInfo.bitsPerSample;
+  return m_playerAudioInfo.Get().bitsPerSample;
 }
 
 void CDataCacheCore::SetRenderClockSync(bool enable)
 {
-  CSingleLock lock(m_renderSection);
-
-  m_renderInfo.m_isClockSync = enable;
+  m_renderInfo.Update([&](SRenderInfo &info)
+  {
+    info.m_isClockSync = enable;
+  });
 }
 
 bool CDataCacheCore::IsRenderClockSync()
 {
-  CSingleLock lock(m_renderSection);
-
-  return m_renderInfo.m_isClockSync;
+  return m_renderInfo.Get().m_isClockSync;
 }
 
 // player states
 void CDataCacheCore::SetStateSeeking(bool active)
 {
-  CSingleLock lock(m_stateSection);
-
-  m_stateInfo.m_stateSeeking = active;
+  m_stateInfo.Update([&](SStateInfo &info)
+  {
+    info.m_stateSeeking = active;
+  });
 }
 
 bool CDataCacheCore::CDataCacheCore::IsSeeking()
 {
-  CSingleLock lock(m_stateSection);
-
-  return m_stateInfo.m_stateSeeking;
+  return m_stateInfo.Get().m_stateSeeking;
 }
@@ -22,7 +22,7 @@
 
 #include <atomic>
 #include <string>
-#include "threads/CriticalSection.h"
+#include "threads/SeqLock.h"
 
 class CDataCacheCore
 {
@@ -70,37 +70,39 @@ public:
 protected:
   std::atomic_bool m_hasAVInfoChanges;
 
-  CCriticalSection m_videoPlayerSection;
+  // Player threads publish, the GUI reads several times per frame. The info is
+  // kept in sequence locks, so that reading never blocks on a player thread.
   struct SPlayerVideoInfo
   {
-    std::string decoderName;
+    char decoderName[128];
     bool isHwDecoder;
-    std::string deintMethod;
-    std::string pixFormat;
+    char deintMethod[128];
+    char pixFormat[128];
     int width;
     int height;
     float fps;
     float dar;
-  } m_playerVideoInfo;
+  };
+  CSeqLock<SPlayerVideoInfo> m_playerVideoInfo;
 
-  CCriticalSection m_audioPlayerSection;
   struct SPlayerAudioInfo
   {
-    std::string decoderName;
-    std::string channels;
+    char decoderName[128];
+    char channels[128];
     int sampleRate;
     int bitsPerSample;
-  } m_playerAudioInfo;
+  };
+  CSeqLock<SPlayerAudioInfo> m_playerAudioInfo;
 
-  CCriticalSection m_renderSection;
   struct SRenderInfo
   {
     bool m_isClockSync;
-  } m_renderInfo;
+  };
+  CSeqLock<SRenderInfo> m_renderInfo;
 
-  CCriticalSection m_stateSection;
   struct SStateInfo
   {
     bool m_stateSeeking;
-  } m_stateInfo;
+  };
+  CSeqLock<SStateInfo> m_stateInfo;
 };
@@ -248,6 +248,10 @@ public:
   virtual bool Initialize(TiXmlElement* pConfig) { return true; };
   virtual bool OpenFile(const CFileItem& file, const CPlayerOptions& options){ return false;}
   virtual bool QueueNextFile(const CFileItem &file) { return false; }
+  /*! \brief Open the likely next file ahead of time without committing to it.
+   The player may keep the decoder around and reuse it if the same file is queued
+   by QueueNextFile later on. */
+  virtual void PrefetchNextFile(const CFileItem &file) {}
   virtual void OnNothingToQueueNotify() {}
   virtual bool CloseFile(bool reopen = false) = 0;
   virtual bool IsPlaying() const { return false;}
@@ -20,6 +20,7 @@
 
 #include "DVDCodecUtils.h"
 #include "DVDClock.h"
+#include "cores/VideoPlayer/SwScaler.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
 #include "utils/log.h"
 #include "cores/FFmpeg.h"
@@ -268,11 +269,9 @@ DVDVideoPicture* CDVDCodecUtils::ConvertToYUV422PackedPicture(DVDVideoPicture *p
         else
           dstformat = AV_PIX_FMT_YUYV422;
 
-        struct SwsContext *ctx = sws_getContext(pSrc->iWidth, pSrc->iHeight, AV_PIX_FMT_YUV420P,
-                                                           pPicture->iWidth, pPicture->iHeight, (AVPixelFormat)dstformat,
-                                                           SWS_BILINEAR, NULL, NULL, NULL);
-        sws_scale(ctx, src, srcStride, 0, pSrc->iHeight, dst, dstStride);
-        sws_freeContext(ctx);
+        CSwScaler::ScaleOnce(pSrc->iWidth, pSrc->iHeight, AV_PIX_FMT_YUV420P, src, srcStride,
+                             pPicture->iWidth, pPicture->iHeight, (AVPixelFormat)dstformat, dst, dstStride,
+                             SWS_BILINEAR);
       }
     }
     else
@@ -197,6 +197,17 @@ public:
    */
   virtual bool GetPicture(DVDVideoPicture* pDvdVideoPicture) = 0;
 
+  /**
+   * returns true if the data of the picture returned by GetPicture was
+   * referenced in frame, so it stays valid after the next Decode call.
+   * the data pointers of the picture are updated to the referenced ones
+   * frame is unreferenced by the caller when it is done with the picture
+   */
+  virtual bool HoldPicture(DVDVideoPicture* pDvdVideoPicture, AVFrame* frame)
+  {
+    return false;
+  }
+
   /**
    * returns true if successfull
    * the data is cleared to zero
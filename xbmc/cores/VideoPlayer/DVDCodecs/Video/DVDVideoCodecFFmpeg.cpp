@@ -28,12 +28,13 @@
 #include "DVDClock.h"
 #include "DVDCodecs/DVDCodecs.h"
 #include "DVDCodecs/DVDCodecUtils.h"
-#include "utils/CPUInfo.h"
+#include "DVDVideoCodecThreadPolicy.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/VideoSettings.h"
 #include "settings/MediaSettings.h"
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
 #include <memory>
 
 #ifndef TARGET_POSIX
@@ -293,6 +294,9 @@ CDVDVideoCodecFFmpeg::CDVDVideoCodecFFmpeg(CProcessInfo &processInfo) : CDVDVide
   m_droppedFrames = 0;
   m_interlaced = false;
   m_DAR = 1.0;
+  m_decodeTime = 0;
+  m_maxDecodeTime = 0;
+  m_decodedPictures = 0;
 }
 
 CDVDVideoCodecFFmpeg::~CDVDVideoCodecFFmpeg()
@@ -371,12 +375,23 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     }
     else
     {
-      int num_threads = g_cpuInfo.getCPUCount() * 3 / 2;
-      num_threads = std::max(1, std::min(num_threads, 16));
-      m_pCodecContext->thread_count = num_threads;
+      CDVDVideoCodecThreadPolicy::SStream stream;
+      stream.codec = pCodec->id;
+      stream.capabilities = pCodec->capabilities;
+      stream.width = hints.width;
+      stream.height = hints.height;
+      stream.realtime = hints.realtime;
+      CDVDVideoCodecThreadPolicy::SThreading threading =
+        CDVDVideoCodecThreadPolicy::Choose(stream, CDVDVideoCodecThreadPolicy::GetSystem());
+
+      m_pCodecContext->thread_count = threading.count;
+      if (threading.type)
+        m_pCodecContext->thread_type = threading.type;
       m_pCodecContext->thread_safe_callbacks = 1;
       m_decoderState = STATE_SW_MULTI;
-      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open frame threaded with %d threads", num_threads);
+      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open %s threaded with %d threads (%dx%d%s)",
+                CDVDVideoCodecThreadPolicy::TypeName(threading.type), threading.count,
+                hints.width, hints.height, hints.realtime ? ", realtime" : "");
     }
   }
   else
@@ -463,6 +478,8 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
 
 void CDVDVideoCodecFFmpeg::Dispose()
 {
+  LogDecodeTimes();
+
   av_frame_free(&m_pFrame);
   av_frame_free(&m_pDecodedFrame);
   av_frame_free(&m_pFilterFrame);
@@ -472,6 +489,26 @@ void CDVDVideoCodecFFmpeg::Dispose()
   FilterClose();
 }
 
+void CDVDVideoCodecFFmpeg::LogDecodeTimes()
+{
+  if (m_pCodecContext && m_decodedPictures > 0)
+  {
+    double msPerTick = 1000.0 / CurrentHostFrequency();
+    // frame threads decode in the background, then only the submission is timed
+    bool frameThreads = m_pCodecContext->thread_count > 1 && m_pCodecContext->active_thread_type == FF_THREAD_FRAME;
+    CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - %s %dx%d, %s threaded with %d threads: %u pictures, %s time per picture %.2f ms on average, at most %.2f ms",
+              m_name.c_str(), m_pCodecContext->width, m_pCodecContext->height,
+              CDVDVideoCodecThreadPolicy::TypeName(m_pCodecContext->thread_count > 1 ? m_pCodecContext->active_thread_type : 0),
+              m_pCodecContext->thread_count, m_decodedPictures,
+              frameThreads ? "submission" : "decode",
+              m_decodeTime * msPerTick / m_decodedPictures, m_maxDecodeTime * msPerTick);
+  }
+
+  m_decodeTime = 0;
+  m_maxDecodeTime = 0;
+  m_decodedPictures = 0;
+}
+
 void CDVDVideoCodecFFmpeg::SetDropState(bool bDrop)
 {
   if( m_pCodecContext )
@@ -649,7 +686,13 @@ int CDVDVideoCodecFFmpeg::Decode(uint8_t* pData, int iSize, double dts, double p
   /* We lie, but this flag is only used by pngdec.c.
    * Setting it correctly would allow CorePNG decoding. */
   avpkt.flags = AV_PKT_FLAG_KEY;
+  int64_t decodeStart = CurrentHostCounter();
   len = avcodec_decode_video2(m_pCodecContext, m_pDecodedFrame, &iGotPicture, &avpkt);
+  int64_t decodeTime = CurrentHostCounter() - decodeStart;
+  m_decodeTime += decodeTime;
+  m_maxDecodeTime = std::max(m_maxDecodeTime, decodeTime);
+  if (iGotPicture)
+    m_decodedPictures++;
 
   if (m_decoderState == STATE_HW_FAILED && !m_pHardware)
     return VC_REOPEN;
@@ -967,6 +1010,21 @@ bool CDVDVideoCodecFFmpeg::GetPicture(DVDVideoPicture* pDvdVideoPicture)
   return true;
 }
 
+bool CDVDVideoCodecFFmpeg::HoldPicture(DVDVideoPicture* pDvdVideoPicture, AVFrame* frame)
+{
+  // hardware and post processed pictures aren't in the frame
+  if (m_pHardware || !m_pFrame->buf[0] || pDvdVideoPicture->data[0] != m_pFrame->data[0])
+    return false;
+
+  if (av_frame_ref(frame, m_pFrame) < 0)
+    return false;
+
+  for (int i = 0; i < 4; i++)
+    pDvdVideoPicture->data[i] = frame->data[i];
+
+  return true;
+}
+
 int CDVDVideoCodecFFmpeg::FilterOpen(const std::string& filters, bool scale)
 {
   int result;
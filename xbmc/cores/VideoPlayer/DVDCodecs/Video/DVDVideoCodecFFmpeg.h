@@ -66,6 +66,7 @@ public:
   virtual void Reopen() override;
   bool GetPictureCommon(DVDVideoPicture* pDvdVideoPicture);
   virtual bool GetPicture(DVDVideoPicture* pDvdVideoPicture) override;
+  virtual bool HoldPicture(DVDVideoPicture* pDvdVideoPicture, AVFrame* frame) override;
   virtual void SetDropState(bool bDrop) override;
   virtual const char* GetName() override { return m_name.c_str(); }; // m_name is never changed after open
   virtual unsigned GetConvergeCount() override;
@@ -78,6 +79,7 @@ public:
 
 protected:
   void Dispose();
+  void LogDecodeTimes();
   static enum AVPixelFormat GetFormat(struct AVCodecContext * avctx, const AVPixelFormat * fmt);
 
   int  FilterOpen(const std::string& filters, bool scale);
@@ -126,6 +128,11 @@ protected:
   CDVDStreamInfo m_hints;
   CDVDCodecOptions m_options;
 
+  // the time spent in the decoder, for tuning the threading
+  int64_t m_decodeTime;
+  int64_t m_maxDecodeTime;
+  unsigned int m_decodedPictures;
+
   struct CDropControl
   {
     CDropControl();
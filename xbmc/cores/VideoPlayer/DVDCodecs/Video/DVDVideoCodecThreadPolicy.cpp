@@ -0,0 +1,159 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "DVDVideoCodecThreadPolicy.h"
+
+#include <algorithm>
+
+#include "powermanagement/PowerManager.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
+#include "utils/Temperature.h"
+
+// above that the cpu is likely to throttle soon
+#define POWERSAVING_TEMPERATURE 80.0
+#define POWERSAVING_BATTERY_LEVEL 20
+#define TEMPERATURE_UPDATE_INTERVAL 60000
+
+namespace
+{
+
+/*!
+ * @brief The cpu temperature of the last reading.
+ *
+ * Reading it may run a command or read procfs, so that is done by a job and
+ * opening a codec only uses the last value.
+ */
+class CCachedTemperature
+{
+public:
+  static CCachedTemperature& GetInstance()
+  {
+    static CCachedTemperature instance;
+    return instance;
+  }
+
+  CTemperature Get()
+  {
+    CSingleLock lock(m_section);
+    if (!m_updating && (!m_updated || XbmcThreads::SystemClockMillis() - m_lastUpdate >= TEMPERATURE_UPDATE_INTERVAL))
+    {
+      m_updating = true;
+      CJobManager::GetInstance().Submit([this]()
+      {
+        CTemperature temperature;
+        if (!g_cpuInfo.getTemperature(temperature))
+          temperature.SetValid(false);
+
+        CSingleLock lock(m_section);
+        m_temperature = temperature;
+        m_lastUpdate = XbmcThreads::SystemClockMillis();
+        m_updated = true;
+        m_updating = false;
+      }, CJob::PRIORITY_LOW);
+    }
+    return m_temperature;
+  }
+
+private:
+  CCachedTemperature() = default;
+
+  CCriticalSection m_section;
+  CTemperature m_temperature;
+  unsigned int m_lastUpdate = 0;
+  bool m_updated = false;
+  bool m_updating = false;
+};
+
+}
+
+CDVDVideoCodecThreadPolicy::SThreading CDVDVideoCodecThreadPolicy::Choose(const SStream &stream, const SSystem &system)
+{
+  SThreading threading = { 0, 1 };
+
+  bool frame = (stream.capabilities & CODEC_CAP_FRAME_THREADS) != 0;
+  bool slice = (stream.capabilities & CODEC_CAP_SLICE_THREADS) != 0;
+  if (!frame && !slice)
+    return threading;
+
+  // extra threads cover for those waiting on reference pictures
+  int count = system.cpus * 3 / 2;
+
+  // small pictures gain little from more threads, but each delays them
+  if (stream.width > 0 && stream.height > 0 && stream.width * stream.height <= 720 * 576)
+    count = std::min(count, 4);
+
+  if (system.powerSaving)
+    count = std::max(2, count / 2);
+
+  count = std::max(1, std::min(count, 16));
+  if (count == 1)
+    return threading;
+
+  // every row of an MPEG-1/2 picture is a slice, so slice threading scales without delay
+  bool rowSlices = stream.codec == AV_CODEC_ID_MPEG1VIDEO || stream.codec == AV_CODEC_ID_MPEG2VIDEO;
+  if (slice && (!frame || (stream.realtime && rowSlices)))
+  {
+    threading.type = FF_THREAD_SLICE;
+  }
+  else
+  {
+    threading.type = FF_THREAD_FRAME;
+    // no extra threads for live streams, they would only add delay
+    if (stream.realtime)
+      count = std::max(2, std::min(count, system.cpus));
+  }
+
+  threading.count = count;
+  return threading;
+}
+
+CDVDVideoCodecThreadPolicy::SSystem CDVDVideoCodecThreadPolicy::GetSystem()
+{
+  SSystem system;
+  system.cpus = g_cpuInfo.getCPUCount();
+
+  // 0 without a battery
+  int batteryLevel = g_powerManager.BatteryLevel();
+  system.powerSaving = batteryLevel > 0 && batteryLevel < POWERSAVING_BATTERY_LEVEL;
+
+  // invalid until the first reading is done
+  CTemperature temperature = CCachedTemperature::GetInstance().Get();
+  if (temperature.IsValid() && temperature.ToCelsius() >= POWERSAVING_TEMPERATURE)
+    system.powerSaving = true;
+
+  return system;
+}
+
+const char *CDVDVideoCodecThreadPolicy::TypeName(int type)
+{
+  switch (type)
+  {
+    case FF_THREAD_FRAME:
+      return "frame";
+    case FF_THREAD_SLICE:
+      return "slice";
+    default:
+      return "not";
+  }
+}
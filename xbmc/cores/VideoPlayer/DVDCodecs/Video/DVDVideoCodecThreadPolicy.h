@@ -0,0 +1,68 @@
+#pragma once
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+extern "C" {
+#include "libavcodec/avcodec.h"
+}
+
+/*!
+ * @brief Chooses how FFmpeg threads the decoding of a stream.
+ *
+ * Frame threading decodes several pictures at once, but every thread delays
+ * the output by a picture. Slice threading decodes the parts of one picture
+ * at once without delay, but only scales with streams that have many slices.
+ */
+class CDVDVideoCodecThreadPolicy
+{
+public:
+  struct SStream
+  {
+    AVCodecID codec;
+    int capabilities; //!< the CODEC_CAP_* of the decoder
+    int width;
+    int height;
+    bool realtime;    //!< live streams, where every picture of delay counts
+  };
+
+  struct SSystem
+  {
+    int cpus;
+    bool powerSaving; //!< low battery or a hot cpu
+  };
+
+  struct SThreading
+  {
+    int type;         //!< FF_THREAD_FRAME or FF_THREAD_SLICE, 0 without threads
+    int count;
+  };
+
+  /*!
+   * @brief The threading for a stream.
+   */
+  static SThreading Choose(const SStream &stream, const SSystem &system);
+
+  /*!
+   * @brief The current state of the system, for Choose().
+   */
+  static SSystem GetSystem();
+
+  static const char *TypeName(int type);
+};
@@ -20,6 +20,7 @@
 
 #include "DVDDemuxFFmpeg.h"
 
+#include <memory>
 #include <sstream>
 #include <utility>
 
@@ -29,6 +30,8 @@
 #include "DVDDemuxUtils.h"
 #include "DVDInputStreams/DVDInputStream.h"
 #include "DVDInputStreams/DVDInputStreamFFmpeg.h"
+#include "KeyframeIndex.h"
+#include "StreamInfoCache.h"
 #include "filesystem/CurlFile.h"
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
@@ -171,6 +174,8 @@ CDVDDemuxFFmpeg::CDVDDemuxFFmpeg() : CDVDDemux()
   memset(&m_pkt.pkt, 0, sizeof(AVPacket));
   m_streaminfo = true; /* set to true if we want to look for streams before playback */
   m_checkvideo = false;
+  m_keyframeStream = -1;
+  m_keyframeRecord = false;
 }
 
 CDVDDemuxFFmpeg::~CDVDDemuxFFmpeg()
@@ -457,8 +462,27 @@ bool CDVDDemuxFFmpeg::Open(CDVDInputStream* pInput, bool streaminfo, bool filein
     if(m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD))
       av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
 
-    CLog::Log(LOGDEBUG, "%s - avformat_find_stream_info starting", __FUNCTION__);
-    int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+    // files that declare all their streams in the header can take over the
+    // results of an earlier probe, a live stream may change between opens
+    std::unique_ptr<CStreamInfoCache> streamInfoCache;
+    if (m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) && !m_pInput->IsRealtime() &&
+        m_pInput->GetLength() > 0 && !m_checkvideo &&
+        !(m_pFormatContext->ctx_flags & AVFMTCTX_NOHEADER) &&
+        strcmp(m_pFormatContext->iformat->name, "hls,applehttp") != 0)
+      streamInfoCache.reset(new CStreamInfoCache(m_pInput->GetFileName(), m_pInput->GetLength()));
+
+    int iErr = 0;
+    if (streamInfoCache && streamInfoCache->Restore(m_pFormatContext))
+    {
+      CLog::Log(LOGDEBUG, "%s - using cached stream info for %s", __FUNCTION__, CURL::GetRedacted(strFile).c_str());
+    }
+    else
+    {
+      CLog::Log(LOGDEBUG, "%s - avformat_find_stream_info starting", __FUNCTION__);
+      iErr = avformat_find_stream_info(m_pFormatContext, NULL);
+      if (iErr >= 0 && streamInfoCache)
+        streamInfoCache->Store(m_pFormatContext);
+    }
     if (iErr < 0)
     {
       CLog::Log(LOGWARNING,"could not find codec parameters for %s", CURL::GetRedacted(strFile).c_str());
@@ -534,6 +558,8 @@ bool CDVDDemuxFFmpeg::Open(CDVDInputStream* pInput, bool streaminfo, bool filein
   if (skipCreateStreams && GetNrOfStreams() == 0)
     m_program = 0;
 
+  OpenKeyframeIndex();
+
   m_displayTime = 0;
   m_dtsAtDisplayTime = DVD_NOPTS_VALUE;
 
@@ -552,6 +578,8 @@ void CDVDDemuxFFmpeg::Dispose()
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
+  CloseKeyframeIndex();
+
   if (m_pFormatContext)
   {
     for (unsigned int i = 0; i < m_pFormatContext->nb_streams; i++)
@@ -912,6 +940,9 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
 
       AVStream *stream = m_pFormatContext->streams[m_pkt.pkt.stream_index];
 
+      if (m_keyframeRecord && m_pkt.pkt.stream_index == m_keyframeStream && (m_pkt.pkt.flags & AV_PKT_FLAG_KEY))
+        m_keyframeIndex->Add(m_pkt.pkt.pos, m_pkt.pkt.dts);
+
       if (IsVideoReady())
       {
         if (m_program != UINT_MAX)
@@ -1114,7 +1145,10 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double *startpts)
   int ret;
   {
     CSingleLock lock(m_critSection);
-    ret = av_seek_frame(m_pFormatContext, -1, seek_pts, backwards ? AVSEEK_FLAG_BACKWARD : 0);
+    if (SeekKeyframe(seek_pts, backwards))
+      ret = 0;
+    else
+      ret = av_seek_frame(m_pFormatContext, -1, seek_pts, backwards ? AVSEEK_FLAG_BACKWARD : 0);
 
     // demuxer can return failure, if seeking behind eof
     if (ret < 0 && m_pFormatContext->duration &&
@@ -1154,6 +1188,87 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double *startpts)
     return false;
 }
 
+void CDVDDemuxFFmpeg::OpenKeyframeIndex()
+{
+  m_keyframeIndex.reset();
+  m_keyframeStream = -1;
+  m_keyframeRecord = false;
+
+  // only files can be indexed, a live stream or a growing recording changes
+  if (!m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) || m_pInput->IsRealtime() ||
+      m_pInput->GetLength() <= 0 || !m_pFormatContext->iformat)
+    return;
+
+  int idx = av_find_default_stream_index(m_pFormatContext);
+  if (idx < 0)
+    return;
+
+  AVStream *stream = m_pFormatContext->streams[idx];
+  if (!stream->codec || stream->codec->codec_type != AVMEDIA_TYPE_VIDEO ||
+      (stream->disposition & AV_DISPOSITION_ATTACHED_PIC))
+    return;
+
+  // shared with other demuxers that have the file open, like the seek preview extraction
+  m_keyframeIndex = CKeyframeIndex::Get(m_pInput->GetFileName(), m_pInput->GetLength(),
+                                        stream->time_base.num, stream->time_base.den);
+  m_keyframeStream = idx;
+
+  // mpeg program and transport streams have no index, ffmpeg bisects them
+  // using the timestamps of the packets when seeking. Their packets start
+  // at a position the demuxer can resync on, so they can be indexed here.
+  const char *format = m_pFormatContext->iformat->name;
+  m_keyframeRecord = strcmp(format, "mpegts") == 0 || strcmp(format, "mpeg") == 0;
+  if (m_keyframeRecord)
+    m_keyframeIndex->SetTimestampWrap(stream->pts_wrap_bits, stream->start_time);
+
+  if (m_keyframeIndex->Size() > 0)
+  {
+    CLog::Log(LOGDEBUG, "%s - loaded %u keyframes", __FUNCTION__, (unsigned int)m_keyframeIndex->Size());
+    m_keyframeIndex->Apply(stream);
+  }
+}
+
+void CDVDDemuxFFmpeg::CloseKeyframeIndex()
+{
+  if (!m_keyframeIndex)
+    return;
+
+  if (m_pFormatContext && m_keyframeStream >= 0 && m_keyframeStream < (int)m_pFormatContext->nb_streams)
+    m_keyframeIndex->Merge(m_pFormatContext->streams[m_keyframeStream]);
+
+  if (m_keyframeIndex->IsModified())
+  {
+    CLog::Log(LOGDEBUG, "%s - saving %u keyframes", __FUNCTION__, (unsigned int)m_keyframeIndex->Size());
+    m_keyframeIndex->Save();
+  }
+
+  m_keyframeIndex.reset();
+  m_keyframeStream = -1;
+  m_keyframeRecord = false;
+}
+
+bool CDVDDemuxFFmpeg::SeekKeyframe(int64_t seek_pts, bool backwards)
+{
+  // other formats use the keyframes handed to ffmpeg by OpenKeyframeIndex
+  if (!m_keyframeRecord)
+    return false;
+
+  AVStream *stream = m_pFormatContext->streams[m_keyframeStream];
+  int64_t timestamp = av_rescale(seek_pts, stream->time_base.den, (int64_t)stream->time_base.num * AV_TIME_BASE);
+  int64_t maxDistance = av_rescale(30, stream->time_base.den, stream->time_base.num);
+
+  CKeyframeIndex::Entry entry;
+  if (!m_keyframeIndex->Find(timestamp, maxDistance, backwards, entry))
+    return false;
+
+  if (av_seek_frame(m_pFormatContext, -1, entry.pos, AVSEEK_FLAG_BYTE) < 0)
+    return false;
+
+  CLog::Log(LOGDEBUG, "%s - seeking to keyframe at byte %" PRId64, __FUNCTION__, entry.pos);
+  UpdateCurrentPTS();
+  return true;
+}
+
 bool CDVDDemuxFFmpeg::SeekByte(int64_t pos)
 {
   CSingleLock lock(m_critSection);
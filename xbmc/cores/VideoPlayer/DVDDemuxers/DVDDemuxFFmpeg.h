@@ -24,6 +24,7 @@
 #include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
 #include <map>
+#include <memory>
 #include <vector>
 
 extern "C" {
@@ -31,6 +32,7 @@ extern "C" {
 }
 
 class CDVDDemuxFFmpeg;
+class CKeyframeIndex;
 class CURL;
 
 class CDemuxStreamVideoFFmpeg
@@ -137,6 +139,9 @@ protected:
   void UpdateCurrentPTS();
   bool IsProgramChange();
   unsigned int HLSSelectProgram();
+  void OpenKeyframeIndex();
+  void CloseKeyframeIndex();
+  bool SeekKeyframe(int64_t seek_pts, bool backwards);
 
   std::string GetStereoModeFromMetadata(AVDictionary *pMetadata);
   std::string ConvertCodecToInternalStereoMode(const std::string &mode, const StereoModeConversionMap *conversionMap);
@@ -169,5 +174,9 @@ protected:
   bool m_checkvideo;
   int m_displayTime;
   double m_dtsAtDisplayTime;
+
+  std::shared_ptr<CKeyframeIndex> m_keyframeIndex;
+  int m_keyframeStream; // stream the keyframe index is kept for
+  bool m_keyframeRecord; // FFmpeg doesn't index the keyframes of this format by itself
 };
 
@@ -0,0 +1,311 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "KeyframeIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+
+#include "Util.h"
+#include "filesystem/File.h"
+#include "profiles/ProfilesManager.h"
+#include "threads/SingleLock.h"
+#include "utils/auto_buffer.h"
+#include "utils/Crc32.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+
+// bump when the layout of the file changes
+#define KEYFRAME_INDEX_MAGIC "KFI2"
+// one entry per keyframe is plenty for a movie with a keyframe every second
+#define KEYFRAME_INDEX_MAX_ENTRIES 100000
+// indexes and previews of files not played for this many days are deleted
+#define KEYFRAME_CACHE_MAX_AGE 90
+// at most this many index and preview files are kept
+#define KEYFRAME_CACHE_MAX_FILES 10000
+
+namespace
+{
+struct Header
+{
+  char magic[4];
+  uint32_t count;
+  int64_t fileSize;
+  int32_t timeBaseNum;
+  int32_t timeBaseDen;
+};
+
+bool CompareTimestamp(const CKeyframeIndex::Entry &entry, int64_t timestamp)
+{
+  return entry.timestamp < timestamp;
+}
+
+std::string GetCacheName(const std::string &file)
+{
+  return StringUtils::Format("%08x", Crc32::ComputeFromLowerCase(file));
+}
+
+// indexes of the files opened by a demuxer right now
+CCriticalSection openIndexesSection;
+std::map<std::string, std::weak_ptr<CKeyframeIndex> > openIndexes;
+}
+
+CKeyframeIndex::CKeyframeIndex(const std::string &file, int64_t fileSize, int timeBaseNum, int timeBaseDen)
+  : m_file(file),
+    m_fileSize(fileSize),
+    m_timeBaseNum(timeBaseNum),
+    m_timeBaseDen(timeBaseDen),
+    m_wrapBits(0),
+    m_wrapReference(0),
+    m_modified(false)
+{
+}
+
+std::shared_ptr<CKeyframeIndex> CKeyframeIndex::Get(const std::string &file, int64_t fileSize, int timeBaseNum, int timeBaseDen)
+{
+  CSingleLock lock(openIndexesSection);
+  for (std::map<std::string, std::weak_ptr<CKeyframeIndex> >::iterator it = openIndexes.begin(); it != openIndexes.end();)
+  {
+    if (it->second.expired())
+      it = openIndexes.erase(it);
+    else
+      ++it;
+  }
+
+  std::shared_ptr<CKeyframeIndex> index = openIndexes[file].lock();
+  if (index && index->m_fileSize == fileSize &&
+      index->m_timeBaseNum == timeBaseNum && index->m_timeBaseDen == timeBaseDen)
+    return index;
+
+  index.reset(new CKeyframeIndex(file, fileSize, timeBaseNum, timeBaseDen));
+  index->Load();
+  openIndexes[file] = index;
+  return index;
+}
+
+void CKeyframeIndex::SetTimestampWrap(int wrapBits, int64_t reference)
+{
+  CSingleLock lock(m_section);
+  m_wrapBits = wrapBits;
+  m_wrapReference = reference == (int64_t)AV_NOPTS_VALUE ? 0 : reference;
+}
+
+int64_t CKeyframeIndex::Unwrap(int64_t timestamp) const
+{
+  if (m_wrapBits <= 0 || m_wrapBits >= 64)
+    return timestamp;
+
+  int64_t range = (int64_t)1 << m_wrapBits;
+  int64_t offset = (timestamp - m_wrapReference) % range;
+  if (offset < 0)
+    offset += range;
+  return m_wrapReference + offset;
+}
+
+size_t CKeyframeIndex::Size() const
+{
+  CSingleLock lock(m_section);
+  return m_entries.size();
+}
+
+bool CKeyframeIndex::IsModified() const
+{
+  CSingleLock lock(m_section);
+  return m_modified;
+}
+
+void CKeyframeIndex::PruneCache()
+{
+  static std::atomic_flag pruned = ATOMIC_FLAG_INIT;
+  if (pruned.test_and_set())
+    return;
+
+  CJobManager::GetInstance().Submit([]() {
+    CUtil::DeleteOldFiles(CProfilesManager::GetInstance().GetKeyframesFolder(), ".kfi|.jpg",
+                          KEYFRAME_CACHE_MAX_AGE, KEYFRAME_CACHE_MAX_FILES);
+  }, CJob::PRIORITY_LOW);
+}
+
+std::string CKeyframeIndex::GetIndexPath(const std::string &file)
+{
+  return URIUtils::AddFileToFolder(CProfilesManager::GetInstance().GetKeyframesFolder(), GetCacheName(file) + ".kfi");
+}
+
+std::string CKeyframeIndex::GetPreviewPath(const std::string &file, unsigned int index)
+{
+  return URIUtils::AddFileToFolder(CProfilesManager::GetInstance().GetKeyframesFolder(),
+                                   StringUtils::Format("%s-%u.jpg", GetCacheName(file).c_str(), index));
+}
+
+bool CKeyframeIndex::Read(std::vector<Entry> &entries) const
+{
+  XFILE::CFile file;
+  XUTILS::auto_buffer buffer;
+  if (file.LoadFile(GetIndexPath(m_file), buffer) < (ssize_t)sizeof(Header))
+    return false;
+
+  Header header;
+  memcpy(&header, buffer.get(), sizeof(header));
+  if (memcmp(header.magic, KEYFRAME_INDEX_MAGIC, sizeof(header.magic)) != 0 ||
+      header.fileSize != m_fileSize ||
+      header.timeBaseNum != m_timeBaseNum || header.timeBaseDen != m_timeBaseDen ||
+      header.count > KEYFRAME_INDEX_MAX_ENTRIES ||
+      buffer.size() != sizeof(Header) + header.count * sizeof(Entry))
+    return false;
+
+  entries.resize(header.count);
+  if (header.count > 0)
+    memcpy(&entries[0], buffer.get() + sizeof(Header), header.count * sizeof(Entry));
+  return true;
+}
+
+bool CKeyframeIndex::Load()
+{
+  CSingleLock lock(m_section);
+  std::vector<Entry> entries;
+  if (!Read(entries))
+    return false;
+
+  m_entries.swap(entries);
+  m_modified = false;
+  return true;
+}
+
+bool CKeyframeIndex::Save()
+{
+  CSingleLock lock(m_section);
+  if (!m_modified)
+    return true;
+
+  // another player may have saved keyframes of a different part of the file meanwhile
+  std::vector<Entry> saved;
+  if (Read(saved))
+  {
+    for (std::vector<Entry>::const_iterator it = saved.begin(); it != saved.end(); ++it)
+      Add(it->pos, it->timestamp);
+  }
+
+  Header header;
+  memcpy(header.magic, KEYFRAME_INDEX_MAGIC, sizeof(header.magic));
+  header.count = m_entries.size();
+  header.fileSize = m_fileSize;
+  header.timeBaseNum = m_timeBaseNum;
+  header.timeBaseDen = m_timeBaseDen;
+
+  // write to a temporary file first so a reader never sees a partial index.
+  // the index of the same file may be saved from another process at the same time
+  std::string path = GetIndexPath(m_file);
+  std::string tempPath = path + "." + StringUtils::CreateUUID() + ".tmp";
+  XFILE::CFile file;
+  if (!file.OpenForWrite(tempPath, true))
+  {
+    CLog::Log(LOGERROR, "CKeyframeIndex::Save - unable to create %s", tempPath.c_str());
+    return false;
+  }
+
+  size_t size = m_entries.size() * sizeof(Entry);
+  bool ok = file.Write(&header, sizeof(header)) == (ssize_t)sizeof(header) &&
+            (size == 0 || file.Write(&m_entries[0], size) == (ssize_t)size);
+  file.Close();
+
+  if (!ok || !XFILE::CFile::Rename(tempPath, path))
+  {
+    CLog::Log(LOGERROR, "CKeyframeIndex::Save - unable to write %s", path.c_str());
+    XFILE::CFile::Delete(tempPath);
+    return false;
+  }
+
+  m_modified = false;
+  PruneCache();
+  return true;
+}
+
+void CKeyframeIndex::Add(int64_t pos, int64_t timestamp)
+{
+  if (pos < 0 || timestamp == (int64_t)AV_NOPTS_VALUE)
+    return;
+
+  CSingleLock lock(m_section);
+  timestamp = Unwrap(timestamp);
+
+  std::vector<Entry>::iterator it = std::lower_bound(m_entries.begin(), m_entries.end(), timestamp, CompareTimestamp);
+  if (it != m_entries.end() && it->timestamp == timestamp)
+    return;
+
+  if (m_entries.size() >= KEYFRAME_INDEX_MAX_ENTRIES)
+    return;
+
+  Entry entry = { pos, timestamp };
+  m_entries.insert(it, entry);
+  m_modified = true;
+}
+
+void CKeyframeIndex::Merge(const AVStream *stream)
+{
+  CSingleLock lock(m_section);
+  for (int i = 0; i < stream->nb_index_entries; i++)
+  {
+    const AVIndexEntry &entry = stream->index_entries[i];
+    if (entry.flags & AVINDEX_KEYFRAME)
+      Add(entry.pos, entry.timestamp);
+  }
+}
+
+void CKeyframeIndex::Apply(AVStream *stream) const
+{
+  CSingleLock lock(m_section);
+  for (std::vector<Entry>::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    av_add_index_entry(stream, it->pos, it->timestamp, 0, 0, AVINDEX_KEYFRAME);
+}
+
+bool CKeyframeIndex::Find(int64_t timestamp, int64_t maxDistance, bool backwards, Entry &entry) const
+{
+  CSingleLock lock(m_section);
+  timestamp = Unwrap(timestamp);
+
+  std::vector<Entry>::const_iterator next = std::upper_bound(m_entries.begin(), m_entries.end(), timestamp,
+    [](int64_t timestamp, const Entry &entry) { return timestamp < entry.timestamp; });
+
+  if (next == m_entries.begin())
+    return false;
+
+  std::vector<Entry>::const_iterator prev = next - 1;
+  if (prev->timestamp == timestamp)
+  {
+    entry = *prev;
+    return true;
+  }
+
+  // the keyframes on both sides of the timestamp have to be known, otherwise
+  // there might be one closer to it that was never seen
+  if (next == m_entries.end() || next->timestamp - prev->timestamp > maxDistance)
+    return false;
+
+  entry = backwards ? *prev : *next;
+  return true;
+}
@@ -0,0 +1,135 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+
+struct AVStream;
+
+/*!
+ \brief Byte offsets of the keyframes of a file's video stream.
+
+ FFmpeg only knows the keyframes a container indexes itself or that it came
+ across while reading, everything else it finds by bisecting the file, which
+ takes many reads over the network. The keyframes seen during playback are
+ kept in a small file next to the video thumbnails so the next time the file
+ is opened seeks can go straight to them.
+ */
+class CKeyframeIndex
+{
+public:
+  struct Entry
+  {
+    int64_t pos;       ///< byte offset of the keyframe
+    int64_t timestamp; ///< in units of the stream's time base
+  };
+
+  /*!
+   \param file path of the media file
+   \param fileSize size of the media file, an index saved for a different size is discarded
+   \param timeBaseNum numerator of the video stream's time base
+   \param timeBaseDen denominator of the video stream's time base
+   */
+  CKeyframeIndex(const std::string &file, int64_t fileSize, int timeBaseNum, int timeBaseDen);
+
+  /*!
+   \brief Get the index of a file, loaded from disk if no demuxer has the file open yet
+   Demuxers opening the same file at the same time, e.g. the player and the seek
+   preview extraction, share one index. The parameters are those of the constructor.
+   */
+  static std::shared_ptr<CKeyframeIndex> Get(const std::string &file, int64_t fileSize, int timeBaseNum, int timeBaseDen);
+
+  /*!
+   \brief Set how timestamps wrap around, as in mpeg transport streams
+   Timestamps are kept relative to the reference, modulo 2^wrapBits, so keyframes
+   recorded before and after a wrap are ordered as they are in the file.
+   \param wrapBits number of bits of the timestamps, 0 or 64 if they don't wrap
+   \param reference timestamp at the start of the file
+   */
+  void SetTimestampWrap(int wrapBits, int64_t reference);
+
+  /*!
+   \brief Load the saved index of the file, replacing the current entries
+   \return true if a matching index was found
+   */
+  bool Load();
+
+  /*!
+   \brief Save the entries if any were added since the index was loaded
+   \return false if writing the index failed
+   */
+  bool Save();
+
+  void Add(int64_t pos, int64_t timestamp);
+
+  /*!
+   \brief Add the keyframes FFmpeg knows about the stream
+   */
+  void Merge(const AVStream *stream);
+
+  /*!
+   \brief Hand the entries to FFmpeg for its own seeking code
+   */
+  void Apply(AVStream *stream) const;
+
+  /*!
+   \brief Find the keyframe to seek to for a timestamp
+   \param timestamp in units of the stream's time base
+   \param maxDistance entries further away than this are ignored, as the part of the file in between hasn't been indexed
+   \param backwards true for the last keyframe at or before the timestamp, false for the first one at or after it
+   \param entry set to the keyframe found
+   \return false if the index doesn't know the keyframe
+   */
+  bool Find(int64_t timestamp, int64_t maxDistance, bool backwards, Entry &entry) const;
+
+  size_t Size() const;
+  bool IsModified() const;
+
+  static std::string GetIndexPath(const std::string &file);
+
+  /*!
+   \brief Path of the seek bar preview image with the given number
+   */
+  static std::string GetPreviewPath(const std::string &file, unsigned int index);
+
+private:
+  bool Read(std::vector<Entry> &entries) const;
+  int64_t Unwrap(int64_t timestamp) const;
+
+  /*!
+   \brief Delete indexes and previews of files not played for a long time, once per run
+   */
+  static void PruneCache();
+
+  mutable CCriticalSection m_section;
+  std::string m_file;
+  int64_t m_fileSize;
+  int m_timeBaseNum;
+  int m_timeBaseDen;
+  int m_wrapBits;
+  int64_t m_wrapReference;
+  std::vector<Entry> m_entries; // sorted by timestamp
+  bool m_modified;
+};
@@ -0,0 +1,402 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "StreamInfoCache.h"
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "Util.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "URL.h"
+#include "utils/auto_buffer.h"
+#include "utils/Crc32.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+
+// bump when the layout of the file changes
+#define STREAMINFO_CACHE_MAGIC "SIC2"
+#define STREAMINFO_CACHE_FOLDER "special://temp/streaminfo/"
+// entries older than this many days are deleted, the file is just probed again
+#define STREAMINFO_CACHE_MAX_AGE 30
+// at most this many entries are kept
+#define STREAMINFO_CACHE_MAX_FILES 1000
+
+namespace
+{
+struct Header
+{
+  char magic[4];
+  uint32_t pathLength;
+  int64_t fileSize;
+  int64_t mtime;
+  char format[64];
+  int64_t duration;
+  int64_t startTime;
+  int64_t bitRate;
+  uint32_t streams;
+};
+
+struct Stream
+{
+  int32_t id;
+  int32_t codecType;
+  int32_t codecId;
+  uint32_t codecTag;
+  int32_t format;
+  int64_t bitRate;
+  int32_t bitsPerCodedSample;
+  int32_t bitsPerRawSample;
+  int32_t profile;
+  int32_t level;
+  int32_t width;
+  int32_t height;
+  int32_t sampleAspectNum;
+  int32_t sampleAspectDen;
+  int32_t fieldOrder;
+  uint64_t channelLayout;
+  int32_t channels;
+  int32_t sampleRate;
+  int32_t blockAlign;
+  int32_t frameSize;
+  int32_t videoDelay;
+  int32_t timeBaseNum;
+  int32_t timeBaseDen;
+  int32_t frameRateNum;
+  int32_t frameRateDen;
+  int32_t avgFrameRateNum;
+  int32_t avgFrameRateDen;
+  int32_t codecTimeBaseNum;
+  int32_t codecTimeBaseDen;
+  int32_t codecFrameRateNum;
+  int32_t codecFrameRateDen;
+  int32_t ticksPerFrame;
+  int64_t startTime;
+  int64_t duration;
+  int64_t frames;
+  int32_t disposition;
+  int32_t codecInfoFrames;
+  uint32_t extradataSize;
+};
+
+// what avformat_find_stream_info is run for, without these a stream can't be decoded
+bool IsComplete(const AVCodecParameters *par)
+{
+  if (par->codec_type == AVMEDIA_TYPE_VIDEO)
+    return par->width > 0 && par->height > 0 && par->format >= 0;
+  if (par->codec_type == AVMEDIA_TYPE_AUDIO)
+    return par->sample_rate > 0 && par->channels > 0 && par->format >= 0;
+  return true;
+}
+
+// probing sets up the parser of these streams and has it split the packets,
+// which can't be restored from a file
+bool NeedsFullParsing(const AVStream *st)
+{
+  return st->need_parsing == AVSTREAM_PARSE_FULL ||
+         st->need_parsing == AVSTREAM_PARSE_FULL_ONCE ||
+         st->need_parsing == AVSTREAM_PARSE_FULL_RAW;
+}
+
+uint8_t* CopyExtradata(const std::string &extradata)
+{
+  uint8_t *data = (uint8_t*)av_mallocz(extradata.size() + AV_INPUT_BUFFER_PADDING_SIZE);
+  if (data)
+    memcpy(data, extradata.c_str(), extradata.size());
+  return data;
+}
+}
+
+CStreamInfoCache::CStreamInfoCache(const std::string &file, int64_t fileSize)
+  : m_file(file),
+    m_fileSize(fileSize),
+    m_mtime(0)
+{
+  struct __stat64 buffer;
+  if (m_fileSize > 0 && XFILE::CFile::Stat(m_file, &buffer) == 0)
+    m_mtime = buffer.st_mtime;
+}
+
+std::string CStreamInfoCache::GetCachePath() const
+{
+  return StringUtils::Format(STREAMINFO_CACHE_FOLDER "%08x.sic", Crc32::ComputeFromLowerCase(m_file));
+}
+
+bool CStreamInfoCache::Restore(AVFormatContext *context) const
+{
+  if (!IsCacheable() || !context->iformat || !context->iformat->name)
+    return false;
+
+  XFILE::CFile file;
+  XUTILS::auto_buffer buffer;
+  ssize_t size = file.LoadFile(GetCachePath(), buffer);
+  if (size < (ssize_t)sizeof(Header))
+    return false;
+
+  const char *data = buffer.get();
+  const char *end = data + size;
+
+  Header header;
+  memcpy(&header, data, sizeof(header));
+  data += sizeof(header);
+  if (memcmp(header.magic, STREAMINFO_CACHE_MAGIC, sizeof(header.magic)) != 0 ||
+      header.fileSize != m_fileSize || header.mtime != m_mtime ||
+      header.pathLength != m_file.size() || end - data < (ptrdiff_t)header.pathLength ||
+      m_file.compare(0, std::string::npos, data, header.pathLength) != 0)
+    return false;
+  data += header.pathLength;
+
+  header.format[sizeof(header.format) - 1] = '\0';
+  if (strcmp(header.format, context->iformat->name) != 0 || header.streams != context->nb_streams)
+  {
+    CLog::Log(LOGDEBUG, "CStreamInfoCache::Restore - container changed, probing %s", CURL::GetRedacted(m_file).c_str());
+    return false;
+  }
+
+  // check everything before touching the context
+  std::vector<Stream> streams(header.streams);
+  std::vector<std::string> extradata(header.streams);
+  for (unsigned int i = 0; i < header.streams; i++)
+  {
+    if (end - data < (ptrdiff_t)sizeof(Stream))
+      return false;
+    memcpy(&streams[i], data, sizeof(Stream));
+    data += sizeof(Stream);
+
+    if (end - data < (ptrdiff_t)streams[i].extradataSize)
+      return false;
+    extradata[i].assign(data, streams[i].extradataSize);
+    data += streams[i].extradataSize;
+
+    const AVStream *st = context->streams[i];
+    const AVCodecParameters *par = st->codecpar;
+    if (NeedsFullParsing(st))
+    {
+      CLog::Log(LOGDEBUG, "CStreamInfoCache::Restore - stream %u needs a parser, probing %s", i, CURL::GetRedacted(m_file).c_str());
+      return false;
+    }
+    if (streams[i].id != st->id ||
+        streams[i].codecType != par->codec_type ||
+        (par->codec_id != AV_CODEC_ID_NONE && streams[i].codecId != par->codec_id) ||
+        streams[i].timeBaseNum != st->time_base.num || streams[i].timeBaseDen != st->time_base.den ||
+        (par->extradata_size > 0 && extradata[i].compare(0, std::string::npos, (const char*)par->extradata, par->extradata_size) != 0))
+    {
+      CLog::Log(LOGDEBUG, "CStreamInfoCache::Restore - stream %u changed, probing %s", i, CURL::GetRedacted(m_file).c_str());
+      return false;
+    }
+  }
+
+  for (unsigned int i = 0; i < header.streams; i++)
+  {
+    const Stream &s = streams[i];
+    AVStream *st = context->streams[i];
+    AVCodecParameters *par = st->codecpar;
+
+    par->codec_id = (AVCodecID)s.codecId;
+    par->codec_tag = s.codecTag;
+    par->format = s.format;
+    par->bit_rate = s.bitRate;
+    par->bits_per_coded_sample = s.bitsPerCodedSample;
+    par->bits_per_raw_sample = s.bitsPerRawSample;
+    par->profile = s.profile;
+    par->level = s.level;
+    par->width = s.width;
+    par->height = s.height;
+    par->sample_aspect_ratio = av_make_q(s.sampleAspectNum, s.sampleAspectDen);
+    par->field_order = (AVFieldOrder)s.fieldOrder;
+    par->channel_layout = s.channelLayout;
+    par->channels = s.channels;
+    par->sample_rate = s.sampleRate;
+    par->block_align = s.blockAlign;
+    par->frame_size = s.frameSize;
+    par->video_delay = s.videoDelay;
+    if (par->extradata_size == 0 && !extradata[i].empty())
+    {
+      par->extradata = CopyExtradata(extradata[i]);
+      par->extradata_size = par->extradata ? extradata[i].size() : 0;
+    }
+
+    // the deprecated codec context is what the rest of the demuxer looks at
+    AVCodecContext *codec = st->codec;
+    codec->codec_id = par->codec_id;
+    codec->codec_tag = par->codec_tag;
+    codec->bit_rate = par->bit_rate;
+    codec->bits_per_coded_sample = par->bits_per_coded_sample;
+    codec->bits_per_raw_sample = par->bits_per_raw_sample;
+    codec->profile = par->profile;
+    codec->level = par->level;
+    codec->width = par->width;
+    codec->height = par->height;
+    codec->sample_aspect_ratio = par->sample_aspect_ratio;
+    codec->field_order = par->field_order;
+    codec->channel_layout = par->channel_layout;
+    codec->channels = par->channels;
+    codec->sample_rate = par->sample_rate;
+    codec->block_align = par->block_align;
+    codec->frame_size = par->frame_size;
+    codec->has_b_frames = par->video_delay;
+    codec->time_base = av_make_q(s.codecTimeBaseNum, s.codecTimeBaseDen);
+    codec->framerate = av_make_q(s.codecFrameRateNum, s.codecFrameRateDen);
+    codec->ticks_per_frame = s.ticksPerFrame;
+    if (par->codec_type == AVMEDIA_TYPE_VIDEO)
+      codec->pix_fmt = (AVPixelFormat)par->format;
+    else if (par->codec_type == AVMEDIA_TYPE_AUDIO)
+      codec->sample_fmt = (AVSampleFormat)par->format;
+    if (codec->extradata_size == 0 && !extradata[i].empty())
+    {
+      codec->extradata = CopyExtradata(extradata[i]);
+      codec->extradata_size = codec->extradata ? extradata[i].size() : 0;
+    }
+
+    st->r_frame_rate = av_make_q(s.frameRateNum, s.frameRateDen);
+    st->avg_frame_rate = av_make_q(s.avgFrameRateNum, s.avgFrameRateDen);
+    st->sample_aspect_ratio = par->sample_aspect_ratio;
+    st->start_time = s.startTime;
+    st->duration = s.duration;
+    st->nb_frames = s.frames;
+    st->disposition = s.disposition;
+    st->codec_info_nb_frames = s.codecInfoFrames;
+  }
+
+  context->duration = header.duration;
+  context->start_time = header.startTime;
+  context->bit_rate = header.bitRate;
+
+  return true;
+}
+
+void CStreamInfoCache::Store(const AVFormatContext *context) const
+{
+  if (!IsCacheable() || !context->iformat || !context->iformat->name)
+    return;
+
+  Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, STREAMINFO_CACHE_MAGIC, sizeof(header.magic));
+  header.pathLength = m_file.size();
+  header.fileSize = m_fileSize;
+  header.mtime = m_mtime;
+  strncpy(header.format, context->iformat->name, sizeof(header.format) - 1);
+  header.duration = context->duration;
+  header.startTime = context->start_time;
+  header.bitRate = context->bit_rate;
+  header.streams = context->nb_streams;
+
+  std::string data((const char*)&header, sizeof(header));
+  data.append(m_file);
+
+  for (unsigned int i = 0; i < context->nb_streams; i++)
+  {
+    const AVStream *st = context->streams[i];
+    const AVCodecParameters *par = st->codecpar;
+
+    // nothing to gain from caching an incomplete probe, or one that can't be restored
+    if (!IsComplete(par) || NeedsFullParsing(st))
+      return;
+
+    Stream s;
+    memset(&s, 0, sizeof(s));
+    s.id = st->id;
+    s.codecType = par->codec_type;
+    s.codecId = par->codec_id;
+    s.codecTag = par->codec_tag;
+    s.format = par->format;
+    s.bitRate = par->bit_rate;
+    s.bitsPerCodedSample = par->bits_per_coded_sample;
+    s.bitsPerRawSample = par->bits_per_raw_sample;
+    s.profile = par->profile;
+    s.level = par->level;
+    s.width = par->width;
+    s.height = par->height;
+    s.sampleAspectNum = par->sample_aspect_ratio.num;
+    s.sampleAspectDen = par->sample_aspect_ratio.den;
+    s.fieldOrder = par->field_order;
+    s.channelLayout = par->channel_layout;
+    s.channels = par->channels;
+    s.sampleRate = par->sample_rate;
+    s.blockAlign = par->block_align;
+    s.frameSize = par->frame_size;
+    s.videoDelay = par->video_delay;
+    s.timeBaseNum = st->time_base.num;
+    s.timeBaseDen = st->time_base.den;
+    s.frameRateNum = st->r_frame_rate.num;
+    s.frameRateDen = st->r_frame_rate.den;
+    s.avgFrameRateNum = st->avg_frame_rate.num;
+    s.avgFrameRateDen = st->avg_frame_rate.den;
+    s.codecTimeBaseNum = st->codec->time_base.num;
+    s.codecTimeBaseDen = st->codec->time_base.den;
+    s.codecFrameRateNum = st->codec->framerate.num;
+    s.codecFrameRateDen = st->codec->framerate.den;
+    s.ticksPerFrame = st->codec->ticks_per_frame;
+    s.startTime = st->start_time;
+    s.duration = st->duration;
+    s.frames = st->nb_frames;
+    s.disposition = st->disposition;
+    s.codecInfoFrames = st->codec_info_nb_frames;
+    s.extradataSize = par->extradata ? par->extradata_size : 0;
+
+    data.append((const char*)&s, sizeof(s));
+    if (s.extradataSize > 0)
+      data.append((const char*)par->extradata, s.extradataSize);
+  }
+
+  if (!XFILE::CDirectory::Exists(STREAMINFO_CACHE_FOLDER))
+    XFILE::CDirectory::Create(STREAMINFO_CACHE_FOLDER);
+
+  // write to a temporary file first so a reader never sees a partial entry.
+  // the same file may be opened by another demuxer or process at the same time
+  std::string path = GetCachePath();
+  std::string tempPath = path + "." + StringUtils::CreateUUID() + ".tmp";
+  XFILE::CFile file;
+  if (!file.OpenForWrite(tempPath, true))
+    return;
+
+  bool ok = file.Write(data.c_str(), data.size()) == (ssize_t)data.size();
+  file.Close();
+
+  if (!ok || !XFILE::CFile::Rename(tempPath, path))
+  {
+    CLog::Log(LOGERROR, "CStreamInfoCache::Store - unable to write %s", path.c_str());
+    XFILE::CFile::Delete(tempPath);
+    return;
+  }
+
+  PruneCache();
+}
+
+void CStreamInfoCache::PruneCache()
+{
+  static std::atomic_flag pruned = ATOMIC_FLAG_INIT;
+  if (pruned.test_and_set())
+    return;
+
+  CJobManager::GetInstance().Submit([]() {
+    CUtil::DeleteOldFiles(STREAMINFO_CACHE_FOLDER, ".sic",
+                          STREAMINFO_CACHE_MAX_AGE, STREAMINFO_CACHE_MAX_FILES);
+  }, CJob::PRIORITY_LOW);
+}
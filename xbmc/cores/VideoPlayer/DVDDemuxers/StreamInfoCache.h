@@ -0,0 +1,78 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+struct AVFormatContext;
+
+/*!
+ \brief Remembers what avformat_find_stream_info found out about a file.
+
+ Probing reads and decodes the start of every stream, which takes seconds for
+ a remote file with many streams, and is repeated every time the file is
+ opened, e.g. when resuming it. The results are saved keyed by the path, size
+ and modification time of the file so the next open can take them over
+ instead. They are only taken over if the streams the container declares
+ still match them, otherwise the file is probed again. Streams that need a
+ parser to split their packets are always probed.
+ */
+class CStreamInfoCache
+{
+public:
+  /*!
+   \param file path of the media file
+   \param fileSize size of the media file
+   */
+  CStreamInfoCache(const std::string &file, int64_t fileSize);
+
+  /*!
+   \brief Whether the file can be cached, i.e. its modification time is known
+   */
+  bool IsCacheable() const { return m_mtime != 0; }
+
+  /*!
+   \brief Fill in the codec parameters of the opened context from the cache
+   \return true if the context now has everything probing would have found,
+           false if nothing was cached or it doesn't match the streams
+   */
+  bool Restore(AVFormatContext *context) const;
+
+  /*!
+   \brief Save the codec parameters of a fully probed context
+   */
+  void Store(const AVFormatContext *context) const;
+
+  /*!
+   \brief Path of the cache entry for the file
+   */
+  std::string GetCachePath() const;
+
+private:
+  /*!
+   \brief Delete entries of files not opened for a while, once per run
+   */
+  static void PruneCache();
+
+  std::string m_file;
+  int64_t m_fileSize;
+  int64_t m_mtime;
+};
@@ -0,0 +1,121 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "cores/VideoPlayer/DVDDemuxers/KeyframeIndex.h"
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "libavutil/avutil.h"
+}
+
+// 90kHz, the time base of mpeg transport streams
+#define TIMEBASE 90000
+
+TEST(TestKeyframeIndex, AddKeepsEntriesSorted)
+{
+  CKeyframeIndex index("/path/to/file.ts", 1000000, 1, TIMEBASE);
+  EXPECT_FALSE(index.IsModified());
+
+  index.Add(3000, 3 * TIMEBASE);
+  index.Add(1000, 1 * TIMEBASE);
+  index.Add(2000, 2 * TIMEBASE);
+  index.Add(2000, 2 * TIMEBASE);
+  EXPECT_EQ(3u, index.Size());
+  EXPECT_TRUE(index.IsModified());
+
+  CKeyframeIndex::Entry entry;
+  ASSERT_TRUE(index.Find(2 * TIMEBASE + 10, TIMEBASE, true, entry));
+  EXPECT_EQ(2000, entry.pos);
+  EXPECT_EQ(2 * TIMEBASE, entry.timestamp);
+
+  ASSERT_TRUE(index.Find(2 * TIMEBASE, TIMEBASE, true, entry));
+  EXPECT_EQ(2000, entry.pos);
+  ASSERT_TRUE(index.Find(2 * TIMEBASE, TIMEBASE, false, entry));
+  EXPECT_EQ(2000, entry.pos);
+}
+
+TEST(TestKeyframeIndex, FindHonoursDirection)
+{
+  CKeyframeIndex index("/path/to/file.ts", 1000000, 1, TIMEBASE);
+  index.Add(1000, 1 * TIMEBASE);
+  index.Add(2000, 2 * TIMEBASE);
+
+  CKeyframeIndex::Entry entry;
+  ASSERT_TRUE(index.Find(1 * TIMEBASE + 10, TIMEBASE, true, entry));
+  EXPECT_EQ(1000, entry.pos);
+  ASSERT_TRUE(index.Find(1 * TIMEBASE + 10, TIMEBASE, false, entry));
+  EXPECT_EQ(2000, entry.pos);
+
+  // the last keyframe is known, but not whether there's one after it
+  EXPECT_FALSE(index.Find(2 * TIMEBASE + 10, TIMEBASE, false, entry));
+}
+
+TEST(TestKeyframeIndex, FindAcrossTimestampWrap)
+{
+  const int64_t wrap = (int64_t)1 << 33;
+  CKeyframeIndex index("/path/to/file.ts", 1000000, 1, TIMEBASE);
+  index.SetTimestampWrap(33, wrap - 2 * TIMEBASE);
+
+  // keyframes recorded from packets before and after the wrap
+  index.Add(1000, wrap - 1 * TIMEBASE);
+  index.Add(2000, 0);
+  index.Add(3000, 1 * TIMEBASE);
+
+  // a seek target past the wrap, as FFmpeg reports it
+  CKeyframeIndex::Entry entry;
+  ASSERT_TRUE(index.Find(wrap + TIMEBASE / 2, 2 * TIMEBASE, true, entry));
+  EXPECT_EQ(2000, entry.pos);
+  ASSERT_TRUE(index.Find(wrap - TIMEBASE / 2, 2 * TIMEBASE, true, entry));
+  EXPECT_EQ(1000, entry.pos);
+
+  // the same target as a wrapped timestamp
+  ASSERT_TRUE(index.Find(TIMEBASE / 2, 2 * TIMEBASE, true, entry));
+  EXPECT_EQ(2000, entry.pos);
+}
+
+TEST(TestKeyframeIndex, IgnoresInvalidEntries)
+{
+  CKeyframeIndex index("/path/to/file.ts", 1000000, 1, TIMEBASE);
+  index.Add(-1, TIMEBASE);
+  index.Add(1000, AV_NOPTS_VALUE);
+  EXPECT_EQ(0u, index.Size());
+  EXPECT_FALSE(index.IsModified());
+}
+
+TEST(TestKeyframeIndex, FindOnlyWithinIndexedRegion)
+{
+  CKeyframeIndex index("/path/to/file.ts", 1000000, 1, TIMEBASE);
+  index.Add(1000, 10 * TIMEBASE);
+  index.Add(2000, 11 * TIMEBASE);
+  index.Add(9000, 100 * TIMEBASE);
+
+  CKeyframeIndex::Entry entry;
+  // before the first keyframe
+  EXPECT_FALSE(index.Find(5 * TIMEBASE, 2 * TIMEBASE, true, entry));
+  // after the last keyframe, there might be others in between
+  EXPECT_FALSE(index.Find(150 * TIMEBASE, 2 * TIMEBASE, true, entry));
+  // between keyframes too far apart to know there's none in between
+  EXPECT_FALSE(index.Find(50 * TIMEBASE, 2 * TIMEBASE, true, entry));
+
+  ASSERT_TRUE(index.Find(50 * TIMEBASE, 100 * TIMEBASE, true, entry));
+  EXPECT_EQ(2000, entry.pos);
+}
@@ -0,0 +1,164 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/StreamInfoCache.h"
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+
+class TestStreamInfoCache : public testing::Test
+{
+protected:
+  TestStreamInfoCache()
+  {
+    memset(&m_format, 0, sizeof(m_format));
+    m_format.name = "matroska,webm";
+
+    m_file = XBMC_CREATETEMPFILE(".mkv");
+    m_path = XBMC_TEMPFILEPATH(m_file);
+    m_file->Write("dummy media", 11);
+    m_file->Close();
+  }
+
+  ~TestStreamInfoCache()
+  {
+    XFILE::CFile::Delete(CStreamInfoCache(m_path, 11).GetCachePath());
+    XBMC_DELETETEMPFILE(m_file);
+  }
+
+  // a context as it is after avformat_open_input, before probing
+  AVFormatContext* OpenContext()
+  {
+    AVFormatContext *context = avformat_alloc_context();
+    context->iformat = &m_format;
+
+    AVStream *st = avformat_new_stream(context, NULL);
+    st->id = 1;
+    st->time_base = av_make_q(1, 1000);
+    st->codecpar->codec_type = AVMEDIA_TYPE_VIDEO;
+    st->codecpar->codec_id = AV_CODEC_ID_H264;
+    st->codec->codec_type = AVMEDIA_TYPE_VIDEO;
+    st->codec->codec_id = AV_CODEC_ID_H264;
+    return context;
+  }
+
+  // what avformat_find_stream_info adds to it
+  void Probe(AVFormatContext *context)
+  {
+    AVStream *st = context->streams[0];
+    st->codecpar->format = AV_PIX_FMT_YUV420P;
+    st->codecpar->width = 1920;
+    st->codecpar->height = 1080;
+    st->codecpar->video_delay = 2;
+    st->avg_frame_rate = av_make_q(24000, 1001);
+    st->r_frame_rate = av_make_q(24000, 1001);
+    st->codec->pix_fmt = AV_PIX_FMT_YUV420P;
+    st->codec->width = 1920;
+    st->codec->height = 1080;
+    st->codec->time_base = av_make_q(1001, 48000);
+    st->codec->framerate = av_make_q(24000, 1001);
+    st->codec->ticks_per_frame = 2;
+    context->duration = 60 * AV_TIME_BASE;
+  }
+
+  AVInputFormat m_format;
+  XFILE::CFile *m_file;
+  std::string m_path;
+};
+
+TEST_F(TestStreamInfoCache, RestoresProbedStreams)
+{
+  CStreamInfoCache cache(m_path, 11);
+  ASSERT_TRUE(cache.IsCacheable());
+
+  AVFormatContext *probed = OpenContext();
+  Probe(probed);
+  cache.Store(probed);
+  avformat_free_context(probed);
+
+  AVFormatContext *context = OpenContext();
+  ASSERT_TRUE(cache.Restore(context));
+
+  const AVStream *st = context->streams[0];
+  EXPECT_EQ(AV_PIX_FMT_YUV420P, st->codecpar->format);
+  EXPECT_EQ(1920, st->codecpar->width);
+  EXPECT_EQ(1080, st->codecpar->height);
+  EXPECT_EQ(2, st->codec->has_b_frames);
+  EXPECT_EQ(1001, st->codec->time_base.num);
+  EXPECT_EQ(48000, st->codec->time_base.den);
+  EXPECT_EQ(24000, st->codec->framerate.num);
+  EXPECT_EQ(1001, st->codec->framerate.den);
+  EXPECT_EQ(2, st->codec->ticks_per_frame);
+  EXPECT_EQ(24000, st->avg_frame_rate.num);
+  EXPECT_EQ(60 * AV_TIME_BASE, context->duration);
+  avformat_free_context(context);
+}
+
+TEST_F(TestStreamInfoCache, ProbesChangedStreams)
+{
+  CStreamInfoCache cache(m_path, 11);
+
+  AVFormatContext *probed = OpenContext();
+  Probe(probed);
+  cache.Store(probed);
+  avformat_free_context(probed);
+
+  AVFormatContext *context = OpenContext();
+  context->streams[0]->id = 2;
+  EXPECT_FALSE(cache.Restore(context));
+  EXPECT_EQ(0, context->streams[0]->codecpar->width);
+  avformat_free_context(context);
+
+  // a file of a different size is a different file
+  context = OpenContext();
+  EXPECT_FALSE(CStreamInfoCache(m_path, 12).Restore(context));
+  avformat_free_context(context);
+}
+
+TEST_F(TestStreamInfoCache, ProbesStreamsThatNeedParsing)
+{
+  CStreamInfoCache cache(m_path, 11);
+
+  AVFormatContext *probed = OpenContext();
+  Probe(probed);
+  cache.Store(probed);
+  avformat_free_context(probed);
+
+  AVFormatContext *context = OpenContext();
+  context->streams[0]->need_parsing = AVSTREAM_PARSE_FULL;
+  EXPECT_FALSE(cache.Restore(context));
+  avformat_free_context(context);
+}
+
+TEST_F(TestStreamInfoCache, DoesNotStoreIncompleteProbe)
+{
+  CStreamInfoCache cache(m_path, 11);
+
+  AVFormatContext *probed = OpenContext();
+  cache.Store(probed);
+  avformat_free_context(probed);
+
+  EXPECT_FALSE(XFILE::CFile::Exists(cache.GetCachePath()));
+}
@@ -43,7 +43,10 @@
 #include "DVDCodecs/Video/DVDVideoCodec.h"
 #include "DVDCodecs/Video/DVDVideoCodecFFmpeg.h"
 #include "DVDDemuxers/DVDDemuxVobsub.h"
+#include "DVDDemuxers/KeyframeIndex.h"
 #include "Process/ProcessInfo.h"
+#include "SwScaler.h"
+#include "utils/StringUtils.h"
 
 #include "libavcodec/avcodec.h"
 #include "libswscale/swscale.h"
@@ -95,9 +98,119 @@ int DegreeToOrientation(int degrees)
   }
 }
 
+/*!
+ \brief Decode the first picture at a position and cache it scaled to the given width
+ \param nHeight set to the height of the cached picture
+ \param packetsTried incremented by the number of packets read
+ */
+static bool ExtractFrame(CDVDDemux *pDemuxer, CDVDVideoCodec *pVideoCodec, const CDVDStreamInfo &hint,
+                         int nVideoStream, int nSeekTo, unsigned int nWidth, const std::string &cachePath,
+                         unsigned int &nHeight, int &packetsTried)
+{
+  if (!pDemuxer->SeekTime(nSeekTo, true))
+    return false;
+
+  int iDecoderState = VC_ERROR;
+  DVDVideoPicture picture;
+
+  memset(&picture, 0, sizeof(picture));
+
+  // num streams * 160 frames, should get a valid frame, if not abort.
+  int abort_index = pDemuxer->GetNrOfStreams() * 160;
+  do
+  {
+    DemuxPacket* pPacket = pDemuxer->Read();
+    packetsTried++;
+
+    if (!pPacket)
+      break;
+
+    if (pPacket->iStreamId != nVideoStream)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+      continue;
+    }
+
+    iDecoderState = pVideoCodec->Decode(pPacket->pData, pPacket->iSize, pPacket->dts, pPacket->pts);
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+
+    if (iDecoderState & VC_ERROR)
+      break;
+
+    if (iDecoderState & VC_PICTURE)
+    {
+      memset(&picture, 0, sizeof(DVDVideoPicture));
+      if (pVideoCodec->GetPicture(&picture))
+      {
+        if(!(picture.iFlags & DVP_FLAG_DROPPED))
+          break;
+      }
+    }
+
+  } while (abort_index--);
+
+  if (!(iDecoderState & VC_PICTURE) || (picture.iFlags & DVP_FLAG_DROPPED))
+    return false;
+
+  bool bOk = false;
+  double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+  if(hint.forced_aspect && hint.aspect != 0)
+    aspect = hint.aspect;
+  nHeight = (unsigned int)((double)nWidth / aspect);
+
+  uint8_t *pOutBuf = (uint8_t*)av_malloc(nWidth * nHeight * 4);
+  uint8_t *src[] = { picture.data[0], picture.data[1], picture.data[2], 0 };
+  int     srcStride[] = { picture.iLineSize[0], picture.iLineSize[1], picture.iLineSize[2], 0 };
+  uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
+  int     dstStride[] = { (int)nWidth*4, 0, 0, 0 };
+
+  if (CSwScaler::ScaleOnce(picture.iWidth, picture.iHeight, AV_PIX_FMT_YUV420P, src, srcStride,
+                           nWidth, nHeight, AV_PIX_FMT_BGRA, dst, dstStride, SWS_FAST_BILINEAR))
+  {
+    int orientation = DegreeToOrientation(hint.orientation);
+    CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, cachePath);
+    bOk = true;
+  }
+  av_free(pOutBuf);
+
+  return bOk;
+}
+
+int CDVDFileInfo::GetThumbLowres(int width, unsigned int targetWidth)
+{
+  // ffmpeg supports decoding at 1/2, 1/4 and 1/8 of the size, for the codecs
+  // that support it at all, the others ignore it
+  int lowres = 0;
+  while (lowres < 3 && (width >> (lowres + 1)) >= (int)targetWidth)
+    lowres++;
+  return lowres;
+}
+
+/*!
+ \brief Open a software decoder that skips everything but keyframes and decodes
+ them at the smallest size that is still at least nWidth wide
+ */
+static CDVDVideoCodec* CreateKeyframeCodec(CDVDStreamInfo &hint, CProcessInfo &processInfo, unsigned int nWidth)
+{
+  CDVDCodecOptions options;
+  options.m_formats.push_back(RENDER_FMT_YUV420P);
+  options.m_keys.push_back(CDVDCodecOption("lowres", StringUtils::Format("%d", CDVDFileInfo::GetThumbLowres(hint.width, nWidth))));
+  options.m_keys.push_back(CDVDCodecOption("skip_frame", "nokey"));
+  // blocking artifacts disappear when scaling down to thumb size anyway
+  options.m_keys.push_back(CDVDCodecOption("skip_loop_filter", "all"));
+
+  CDVDVideoCodec *pCodec = new CDVDVideoCodecFFmpeg(processInfo);
+  if (!pCodec->Open(hint, options))
+  {
+    delete pCodec;
+    return NULL;
+  }
+  return pCodec;
+}
+
 bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
                                 CTextureDetails &details,
-                                CStreamDetails *pStreamDetails, int pos)
+                                CStreamDetails *pStreamDetails, int pos, bool lowCost)
 {
   std::string redactPath = CURL::GetRedacted(strPath);
   unsigned int nTime = XbmcThreads::SystemClockMillis();
@@ -195,99 +308,41 @@ bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
 
   if (nVideoStream != -1)
   {
-    CDVDVideoCodec *pVideoCodec;
     std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
 
     CDVDStreamInfo hint(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
     hint.software = true;
 
-    pVideoCodec = CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo);
+    int nTotalLen = pDemuxer->GetStreamLength();
+    int nSeekTo = (pos==-1) ? nTotalLen / 3 : pos;
+    unsigned int nWidth = g_advancedSettings.m_imageRes;
+    unsigned int nHeight = 0;
+    std::string cachePath = CTextureCache::GetCachedPath(details.file);
 
-    if (pVideoCodec)
+    CLog::Log(LOGDEBUG,"%s - seeking to pos %dms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
+    if (lowCost)
     {
-      int nTotalLen = pDemuxer->GetStreamLength();
-      int nSeekTo = (pos==-1) ? nTotalLen / 3 : pos;
-
-      CLog::Log(LOGDEBUG,"%s - seeking to pos %dms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
-      if (pDemuxer->SeekTime(nSeekTo, true))
-      {
-        int iDecoderState = VC_ERROR;
-        DVDVideoPicture picture;
-
-        memset(&picture, 0, sizeof(picture));
-
-        // num streams * 160 frames, should get a valid frame, if not abort.
-        int abort_index = pDemuxer->GetNrOfStreams() * 160;
-        do
-        {
-          DemuxPacket* pPacket = pDemuxer->Read();
-          packetsTried++;
-
-          if (!pPacket)
-            break;
-
-          if (pPacket->iStreamId != nVideoStream)
-          {
-            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-            continue;
-          }
-
-          iDecoderState = pVideoCodec->Decode(pPacket->pData, pPacket->iSize, pPacket->dts, pPacket->pts);
-          CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-
-          if (iDecoderState & VC_ERROR)
-            break;
-
-          if (iDecoderState & VC_PICTURE)
-          {
-            memset(&picture, 0, sizeof(DVDVideoPicture));
-            if (pVideoCodec->GetPicture(&picture))
-            {
-              if(!(picture.iFlags & DVP_FLAG_DROPPED))
-                break;
-            }
-          }
+      std::unique_ptr<CDVDVideoCodec> pVideoCodec(CreateKeyframeCodec(hint, *pProcessInfo, nWidth));
+      if (pVideoCodec)
+        bOk = ExtractFrame(pDemuxer, pVideoCodec.get(), hint, nVideoStream, nSeekTo, nWidth, cachePath, nHeight, packetsTried);
+      if (!bOk)
+        CLog::Log(LOGDEBUG,"%s - no keyframe decoded in %s, decoding all frames", __FUNCTION__, redactPath.c_str());
+    }
 
-        } while (abort_index--);
+    if (!bOk)
+    {
+      std::unique_ptr<CDVDVideoCodec> pVideoCodec(CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo));
+      if (pVideoCodec)
+        bOk = ExtractFrame(pDemuxer, pVideoCodec.get(), hint, nVideoStream, nSeekTo, nWidth, cachePath, nHeight, packetsTried);
+    }
 
-        if (iDecoderState & VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
-        {
-          {
-            unsigned int nWidth = g_advancedSettings.m_imageRes;
-            double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-            if(hint.forced_aspect && hint.aspect != 0)
-              aspect = hint.aspect;
-            unsigned int nHeight = (unsigned int)((double)g_advancedSettings.m_imageRes / aspect);
-
-            uint8_t *pOutBuf = (uint8_t*)av_malloc(nWidth * nHeight * 4);
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
-            {
-              uint8_t *src[] = { picture.data[0], picture.data[1], picture.data[2], 0 };
-              int     srcStride[] = { picture.iLineSize[0], picture.iLineSize[1], picture.iLineSize[2], 0 };
-              uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
-              int     dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
-
-              details.width = nWidth;
-              details.height = nHeight;
-              CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
-            }
-            av_free(pOutBuf);
-          }
-        }
-        else
-        {
-          CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
-        }
-      }
-      delete pVideoCodec;
+    if (bOk)
+    {
+      details.width = nWidth;
+      details.height = nHeight;
     }
+    else
+      CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
   }
 
   if (pDemuxer)
@@ -307,6 +362,79 @@ bool CDVDFileInfo::ExtractThumb(const std::string &strPath,
   return bOk;
 }
 
+bool CDVDFileInfo::ExtractSeekPreviews(const std::string &strPath, unsigned int count, unsigned int width)
+{
+  std::string redactPath = CURL::GetRedacted(strPath);
+  unsigned int nTime = XbmcThreads::SystemClockMillis();
+  CFileItem item(strPath, false);
+
+  item.SetMimeTypeForInternetFile();
+  std::unique_ptr<CDVDInputStream> pInputStream(CDVDFactoryInputStream::CreateInputStream(NULL, item));
+  if (!pInputStream || !pInputStream->Open())
+  {
+    CLog::Log(LOGERROR, "InputStream: Error opening, %s", redactPath.c_str());
+    return false;
+  }
+
+  std::unique_ptr<CDVDDemux> pDemuxer;
+  try
+  {
+    pDemuxer.reset(CDVDFactoryDemuxer::CreateDemuxer(pInputStream.get(), true));
+  }
+  catch(...)
+  {
+    CLog::Log(LOGERROR, "%s - Exception thrown when opening demuxer", __FUNCTION__);
+  }
+  if (!pDemuxer)
+    return false;
+
+  int nVideoStream = -1;
+  int64_t demuxerId = -1;
+  for (CDemuxStream* pStream : pDemuxer->GetStreams())
+  {
+    if (pStream)
+    {
+      if (pStream->type == STREAM_VIDEO && !(pStream->flags & AV_DISPOSITION_ATTACHED_PIC))
+      {
+        nVideoStream = pStream->uniqueId;
+        demuxerId = pStream->demuxerId;
+      }
+      else
+        pDemuxer->EnableStream(pStream->demuxerId, pStream->uniqueId, false);
+    }
+  }
+
+  int nTotalLen = pDemuxer->GetStreamLength();
+  if (nVideoStream == -1 || nTotalLen <= 0)
+    return false;
+
+  std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
+  CDVDStreamInfo hint(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
+  hint.software = true;
+
+  std::unique_ptr<CDVDVideoCodec> pVideoCodec(CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo));
+  if (!pVideoCodec)
+    return false;
+
+  int packetsTried = 0;
+  unsigned int extracted = 0;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    // the middle of each of the parts the seek bar is divided into
+    int nSeekTo = (int)((2 * i + 1) * (int64_t)nTotalLen / (2 * count));
+    unsigned int nHeight = 0;
+
+    pVideoCodec->Reset();
+    if (ExtractFrame(pDemuxer.get(), pVideoCodec.get(), hint, nVideoStream, nSeekTo, width,
+                     CKeyframeIndex::GetPreviewPath(strPath, i), nHeight, packetsTried))
+      extracted++;
+  }
+
+  unsigned int nTotalTime = XbmcThreads::SystemClockMillis() - nTime;
+  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract %u of %u previews from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, extracted, count, redactPath.c_str(), packetsTried);
+  return extracted == count;
+}
+
 /**
  * \brief Open the item pointed to by pItem and extact streamdetails
  * \return true if the stream details have changed
@@ -34,9 +34,23 @@ class CDVDFileInfo
 {
 public:
   // Extract a thumbnail immage from the media at strPath, optionally populating a streamdetails class with the data
+  // lowCost only decodes a keyframe at reduced resolution, falling back to a full decode if that fails
   static bool ExtractThumb(const std::string &strPath,
                            CTextureDetails &details,
-                           CStreamDetails *pStreamDetails, int pos=-1);
+                           CStreamDetails *pStreamDetails, int pos=-1, bool lowCost=false);
+
+  /*!
+   \brief FFmpeg's lowres level to decode a picture of the given width for a thumb of at least targetWidth
+   */
+  static int GetThumbLowres(int width, unsigned int targetWidth);
+
+  /*!
+   \brief Extract pictures evenly spread over the media at strPath for previews on the seek bar
+   \param count number of pictures, picture i shows the middle of the i-th of count equal parts
+   \param width width of the pictures
+   \return true if all pictures were extracted, see CKeyframeIndex::GetPreviewPath() for where they are stored
+   */
+  static bool ExtractSeekPreviews(const std::string &strPath, unsigned int count, unsigned int width);
 
   // Probe the files streams and store the info in the VideoInfoTag
   static bool GetFileStreamDetails(CFileItem *pItem);
@@ -0,0 +1,412 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SwScaler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "utils/CPUInfo.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+extern "C" {
+#include "libavutil/imgutils.h"
+#include "libavutil/pixdesc.h"
+#include "libswscale/swscale.h"
+}
+
+// smaller pictures are scaled faster than the threads are woken
+#define SWSCALER_MIN_PIXELS (1280 * 720)
+#define SWSCALER_MIN_BAND_ROWS 64
+#define SWSCALER_MAX_BANDS 16
+// the filters that reach too far for pictures scaled vertically to be split
+#define SWSCALER_UNBANDED_FILTERS (SWS_GAUSS | SWS_SINC | SWS_SPLINE)
+
+namespace
+{
+// the jobs scaling bands for all scalers, at most one per cpu
+std::atomic<int> g_bandJobs(0);
+
+int ReserveBandJobs(int wanted)
+{
+  int limit = g_cpuInfo.getCPUCount();
+  int jobs = g_bandJobs.load();
+  int reserved;
+  do
+  {
+    reserved = std::max(0, std::min(wanted, limit - jobs));
+    if (reserved == 0)
+      return 0;
+  } while (!g_bandJobs.compare_exchange_weak(jobs, jobs + reserved));
+  return reserved;
+}
+
+// the bands of one Scale(), taken by the jobs that start before it is done
+struct SBandWork
+{
+  SBandWork() : done(false), running(0) {}
+
+  CCriticalSection section;
+  bool done;
+  int running;
+  CEvent idle;
+  std::function<void()> scale;
+};
+
+class CScaleBandsJob : public CJob
+{
+public:
+  explicit CScaleBandsJob(const std::shared_ptr<SBandWork> &work) : m_work(work) {}
+
+  // a job that is never queued, dropped or done gives its reservation back
+  ~CScaleBandsJob() override { g_bandJobs--; }
+
+  bool DoWork() override
+  {
+    {
+      CSingleLock lock(m_work->section);
+      if (m_work->done)
+        return true;
+      m_work->running++;
+    }
+
+    m_work->scale();
+
+    CSingleLock lock(m_work->section);
+    if (--m_work->running == 0)
+      m_work->idle.Set();
+    return true;
+  }
+
+private:
+  std::shared_ptr<SBandWork> m_work;
+};
+}
+
+CSwScaler::CSwScaler() :
+  m_srcWidth(0),
+  m_srcHeight(0),
+  m_srcFormat(AV_PIX_FMT_NONE),
+  m_dstWidth(0),
+  m_dstHeight(0),
+  m_dstFormat(AV_PIX_FMT_NONE),
+  m_flags(0),
+  m_threads(0)
+{
+}
+
+CSwScaler::~CSwScaler()
+{
+  Free();
+}
+
+void CSwScaler::Free()
+{
+  for (auto &band : m_bands)
+  {
+    sws_freeContext(band.context);
+    av_freep(&band.output[0]);
+  }
+  m_bands.clear();
+}
+
+int CSwScaler::GetBandCount(int srcWidth, int srcHeight, AVPixelFormat srcFormat,
+                            int dstWidth, int dstHeight, AVPixelFormat dstFormat, int flags, int threads)
+{
+  if (threads == 1)
+    return 1;
+
+  const AVPixFmtDescriptor *srcDesc = av_pix_fmt_desc_get(srcFormat);
+  const AVPixFmtDescriptor *dstDesc = av_pix_fmt_desc_get(dstFormat);
+  if (!srcDesc || !dstDesc)
+    return 1;
+
+  // the second plane of these is a palette, not rows
+  const uint64_t unbanded = AV_PIX_FMT_FLAG_PAL | AV_PIX_FMT_FLAG_PSEUDOPAL | AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_BITSTREAM;
+  if ((srcDesc->flags | dstDesc->flags) & unbanded)
+    return 1;
+
+  if (srcHeight != dstHeight && (flags & SWSCALER_UNBANDED_FILTERS))
+    return 1;
+
+  int bands = threads;
+  if (bands <= 0)
+  {
+    if (std::max((int64_t)srcWidth * srcHeight, (int64_t)dstWidth * dstHeight) < SWSCALER_MIN_PIXELS)
+      return 1;
+    bands = g_cpuInfo.getCPUCount();
+  }
+
+  bands = std::min(bands, SWSCALER_MAX_BANDS);
+  bands = std::min(bands, std::max(srcHeight, dstHeight) / SWSCALER_MIN_BAND_ROWS);
+  return std::max(bands, 1);
+}
+
+bool CSwScaler::Configure(int srcWidth, int srcHeight, AVPixelFormat srcFormat,
+                          int dstWidth, int dstHeight, AVPixelFormat dstFormat,
+                          int flags, int threads /* = 0 */)
+{
+  if (!m_bands.empty() &&
+      srcWidth == m_srcWidth && srcHeight == m_srcHeight && srcFormat == m_srcFormat &&
+      dstWidth == m_dstWidth && dstHeight == m_dstHeight && dstFormat == m_dstFormat &&
+      flags == m_flags && threads == m_threads)
+    return true;
+
+  Free();
+
+  const AVPixFmtDescriptor *srcDesc = av_pix_fmt_desc_get(srcFormat);
+  const AVPixFmtDescriptor *dstDesc = av_pix_fmt_desc_get(dstFormat);
+  if (!srcDesc || !dstDesc || srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0)
+    return false;
+
+  // a band starts on the first row of a chroma row in the input and the
+  // output. when scaling vertically it also has to start on a source row
+  // that the whole picture maps onto an output row, so that the band is
+  // scaled with the same filter as the rows of the whole picture are.
+  int align = 1 << std::max(srcDesc->log2_chroma_h, dstDesc->log2_chroma_h);
+  int srcUnit = align;
+  int dstUnit = align;
+  int overlap = 0;
+  if (srcHeight != dstHeight)
+  {
+    int gcd = srcHeight;
+    for (int b = dstHeight; b != 0;)
+    {
+      int r = gcd % b;
+      gcd = b;
+      b = r;
+    }
+    int k = 1;
+    while ((k * (srcHeight / gcd)) % align || (k * (dstHeight / gcd)) % align)
+      ++k;
+    srcUnit = k * (srcHeight / gcd);
+    dstUnit = k * (dstHeight / gcd);
+
+    // the band is scaled with as many rows of its neighbours as the filter
+    // reaches, in rows of the plane with the fewest rows, times the ratio
+    // when scaling down. the rows scaled from them are dropped.
+    int reach = 1;
+    if (flags & SWS_X)
+      reach = 4;
+    else if (flags & SWS_LANCZOS)
+      reach = 3;
+    else if (flags & (SWS_BICUBIC | SWS_BICUBLIN))
+      reach = 2;
+    int ratio = std::max(1, (srcHeight + dstHeight - 1) / dstHeight);
+    overlap = (align * (reach * ratio + 1) + srcUnit - 1) / srcUnit;
+  }
+
+  // bands have at least twice the rows they take from their neighbours
+  int units = srcHeight / srcUnit;
+  int count = GetBandCount(srcWidth, srcHeight, srcFormat, dstWidth, dstHeight, dstFormat, flags, threads);
+  count = std::max(1, std::min(count, units / std::max(1, 2 * overlap)));
+  if (count == 1)
+    overlap = 0;
+
+  std::vector<int> first(count + 1);
+  for (int i = 0; i < count; ++i)
+    first[i] = (int)((int64_t)units * i / count);
+  first[count] = units;
+
+  for (int i = 0; i < count; ++i)
+  {
+    int from = std::max(0, first[i] - overlap);
+    int to = std::min(units, first[i + 1] + overlap);
+
+    SBand band;
+    band.srcY = from * srcUnit;
+    band.srcHeight = to == units ? srcHeight - band.srcY : (to - from) * srcUnit;
+    band.dstY = first[i] * dstUnit;
+    band.dstHeight = i == count - 1 ? dstHeight - band.dstY : (first[i + 1] - first[i]) * dstUnit;
+    band.skip = (first[i] - from) * dstUnit;
+    int outputHeight = to == units ? dstHeight - from * dstUnit : (to - from) * dstUnit;
+
+    // a band that is scaled with rows of its neighbours goes through a
+    // picture of its own, the others are scaled right into the output
+    memset(band.output, 0, sizeof(band.output));
+    memset(band.outputStride, 0, sizeof(band.outputStride));
+    if (outputHeight != band.dstHeight &&
+        av_image_alloc(band.output, band.outputStride, dstWidth, outputHeight, dstFormat, 32) < 0)
+    {
+      CLog::Log(LOGERROR, "CSwScaler::%s - unable to allocate a band of %dx%d", __FUNCTION__, dstWidth, outputHeight);
+      Free();
+      return false;
+    }
+
+    band.context = sws_getContext(srcWidth, band.srcHeight, srcFormat,
+                                  dstWidth, outputHeight, dstFormat,
+                                  flags, NULL, NULL, NULL);
+    if (!band.context)
+    {
+      CLog::Log(LOGERROR, "CSwScaler::%s - unable to convert %s %dx%d to %s %dx%d", __FUNCTION__,
+                srcDesc->name, srcWidth, srcHeight, dstDesc->name, dstWidth, dstHeight);
+      av_freep(&band.output[0]);
+      Free();
+      return false;
+    }
+    m_bands.push_back(band);
+  }
+
+  m_srcWidth = srcWidth;
+  m_srcHeight = srcHeight;
+  m_srcFormat = srcFormat;
+  m_dstWidth = dstWidth;
+  m_dstHeight = dstHeight;
+  m_dstFormat = dstFormat;
+  m_flags = flags;
+  m_threads = threads;
+  return true;
+}
+
+bool CSwScaler::SetRange(int srcRange, int dstRange)
+{
+  for (auto &band : m_bands)
+  {
+    int *inv_table = nullptr;
+    int *table = nullptr;
+    int bandSrcRange, bandDstRange, brightness, contrast, saturation;
+    if (sws_getColorspaceDetails(band.context, &inv_table, &bandSrcRange, &table, &bandDstRange, &brightness, &contrast, &saturation) < 0)
+      return false;
+
+    if (srcRange >= 0)
+      bandSrcRange = srcRange;
+    if (dstRange >= 0)
+      bandDstRange = dstRange;
+    if (sws_setColorspaceDetails(band.context, inv_table, bandSrcRange, table, bandDstRange, brightness, contrast, saturation) < 0)
+      return false;
+  }
+
+  return !m_bands.empty();
+}
+
+int CSwScaler::ScaleBand(const SBand &band, int width, AVPixelFormat srcFormat, const uint8_t *const src[], const int srcStride[],
+                         AVPixelFormat dstFormat, uint8_t *const dst[], const int dstStride[])
+{
+  const AVPixFmtDescriptor *srcDesc = av_pix_fmt_desc_get(srcFormat);
+  const AVPixFmtDescriptor *dstDesc = av_pix_fmt_desc_get(dstFormat);
+
+  // planes 1 and 2 hold the chroma, the others have a row for every row of the picture
+  const uint8_t *srcBand[4];
+  uint8_t *dstBand[4];
+  for (int plane = 0; plane < 4; ++plane)
+  {
+    int srcShift = plane == 1 || plane == 2 ? srcDesc->log2_chroma_h : 0;
+    int dstShift = plane == 1 || plane == 2 ? dstDesc->log2_chroma_h : 0;
+    srcBand[plane] = src[plane] ? src[plane] + (ptrdiff_t)(band.srcY >> srcShift) * srcStride[plane] : NULL;
+    dstBand[plane] = dst[plane] ? dst[plane] + (ptrdiff_t)(band.dstY >> dstShift) * dstStride[plane] : NULL;
+  }
+
+  if (!band.output[0])
+    return sws_scale(band.context, srcBand, srcStride, 0, band.srcHeight, dstBand, dstStride);
+
+  int rows = sws_scale(band.context, srcBand, srcStride, 0, band.srcHeight, band.output, band.outputStride);
+  if (rows < 0)
+    return rows;
+
+  // keep the rows of this band, the ones of the neighbours are theirs to scale
+  for (int plane = 0; plane < 4 && dstBand[plane] && band.output[plane]; ++plane)
+  {
+    int shift = plane == 1 || plane == 2 ? dstDesc->log2_chroma_h : 0;
+    int bytes = av_image_get_linesize(dstFormat, width, plane);
+    if (bytes <= 0)
+      break;
+    av_image_copy_plane(dstBand[plane], dstStride[plane],
+                        band.output[plane] + (ptrdiff_t)(band.skip >> shift) * band.outputStride[plane], band.outputStride[plane],
+                        bytes, -((-band.dstHeight) >> shift));
+  }
+  return band.dstHeight;
+}
+
+int CSwScaler::Scale(const uint8_t *const src[], const int srcStride[], uint8_t *const dst[], const int dstStride[])
+{
+  if (m_bands.empty())
+    return -1;
+
+  int jobs = m_bands.size() > 1 ? ReserveBandJobs(m_bands.size() - 1) : 0;
+  if (jobs == 0)
+  {
+    int total = 0;
+    for (const auto &band : m_bands)
+    {
+      int bandRows = ScaleBand(band, m_dstWidth, m_srcFormat, src, srcStride, m_dstFormat, dst, dstStride);
+      if (bandRows < 0)
+        return bandRows;
+      total += bandRows;
+    }
+    return total;
+  }
+
+  // this thread and the jobs take the next band until all are scaled
+  std::vector<int> rows(m_bands.size(), 0);
+  std::atomic<size_t> next(0);
+  auto scaleBands = [this, &rows, &next, src, srcStride, dst, dstStride]()
+  {
+    for (size_t i = next++; i < m_bands.size(); i = next++)
+      rows[i] = ScaleBand(m_bands[i], m_dstWidth, m_srcFormat, src, srcStride, m_dstFormat, dst, dstStride);
+  };
+
+  std::shared_ptr<SBandWork> work = std::make_shared<SBandWork>();
+  work->scale = scaleBands;
+  for (int i = 0; i < jobs; ++i)
+  {
+    CScaleBandsJob *job = new CScaleBandsJob(work);
+    if (CJobManager::GetInstance().AddJob(job, nullptr, CJob::PRIORITY_DEDICATED) == 0)
+      delete job;
+  }
+  scaleBands();
+
+  // all bands are taken, jobs starting from now on have nothing to do. wait
+  // for the ones that are still scaling theirs.
+  {
+    CSingleLock lock(work->section);
+    work->done = true;
+    while (work->running > 0)
+    {
+      CSingleExit exit(work->section);
+      work->idle.Wait();
+    }
+  }
+
+  int total = 0;
+  for (int bandRows : rows)
+  {
+    if (bandRows < 0)
+      return bandRows;
+    total += bandRows;
+  }
+  return total;
+}
+
+bool CSwScaler::ScaleOnce(int srcWidth, int srcHeight, AVPixelFormat srcFormat, const uint8_t *const src[], const int srcStride[],
+                          int dstWidth, int dstHeight, AVPixelFormat dstFormat, uint8_t *const dst[], const int dstStride[],
+                          int flags)
+{
+  CSwScaler scaler;
+  if (!scaler.Configure(srcWidth, srcHeight, srcFormat, dstWidth, dstHeight, dstFormat, flags))
+    return false;
+  return scaler.Scale(src, srcStride, dst, dstStride) >= 0;
+}
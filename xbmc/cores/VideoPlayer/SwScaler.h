@@ -0,0 +1,116 @@
+#pragma once
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <vector>
+
+extern "C" {
+#include "libavutil/pixfmt.h"
+}
+
+struct SwsContext;
+
+/*!
+ * @brief Scales and converts pictures with swscale, large pictures in
+ * horizontal bands on several threads.
+ *
+ * Every band has a context of its own that scales the band as a picture of
+ * its own. When the picture is scaled vertically, a band starts on a source
+ * row that maps onto an output row and also takes the rows of its neighbours
+ * the vertical filter reaches. Those are scaled into a picture of the band
+ * and only the rows of the band itself are copied to the output. The bands of
+ * all scalers are scaled by at most one job per cpu, the rest by the calling
+ * thread. Scale() only waits for the jobs that started before it took the
+ * last band.
+ */
+class CSwScaler
+{
+public:
+  CSwScaler();
+  ~CSwScaler();
+
+  /*!
+   * @brief Set up the contexts, they are reused if nothing changed.
+   * @param flags the SWS_* scaling algorithm.
+   * @param threads the number of bands at most, 0 for as many as there are
+   * cpus if the picture is large enough to gain from it. Pictures that change
+   * their height with a filter reaching far (gauss, sinc, spline) or with
+   * too few rows mapping onto output rows are scaled in one band.
+   * @return false if swscale doesn't support the conversion.
+   */
+  bool Configure(int srcWidth, int srcHeight, AVPixelFormat srcFormat,
+                 int dstWidth, int dstHeight, AVPixelFormat dstFormat,
+                 int flags, int threads = 0);
+
+  /*!
+   * @brief Set the range of the YUV data.
+   * @param srcRange 1 for full (JPEG) range, 0 for limited range, -1 to keep it.
+   * @param dstRange same as srcRange, for the output.
+   */
+  bool SetRange(int srcRange, int dstRange);
+
+  /*!
+   * @brief Scale a whole picture.
+   * @return the number of output rows, negative on failure.
+   */
+  int Scale(const uint8_t *const src[], const int srcStride[], uint8_t *const dst[], const int dstStride[]);
+
+  /*!
+   * @return the number of bands the picture is scaled in.
+   */
+  int Bands() const { return m_bands.size(); }
+
+  /*!
+   * @brief Scale a picture with a context set up for this call only.
+   */
+  static bool ScaleOnce(int srcWidth, int srcHeight, AVPixelFormat srcFormat, const uint8_t *const src[], const int srcStride[],
+                        int dstWidth, int dstHeight, AVPixelFormat dstFormat, uint8_t *const dst[], const int dstStride[],
+                        int flags);
+
+private:
+  struct SBand
+  {
+    SwsContext *context;
+    int srcY;
+    int srcHeight;
+    int dstY;
+    int dstHeight;
+    int skip; //!< rows scaled from the rows of the band above
+    uint8_t *output[4]; //!< the scaled rows with the ones of the neighbours, if any
+    int outputStride[4];
+  };
+
+  static int GetBandCount(int srcWidth, int srcHeight, AVPixelFormat srcFormat,
+                          int dstWidth, int dstHeight, AVPixelFormat dstFormat, int flags, int threads);
+  static int ScaleBand(const SBand &band, int width, AVPixelFormat srcFormat, const uint8_t *const src[], const int srcStride[],
+                       AVPixelFormat dstFormat, uint8_t *const dst[], const int dstStride[]);
+  void Free();
+
+  std::vector<SBand> m_bands;
+  int m_srcWidth;
+  int m_srcHeight;
+  AVPixelFormat m_srcFormat;
+  int m_dstWidth;
+  int m_dstHeight;
+  AVPixelFormat m_dstFormat;
+  int m_flags;
+  int m_threads;
+};
@@ -0,0 +1,95 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "VideoFramePool.h"
+
+extern "C" {
+#include "libavutil/frame.h"
+}
+
+CVideoFramePool::CVideoFramePool() :
+  m_first(0),
+  m_size(0),
+  m_count(0),
+  m_peak(0)
+{
+}
+
+CVideoFramePool::~CVideoFramePool()
+{
+  SetSize(0);
+}
+
+void CVideoFramePool::SetSize(unsigned int size)
+{
+  Clear();
+
+  for (auto &entry : m_entries)
+    av_frame_free(&entry.frame);
+  m_entries.resize(size);
+  for (auto &entry : m_entries)
+    entry.frame = av_frame_alloc();
+
+  m_size = size;
+  m_peak = 0;
+}
+
+bool CVideoFramePool::Push(CDVDVideoCodec &codec, const DVDVideoPicture &picture, double pts)
+{
+  if (IsFull())
+    return false;
+
+  SEntry &entry = m_entries[(m_first + m_count) % m_size];
+  if (!entry.frame)
+    return false;
+
+  entry.picture = picture;
+  entry.pts = pts;
+  if (!codec.HoldPicture(&entry.picture, entry.frame))
+    return false;
+
+  if (++m_count > m_peak)
+    m_peak = m_count.load();
+  return true;
+}
+
+const DVDVideoPicture &CVideoFramePool::Front(double &pts) const
+{
+  const SEntry &entry = m_entries[m_first];
+  pts = entry.pts;
+  return entry.picture;
+}
+
+void CVideoFramePool::Pop()
+{
+  if (IsEmpty())
+    return;
+
+  av_frame_unref(m_entries[m_first].frame);
+  m_first = (m_first + 1) % m_size;
+  --m_count;
+}
+
+void CVideoFramePool::Clear()
+{
+  while (!IsEmpty())
+    Pop();
+  m_first = 0;
+}
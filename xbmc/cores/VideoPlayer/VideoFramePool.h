@@ -0,0 +1,92 @@
+#pragma once
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <vector>
+
+#include "DVDCodecs/Video/DVDVideoCodec.h"
+
+/*!
+ * @brief Holds pictures decoded ahead of the renderer, in decoding order.
+ *
+ * The data of a picture stays referenced by a frame of the pool, so the
+ * decoder can go on while the renderer has no free buffer and the picture is
+ * only copied once, into the render buffer. The frames are allocated once and
+ * reused, the picture buffers come from the buffer pool of the decoder.
+ */
+class CVideoFramePool
+{
+public:
+  CVideoFramePool();
+  ~CVideoFramePool();
+
+  /*!
+   * @brief Release all pictures and change the number of pictures that can be held.
+   * @param size the number of pictures, 0 disables holding pictures.
+   */
+  void SetSize(unsigned int size);
+  unsigned int Size() const { return m_size; }
+  unsigned int Count() const { return m_count; }
+  bool IsEmpty() const { return m_count == 0; }
+  bool IsFull() const { return m_count == m_size; }
+
+  /*!
+   * @brief Hold the picture last returned by the codec.
+   * @return false if the pool is full or the codec can't keep the picture.
+   */
+  bool Push(CDVDVideoCodec &codec, const DVDVideoPicture &picture, double pts);
+
+  /*!
+   * @brief The oldest picture, the pool must not be empty.
+   * @param pts the pts the picture was pushed with.
+   */
+  const DVDVideoPicture &Front(double &pts) const;
+
+  /*!
+   * @brief Release the oldest picture.
+   */
+  void Pop();
+
+  /*!
+   * @brief Release all pictures.
+   */
+  void Clear();
+
+  /*!
+   * @return the highest number of pictures held since the size was set.
+   */
+  unsigned int Peak() const { return m_peak; }
+
+private:
+  struct SEntry
+  {
+    AVFrame *frame;
+    DVDVideoPicture picture;
+    double pts;
+  };
+
+  std::vector<SEntry> m_entries;
+  unsigned int m_first;
+  // read by the stats of other threads
+  std::atomic<unsigned int> m_size;
+  std::atomic<unsigned int> m_count;
+  std::atomic<unsigned int> m_peak;
+};
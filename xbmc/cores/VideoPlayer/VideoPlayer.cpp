@@ -623,7 +623,8 @@ CVideoPlayer::CVideoPlayer(IPlayerCallback& callback)
       m_CurrentRadioRDS(STREAM_RADIO_RDS, VideoPlayer_RDS),
       m_messenger("player"),
       m_renderManager(m_clock, this),
-      m_ready(true)
+      m_ready(true),
+      m_parseCaptions(CSettings::SETTING_SUBTITLES_PARSECAPTIONS)
 {
   m_players_created = false;
   m_pDemuxer = NULL;
@@ -1572,7 +1573,7 @@ void CVideoPlayer::Process()
     CheckBetterStream(m_CurrentRadioRDS, pStream);
 
     // demux video stream
-    if (CSettings::GetInstance().GetBool(CSettings::SETTING_SUBTITLES_PARSECAPTIONS) && CheckIsCurrent(m_CurrentVideo, pStream, pPacket))
+    if (m_parseCaptions && CheckIsCurrent(m_CurrentVideo, pStream, pPacket))
     {
       if (m_pCCDemuxer)
       {
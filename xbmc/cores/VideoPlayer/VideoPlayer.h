@@ -41,6 +41,7 @@
 #include "threads/Thread.h"
 #include "utils/StreamDetails.h"
 #include "guilib/DispResource.h"
+#include "settings/SettingRef.h"
 
 #ifdef HAS_OMXPLAYER
 #include "OMXCore.h"
@@ -596,4 +597,7 @@ protected:
   bool m_omxplayer_mode;            // using omxplayer acceleration
 
   XbmcThreads::EndTime m_player_status_timer;
+
+  // read for every demuxed packet
+  CSettingRef<bool> m_parseCaptions;
 };
@@ -32,6 +32,7 @@
 #include "DVDDemuxers/DVDDemux.h"
 #include "DVDDemuxers/DVDDemuxPacket.h"
 #include "guilib/GraphicContext.h"
+#include "threads/SystemClock.h"
 #include <sstream>
 #include <iomanip>
 #include <numeric>
@@ -95,6 +96,9 @@ CVideoPlayerVideo::CVideoPlayerVideo(CDVDClock* pClock
   m_iFrameRateLength = 0;
   m_bFpsInvalid = false;
   m_bAllowFullscreen = false;
+  m_iCopiedPictures = 0;
+  m_copiesTime = 0;
+  m_iCopiesPerSecond = 0;
 }
 
 CVideoPlayerVideo::~CVideoPlayerVideo()
@@ -186,6 +190,8 @@ void CVideoPlayerVideo::OpenStream(CDVDStreamInfo &hint, CDVDVideoCodec* codec)
   else
     m_fForcedAspectRatio = 0.0;
 
+  m_decodeAhead.SetSize(g_advancedSettings.m_videoDecodeAhead);
+
   if (m_pVideoCodec)
   {
     m_pVideoCodec->ClearPicture(&m_picture);
@@ -268,6 +274,10 @@ void CVideoPlayerVideo::Process()
     if (m_paused)
       iPriority = 1;
 
+    // decode on while there are packets, otherwise the held pictures are output
+    if (!iPriority && !m_decodeAhead.IsEmpty())
+      iQueueTimeOut = 0;
+
     CDVDMsg* pMsg;
     MsgQueueReturnCode ret = m_messageQueue.Get(&pMsg, iQueueTimeOut, iPriority);
 
@@ -282,6 +292,12 @@ void CVideoPlayerVideo::Process()
       if( iPriority )
         continue;
 
+      if (!m_decodeAhead.IsEmpty())
+      {
+        OutputHeldPicture();
+        continue;
+      }
+
       // check if decoder has produced some output
       m_pVideoCodec->SetCodecControl(DVD_CODEC_CTRL_DRAIN);
       int decoderState = m_pVideoCodec->Decode(NULL, 0, DVD_NOPTS_VALUE, DVD_NOPTS_VALUE);
@@ -332,6 +348,7 @@ void CVideoPlayerVideo::Process()
     }
     else if (pMsg->IsType(CDVDMsg::GENERAL_RESET))
     {
+      m_decodeAhead.Clear();
       if(m_pVideoCodec)
         m_pVideoCodec->Reset();
       m_picture.iFlags &= ~DVP_FLAG_ALLOCATED;
@@ -343,6 +360,7 @@ void CVideoPlayerVideo::Process()
     else if (pMsg->IsType(CDVDMsg::GENERAL_FLUSH)) // private message sent by (CVideoPlayerVideo::Flush())
     {
       bool sync = static_cast<CDVDMsgBool*>(pMsg)->m_value;
+      m_decodeAhead.Clear();
       if(m_pVideoCodec)
         m_pVideoCodec->Reset();
       m_picture.iFlags &= ~DVP_FLAG_ALLOCATED;
@@ -386,6 +404,7 @@ void CVideoPlayerVideo::Process()
         if (decoderState & VC_BUFFER)
           break;
       }
+      OutputHeldPictures(true);
 
       OpenStream(msg->m_hints, msg->m_codec);
       msg->m_codec = NULL;
@@ -406,6 +425,7 @@ void CVideoPlayerVideo::Process()
         if (decoderState & VC_BUFFER)
           break;
       }
+      OutputHeldPictures(true);
     }
     else if (pMsg->IsType(CDVDMsg::GENERAL_PAUSE))
     {
@@ -507,6 +527,7 @@ void CVideoPlayerVideo::Process()
   }
 
   // we need to let decoder release any picture retained resources.
+  m_decodeAhead.Clear();
   m_pVideoCodec->ClearPicture(&m_picture);
 }
 
@@ -524,6 +545,7 @@ bool CVideoPlayerVideo::ProcessDecoderOutput(int &decoderState, double &frametim
       m_messageQueue.Put(msg, 10);
     }
 
+    m_decodeAhead.Clear();
     m_pVideoCodec->Reset();
     m_packets.clear();
     //picture.iFlags &= ~DVP_FLAG_ALLOCATED;
@@ -540,6 +562,7 @@ bool CVideoPlayerVideo::ProcessDecoderOutput(int &decoderState, double &frametim
       m_messageQueue.Put(msg, 10);
     }
 
+    m_decodeAhead.Clear();
     m_pVideoCodec->Reopen();
     m_packets.clear();
     //picture.iFlags &= ~DVP_FLAG_ALLOCATED;
@@ -594,7 +617,7 @@ bool CVideoPlayerVideo::ProcessDecoderOutput(int &decoderState, double &frametim
         m_picture.iDuration += extraDelay;
       }
 
-      int iResult = OutputPicture(&m_picture, pts + extraDelay);
+      int iResult = OutputDecodedPicture(pts + extraDelay);
 
       frametime = (double)DVD_TIME_BASE / m_fFrameRate;
 
@@ -728,6 +751,56 @@ std::string CVideoPlayerVideo::GetStereoMode()
   return stereo_mode;
 }
 
+int CVideoPlayerVideo::OutputDecodedPicture(double pts)
+{
+  // while the renderer has no free buffer, pictures are held back and decoding
+  // goes on, so the held pictures cover for one that takes longer to decode
+  if (m_syncState == IDVDStreamPlayer::SYNC_INSYNC &&
+      m_speed == DVD_PLAYSPEED_NORMAL &&
+      !(m_picture.iFlags & DVP_FLAG_DROPPED) &&
+      m_decodeAhead.Size() > 0)
+  {
+    OutputHeldPictures(false);
+    if (!m_decodeAhead.IsEmpty() || !m_renderManager.HasFreeBuffer())
+    {
+      if (m_decodeAhead.IsFull())
+        OutputHeldPicture();
+      if (m_decodeAhead.Push(*m_pVideoCodec, m_picture, pts))
+        return 0;
+    }
+  }
+
+  // the held pictures go first
+  OutputHeldPictures(true);
+  return OutputPicture(&m_picture, pts);
+}
+
+void CVideoPlayerVideo::OutputHeldPicture()
+{
+  double pts;
+  const DVDVideoPicture &picture = m_decodeAhead.Front(pts);
+  int iResult = OutputPicture(&picture, pts);
+
+  if (iResult & EOS_ABORT)
+  {
+    m_decodeAhead.Clear();
+    return;
+  }
+
+  if ((iResult & EOS_DROPPED) && !(picture.iFlags & DVP_FLAG_DROPPED))
+  {
+    m_iDroppedFrames++;
+    m_pullupCorrection.Flush();
+  }
+  m_decodeAhead.Pop();
+}
+
+void CVideoPlayerVideo::OutputHeldPictures(bool bWait)
+{
+  while (!m_decodeAhead.IsEmpty() && (bWait || m_renderManager.HasFreeBuffer()))
+    OutputHeldPicture();
+}
+
 int CVideoPlayerVideo::OutputPicture(const DVDVideoPicture* src, double pts)
 {
   m_bAbortOutput = false;
@@ -901,6 +974,17 @@ std::string CVideoPlayerVideo::GetPlayerInfo()
   s << ", fr:"     << std::fixed << std::setprecision(3) << m_fFrameRate;
   s << ", drop:" << m_iDroppedFrames;
   s << ", skip:" << m_renderManager.GetSkippedFrames();
+  s << ", dq:" << m_decodeAhead.Count() << "/" << m_decodeAhead.Size() << " max:" << m_decodeAhead.Peak();
+
+  unsigned int now = XbmcThreads::SystemClockMillis();
+  if (now - m_copiesTime >= 1000)
+  {
+    unsigned int copies = m_renderManager.GetCopiedPictures();
+    m_iCopiesPerSecond = m_copiesTime ? (copies - m_iCopiedPictures) * 1000 / (now - m_copiesTime) : 0;
+    m_iCopiedPictures = copies;
+    m_copiesTime = now;
+  }
+  s << ", cp/s:" << m_iCopiesPerSecond;
 
   int pc = m_pullupCorrection.GetPatternLength();
   if (pc > 0)
@@ -28,6 +28,7 @@
 #include "DVDClock.h"
 #include "DVDOverlayContainer.h"
 #include "DVDTSCorrection.h"
+#include "VideoFramePool.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
 #include "utils/BitstreamStats.h"
 #include <atomic>
@@ -103,6 +104,9 @@ protected:
   bool ProcessDecoderOutput(int &decoderState, double &frametime, double &pts);
 
   int OutputPicture(const DVDVideoPicture* src, double pts);
+  int OutputDecodedPicture(double pts);
+  void OutputHeldPicture();
+  void OutputHeldPictures(bool bWait);
   void ProcessOverlays(DVDVideoPicture* pSource, double pts);
   void OpenStream(CDVDStreamInfo &hint, CDVDVideoCodec* codec);
 
@@ -148,5 +152,11 @@ protected:
   CDroppingStats m_droppingStats;
   CRenderManager& m_renderManager;
   DVDVideoPicture m_picture;
+  CVideoFramePool m_decodeAhead;
+
+  // for the copies per second of GetPlayerInfo()
+  unsigned int m_iCopiedPictures;
+  unsigned int m_copiesTime;
+  int m_iCopiesPerSecond;
 };
 
@@ -36,7 +36,8 @@
 #include "cores/VideoPlayer/VideoRenderers/RenderFlags.h"
 
 
-CBaseRenderer::CBaseRenderer()
+CBaseRenderer::CBaseRenderer() :
+  m_errorInAspect(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT)
 {
   m_sourceFrameRatio = 1.0f;
   m_sourceWidth = 720;
@@ -229,7 +230,7 @@ void CBaseRenderer::CalcNormalRenderRect(float offsetX, float offsetY, float wid
 
   // allow a certain error to maximize size of render area
   float fCorrection = width / height / outputFrameRatio - 1.0f;
-  float fAllowed    = CSettings::GetInstance().GetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT) * 0.01f;
+  float fAllowed    = m_errorInAspect * 0.01f;
   if(fCorrection >   fAllowed) fCorrection =   fAllowed;
   if(fCorrection < - fAllowed) fCorrection = - fAllowed;
 
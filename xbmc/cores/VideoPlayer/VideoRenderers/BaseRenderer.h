@@ -27,6 +27,7 @@
 #include "guilib/Geometry.h"
 #include "RenderFormats.h"
 #include "cores/IPlayer.h"
+#include "settings/SettingRef.h"
 
 #define MAX_PLANES 3
 #define MAX_FIELDS 3
@@ -150,4 +151,7 @@ protected:
   // rendering flags
   unsigned m_iFlags;
   ERenderFormat m_format;
+
+  // read for every frame
+  CSettingRef<int> m_errorInAspect;
 };
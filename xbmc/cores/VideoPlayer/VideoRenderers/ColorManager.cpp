@@ -32,7 +32,14 @@
 
 using namespace XFILE;
 
-CColorManager::CColorManager()
+CColorManager::CColorManager() :
+  m_cmsEnabled("videoscreen.cmsenabled"),
+  m_cmsMode("videoscreen.cmsmode"),
+  m_cmsWhitePoint("videoscreen.cmswhitepoint"),
+  m_cmsPrimaries("videoscreen.cmsprimaries"),
+  m_cmsGammaMode("videoscreen.cmsgammamode"),
+  m_cmsGamma("videoscreen.cmsgamma"),
+  m_cmsLutSize("videoscreen.cmslutsize")
 {
   m_curVideoPrimaries = CMS_PRIMARIES_AUTO;
   m_curClutSize = 0;
@@ -60,7 +67,7 @@ bool CColorManager::IsEnabled()
 {
   //TODO: check that the configuration is valid here (files exist etc)
 
-  return CSettings::GetInstance().GetBool("videoscreen.cmsenabled");
+  return m_cmsEnabled;
 }
 
 CMS_PRIMARIES videoFlagsToPrimaries(int flags)
@@ -171,7 +178,7 @@ bool CColorManager::CheckConfiguration(int cmsToken, int flags)
 {
   if (cmsToken != m_curCmsToken)
     return false;
-  if (m_curCmsMode != CSettings::GetInstance().GetInt("videoscreen.cmsmode"))
+  if (m_curCmsMode != m_cmsMode)
     return false;   // CMS mode has changed
   switch (m_curCmsMode)
   {
@@ -183,19 +190,19 @@ bool CColorManager::CheckConfiguration(int cmsToken, int flags)
 #if defined(HAVE_LCMS2)
     if (m_curIccProfile != CSettings::GetInstance().GetString("videoscreen.displayprofile"))
       return false; // different ICC profile selected
-    if (m_curIccWhitePoint != CSettings::GetInstance().GetInt("videoscreen.cmswhitepoint"))
+    if (m_curIccWhitePoint != m_cmsWhitePoint)
       return false; // whitepoint changed
     {
-      CMS_PRIMARIES primaries = (CMS_PRIMARIES)CSettings::GetInstance().GetInt("videoscreen.cmsprimaries");
+      CMS_PRIMARIES primaries = (CMS_PRIMARIES)m_cmsPrimaries.Get();
       if (primaries == CMS_PRIMARIES_AUTO) primaries = videoFlagsToPrimaries(flags);
       if (m_curIccPrimaries != primaries)
         return false; // primaries changed
     }
-    if (m_m_curIccGammaMode != (CMS_TRC_TYPE)CSettings::GetInstance().GetInt("videoscreen.cmsgammamode"))
+    if (m_m_curIccGammaMode != (CMS_TRC_TYPE)m_cmsGammaMode.Get())
       return false; // gamma mode changed
-    if (m_curIccGamma != CSettings::GetInstance().GetInt("videoscreen.cmsgamma"))
+    if (m_curIccGamma != m_cmsGamma)
       return false; // effective gamma changed
-    if (m_curClutSize != 1 << CSettings::GetInstance().GetInt("videoscreen.cmslutsize"))
+    if (m_curClutSize != 1 << m_cmsLutSize)
       return false; // CLUT size changed
     // TODO: check other parameters
 #else   //defined(HAVE_LCMS2)
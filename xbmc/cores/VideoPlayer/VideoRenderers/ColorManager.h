@@ -26,6 +26,8 @@
 
 #include <string>
 
+#include "settings/SettingRef.h"
+
 enum CMS_MODE
 {
   CMS_MODE_3DLUT,
@@ -160,6 +162,14 @@ private:
   std::string m_cur3dlutFile;
   std::string m_curIccProfile;
 
+  // checked by the renderers for every frame
+  CSettingRef<bool> m_cmsEnabled;
+  CSettingRef<int> m_cmsMode;
+  CSettingRef<int> m_cmsWhitePoint;
+  CSettingRef<int> m_cmsPrimaries;
+  CSettingRef<int> m_cmsGammaMode;
+  CSettingRef<int> m_cmsGamma;
+  CSettingRef<int> m_cmsLutSize;
 };
 
 
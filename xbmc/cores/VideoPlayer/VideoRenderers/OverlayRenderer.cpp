@@ -61,7 +61,12 @@ COverlay::~COverlay()
 
 unsigned int CRenderer::m_textureid = 1;
 
-CRenderer::CRenderer()
+CRenderer::CRenderer() :
+  m_subtitleAlign(CSettings::SETTING_SUBTITLES_ALIGN),
+  m_subtitleColor(CSettings::SETTING_SUBTITLES_COLOR),
+  m_subtitleHeight(CSettings::SETTING_SUBTITLES_HEIGHT),
+  m_subtitleStyle(CSettings::SETTING_SUBTITLES_STYLE),
+  m_subtitleStereoscopicDepth(CSettings::SETTING_SUBTITLES_STEREOSCOPICDEPTH)
 {
   m_font = "__subtitle__";
   m_fontBorder = "__subtitleborder__";
@@ -172,7 +177,7 @@ void CRenderer::Render(int idx)
 
   float total_height = 0.0f;
   float cur_height = 0.0f;
-  int subalign = CSettings::GetInstance().GetInt(CSettings::SETTING_SUBTITLES_ALIGN);
+  int subalign = m_subtitleAlign;
   for (std::vector<COverlay*>::iterator it = render.begin(); it != render.end(); ++it)
   {
     COverlay* o = nullptr;
@@ -180,9 +185,9 @@ void CRenderer::Render(int idx)
     if (text)
     {
       text->PrepareRender(CSettings::GetInstance().GetString(CSettings::SETTING_SUBTITLES_FONT),
-                          CSettings::GetInstance().GetInt(CSettings::SETTING_SUBTITLES_COLOR),
-                          CSettings::GetInstance().GetInt(CSettings::SETTING_SUBTITLES_HEIGHT),
-                          CSettings::GetInstance().GetInt(CSettings::SETTING_SUBTITLES_STYLE),
+                          m_subtitleColor,
+                          m_subtitleHeight,
+                          m_subtitleStyle,
                           m_font, m_fontBorder);
       o = text;
     }
@@ -292,7 +297,7 @@ void CRenderer::Render(COverlay* o, float adjust_height)
 
   }
 
-  state.x += GetStereoscopicDepth();
+  state.x += GetStereoscopicDepth(m_subtitleStereoscopicDepth);
   state.y += adjust_height;
 
   o->Render(state);
@@ -334,7 +339,7 @@ COverlay* CRenderer::Convert(CDVDOverlaySSA* o, double pts)
   int targetHeight = MathUtils::round_int(m_rv.Height());
   int useMargin;
 
-  int subalign = CSettings::GetInstance().GetInt(CSettings::SETTING_SUBTITLES_ALIGN);
+  int subalign = m_subtitleAlign;
   if(subalign == SUBTITLE_ALIGN_BOTTOM_OUTSIDE
   || subalign == SUBTITLE_ALIGN_TOP_OUTSIDE
   ||(subalign == SUBTITLE_ALIGN_MANUAL && g_advancedSettings.m_videoAssFixedWorks))
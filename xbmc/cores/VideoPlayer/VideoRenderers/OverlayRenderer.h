@@ -22,6 +22,7 @@
 #pragma once
 
 #include "threads/CriticalSection.h"
+#include "settings/SettingRef.h"
 #include "BaseRenderer.h"
 
 #include <vector>
@@ -115,5 +116,12 @@ namespace OVERLAY {
     static unsigned int m_textureid;
     CRect m_rv, m_rs, m_rd;
     std::string m_font, m_fontBorder;
+
+    // read for every frame with subtitles
+    CSettingRef<int> m_subtitleAlign;
+    CSettingRef<int> m_subtitleColor;
+    CSettingRef<int> m_subtitleHeight;
+    CSettingRef<int> m_subtitleStyle;
+    CSettingRef<int> m_subtitleStereoscopicDepth;
   };
 }
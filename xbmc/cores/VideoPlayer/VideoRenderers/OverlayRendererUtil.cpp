@@ -25,7 +25,6 @@
 #include "cores/VideoPlayer/DVDCodecs/Overlay/DVDOverlaySSA.h"
 #include "windowing/WindowingFactory.h"
 #include "guilib/GraphicContext.h"
-#include "settings/Settings.h"
 
 namespace OVERLAY {
 
@@ -296,18 +295,13 @@ bool convert_quad(ASS_Image* images, SQuads& quads)
   return true;
 }
 
-int GetStereoscopicDepth()
+int GetStereoscopicDepth(int depth)
 {
-  int depth = 0;
-
   if(g_graphicsContext.GetStereoMode() != RENDER_STEREO_MODE_MONO
   && g_graphicsContext.GetStereoMode() != RENDER_STEREO_MODE_OFF)
-  {
-    depth  = CSettings::GetInstance().GetInt(CSettings::SETTING_SUBTITLES_STEREOSCOPICDEPTH);
-    depth *= (g_graphicsContext.GetStereoView() == RENDER_STEREO_VIEW_LEFT ? 1 : -1);
-  }
+    return depth * (g_graphicsContext.GetStereoView() == RENDER_STEREO_VIEW_LEFT ? 1 : -1);
 
-  return depth;
+  return 0;
 }
 
 }
@@ -64,6 +64,6 @@ namespace OVERLAY {
                        , int& min_x, int& max_x
                        , int& min_y, int& max_y);
   bool      convert_quad(ASS_Image* images, SQuads& quads);
-  int       GetStereoscopicDepth();
+  int       GetStereoscopicDepth(int depth);
 
 }
@@ -139,6 +139,7 @@ CRenderManager::CRenderManager(CDVDClock &clock, IRenderMsg *player) :
   m_videoDelay(0),
   m_QueueSize(2),
   m_QueueSkip(0),
+  m_adjustRefreshRate(CSettings::SETTING_VIDEOPLAYER_ADJUSTREFRESHRATE),
   m_format(RENDER_FMT_NONE),
   m_width(0),
   m_height(0),
@@ -148,6 +149,7 @@ CRenderManager::CRenderManager(CDVDClock &clock, IRenderMsg *player) :
   m_extended_format(0),
   m_orientation(0),
   m_NumberBuffers(0),
+  m_copiedPictures(0),
   m_lateframes(-1),
   m_presentpts(0.0),
   m_presentstep(PRESENT_IDLE),
@@ -882,7 +884,7 @@ RESOLUTION CRenderManager::GetResolution()
   if (m_renderState == STATE_UNCONFIGURED)
     return res;
 
-  if (CSettings::GetInstance().GetInt(CSettings::SETTING_VIDEOPLAYER_ADJUSTREFRESHRATE) != ADJUST_REFRESHRATE_OFF)
+  if (m_adjustRefreshRate != ADJUST_REFRESHRATE_OFF)
     res = CResolutionUtils::ChooseBestResolution(m_fps, m_width, CONF_FLAGS_STEREO_MODE_MASK(m_flags));
 
   return res;
@@ -1077,7 +1079,7 @@ void CRenderManager::UpdateResolution()
   {
     if (g_graphicsContext.IsFullScreenVideo() && g_graphicsContext.IsFullScreenRoot())
     {
-      if (CSettings::GetInstance().GetInt(CSettings::SETTING_VIDEOPLAYER_ADJUSTREFRESHRATE) != ADJUST_REFRESHRATE_OFF && m_fps > 0.0f)
+      if (m_adjustRefreshRate != ADJUST_REFRESHRATE_OFF && m_fps > 0.0f)
       {
         RESOLUTION res = CResolutionUtils::ChooseBestResolution(m_fps, m_width, CONF_FLAGS_STEREO_MODE_MASK(m_flags));
         g_graphicsContext.SetVideoResolution(res);
@@ -1157,15 +1159,18 @@ int CRenderManager::AddVideoPicture(DVDVideoPicture& pic)
        || pic.format == RENDER_FMT_YUV420P16)
   {
     CDVDCodecUtils::CopyPicture(&image, &pic);
+    m_copiedPictures++;
   }
   else if(pic.format == RENDER_FMT_NV12)
   {
     CDVDCodecUtils::CopyNV12Picture(&image, &pic);
+    m_copiedPictures++;
   }
   else if(pic.format == RENDER_FMT_YUYV422
        || pic.format == RENDER_FMT_UYVY422)
   {
     CDVDCodecUtils::CopyYUV422PackedPicture(&image, &pic);
+    m_copiedPictures++;
   }
 
   m_pRenderer->ReleaseImage(index, false);
@@ -1358,6 +1363,12 @@ void CRenderManager::DiscardBuffer()
   m_presentevent.notifyAll();
 }
 
+bool CRenderManager::HasFreeBuffer()
+{
+  CSingleLock lock(m_presentlock);
+  return !m_free.empty();
+}
+
 bool CRenderManager::GetStats(int &lateframes, double &pts, int &queued, int &discard)
 {
   CSingleLock lock(m_presentlock);
@@ -20,6 +20,7 @@
  *
  */
 
+#include <atomic>
 #include <list>
 
 #include "cores/VideoPlayer/VideoRenderers/BaseRenderer.h"
@@ -27,6 +28,7 @@
 #include "guilib/Geometry.h"
 #include "guilib/Resolution.h"
 #include "threads/CriticalSection.h"
+#include "settings/SettingRef.h"
 #include "settings/VideoSettings.h"
 #include "OverlayRenderer.h"
 #include "DebugRenderer.h"
@@ -142,6 +144,16 @@ public:
    */
   int WaitForBuffer(volatile std::atomic_bool& bStop, int timeout = 100);
 
+  /**
+   * Returns true if AddVideoPicture can be called without waiting for a buffer.
+   */
+  bool HasFreeBuffer();
+
+  /**
+   * Number of pictures copied into render buffers, hardware pictures aren't copied.
+   */
+  unsigned int GetCopiedPictures() const { return m_copiedPictures; }
+
   /**
    * Can be called by player for lateness detection. This is done best by
    * looking at the end of the queue.
@@ -220,6 +232,8 @@ protected:
   int m_QueueSize;
   int m_QueueSkip;
 
+  CSettingRef<int> m_adjustRefreshRate;
+
   struct SPresent
   {
     double         pts;
@@ -238,6 +252,7 @@ protected:
   unsigned int m_extended_format;
   unsigned int m_orientation;
   int m_NumberBuffers;
+  std::atomic<unsigned int> m_copiedPictures;
 
   int m_lateframes;
   double m_presentpts;
@@ -0,0 +1,33 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/VideoPlayer/DVDFileInfo.h"
+
+#include "gtest/gtest.h"
+
+TEST(TestDVDFileInfo, GetThumbLowres)
+{
+  EXPECT_EQ(0, CDVDFileInfo::GetThumbLowres(720, 720));
+  EXPECT_EQ(0, CDVDFileInfo::GetThumbLowres(1280, 720));
+  EXPECT_EQ(1, CDVDFileInfo::GetThumbLowres(1920, 720));
+  EXPECT_EQ(2, CDVDFileInfo::GetThumbLowres(3840, 720));
+  EXPECT_EQ(3, CDVDFileInfo::GetThumbLowres(7680, 320));
+  EXPECT_EQ(0, CDVDFileInfo::GetThumbLowres(0, 720));
+}
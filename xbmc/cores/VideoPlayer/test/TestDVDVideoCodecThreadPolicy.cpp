@@ -0,0 +1,90 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cores/VideoPlayer/DVDCodecs/Video/DVDVideoCodecThreadPolicy.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+const int BOTH = CODEC_CAP_FRAME_THREADS | CODEC_CAP_SLICE_THREADS;
+
+CDVDVideoCodecThreadPolicy::SThreading Choose(AVCodecID codec, int capabilities, int width, int height,
+                                              bool realtime, int cpus, bool powerSaving = false)
+{
+  CDVDVideoCodecThreadPolicy::SStream stream = { codec, capabilities, width, height, realtime };
+  CDVDVideoCodecThreadPolicy::SSystem system = { cpus, powerSaving };
+  return CDVDVideoCodecThreadPolicy::Choose(stream, system);
+}
+}
+
+TEST(TestDVDVideoCodecThreadPolicy, FileUsesFrameThreads)
+{
+  CDVDVideoCodecThreadPolicy::SThreading threading = Choose(AV_CODEC_ID_H264, BOTH, 1920, 1080, false, 4);
+  EXPECT_EQ(FF_THREAD_FRAME, threading.type);
+  EXPECT_EQ(6, threading.count);
+
+  // as many as there are, but not too many
+  EXPECT_EQ(16, Choose(AV_CODEC_ID_HEVC, BOTH, 3840, 2160, false, 32).count);
+}
+
+TEST(TestDVDVideoCodecThreadPolicy, SmallPicturesUseFewerThreads)
+{
+  EXPECT_EQ(4, Choose(AV_CODEC_ID_H264, BOTH, 720, 576, false, 8).count);
+  EXPECT_EQ(12, Choose(AV_CODEC_ID_H264, BOTH, 1280, 720, false, 8).count);
+
+  // unknown sizes are treated as large ones
+  EXPECT_EQ(12, Choose(AV_CODEC_ID_H264, BOTH, 0, 0, false, 8).count);
+}
+
+TEST(TestDVDVideoCodecThreadPolicy, RealtimeAvoidsDelay)
+{
+  // slices are rows, so slice threads don't delay
+  CDVDVideoCodecThreadPolicy::SThreading threading = Choose(AV_CODEC_ID_MPEG2VIDEO, BOTH, 1920, 1080, true, 4);
+  EXPECT_EQ(FF_THREAD_SLICE, threading.type);
+  EXPECT_EQ(6, threading.count);
+
+  // no extra frame threads
+  threading = Choose(AV_CODEC_ID_H264, BOTH, 1920, 1080, true, 4);
+  EXPECT_EQ(FF_THREAD_FRAME, threading.type);
+  EXPECT_EQ(4, threading.count);
+
+  // the same stream from a file
+  EXPECT_EQ(FF_THREAD_FRAME, Choose(AV_CODEC_ID_MPEG2VIDEO, BOTH, 1920, 1080, false, 4).type);
+}
+
+TEST(TestDVDVideoCodecThreadPolicy, Capabilities)
+{
+  CDVDVideoCodecThreadPolicy::SThreading threading = Choose(AV_CODEC_ID_VC1, CODEC_CAP_SLICE_THREADS, 1920, 1080, false, 4);
+  EXPECT_EQ(FF_THREAD_SLICE, threading.type);
+
+  threading = Choose(AV_CODEC_ID_MJPEG, 0, 1920, 1080, false, 4);
+  EXPECT_EQ(0, threading.type);
+  EXPECT_EQ(1, threading.count);
+
+  threading = Choose(AV_CODEC_ID_H264, BOTH, 1920, 1080, false, 1);
+  EXPECT_EQ(1, threading.count);
+}
+
+TEST(TestDVDVideoCodecThreadPolicy, PowerSavingHalvesThreads)
+{
+  EXPECT_EQ(6, Choose(AV_CODEC_ID_H264, BOTH, 1920, 1080, false, 8, true).count);
+  EXPECT_EQ(2, Choose(AV_CODEC_ID_H264, BOTH, 1920, 1080, false, 2, true).count);
+}
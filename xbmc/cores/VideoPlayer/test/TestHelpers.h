@@ -0,0 +1,57 @@
+#pragma once
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+extern "C" {
+#include "libavutil/imgutils.h"
+#include "libavutil/mem.h"
+}
+
+/*!
+ * A picture in buffers of its own, for scaling.
+ */
+class CImage
+{
+public:
+  CImage(int width, int height, AVPixelFormat format) : m_size(0)
+  {
+    m_size = av_image_alloc(m_data, m_linesize, width, height, format, 32);
+  }
+
+  ~CImage() { av_freep(&m_data[0]); }
+
+  // not a picture of anything, but with a different value in every byte of a row
+  void Fill()
+  {
+    for (int i = 0; i < m_size; ++i)
+      m_data[0][i] = (uint8_t)(i * 7 + (i >> 11));
+  }
+
+  bool IsValid() const { return m_size > 0; }
+  int Size() const { return m_size; }
+  uint8_t *const *Data() { return m_data; }
+  const uint8_t *const *ConstData() const { return m_data; }
+  const int *Linesize() const { return m_linesize; }
+
+private:
+  uint8_t *m_data[4];
+  int m_linesize[4];
+  int m_size;
+};
@@ -0,0 +1,136 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "cores/VideoPlayer/SwScaler.h"
+#include "cores/VideoPlayer/test/TestHelpers.h"
+
+extern "C" {
+#include "libswscale/swscale.h"
+}
+
+#include "gtest/gtest.h"
+
+namespace
+{
+bool Scale(const CImage &src, int srcWidth, int srcHeight, AVPixelFormat srcFormat,
+           CImage &dst, int dstWidth, int dstHeight, AVPixelFormat dstFormat, int flags, int threads)
+{
+  CSwScaler scaler;
+  if (!scaler.Configure(srcWidth, srcHeight, srcFormat, dstWidth, dstHeight, dstFormat, flags, threads))
+    return false;
+  return scaler.Scale(src.ConstData(), src.Linesize(), dst.Data(), dst.Linesize()) == dstHeight;
+}
+
+int MaxDifference(const CImage &a, const CImage &b)
+{
+  int difference = 0;
+  for (int i = 0; i < a.Size(); ++i)
+    difference = std::max(difference, std::abs(a.ConstData()[0][i] - b.ConstData()[0][i]));
+  return difference;
+}
+}
+
+TEST(TestSwScaler, ConvertedBandsMatchWholePicture)
+{
+  CImage src(1920, 1080, AV_PIX_FMT_YUV420P);
+  CImage single(1920, 1080, AV_PIX_FMT_BGRA);
+  CImage banded(1920, 1080, AV_PIX_FMT_BGRA);
+  ASSERT_TRUE(src.IsValid() && single.IsValid() && banded.IsValid());
+  src.Fill();
+
+  ASSERT_TRUE(Scale(src, 1920, 1080, AV_PIX_FMT_YUV420P, single, 1920, 1080, AV_PIX_FMT_BGRA, SWS_BILINEAR, 1));
+  ASSERT_TRUE(Scale(src, 1920, 1080, AV_PIX_FMT_YUV420P, banded, 1920, 1080, AV_PIX_FMT_BGRA, SWS_BILINEAR, 4));
+  EXPECT_EQ(0, memcmp(single.Data()[0], banded.Data()[0], single.Size()));
+}
+
+TEST(TestSwScaler, HorizontallyScaledBandsMatchWholePicture)
+{
+  CImage src(3840, 2160, AV_PIX_FMT_BGRA);
+  CImage single(1920, 2160, AV_PIX_FMT_BGRA);
+  CImage banded(1920, 2160, AV_PIX_FMT_BGRA);
+  ASSERT_TRUE(src.IsValid() && single.IsValid() && banded.IsValid());
+  src.Fill();
+
+  ASSERT_TRUE(Scale(src, 3840, 2160, AV_PIX_FMT_BGRA, single, 1920, 2160, AV_PIX_FMT_BGRA, SWS_BILINEAR, 1));
+  ASSERT_TRUE(Scale(src, 3840, 2160, AV_PIX_FMT_BGRA, banded, 1920, 2160, AV_PIX_FMT_BGRA, SWS_BILINEAR, 8));
+  EXPECT_EQ(0, memcmp(single.Data()[0], banded.Data()[0], single.Size()));
+}
+
+TEST(TestSwScaler, VerticallyScaledBandsMatchWholePicture)
+{
+  CImage src(3840, 2160, AV_PIX_FMT_YUV420P);
+  CImage single(320, 180, AV_PIX_FMT_BGRA);
+  CImage banded(320, 180, AV_PIX_FMT_BGRA);
+  ASSERT_TRUE(src.IsValid() && single.IsValid() && banded.IsValid());
+  src.Fill();
+
+  // the filters of the bands are set up for pictures of their own, the
+  // coefficients may round differently
+  ASSERT_TRUE(Scale(src, 3840, 2160, AV_PIX_FMT_YUV420P, single, 320, 180, AV_PIX_FMT_BGRA, SWS_BICUBIC, 1));
+  ASSERT_TRUE(Scale(src, 3840, 2160, AV_PIX_FMT_YUV420P, banded, 320, 180, AV_PIX_FMT_BGRA, SWS_BICUBIC, 4));
+  EXPECT_LE(MaxDifference(single, banded), 2);
+
+  CImage upSingle(3840, 2160, AV_PIX_FMT_BGRA);
+  CImage upBanded(3840, 2160, AV_PIX_FMT_BGRA);
+  ASSERT_TRUE(upSingle.IsValid() && upBanded.IsValid());
+  ASSERT_TRUE(Scale(src, 1920, 1080, AV_PIX_FMT_YUV420P, upSingle, 3840, 2160, AV_PIX_FMT_BGRA, SWS_LANCZOS, 1));
+  ASSERT_TRUE(Scale(src, 1920, 1080, AV_PIX_FMT_YUV420P, upBanded, 3840, 2160, AV_PIX_FMT_BGRA, SWS_LANCZOS, 8));
+  EXPECT_LE(MaxDifference(upSingle, upBanded), 2);
+}
+
+TEST(TestSwScaler, Bands)
+{
+  CSwScaler scaler;
+
+  // small pictures on this thread only
+  ASSERT_TRUE(scaler.Configure(640, 360, AV_PIX_FMT_YUV420P, 640, 360, AV_PIX_FMT_BGRA, SWS_BILINEAR));
+  EXPECT_EQ(1, scaler.Bands());
+
+  // no band smaller than 64 rows
+  ASSERT_TRUE(scaler.Configure(1920, 128, AV_PIX_FMT_YUV420P, 1920, 128, AV_PIX_FMT_BGRA, SWS_BILINEAR, 8));
+  EXPECT_EQ(2, scaler.Bands());
+
+  // scaled vertically, every other source row maps onto an output row
+  ASSERT_TRUE(scaler.Configure(3840, 2160, AV_PIX_FMT_YUV420P, 1920, 1080, AV_PIX_FMT_BGRA, SWS_BILINEAR, 8));
+  EXPECT_EQ(8, scaler.Bands());
+
+  // a thumbnail, the bands take twice as many rows as they share
+  ASSERT_TRUE(scaler.Configure(3840, 2160, AV_PIX_FMT_YUV420P, 320, 180, AV_PIX_FMT_BGRA, SWS_BICUBIC, 16));
+  EXPECT_EQ(15, scaler.Bands());
+
+  // no source row but the first maps onto an output row
+  ASSERT_TRUE(scaler.Configure(1920, 1080, AV_PIX_FMT_YUV420P, 1280, 719, AV_PIX_FMT_BGRA, SWS_BILINEAR, 8));
+  EXPECT_EQ(1, scaler.Bands());
+
+  // the filter reaches too far
+  ASSERT_TRUE(scaler.Configure(3840, 2160, AV_PIX_FMT_YUV420P, 1920, 1080, AV_PIX_FMT_BGRA, SWS_SPLINE, 8));
+  EXPECT_EQ(1, scaler.Bands());
+
+  // the palette can't be split
+  ASSERT_TRUE(scaler.Configure(1920, 1080, AV_PIX_FMT_PAL8, 1920, 1080, AV_PIX_FMT_BGRA, SWS_BILINEAR, 8));
+  EXPECT_EQ(1, scaler.Bands());
+
+  EXPECT_FALSE(scaler.Configure(0, 1080, AV_PIX_FMT_YUV420P, 1920, 1080, AV_PIX_FMT_BGRA, SWS_BILINEAR));
+  EXPECT_EQ(0, scaler.Bands());
+}
@@ -0,0 +1,166 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstring>
+#include <memory>
+
+#include "cores/VideoPlayer/VideoFramePool.h"
+
+extern "C" {
+#include "libavutil/buffer.h"
+}
+
+#include "gtest/gtest.h"
+
+namespace
+{
+/*!
+ * Returns every picture in a frame of its own, like the FFmpeg decoder with
+ * reference counted frames does.
+ */
+class CTestCodec : public CDVDVideoCodec
+{
+public:
+  CTestCodec(CProcessInfo &processInfo, bool bCanHold) :
+    CDVDVideoCodec(processInfo),
+    m_bCanHold(bCanHold),
+    m_frame(av_frame_alloc())
+  {
+  }
+
+  virtual ~CTestCodec() { av_frame_free(&m_frame); }
+
+  virtual bool Open(CDVDStreamInfo &hints, CDVDCodecOptions &options) override { return true; }
+  virtual int Decode(uint8_t* pData, int iSize, double dts, double pts) override { return VC_BUFFER; }
+  virtual void Reset() override {}
+  virtual void SetDropState(bool bDrop) override {}
+  virtual const char* GetName() override { return "test"; }
+
+  virtual bool GetPicture(DVDVideoPicture* pDvdVideoPicture) override
+  {
+    memset(pDvdVideoPicture, 0, sizeof(DVDVideoPicture));
+    for (int i = 0; i < 4; i++)
+    {
+      pDvdVideoPicture->data[i] = m_frame->data[i];
+      pDvdVideoPicture->iLineSize[i] = m_frame->linesize[i];
+    }
+    pDvdVideoPicture->iWidth = m_frame->width;
+    pDvdVideoPicture->iHeight = m_frame->height;
+    pDvdVideoPicture->format = RENDER_FMT_YUV420P;
+    return true;
+  }
+
+  virtual bool HoldPicture(DVDVideoPicture* pDvdVideoPicture, AVFrame* frame) override
+  {
+    if (!m_bCanHold || av_frame_ref(frame, m_frame) < 0)
+      return false;
+    for (int i = 0; i < 4; i++)
+      pDvdVideoPicture->data[i] = frame->data[i];
+    return true;
+  }
+
+  // decodes a picture filled with value, the previous one is released
+  DVDVideoPicture DecodePicture(uint8_t value)
+  {
+    av_frame_unref(m_frame);
+    m_frame->format = AV_PIX_FMT_YUV420P;
+    m_frame->width = 64;
+    m_frame->height = 36;
+    EXPECT_EQ(0, av_frame_get_buffer(m_frame, 32));
+    memset(m_frame->data[0], value, m_frame->linesize[0] * m_frame->height);
+
+    DVDVideoPicture picture;
+    GetPicture(&picture);
+    return picture;
+  }
+
+  int References() const { return av_buffer_get_ref_count(m_frame->buf[0]); }
+
+private:
+  bool m_bCanHold;
+  AVFrame *m_frame;
+};
+}
+
+TEST(TestVideoFramePool, HoldsPicturesInOrder)
+{
+  std::unique_ptr<CProcessInfo> processInfo(CProcessInfo::CreateInstance());
+  CTestCodec codec(*processInfo, true);
+  CVideoFramePool pool;
+  pool.SetSize(3);
+
+  for (int i = 1; i <= 3; i++)
+    EXPECT_TRUE(pool.Push(codec, codec.DecodePicture(i), i * 1000.0));
+  EXPECT_TRUE(pool.IsFull());
+  EXPECT_FALSE(pool.Push(codec, codec.DecodePicture(4), 4000.0));
+  EXPECT_EQ(3u, pool.Peak());
+
+  // the data outlives the decoder moving on
+  for (int i = 1; i <= 3; i++)
+  {
+    double pts;
+    const DVDVideoPicture &picture = pool.Front(pts);
+    EXPECT_EQ(i * 1000.0, pts);
+    EXPECT_EQ(i, picture.data[0][0]);
+    EXPECT_EQ(i, picture.data[0][picture.iLineSize[0] * 35 + 63]);
+    pool.Pop();
+  }
+  EXPECT_TRUE(pool.IsEmpty());
+
+  // the frames are reused once the first ones were released
+  EXPECT_TRUE(pool.Push(codec, codec.DecodePicture(5), 5000.0));
+  EXPECT_EQ(1u, pool.Count());
+}
+
+TEST(TestVideoFramePool, ReleasesHeldPictures)
+{
+  std::unique_ptr<CProcessInfo> processInfo(CProcessInfo::CreateInstance());
+  CTestCodec codec(*processInfo, true);
+  CVideoFramePool pool;
+  pool.SetSize(2);
+
+  ASSERT_TRUE(pool.Push(codec, codec.DecodePicture(1), 0.0));
+  EXPECT_EQ(2, codec.References());
+
+  pool.Clear();
+  EXPECT_EQ(1, codec.References());
+  EXPECT_EQ(0u, pool.Count());
+
+  ASSERT_TRUE(pool.Push(codec, codec.DecodePicture(2), 0.0));
+  pool.SetSize(4);
+  EXPECT_EQ(1, codec.References());
+  EXPECT_EQ(4u, pool.Size());
+}
+
+TEST(TestVideoFramePool, DoesNotHoldWithoutFrames)
+{
+  std::unique_ptr<CProcessInfo> processInfo(CProcessInfo::CreateInstance());
+  CTestCodec codec(*processInfo, false);
+  CVideoFramePool pool;
+
+  // disabled
+  CTestCodec holding(*processInfo, true);
+  EXPECT_FALSE(pool.Push(holding, holding.DecodePicture(1), 0.0));
+
+  // pictures the codec can't keep, like hardware or post processed ones
+  pool.SetSize(2);
+  EXPECT_FALSE(pool.Push(codec, codec.DecodePicture(1), 0.0));
+  EXPECT_TRUE(pool.IsEmpty());
+}
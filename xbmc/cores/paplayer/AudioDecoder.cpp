@@ -43,6 +43,7 @@ CAudioDecoder::CAudioDecoder()
   memset(&m_inputBuffer, 0, INPUT_SAMPLES * sizeof(float));
 
   m_rawBufferSize = 0;
+  m_queueSize = 0;
 }
 
 CAudioDecoder::~CAudioDecoder()
@@ -64,7 +65,7 @@ void CAudioDecoder::Destroy()
   m_canPlay = false;
 }
 
-bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
+bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset, unsigned int prefetchSize)
 {
   Destroy();
 
@@ -100,8 +101,18 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
     return false;
   }
 
-  /* allocate the pcmBuffer for 2 seconds of audio */
-  m_pcmBuffer.Create(2 * blockSize * m_codec->m_format.m_sampleRate);
+  /* allocate the pcmBuffer for 2 seconds of audio, or up to prefetchSize if
+     we are asked to decode ahead, but not more than the whole file */
+  unsigned int bufferSize = 2 * blockSize * m_codec->m_format.m_sampleRate;
+  m_queueSize = (unsigned int)(bufferSize * 0.9);
+  if (prefetchSize > bufferSize)
+  {
+    uint64_t fileSize = (uint64_t)blockSize * m_codec->m_format.m_sampleRate * m_codec->m_TotalTime / 1000;
+    if (fileSize > bufferSize)
+      bufferSize = (unsigned int)std::min<uint64_t>(fileSize, prefetchSize);
+    bufferSize -= bufferSize % blockSize;
+  }
+  m_pcmBuffer.Create(bufferSize);
 
   if (file.HasMusicInfoTag())
   {
@@ -265,7 +276,7 @@ int CAudioDecoder::ReadSamples(int numsamples)
         m_pcmBuffer.WriteData((char *)m_pcmInputBuffer, readSize);
 
         // update status
-        if (m_status == STATUS_QUEUING && m_pcmBuffer.getMaxReadSize() > m_pcmBuffer.getSize() * 0.9)
+        if (m_status == STATUS_QUEUING && m_pcmBuffer.getMaxReadSize() > m_queueSize)
         {
           CLog::Log(LOGINFO, "AudioDecoder: File is queued");
           m_status = STATUS_QUEUED;
@@ -55,7 +55,14 @@ public:
   CAudioDecoder();
   ~CAudioDecoder();
 
-  bool Create(const CFileItem &file, int64_t seekOffset);
+  /*! \brief Open the file and allocate the pcm buffer
+   \param file the item to decode
+   \param seekOffset position in ms to start decoding at
+   \param prefetchSize bytes the pcm buffer may use to decode ahead, 0 for the
+          regular two seconds. The buffer never exceeds this size beyond the
+          regular two seconds nor the decoded size of the file.
+   */
+  bool Create(const CFileItem &file, int64_t seekOffset, unsigned int prefetchSize = 0);
   void Destroy();
 
   int ReadSamples(int numsamples);
@@ -66,6 +73,8 @@ public:
   void SetTotalTime(int64_t time);
   void Start() { m_canPlay = true;}; // cause a pre-buffered stream to start.
   int GetStatus() { return m_status; };
+  unsigned int GetBufferSize() { return m_pcmBuffer.getSize(); }
+  unsigned int GetBufferedSize() { return m_pcmBuffer.getMaxReadSize(); }
   void SetStatus(int status) { m_status = status; }
 
   AEAudioFormat GetFormat();
@@ -91,6 +100,9 @@ private:
   uint8_t *m_rawBuffer;
   int m_rawBufferSize;
 
+  // amount of decoded data after which the file is considered queued
+  unsigned int m_queueSize;
+
   // status
   bool m_eof;
   int m_status;
@@ -25,6 +25,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "music/tags/MusicInfoTag.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 #include "utils/JobManager.h"
 
@@ -35,6 +36,7 @@
 #include "cores/VideoPlayer/Process/ProcessInfo.h"
 
 #define TIME_TO_CACHE_NEXT_FILE 5000 /* 5 seconds before end of song, start caching the next song */
+#define TIME_TO_PREFETCH_NEXT_FILE 3000 /* after 3 seconds of stable playback, prefetch the next song */
 #define FAST_XFADE_TIME           80 /* 80 milliseconds */
 #define MAX_SKIP_XFADE_TIME     2000 /* max 2 seconds crossfade on track skip */
 
@@ -53,6 +55,21 @@ public:
   }
 };
 
+class CPrefetchNextFileJob : public CJob
+{
+  CFileItem m_item;
+  PAPlayer &m_player;
+
+public:
+                CPrefetchNextFileJob(const CFileItem& item, PAPlayer &player)
+                  : m_item(item), m_player(player) {}
+  virtual       ~CPrefetchNextFileJob() {}
+  virtual bool  DoWork()
+  {
+    return m_player.PrefetchNextFileEx(m_item);
+  }
+};
+
 // PAP: Psycho-acoustic Audio Player
 // Supporting all open  audio codec standards.
 // First one being nullsoft's nsv audio decoder format
@@ -70,10 +87,13 @@ PAPlayer::PAPlayer(IPlayerCallback& callback) :
   m_currentStream      (NULL ),
   m_audioCallback      (NULL ),
   m_FileItem           (new CFileItem()),
+  m_prefetchStream     (NULL ),
   m_jobCounter         (0),
   m_continueStream     (false),
   m_newForcedPlayerTime(-1),
-  m_newForcedTotalTime (-1)
+  m_newForcedTotalTime (-1),
+  m_trackEnded         (false),
+  m_trackEndTime       (0)
 {
   memset(&m_playerGUIData, 0, sizeof(m_playerGUIData));
   m_processInfo.reset(CProcessInfo::CreateInstance());
@@ -198,6 +218,8 @@ void PAPlayer::SoftStop(bool wait/* = false */, bool close/* = true */)
 
 void PAPlayer::CloseAllStreams(bool fade/* = true */)
 {
+  DiscardPrefetchedStream();
+
   if (!fade) 
   {
     CSingleLock lock(m_streamsLock);
@@ -266,6 +288,7 @@ bool PAPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options)
   }
 
   CSingleLock lock(m_streamsLock);
+  m_trackEnded = false;
   if (m_streams.size() == 2)
   {
     //do a short crossfade on trackskip, set to max 2 seconds for these prev/next transitions
@@ -323,6 +346,94 @@ bool PAPlayer::QueueNextFile(const CFileItem &file)
   return true;
 }
 
+void PAPlayer::PrefetchNextFile(const CFileItem &file)
+{
+  // cue sheet tracks continue the current stream and audio cds don't like to
+  // be read ahead, only prefetch plain files
+  if (!g_advancedSettings.m_audioPrefetchNextFile || file.m_lStartOffset || file.m_lEndOffset || file.IsCDDA())
+    return;
+
+  {
+    CSingleLock lock(m_streamsLock);
+    m_jobCounter++;
+  }
+  CJobManager::GetInstance().AddJob(new CPrefetchNextFileJob(file, *this), this, CJob::PRIORITY_NORMAL);
+}
+
+bool PAPlayer::PrefetchNextFileEx(const CFileItem &file)
+{
+  {
+    CSingleLock lock(m_streamsLock);
+    // already queued for real or already prefetched
+    if (file.GetPath() == m_FileItem->GetPath() || file.GetPath() == m_prefetchPath)
+      return true;
+  }
+
+  StreamInfo *si = new StreamInfo();
+  if (!si->m_decoder.Create(file, 0, g_advancedSettings.m_audioPrefetchBufferSize * 1024))
+  {
+    CLog::Log(LOGDEBUG, "PAPlayer::PrefetchNextFileEx - Failed to create the decoder");
+    delete si;
+    return false;
+  }
+
+  CSingleLock lock(m_streamsLock);
+  // the file may have been queued while we were opening it
+  if (file.GetPath() == m_FileItem->GetPath())
+  {
+    si->m_decoder.Destroy();
+    delete si;
+    return true;
+  }
+
+  DiscardPrefetchedStream();
+  m_prefetchStream = si;
+  m_prefetchPath = file.GetPath();
+  return true;
+}
+
+PAPlayer::StreamInfo* PAPlayer::TakePrefetchedStream(const CFileItem &file)
+{
+  CSingleLock lock(m_streamsLock);
+  StreamInfo *si = NULL;
+  if (m_prefetchStream && !file.m_lStartOffset && file.GetPath() == m_prefetchPath)
+  {
+    si = m_prefetchStream;
+    m_prefetchStream = NULL;
+    m_prefetchPath.clear();
+  }
+
+  // the playlist went elsewhere, the prefetched file is not needed anymore
+  DiscardPrefetchedStream();
+  return si;
+}
+
+void PAPlayer::DiscardPrefetchedStream()
+{
+  CSingleLock lock(m_streamsLock);
+  if (!m_prefetchStream)
+    return;
+
+  m_prefetchStream->m_decoder.Destroy();
+  delete m_prefetchStream;
+  m_prefetchStream = NULL;
+  m_prefetchPath.clear();
+}
+
+void PAPlayer::ProcessPrefetchedStream()
+{
+  CSingleLock lock(m_streamsLock);
+  if (!m_prefetchStream)
+    return;
+
+  // errors are reported when the file is queued and opened again
+  if (m_prefetchStream->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR)
+  {
+    CLog::Log(LOGDEBUG, "PAPlayer::ProcessPrefetchedStream - Error reading samples, dropping prefetched file");
+    DiscardPrefetchedStream();
+  }
+}
+
 bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, bool job /* = false */)
 {
   // check if we advance a track of a CUE sheet
@@ -344,17 +455,29 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
     m_continueStream = false;
   }
 
-  StreamInfo *si = new StreamInfo();
-  if (!si->m_decoder.Create(file, (file.m_lStartOffset * 1000) / 75))
+  StreamInfo *si = TakePrefetchedStream(file);
+  if (si)
+    CLog::Log(LOGDEBUG, "PAPlayer::QueueNextFileEx - Using the prefetched decoder, %u KB decoded ahead",
+              si->m_decoder.GetBufferedSize() / 1024);
+  else
   {
-    CLog::Log(LOGWARNING, "PAPlayer::QueueNextFileEx - Failed to create the decoder");
+    // decode ahead into a larger buffer if there is a song playing in front of this one
+    unsigned int prefetchSize = 0;
+    if (m_currentStream && g_advancedSettings.m_audioPrefetchNextFile && !file.IsCDDA())
+      prefetchSize = g_advancedSettings.m_audioPrefetchBufferSize * 1024;
 
-    delete si;
-    // advance playlist
-    if (job)
-      m_callback.OnPlayBackStarted();
-    m_callback.OnQueueNextItem();
-    return false;
+    si = new StreamInfo();
+    if (!si->m_decoder.Create(file, (file.m_lStartOffset * 1000) / 75, prefetchSize))
+    {
+      CLog::Log(LOGWARNING, "PAPlayer::QueueNextFileEx - Failed to create the decoder");
+
+      delete si;
+      // advance playlist
+      if (job)
+        m_callback.OnPlayBackStarted();
+      m_callback.OnQueueNextItem();
+      return false;
+    }
   }
 
   /* decode until there is data-available */
@@ -399,30 +522,31 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
   si->m_volume = (fadeIn && m_upcomingCrossfadeMS) ? 0.0f : 1.0f;
   si->m_fadeOutTriggered = false;
   si->m_isSlaved = false;
+  si->m_queuedTime = XbmcThreads::SystemClockMillis();
 
   int64_t streamTotalTime = si->m_decoder.TotalTime();
   if (si->m_endOffset)
     streamTotalTime = si->m_endOffset - si->m_startOffset;
   
   si->m_prepareNextAtFrame = 0;
+  si->m_prefetchNextAtFrame = 0;
   // cd drives don't really like it to be crossfaded or prepared
   if(!file.IsCDDA())
-  {
-    if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
-      si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
-  }
+    UpdateStreamInfoPrepareNextAtFrame(si, streamTotalTime);
 
   if (m_currentStream && ((m_currentStream->m_audioFormat.m_dataFormat == AE_FMT_RAW) || (si->m_audioFormat.m_dataFormat == AE_FMT_RAW)))
   {
     m_currentStream->m_prepareTriggered = false;
     m_currentStream->m_waitOnDrain = true;
     m_currentStream->m_prepareNextAtFrame = 0;
+    m_currentStream->m_prefetchNextAtFrame = 0;
     si->m_decoder.Destroy();
     delete si;
     return false;
   }
 
   si->m_prepareTriggered = false;
+  si->m_prefetchTriggered = false;
   si->m_playNextAtFrame = 0;
   si->m_playNextTriggered = false;
   si->m_waitOnDrain = false;
@@ -466,6 +590,21 @@ void PAPlayer::UpdateStreamInfoPlayNextAtFrame(StreamInfo *si, unsigned int cros
   }
 }
 
+void PAPlayer::UpdateStreamInfoPrepareNextAtFrame(StreamInfo *si, int64_t streamTotalTime)
+{
+  si->m_prepareNextAtFrame = 0;
+  si->m_prefetchNextAtFrame = 0;
+  if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
+    si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
+
+  // open the likely next file as soon as this one is playing stable so slow
+  // sources have time to deliver it. the playlist is still only asked for the
+  // next item at m_prepareNextAtFrame, so changes until then are honoured.
+  int prefetchAtFrame = (int)(TIME_TO_PREFETCH_NEXT_FILE * si->m_audioFormat.m_sampleRate / 1000.0f);
+  if (g_advancedSettings.m_audioPrefetchNextFile && si->m_prepareNextAtFrame > prefetchAtFrame)
+    si->m_prefetchNextAtFrame = prefetchAtFrame;
+}
+
 inline bool PAPlayer::PrepareStream(StreamInfo *si)
 {
   /* if we have a stream we are already prepared */
@@ -550,6 +689,9 @@ bool PAPlayer::CloseFile(bool reopen)
     }
   }
 
+  // a prefetch job may have finished after the streams were closed
+  DiscardPrefetchedStream();
+
   return true;
 }
 
@@ -573,6 +715,7 @@ void PAPlayer::Process()
 
     double freeBufferTime = 0.0;
     ProcessStreams(freeBufferTime);
+    ProcessPrefetchedStream();
 
     // if none of our streams wants at least 10ms of data, we sleep
     if (freeBufferTime < 0.01)
@@ -656,6 +799,8 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
       /* if its the current stream */
       if (si == m_currentStream)
       {
+        OnTrackEnded();
+
         /* if it was the last stream */
         if (itt == m_streams.end())
         {
@@ -690,6 +835,13 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
     if (!si->m_started)
       continue;
 
+    /* is it time to open the likely next stream ahead? */
+    if (si->m_prefetchNextAtFrame > 0 && !si->m_prefetchTriggered && !si->m_prepareTriggered && si->m_framesSent >= si->m_prefetchNextAtFrame)
+    {
+      si->m_prefetchTriggered = true;
+      m_callback.OnPrefetchNextItem();
+    }
+
     /* is it time to prepare the next stream? */
     if (si->m_prepareNextAtFrame > 0 && !si->m_prepareTriggered && si->m_framesSent >= si->m_prepareNextAtFrame)
     {
@@ -714,6 +866,7 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
           si->m_fadeOutTriggered = true;
         }
         m_currentStream = NULL;
+        OnTrackEnded();
 
         /* unregister the audio callback */
         si->m_stream->UnRegisterAudioCallback();
@@ -737,10 +890,15 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
     m_callback.OnPlayBackStarted();
   }
 
-  /* if we have not started yet and the stream has been primed */
+  /* if we have not started yet and the stream has been primed, keep decoding
+     ahead into the decoder buffer until it is our turn. errors are handled
+     once the stream has started and reads the decoder again */
   unsigned int space = si->m_stream->GetSpace();
   if (!si->m_started && !space)
+  {
+    si->m_decoder.ReadSamples(PACKET_SIZE);
     return true;
+  }
 
   /* see if it is time yet to FF/RW or a direct seek */
   if (!si->m_playNextTriggered && ((m_playbackSpeed != 1 && si->m_framesSent >= si->m_seekNextAtFrame) || si->m_seekFrame > -1))
@@ -796,11 +954,10 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
         streamTotalTime = si->m_endOffset - si->m_startOffset;
 
       // calculate time when to prepare next stream
-      si->m_prepareNextAtFrame = 0;
-      if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
-        si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
+      UpdateStreamInfoPrepareNextAtFrame(si, streamTotalTime);
 
       si->m_prepareTriggered = false;
+      si->m_prefetchTriggered = false;
       si->m_playNextAtFrame = 0;
       si->m_playNextTriggered = false;
       si->m_seekNextAtFrame = 0;
@@ -888,9 +1045,29 @@ bool PAPlayer::QueueData(StreamInfo *si)
   const ICodec* codec = si->m_decoder.GetCodec();
   m_playerGUIData.m_cacheLevel = codec ? codec->GetCacheLevel() : 0; //update for GUI
 
+  if (si->m_started && m_trackEnded && si->m_framesSent > 0)
+    ReportTrackGap(si);
+
   return true;
 }
 
+void PAPlayer::OnTrackEnded()
+{
+  m_trackEnded = true;
+  m_trackEndTime = XbmcThreads::SystemClockMillis();
+}
+
+void PAPlayer::ReportTrackGap(StreamInfo *si)
+{
+  m_trackEnded = false;
+
+  unsigned int gap = XbmcThreads::SystemClockMillis() - m_trackEndTime;
+  int queuedAhead = (int)(m_trackEndTime - si->m_queuedTime);
+  CLog::Log(LOGDEBUG, "PAPlayer::ReportTrackGap - %u ms between end of track and first sample of next track "
+            "(queued %d ms before the end, %u of %u KB decoded ahead)", gap, queuedAhead,
+            si->m_decoder.GetBufferedSize() / 1024, si->m_decoder.GetBufferSize() / 1024);
+}
+
 void PAPlayer::OnExit()
 {
 
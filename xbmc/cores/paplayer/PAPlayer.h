@@ -22,6 +22,7 @@
 
 #include <atomic>
 #include <list>
+#include <string>
 #include <vector>
 
 #include "cores/IPlayer.h"
@@ -40,6 +41,7 @@ class CProcessInfo;
 class PAPlayer : public IPlayer, public CThread, public IJobCallback
 {
 friend class CQueueNextFileJob;
+friend class CPrefetchNextFileJob;
 public:
   PAPlayer(IPlayerCallback& callback);
   virtual ~PAPlayer();
@@ -48,6 +50,7 @@ public:
   virtual void UnRegisterAudioCallback();
   virtual bool OpenFile(const CFileItem& file, const CPlayerOptions &options);
   virtual bool QueueNextFile(const CFileItem &file);
+  virtual void PrefetchNextFile(const CFileItem &file) override;
   virtual void OnNothingToQueueNotify();
   virtual bool CloseFile(bool reopen = false);
   virtual bool IsPlaying() const;
@@ -111,6 +114,8 @@ private:
     int m_framesSent;                    /* number of frames sent to the stream */
     int m_prepareNextAtFrame;            /* when to prepare the next stream */
     bool m_prepareTriggered;             /* if the next stream has been prepared */
+    int m_prefetchNextAtFrame;           /* when to open the likely next stream ahead */
+    bool m_prefetchTriggered;            /* if the likely next stream has been requested */
     int m_playNextAtFrame;               /* when to start playing the next stream */
     bool m_playNextTriggered;            /* if this stream has started the next one */
     bool m_fadeOutTriggered;             /* if the stream has been told to fade out */
@@ -122,6 +127,7 @@ private:
 
     bool m_isSlaved;                     /* true if the stream has been slaved to another */
     bool m_waitOnDrain;                  /* wait for stream being drained in AE */
+    unsigned int m_queuedTime;           /* when the stream has been queued */
   } StreamInfo;
 
   typedef std::list<StreamInfo*> StreamList;
@@ -142,14 +148,22 @@ private:
   CCriticalSection    m_streamsLock;         /* lock for the stream list */
   StreamList          m_streams;             /* playing streams */  
   StreamList          m_finishing;           /* finishing streams */
+  StreamInfo*         m_prefetchStream;      /* decoder opened ahead for the likely next file, not queued yet */
+  std::string         m_prefetchPath;        /* the file m_prefetchStream decodes */
   int                 m_jobCounter;
   CEvent              m_jobEvent;
   bool                m_continueStream;
   int64_t             m_newForcedPlayerTime;
   int64_t             m_newForcedTotalTime;
+  bool                m_trackEnded;          /* if the previous track ended and the next one has no sample out yet */
+  unsigned int        m_trackEndTime;        /* when the previous track ended */
   std::unique_ptr<CProcessInfo> m_processInfo;
 
   bool QueueNextFileEx(const CFileItem &file, bool fadeIn = true, bool job = false);
+  bool PrefetchNextFileEx(const CFileItem &file);
+  StreamInfo* TakePrefetchedStream(const CFileItem &file);
+  void DiscardPrefetchedStream();
+  void ProcessPrefetchedStream();
   void SoftStart(bool wait = false);
   void SoftStop(bool wait = false, bool close = true);
   void CloseAllStreams(bool fade = true);
@@ -157,9 +171,12 @@ private:
   bool PrepareStream(StreamInfo *si);
   bool ProcessStream(StreamInfo *si, double &freeBufferTime);
   bool QueueData(StreamInfo *si);
+  void OnTrackEnded();
+  void ReportTrackGap(StreamInfo *si);
   int64_t GetTotalTime64();
   void UpdateCrossfadeTime(const CFileItem& file);
   void UpdateStreamInfoPlayNextAtFrame(StreamInfo *si, unsigned int crossFadingTime);
+  void UpdateStreamInfoPrepareNextAtFrame(StreamInfo *si, int64_t streamTotalTime);
   void UpdateGUIData(StreamInfo *si);
   int64_t GetTimeInternal();
   void SetTimeInternal(int64_t time);
@@ -58,7 +58,8 @@ bool CGUIDialogBusy::Wait(IRunnable *runnable)
   return waiter.Wait();
 }
 
-bool CGUIDialogBusy::WaitOnEvent(CEvent &event, unsigned int displaytime /* = 100 */, bool allowCancel /* = true */)
+bool CGUIDialogBusy::WaitOnEvent(CEvent &event, unsigned int displaytime /* = 100 */, bool allowCancel /* = true */,
+                                 const std::function<float()> &progress /* = nullptr */)
 {
   bool cancelled = false;
   if (!event.WaitMSec(displaytime))
@@ -71,6 +72,11 @@ bool CGUIDialogBusy::WaitOnEvent(CEvent &event, unsigned int displaytime /* = 10
 
       while(!event.WaitMSec(1))
       {
+        if (progress)
+        {
+          float percent = progress();
+          dialog->SetProgress(percent > 0.0f ? percent : -1.0f);
+        }
         dialog->ProcessRenderLoop(false);
         if (allowCancel && dialog->IsCanceled())
         {
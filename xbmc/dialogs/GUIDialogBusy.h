@@ -20,6 +20,8 @@
  *
  */
 
+#include <functional>
+
 #include "guilib/GUIDialog.h"
 
 class IRunnable;
@@ -53,9 +55,11 @@ public:
    \param even the CEvent to wait on.
    \param displaytime the time in ms to wait prior to showing the busy dialog (defaults to 100ms)
    \param allowCancel whether the user can cancel the wait, defaults to true.
+   \param progress called while waiting to get the percentage to show, the progress is hidden while it is 0.
    \return true if the event completed, false if cancelled.
    */
-  static bool WaitOnEvent(CEvent &event, unsigned int timeout = 100, bool allowCancel = true);
+  static bool WaitOnEvent(CEvent &event, unsigned int timeout = 100, bool allowCancel = true,
+                          const std::function<float()> &progress = nullptr);
 protected:
   virtual void Open_Internal(const std::string &param = "");
   bool m_bCanceled;
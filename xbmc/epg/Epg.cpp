@@ -355,8 +355,10 @@ bool CEpg::UpdateEntries(const CEpg &epg, bool bStoreInDb /* = true */)
   CLog::Log(LOGDEBUG, "EPG - %s - %" PRIuS" entries in memory before merging", __FUNCTION__, m_tags.size());
 #endif
   /* copy over tags */
+  std::vector<CEpgInfoTagPtr> infoTags;
+  infoTags.reserve(epg.m_tags.size());
   for (std::map<CDateTime, CEpgInfoTagPtr>::const_iterator it = epg.m_tags.begin(); it != epg.m_tags.end(); ++it)
-    UpdateEntry(it->second, bStoreInDb);
+    infoTags.push_back(MergeEntry(*it->second, bStoreInDb));
 
 #if EPG_DEBUGGING
   CLog::Log(LOGDEBUG, "EPG - %s - %" PRIuS" entries in memory after merging and before fixing", __FUNCTION__, m_tags.size());
@@ -373,6 +375,8 @@ bool CEpg::UpdateEntries(const CEpg &epg, bool bStoreInDb /* = true */)
   SetChanged(true);
   lock.Leave();
 
+  SetTimersAndRecordings(infoTags);
+
   NotifyObservers(ObservableMessageEpg);
 
   return true;
@@ -413,6 +417,8 @@ bool CEpg::UpdateEntry(const EPG_TAG *data, bool bUpdateDatabase /* = false */)
     return false;
 
   CEpgInfoTagPtr tag(new CEpgInfoTag(*data));
+  tag->SetEpg(this);
+  tag->SetPVRChannel(Channel());
   return UpdateEntry(tag, bUpdateDatabase);
 }
 
@@ -422,32 +428,82 @@ bool CEpg::UpdateEntry(const CEpgInfoTagPtr &tag, bool bUpdateDatabase /* = fals
 
   {
     CSingleLock lock(m_critSection);
-    std::map<CDateTime, CEpgInfoTagPtr>::iterator it = m_tags.find(tag->StartAsUTC());
-    bool bNewTag(false);
-    if (it != m_tags.end())
-    {
-      infoTag = it->second;
-    }
-    else
+    infoTag = MergeEntry(*tag, bUpdateDatabase);
+  }
+
+  SetTimersAndRecordings(std::vector<CEpgInfoTagPtr>(1, infoTag));
+
+  return true;
+}
+
+bool CEpg::UpdateEntries(const EPG_TAG *data, unsigned int iCount, bool bUpdateDatabase /* = false */)
+{
+  if (!data && iCount > 0)
+    return false;
+
+  std::vector<CEpgInfoTagPtr> infoTags;
+  infoTags.reserve(iCount);
+
+  {
+    CSingleLock lock(m_critSection);
+    for (unsigned int i = 0; i < iCount; ++i)
     {
-      infoTag.reset(new CEpgInfoTag(this, m_pvrChannel, m_strName, m_pvrChannel ? m_pvrChannel->IconPath() : ""));
-      infoTag->SetUniqueBroadcastID(tag->UniqueBroadcastID());
-      m_tags.insert(std::make_pair(tag->StartAsUTC(), infoTag));
-      bNewTag = true;
+      /* the tag is compared with ours including the epg and channel, they mustn't count as a change */
+      CEpgInfoTag tag(data[i]);
+      tag.SetEpg(this);
+      tag.SetPVRChannel(m_pvrChannel);
+      infoTags.push_back(MergeEntry(tag, bUpdateDatabase));
     }
+  }
 
-    infoTag->Update(*tag, bNewTag);
-    infoTag->SetEpg(this);
-    infoTag->SetPVRChannel(m_pvrChannel);
+  SetTimersAndRecordings(infoTags);
 
-    if (bUpdateDatabase)
-      m_changedTags.insert(std::make_pair(infoTag->UniqueBroadcastID(), infoTag));
+  return true;
+}
+
+CEpgInfoTagPtr CEpg::MergeEntry(const CEpgInfoTag &tag, bool bUpdateDatabase)
+{
+  CEpgInfoTagPtr infoTag;
+  bool bNewTag(false);
+
+  /* clients send their tags by start time, so the position found here is also the hint for inserting */
+  std::map<CDateTime, CEpgInfoTagPtr>::iterator it = m_tags.lower_bound(tag.StartAsUTC());
+  if (it != m_tags.end() && it->first == tag.StartAsUTC())
+  {
+    infoTag = it->second;
+  }
+  else
+  {
+    infoTag.reset(new CEpgInfoTag(this, m_pvrChannel, m_strName, m_pvrChannel ? m_pvrChannel->IconPath() : ""));
+    infoTag->SetUniqueBroadcastID(tag.UniqueBroadcastID());
+    m_tags.insert(it, std::make_pair(tag.StartAsUTC(), infoTag));
+    bNewTag = true;
   }
 
-  infoTag->SetTimer(g_PVRTimers->GetTimerForEpgTag(infoTag));
-  infoTag->SetRecording(g_PVRRecordings->GetRecordingForEpgTag(infoTag));
+  bool bChanged = infoTag->Update(tag, bNewTag);
+  infoTag->SetEpg(this);
+  infoTag->SetPVRChannel(m_pvrChannel);
 
-  return true;
+  /* clients send the whole guide on every update, only write what is new or differs from what we have */
+  if (bUpdateDatabase && (bNewTag || bChanged))
+    m_changedTags.insert(std::make_pair(infoTag->UniqueBroadcastID(), infoTag));
+
+  return infoTag;
+}
+
+void CEpg::SetTimersAndRecordings(const std::vector<CEpgInfoTagPtr> &tags) const
+{
+  /* get the containers once instead of once per tag, they are not there while the pvr manager is stopped */
+  const CPVRTimersPtr timers(g_PVRTimers);
+  const CPVRRecordingsPtr recordings(g_PVRRecordings);
+
+  for (const auto &tag : tags)
+  {
+    if (timers)
+      tag->SetTimer(timers->GetTimerForEpgTag(tag));
+    if (recordings)
+      tag->SetRecording(recordings->GetRecordingForEpgTag(tag));
+  }
 }
 
 bool CEpg::UpdateEntry(const CEpgInfoTagPtr &tag, EPG_EVENT_STATE newState, bool bUpdateDatabase /* = false */)
@@ -615,11 +671,17 @@ bool CEpg::Persist(void)
         m_iEpgID = iId;
     }
 
+    std::vector<CEpgInfoTagPtr> deletedTags;
+    deletedTags.reserve(m_deletedTags.size());
     for (std::map<int, CEpgInfoTagPtr>::iterator it = m_deletedTags.begin(); it != m_deletedTags.end(); ++it)
-      database->Delete(*it->second);
+      deletedTags.push_back(it->second);
+    database->Delete(deletedTags);
 
+    std::vector<CEpgInfoTagPtr> changedTags;
+    changedTags.reserve(m_changedTags.size());
     for (std::map<int, CEpgInfoTagPtr>::iterator it = m_changedTags.begin(); it != m_changedTags.end(); ++it)
-      it->second->Persist(false);
+      changedTags.push_back(it->second);
+    database->Persist(changedTags);
 
     if (m_bUpdateLastScanTime)
       database->PersistLastEpgScanTime(m_iEpgID, true);
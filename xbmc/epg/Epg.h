@@ -205,6 +205,15 @@ namespace EPG
      */
     bool UpdateEntry(const CEpgInfoTagPtr &tag, bool bUpdateDatabase = false);
 
+    /*!
+     * @brief Update many entries in this EPG at once.
+     * @param data The tags to update.
+     * @param iCount The number of tags.
+     * @param bUpdateDatabase If set to true, these events will be persisted in the database.
+     * @return True if they were updated successfully, false otherwise.
+     */
+    bool UpdateEntries(const EPG_TAG *data, unsigned int iCount, bool bUpdateDatabase = false);
+
     /*!
      * @brief Update an entry in this EPG.
      * @param tag The tag to update.
@@ -327,6 +336,20 @@ namespace EPG
      */
     bool UpdateEntries(const CEpg &epg, bool bStoreInDb = true);
 
+    /*!
+     * @brief Add a tag to this table or update the tag with the same start time. m_critSection must be held.
+     * @param tag The tag.
+     * @param bUpdateDatabase If set to true, the tag will be persisted in the database.
+     * @return The tag in this table.
+     */
+    CEpgInfoTagPtr MergeEntry(const CEpgInfoTag &tag, bool bUpdateDatabase);
+
+    /*!
+     * @brief Look up the timers and recordings of tags of this table. Must not be called with m_critSection held.
+     * @param tags The tags.
+     */
+    void SetTimersAndRecordings(const std::vector<CEpgInfoTagPtr> &tags) const;
+
     std::map<CDateTime, CEpgInfoTagPtr> m_tags;
     std::map<int, CEpgInfoTagPtr>       m_changedTags;
     std::map<int, CEpgInfoTagPtr>       m_deletedTags;
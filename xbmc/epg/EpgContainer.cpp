@@ -306,6 +306,14 @@ bool CEpgContainer::PersistAll(void)
     }
   }
 
+  if (m_database.IsOpen())
+  {
+    unsigned int iWritten, iDeleted;
+    m_database.GetAndResetChangeCounters(iWritten, iDeleted);
+    if (iWritten > 0 || iDeleted > 0)
+      CLog::Log(LOGDEBUG, "EPG - %s - %u events written, %u events deleted", __FUNCTION__, iWritten, iDeleted);
+  }
+
   return bReturn;
 }
 
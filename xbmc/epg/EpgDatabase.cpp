@@ -18,6 +18,7 @@
  *
  */
 
+#include <algorithm>
 #include <cstdlib>
 
 #include "system.h"
@@ -33,6 +34,18 @@
 using namespace dbiplus;
 using namespace EPG;
 
+namespace
+{
+const char *tagColumns = "idEpg, iStartTime, "
+    "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
+    "sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, iStarRating, bNotify, iSeriesId, "
+    "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, iBroadcastUid";
+
+/* keep the queries well below the statement size limits of sqlite and mysql */
+const size_t maxRowsPerQuery = 100;
+const size_t maxQueryLength = 256 * 1024;
+}
+
 bool CEpgDatabase::Open(void)
 {
   return CDatabase::Open(g_advancedSettings.m_databaseEpg);
@@ -172,6 +185,55 @@ bool CEpgDatabase::Delete(const CEpgInfoTag &tag)
   return DeleteValues("epgtags", filter);
 }
 
+bool CEpgDatabase::Delete(const std::vector<CEpgInfoTagPtr> &tags)
+{
+  std::vector<std::string> broadcastIds;
+  std::map<int, std::vector<std::string>> startTimesByEpg;
+
+  for (const auto &tag : tags)
+  {
+    if (tag->BroadcastId() > 0)
+    {
+      broadcastIds.push_back(StringUtils::Format("%i", tag->BroadcastId()));
+    }
+    else if (tag->EpgID() > 0)
+    {
+      time_t iStartTime;
+      tag->StartAsUTC().GetAsTime(iStartTime);
+      startTimesByEpg[tag->EpgID()].push_back(StringUtils::Format("%u", static_cast<unsigned int>(iStartTime)));
+    }
+    else
+      continue;
+
+    ++m_iDeletedTags;
+  }
+
+  bool bReturn(true);
+  for (size_t i = 0; i < broadcastIds.size(); i += maxRowsPerQuery)
+  {
+    std::vector<std::string> chunk(broadcastIds.begin() + i, broadcastIds.begin() + std::min(i + maxRowsPerQuery, broadcastIds.size()));
+    bReturn &= QueueInsertQuery("DELETE FROM epgtags WHERE idBroadcast IN (" + StringUtils::Join(chunk, ",") + ");");
+  }
+
+  for (const auto &epgEntry : startTimesByEpg)
+  {
+    const std::vector<std::string> &startTimes = epgEntry.second;
+    for (size_t i = 0; i < startTimes.size(); i += maxRowsPerQuery)
+    {
+      std::vector<std::string> chunk(startTimes.begin() + i, startTimes.begin() + std::min(i + maxRowsPerQuery, startTimes.size()));
+      bReturn &= QueueInsertQuery(PrepareSQL("DELETE FROM epgtags WHERE idEpg = %u AND iStartTime IN (", epgEntry.first) + StringUtils::Join(chunk, ",") + ");");
+    }
+  }
+
+  return bReturn;
+}
+
+void CEpgDatabase::GetAndResetChangeCounters(unsigned int &iWritten, unsigned int &iDeleted)
+{
+  iWritten = m_iWrittenTags.exchange(0);
+  iDeleted = m_iDeletedTags.exchange(0);
+}
+
 int CEpgDatabase::Get(CEpgContainer &container)
 {
   int iReturn(-1);
@@ -337,58 +399,48 @@ int CEpgDatabase::Persist(const CEpg &epg, bool bQueueWrite /* = false */)
   return iReturn;
 }
 
-int CEpgDatabase::Persist(const CEpgInfoTag &tag, bool bSingleUpdate /* = true */)
+std::string CEpgDatabase::PrepareTagValues(const CEpgInfoTag &tag, bool bWithBroadcastId)
 {
-  int iReturn(-1);
-
-  if (tag.EpgID() <= 0)
-  {
-    CLog::Log(LOGERROR, "%s - tag '%s' does not have a valid table", __FUNCTION__, tag.Title(true).c_str());
-    return iReturn;
-  }
-
   time_t iStartTime, iEndTime, iFirstAired;
   tag.StartAsUTC().GetAsTime(iStartTime);
   tag.EndAsUTC().GetAsTime(iEndTime);
   tag.FirstAiredAsUTC().GetAsTime(iFirstAired);
 
-  int iBroadcastId = tag.BroadcastId();
-  std::string strQuery;
-
   /* Only store the genre string when needed */
   std::string strGenre = (tag.GenreType() == EPG_GENRE_USE_STRING) ? StringUtils::Join(tag.Genre(), g_advancedSettings.m_videoItemSeparator) : "";
 
-  if (iBroadcastId < 0)
-  {
-    strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, iStarRating, bNotify, iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, iBroadcastUid) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, %i);",
-        tag.EpgID(), iStartTime, iEndTime,
-        tag.Title(true).c_str(), tag.PlotOutline(true).c_str(), tag.Plot(true).c_str(),
-        tag.OriginalTitle(true).c_str(), tag.Cast().c_str(), tag.Director().c_str(), tag.Writer().c_str(), tag.Year(), tag.IMDBNumber().c_str(),
-        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
-        iFirstAired, tag.ParentalRating(), tag.StarRating(), tag.Notify(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(),
-        tag.UniqueBroadcastID());
-  }
-  else
+  std::string strValues = PrepareSQL("(%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, %i",
+      tag.EpgID(), iStartTime, iEndTime,
+      tag.Title(true).c_str(), tag.PlotOutline(true).c_str(), tag.Plot(true).c_str(),
+      tag.OriginalTitle(true).c_str(), tag.Cast().c_str(), tag.Director().c_str(), tag.Writer().c_str(), tag.Year(), tag.IMDBNumber().c_str(),
+      tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
+      iFirstAired, tag.ParentalRating(), tag.StarRating(), tag.Notify(),
+      tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(),
+      tag.UniqueBroadcastID());
+
+  if (bWithBroadcastId)
+    strValues += PrepareSQL(", %i", tag.BroadcastId());
+  strValues += ")";
+
+  return strValues;
+}
+
+int CEpgDatabase::Persist(const CEpgInfoTag &tag, bool bSingleUpdate /* = true */)
+{
+  int iReturn(-1);
+
+  if (tag.EpgID() <= 0)
   {
-    strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, iStarRating, bNotify, iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, iBroadcastUid, idBroadcast) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, %i, %i);",
-        tag.EpgID(), iStartTime, iEndTime,
-        tag.Title(true).c_str(), tag.PlotOutline(true).c_str(), tag.Plot(true).c_str(),
-        tag.OriginalTitle(true).c_str(), tag.Cast().c_str(), tag.Director().c_str(), tag.Writer().c_str(), tag.Year(), tag.IMDBNumber().c_str(),
-        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
-        iFirstAired, tag.ParentalRating(), tag.StarRating(), tag.Notify(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(),
-        tag.UniqueBroadcastID(), iBroadcastId);
+    CLog::Log(LOGERROR, "%s - tag '%s' does not have a valid table", __FUNCTION__, tag.Title(true).c_str());
+    return iReturn;
   }
 
+  bool bWithBroadcastId = tag.BroadcastId() >= 0;
+  std::string strQuery = StringUtils::Format("REPLACE INTO epgtags (%s%s) VALUES %s;",
+      tagColumns, bWithBroadcastId ? ", idBroadcast" : "", PrepareTagValues(tag, bWithBroadcastId).c_str());
+
+  ++m_iWrittenTags;
+
   if (bSingleUpdate)
   {
     if (ExecuteQuery(strQuery))
@@ -403,6 +455,47 @@ int CEpgDatabase::Persist(const CEpgInfoTag &tag, bool bSingleUpdate /* = true *
   return iReturn;
 }
 
+bool CEpgDatabase::Persist(const std::vector<CEpgInfoTagPtr> &tags)
+{
+  /* new tags and tags that were read from the database need different queries */
+  std::string strQueries[2];
+  size_t iRows[2] = { 0, 0 };
+  bool bReturn(true);
+
+  for (const auto &tag : tags)
+  {
+    if (tag->EpgID() <= 0)
+    {
+      CLog::Log(LOGERROR, "%s - tag '%s' does not have a valid table", __FUNCTION__, tag->Title(true).c_str());
+      continue;
+    }
+
+    int iQuery = tag->BroadcastId() >= 0 ? 1 : 0;
+    std::string &strQuery = strQueries[iQuery];
+    if (strQuery.empty())
+      strQuery = StringUtils::Format("REPLACE INTO epgtags (%s%s) VALUES ", tagColumns, iQuery ? ", idBroadcast" : "");
+    else
+      strQuery += ", ";
+    strQuery += PrepareTagValues(*tag, iQuery == 1);
+    ++m_iWrittenTags;
+
+    if (++iRows[iQuery] >= maxRowsPerQuery || strQuery.size() >= maxQueryLength)
+    {
+      bReturn &= QueueInsertQuery(strQuery + ";");
+      strQuery.clear();
+      iRows[iQuery] = 0;
+    }
+  }
+
+  for (const auto &strQuery : strQueries)
+  {
+    if (!strQuery.empty())
+      bReturn &= QueueInsertQuery(strQuery + ";");
+  }
+
+  return bReturn;
+}
+
 int CEpgDatabase::GetLastEPGId(void)
 {
   std::string strQuery = PrepareSQL("SELECT MAX(idEpg) FROM epg");
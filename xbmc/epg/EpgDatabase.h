@@ -19,8 +19,11 @@
  *
  */
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "XBDateTime.h"
 #include "dbwrappers/Database.h"
@@ -42,7 +45,7 @@ namespace EPG
     /*!
      * @brief Create a new instance of the EPG database.
      */
-    CEpgDatabase(void) {};
+    CEpgDatabase(void) : m_iWrittenTags(0), m_iDeletedTags(0) {};
 
     /*!
      * @brief Destroy this instance.
@@ -97,6 +100,23 @@ namespace EPG
      */
     virtual bool Delete(const CEpgInfoTag &tag);
 
+    /*!
+     * @brief Remove many EPG entries with a few queries. Entries that were
+     * queued for writing but didn't get their database ID yet are found by
+     * their table and start time.
+     * The queries are queued, CommitInsertQueries() executes them.
+     * @param tags The entries to remove.
+     * @return True if the queries were queued, false otherwise.
+     */
+    bool Delete(const std::vector<CEpgInfoTagPtr> &tags);
+
+    /*!
+     * @brief Get the number of entries queued for writing and removal since the last call.
+     * @param iWritten The number of entries written.
+     * @param iDeleted The number of entries removed.
+     */
+    void GetAndResetChangeCounters(unsigned int &iWritten, unsigned int &iDeleted);
+
     /*!
      * @brief Get all EPG tables from the database. Does not get the EPG tables' entries.
      * @param container The container to fill.
@@ -145,6 +165,14 @@ namespace EPG
      */
     virtual int Persist(const CEpgInfoTag &tag, bool bSingleUpdate = true);
 
+    /*!
+     * @brief Persist many infotags with a few queries that write many rows each.
+     * The queries are queued, CommitInsertQueries() executes them.
+     * @param tags The tags to persist.
+     * @return True if the queries were queued, false otherwise.
+     */
+    bool Persist(const std::vector<CEpgInfoTagPtr> &tags);
+
     /*!
      * @return Last EPG id in the database
      */
@@ -153,6 +181,14 @@ namespace EPG
     //@}
 
   protected:
+    /*!
+     * @brief Get the values of a tag for the REPLACE INTO epgtags queries.
+     * @param tag The tag.
+     * @param bWithBroadcastId Add the database ID of the tag as last value.
+     * @return The values, in parentheses.
+     */
+    std::string PrepareTagValues(const CEpgInfoTag &tag, bool bWithBroadcastId);
+
     /*!
      * @brief Create the EPG database tables.
      */
@@ -169,5 +205,9 @@ namespace EPG
      */
     virtual void UpdateTables(int version);
     virtual int GetMinSchemaVersion() const { return 4; }
+
+  private:
+    std::atomic<unsigned int> m_iWrittenTags; /*!< entries queued by Persist() since the counters were reset */
+    std::atomic<unsigned int> m_iDeletedTags; /*!< entries queued by Delete() since the counters were reset */
   };
 }
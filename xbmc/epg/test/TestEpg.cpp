@@ -0,0 +1,140 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "addons/binary/interfaces/api1/PVR/AddonCallbacksPVR.h"
+#include "addons/kodi-addon-dev-kit/include/kodi/libXBMC_pvr.h"
+#include "epg/Epg.h"
+#include "epg/test/TestHelpers.h"
+
+#include "gtest/gtest.h"
+
+using namespace EPG;
+using V1::KodiAPI::PVR::CAddonCallbacksPVR;
+
+namespace
+{
+class CTestEpg : public CEpg
+{
+public:
+  explicit CTestEpg(int iEpgID) : CEpg(iEpgID) {}
+
+  size_t ChangedTags(void) const { return m_changedTags.size(); }
+  void ClearChangedTags(void) { m_changedTags.clear(); }
+};
+
+EPG_TAG CreateTag(unsigned int iUniqueBroadcastId, const char *strTitle)
+{
+  EPG_TAG tag;
+  memset(&tag, 0, sizeof(tag));
+  tag.iUniqueBroadcastId = iUniqueBroadcastId;
+  tag.strTitle = strTitle;
+  tag.startTime = 1483228800 + iUniqueBroadcastId * 1800;
+  tag.endTime = tag.startTime + 1800;
+  return tag;
+}
+
+std::vector<std::string> GetTitles(const CEpg &epg)
+{
+  std::vector<std::string> titles;
+  for (const auto &tag : epg.GetTagsBetween(CDateTime(1970, 1, 1, 0, 0, 0), CDateTime(2100, 1, 1, 0, 0, 0)))
+    titles.push_back(tag->Title(true));
+  return titles;
+}
+}
+
+TEST(TestEpg, BatchedTransferMatchesSingleTransfers)
+{
+  // 4 days, half an hour each, in batches that don't divide them evenly
+  CSyntheticEpgClient client(192, 1483228800);
+
+  CEpg single(1);
+  ADDON_HANDLE_STRUCT singleHandle = CreateEpgHandle(single);
+  client.TransferOneByOne(&singleHandle);
+
+  CEpg batched(2);
+  ADDON_HANDLE_STRUCT batchedHandle = CreateEpgHandle(batched);
+  client.TransferBatched(&batchedHandle, 50);
+
+  EXPECT_EQ(192u, single.Size());
+  EXPECT_EQ(single.Size(), batched.Size());
+  EXPECT_EQ(GetTitles(single), GetTitles(batched));
+
+  // transferring the same tags again updates them
+  client.TransferBatched(&batchedHandle, 50);
+  EXPECT_EQ(192u, batched.Size());
+}
+
+TEST(TestEpg, EpgTagBatchCopiesStrings)
+{
+  char strTitle[16];
+  strcpy(strTitle, "News");
+
+  EPG_TAG tag;
+  memset(&tag, 0, sizeof(tag));
+  tag.strTitle = strTitle;
+
+  CEpgTagBatch batch(NULL, NULL);
+  batch.Add(tag);
+  strcpy(strTitle, "Weather");
+  batch.Add(tag);
+
+  ASSERT_EQ(2u, batch.Size());
+  EXPECT_STREQ("News", batch.Entries()[0].strTitle);
+  EXPECT_STREQ("Weather", batch.Entries()[1].strTitle);
+  EXPECT_TRUE(batch.Entries()[0].strPlot == NULL);
+
+  batch.Clear();
+  EXPECT_EQ(0u, batch.Size());
+}
+
+TEST(TestEpg, OnlyChangedTagsAreWritten)
+{
+  std::vector<EPG_TAG> tags;
+  for (unsigned int i = 1; i <= 10; ++i)
+    tags.push_back(CreateTag(i, "Event"));
+
+  // transferred like a client does, with the database to be updated
+  CTestEpg epg(1);
+  ADDON_HANDLE_STRUCT handle = CreateEpgHandle(epg);
+  handle.dataIdentifier = 1;
+
+  CAddonCallbacksPVR::PVRTransferEpgEntries(NULL, &handle, &tags[0], tags.size());
+  EXPECT_EQ(10u, epg.ChangedTags());
+  epg.ClearChangedTags();
+
+  // the same guide again doesn't have to be written
+  CAddonCallbacksPVR::PVRTransferEpgEntries(NULL, &handle, &tags[0], tags.size());
+  EXPECT_EQ(0u, epg.ChangedTags());
+
+  // neither one by one
+  for (const auto &tag : tags)
+    CAddonCallbacksPVR::PVRTransferEpgEntry(NULL, &handle, &tag);
+  EXPECT_EQ(0u, epg.ChangedTags());
+
+  tags[3].strTitle = "Changed event";
+  tags.push_back(CreateTag(11, "New event"));
+  CAddonCallbacksPVR::PVRTransferEpgEntries(NULL, &handle, &tags[0], tags.size());
+  EXPECT_EQ(2u, epg.ChangedTags());
+  EXPECT_EQ(11u, epg.Size());
+}
@@ -0,0 +1,89 @@
+#pragma once
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstring>
+#include <string>
+
+#include "addons/binary/interfaces/api1/PVR/AddonCallbacksPVR.h"
+#include "addons/kodi-addon-dev-kit/include/kodi/libXBMC_pvr.h"
+#include "epg/Epg.h"
+#include "utils/StringUtils.h"
+
+/*!
+ * Behaves like the GetEPGForChannel() of a PVR add-on: builds every tag in
+ * its own buffers, which it reuses for the next tag.
+ */
+class CSyntheticEpgClient
+{
+public:
+  CSyntheticEpgClient(unsigned int iTags, time_t start) : m_iTags(iTags), m_start(start) {}
+
+  void TransferOneByOne(const ADDON_HANDLE handle)
+  {
+    for (unsigned int i = 0; i < m_iTags; ++i)
+      V1::KodiAPI::PVR::CAddonCallbacksPVR::PVRTransferEpgEntry(NULL, handle, &CreateTag(i));
+  }
+
+  void TransferBatched(const ADDON_HANDLE handle, unsigned int iBatchSize)
+  {
+    // no add-on library to flush to in here, so hand the batches over directly
+    CEpgTagBatch batch(NULL, handle, m_iTags + 1);
+    for (unsigned int i = 0; i < m_iTags; ++i)
+    {
+      batch.Add(CreateTag(i));
+      if (batch.Size() == iBatchSize || i == m_iTags - 1)
+      {
+        V1::KodiAPI::PVR::CAddonCallbacksPVR::PVRTransferEpgEntries(NULL, handle, batch.Entries(), batch.Size());
+        batch.Clear();
+      }
+    }
+  }
+
+private:
+  const EPG_TAG &CreateTag(unsigned int i)
+  {
+    m_strTitle = StringUtils::Format("Event %u", i);
+    m_strPlot = StringUtils::Format("The plot of event %u, which is a bit longer than its title.", i);
+
+    memset(&m_tag, 0, sizeof(m_tag));
+    m_tag.iUniqueBroadcastId = i + 1;
+    m_tag.strTitle = m_strTitle.c_str();
+    m_tag.strPlot = m_strPlot.c_str();
+    m_tag.startTime = m_start + i * 1800;
+    m_tag.endTime = m_tag.startTime + 1800;
+    return m_tag;
+  }
+
+  unsigned int m_iTags;
+  time_t m_start;
+  std::string m_strTitle;
+  std::string m_strPlot;
+  EPG_TAG m_tag;
+};
+
+inline ADDON_HANDLE_STRUCT CreateEpgHandle(EPG::CEpg &epg)
+{
+  ADDON_HANDLE_STRUCT handle;
+  handle.callerAddress = NULL;
+  handle.dataAddress = &epg;
+  handle.dataIdentifier = 0;
+  return handle;
+}
@@ -107,7 +107,9 @@ public:
       return false;
     }
 
-    list.Copy(m_result->m_list);
+    // the items were fetched for us only, take them over instead of copying
+    list.Copy(m_result->m_list, false);
+    list.Append(m_result->m_list);
     return true;
   }
   std::shared_ptr<CResult> m_result;
@@ -174,7 +176,8 @@ bool CDirectory::GetDirectory(const CURL& url, CFileItemList &items, const CHint
 
           CGetDirectory get(pDirectory, realURL, url);
 
-          if (!CGUIDialogBusy::WaitOnEvent(get.GetEvent(), TIME_TO_BUSY_DIALOG))
+          if (!CGUIDialogBusy::WaitOnEvent(get.GetEvent(), TIME_TO_BUSY_DIALOG, true,
+                                           [&pDirectory]() { return pDirectory->GetProgress(); }))
           {
             cancel = true;
             pDirectory->CancelDirectory();
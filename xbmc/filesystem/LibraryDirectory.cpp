@@ -142,6 +142,23 @@ bool CLibraryDirectory::GetDirectory(const CURL& url, CFileItemList &items)
   return true;
 }
 
+std::string CLibraryDirectory::GetFolderPath(const CURL& url)
+{
+  std::string libNode = GetNode(url);
+  if (!URIUtils::HasExtension(libNode, ".xml"))
+    return "";
+
+  TiXmlElement *node = LoadXML(libNode);
+  if (!node || XMLUtils::GetAttribute(node, "type") != "folder")
+    return "";
+
+  std::string path;
+  XMLUtils::GetPath(node, "path", path);
+  if (!path.empty())
+    URIUtils::AddSlashAtEnd(path);
+  return path;
+}
+
 TiXmlElement *CLibraryDirectory::LoadXML(const std::string &xmlFile)
 {
   if (!CFile::Exists(xmlFile))
@@ -32,6 +32,12 @@ namespace XFILE
     virtual bool GetDirectory(const CURL& url, CFileItemList &items);
     virtual bool Exists(const CURL& url);
     virtual bool AllowAll() const { return true; }
+
+    /*! \brief resolve a folder node to the path it points to
+     \param url the library:// path of the node
+     \return the path of the folder node, empty if the node isn't a visible folder node
+     */
+    std::string GetFolderPath(const CURL& url);
   private:
     /*! \brief parse the given path and return the node corresponding to this path
      \param path the library:// path to parse
@@ -204,17 +204,16 @@ bool CPluginDirectory::AddItem(int handle, const CFileItem *item, int totalItems
   return !dir->m_cancelled;
 }
 
-bool CPluginDirectory::AddItems(int handle, const CFileItemList *items, int totalItems)
+bool CPluginDirectory::AddItems(int handle, CFileItemList *items, int totalItems)
 {
   CSingleLock lock(m_handleLock);
   CPluginDirectory *dir = dirFromHandle(handle);
   if (!dir)
     return false;
 
-  CFileItemList pItemList;
-  pItemList.Copy(*items);
-  dir->m_listItems->Append(pItemList);
+  dir->m_listItems->Append(*items);
   dir->m_totalItems = totalItems;
+  items->Clear();
 
   return !dir->m_cancelled;
 }
@@ -483,7 +482,7 @@ bool CPluginDirectory::WaitOnScriptResult(const std::string &scriptPath, int scr
     if (!m_fetchComplete.WaitMSec(20))
     {
       CScriptObserver scriptObs(scriptId, m_fetchComplete);
-      if (!CGUIDialogBusy::WaitOnEvent(m_fetchComplete, 200))
+      if (!CGUIDialogBusy::WaitOnEvent(m_fetchComplete, 200, true, [this]() { return GetProgress(); }))
       {
         m_cancelled = true;
       }
@@ -575,6 +574,8 @@ void CPluginDirectory::CancelDirectory()
 
 float CPluginDirectory::GetProgress() const
 {
+  // the list is filled by the script's thread
+  CSingleLock lock(m_handleLock);
   if (m_totalItems > 0)
     return (m_listItems->Size() * 100.0f) / m_totalItems;
   return 0.0f;
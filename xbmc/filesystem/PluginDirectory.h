@@ -54,7 +54,11 @@ public:
 
   // callbacks from python
   static bool AddItem(int handle, const CFileItem *item, int totalItems);
-  static bool AddItems(int handle, const CFileItemList *items, int totalItems);
+  /*! \brief Hand items over to the listing of a plugin
+   The items are moved into the listing without being copied, items is left
+   empty. They count towards the progress reported while the plugin runs.
+   */
+  static bool AddItems(int handle, CFileItemList *items, int totalItems);
   static void EndOfDirectory(int handle, bool success, bool replaceListing, bool cacheToDisc);
   static void AddSortMethod(int handle, SORT_METHOD sortMethod, const std::string &label2Mask);
   static std::string GetSetting(int handle, const std::string &key);
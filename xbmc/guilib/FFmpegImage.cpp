@@ -21,6 +21,7 @@
 #include "FFmpegImage.h"
 #include "utils/log.h"
 #include "cores/FFmpeg.h"
+#include "cores/VideoPlayer/SwScaler.h"
 #include "guilib/Texture.h"
 
 #include <algorithm>
@@ -69,7 +70,7 @@ struct ThumbDataManagement
   uint8_t* intermediateBuffer = nullptr; // gets av_alloced
   AVFrame* frame_input = nullptr;
   AVFrame* frame_temporary = nullptr;
-  SwsContext* sws = nullptr;
+  CSwScaler scaler;
   AVCodecContext* avOutctx = nullptr;
   AVCodec* codec = nullptr;
   ~ThumbDataManagement()
@@ -83,8 +84,6 @@ struct ThumbDataManagement
     avcodec_close(avOutctx);
     avcodec_free_context(&avOutctx);
     avOutctx = nullptr;
-    sws_freeContext(sws);
-    sws = nullptr;
   }
 };
 
@@ -454,22 +453,15 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     nHeight = (unsigned int)(nWidth / ratio + 0.5f);
   }
 
-  struct SwsContext* context = sws_getContext(m_originalWidth, m_originalHeight, pixFormat,
-    nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC, NULL, NULL, NULL);
-
-  if (range == AVCOL_RANGE_JPEG)
+  CSwScaler scaler;
+  if (scaler.Configure(m_originalWidth, m_originalHeight, pixFormat,
+                       nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC))
   {
-    int* inv_table = nullptr;
-    int* table = nullptr;
-    int srcRange, dstRange, brightness, contrast, saturation;
-    sws_getColorspaceDetails(context, &inv_table, &srcRange, &table, &dstRange, &brightness, &contrast, &saturation);
-    srcRange = 1;
-    sws_setColorspaceDetails(context, inv_table, srcRange, table, dstRange, brightness, contrast, saturation);
-  }
+    if (range == AVCOL_RANGE_JPEG)
+      scaler.SetRange(1, -1);
 
-  sws_scale(context, frame->data, frame->linesize, 0, m_originalHeight,
-    pictureRGB->data, pictureRGB->linesize);
-  sws_freeContext(context);
+    scaler.Scale(frame->data, frame->linesize, pictureRGB->data, pictureRGB->linesize);
+  }
 
   if (needsCopy)
   {
@@ -620,8 +612,7 @@ bool CFFmpegImage::CreateThumbnailFromSurface(unsigned char* bufferin, unsigned
   int srcStride[] = { (int) pitch, 0, 0, 0};
 
   //input size == output size which means only pix_fmt conversion
-  tdm.sws = sws_getContext(width, height, AV_PIX_FMT_RGB32, width, height, jpg_output ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_RGBA, 0, 0, 0, 0);
-  if (!tdm.sws)
+  if (!tdm.scaler.Configure(width, height, AV_PIX_FMT_RGB32, width, height, jpg_output ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_RGBA, 0))
   {
     CLog::Log(LOGERROR, "Could not setup scaling context for thumbnail: %s", destFile.c_str());
     CleanupLocalOutputBuffer();
@@ -631,19 +622,8 @@ bool CFFmpegImage::CreateThumbnailFromSurface(unsigned char* bufferin, unsigned
   // Setup jpeg range for sws
   if (jpg_output)
   {
-    int* inv_table = nullptr;
-    int* table = nullptr;
-    int srcRange, dstRange, brightness, contrast, saturation;
-
-    if (sws_getColorspaceDetails(tdm.sws, &inv_table, &srcRange, &table, &dstRange, &brightness, &contrast, &saturation) < 0)
-    {
-      CLog::Log(LOGERROR, "SWS_SCALE failed to get ColorSpaceDetails for thumbnail: %s", destFile.c_str());
-      CleanupLocalOutputBuffer();
-      return false;
-    }
-    dstRange = 1; // jpeg full range yuv420p output
-    srcRange = 0; // full range RGB32 input
-    if (sws_setColorspaceDetails(tdm.sws, inv_table, srcRange, table, dstRange, brightness, contrast, saturation) < 0)
+    // jpeg full range yuv420p output from full range RGB32 input
+    if (!tdm.scaler.SetRange(0, 1))
     {
       CLog::Log(LOGERROR, "SWS_SCALE failed to set ColorSpace Details for thumbnail: %s", destFile.c_str());
       CleanupLocalOutputBuffer();
@@ -651,7 +631,7 @@ bool CFFmpegImage::CreateThumbnailFromSurface(unsigned char* bufferin, unsigned
     }
   }
 
-  if (sws_scale(tdm.sws, src, srcStride, 0, height, tdm.frame_temporary->data, tdm.frame_temporary->linesize) < 0)
+  if (tdm.scaler.Scale(src, srcStride, tdm.frame_temporary->data, tdm.frame_temporary->linesize) < 0)
   {
     CLog::Log(LOGERROR, "SWS_SCALE failed for thumbnail: %s", destFile.c_str());
     CleanupLocalOutputBuffer();
@@ -28,9 +28,9 @@
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
-bool CGUIListItem::icompare::operator()(const std::string &s1, const std::string &s2) const
+namespace
 {
-  return StringUtils::CompareNoCase(s1, s2) < 0;
+const CGUIListItem::ArtMap emptyArt;
 }
 
 CGUIListItem::CGUIListItem(const CGUIListItem& item)
@@ -111,31 +111,53 @@ const std::wstring& CGUIListItem::GetSortLabel() const
   return m_sortLabel;
 }
 
+CGUIListItem::ArtMap &CGUIListItem::GetMutableArt()
+{
+  if (!m_art)
+    m_art = std::make_shared<ArtMap>();
+  else if (!m_art.unique())
+    m_art = std::make_shared<ArtMap>(*m_art);
+  return *m_art;
+}
+
+CGUIListItem::ArtMap &CGUIListItem::GetMutableArtFallbacks()
+{
+  if (!m_artFallbacks)
+    m_artFallbacks = std::make_shared<ArtMap>();
+  else if (!m_artFallbacks.unique())
+    m_artFallbacks = std::make_shared<ArtMap>(*m_artFallbacks);
+  return *m_artFallbacks;
+}
+
 void CGUIListItem::SetArt(const std::string &type, const std::string &url)
 {
-  ArtMap::iterator i = m_art.find(type);
-  if (i == m_art.end() || i->second != url)
+  const ArtMap &art = GetArt();
+  ArtMap::const_iterator i = art.find(type);
+  if (i == art.end() || i->second != url)
   {
-    m_art[type] = url;
+    GetMutableArt()[type] = url;
     SetInvalid();
   }
 }
 
 void CGUIListItem::SetArt(const ArtMap &art)
 {
-  m_art = art;
+  if (art.empty())
+    m_art.reset();
+  else
+    m_art = std::make_shared<ArtMap>(art);
   SetInvalid();
 }
 
 void CGUIListItem::SetArtFallback(const std::string &from, const std::string &to)
 {
-  m_artFallbacks[from] = to;
+  GetMutableArtFallbacks()[from] = to;
 }
 
 void CGUIListItem::ClearArt()
 {
-  m_art.clear();
-  m_artFallbacks.clear();
+  m_art.reset();
+  m_artFallbacks.reset();
 }
 
 void CGUIListItem::AppendArt(const ArtMap &art, const std::string &prefix)
@@ -146,22 +168,26 @@ void CGUIListItem::AppendArt(const ArtMap &art, const std::string &prefix)
 
 std::string CGUIListItem::GetArt(const std::string &type) const
 {
-  ArtMap::const_iterator i = m_art.find(type);
-  if (i != m_art.end())
+  const ArtMap &art = GetArt();
+  ArtMap::const_iterator i = art.find(type);
+  if (i != art.end())
     return i->second;
-  i = m_artFallbacks.find(type);
-  if (i != m_artFallbacks.end())
+  if (m_artFallbacks)
   {
-    ArtMap::const_iterator j = m_art.find(i->second);
-    if (j != m_art.end())
-      return j->second;
+    i = m_artFallbacks->find(type);
+    if (i != m_artFallbacks->end())
+    {
+      ArtMap::const_iterator j = art.find(i->second);
+      if (j != art.end())
+        return j->second;
+    }
   }
   return "";
 }
 
 const CGUIListItem::ArtMap &CGUIListItem::GetArt() const
 {
-  return m_art;
+  return m_art ? *m_art : emptyArt;
 }
 
 bool CGUIListItem::HasArt(const std::string &type) const
@@ -267,14 +293,16 @@ void CGUIListItem::Archive(CArchive &ar)
       ar << it->first;
       ar << it->second;
     }
-    ar << (int)m_art.size();
-    for (ArtMap::const_iterator i = m_art.begin(); i != m_art.end(); ++i)
+    const ArtMap &art = GetArt();
+    ar << (int)art.size();
+    for (ArtMap::const_iterator i = art.begin(); i != art.end(); ++i)
     {
       ar << i->first;
       ar << i->second;
     }
-    ar << (int)m_artFallbacks.size();
-    for (ArtMap::const_iterator i = m_artFallbacks.begin(); i != m_artFallbacks.end(); ++i)
+    const ArtMap &artFallbacks = m_artFallbacks ? *m_artFallbacks : emptyArt;
+    ar << (int)artFallbacks.size();
+    for (ArtMap::const_iterator i = artFallbacks.begin(); i != artFallbacks.end(); ++i)
     {
       ar << i->first;
       ar << i->second;
@@ -309,7 +337,7 @@ void CGUIListItem::Archive(CArchive &ar)
       std::string key, value;
       ar >> key;
       ar >> value;
-      m_art.insert(make_pair(key, value));
+      GetMutableArt().insert(make_pair(key, value));
     }
     ar >> mapSize;
     for (int i = 0; i < mapSize; i++)
@@ -317,7 +345,7 @@ void CGUIListItem::Archive(CArchive &ar)
       std::string key, value;
       ar >> key;
       ar >> value;
-      m_artFallbacks.insert(make_pair(key, value));
+      GetMutableArtFallbacks().insert(make_pair(key, value));
     }
     SetInvalid();
   }
@@ -335,7 +363,8 @@ void CGUIListItem::Serialize(CVariant &value)
   {
     value["properties"][it->first] = it->second;
   }
-  for (ArtMap::const_iterator it = m_art.begin(); it != m_art.end(); ++it)
+  const ArtMap &art = GetArt();
+  for (ArtMap::const_iterator it = art.begin(); it != art.end(); ++it)
     value["art"][it->first] = it->second;
 }
 
@@ -391,12 +420,28 @@ void CGUIListItem::SetInvalid()
   if (m_focusedLayout) m_focusedLayout->SetInvalid();
 }
 
+CGUIListItem::PropertyMap::iterator CGUIListItem::FindProperty(const std::string &strKey)
+{
+  PropertyMap::iterator iter = m_mapProperties.begin();
+  while (iter != m_mapProperties.end() && !StringUtils::EqualsNoCase(iter->first, strKey))
+    ++iter;
+  return iter;
+}
+
+CGUIListItem::PropertyMap::const_iterator CGUIListItem::FindProperty(const std::string &strKey) const
+{
+  PropertyMap::const_iterator iter = m_mapProperties.begin();
+  while (iter != m_mapProperties.end() && !StringUtils::EqualsNoCase(iter->first, strKey))
+    ++iter;
+  return iter;
+}
+
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::iterator iter = FindProperty(strKey);
   if (iter == m_mapProperties.end())
   {
-    m_mapProperties.insert(make_pair(strKey, value));
+    m_mapProperties.push_back(make_pair(strKey, value));
     SetInvalid();
   }
   else if (iter->second != value)
@@ -408,7 +453,7 @@ void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 
 const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::const_iterator iter = FindProperty(strKey);
   static CVariant nullVariant = CVariant(CVariant::VariantTypeNull);
   
   if (iter == m_mapProperties.end())
@@ -419,7 +464,7 @@ const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 
 bool CGUIListItem::HasProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::const_iterator iter = FindProperty(strKey);
   if (iter == m_mapProperties.end())
     return false;
 
@@ -428,7 +473,7 @@ bool CGUIListItem::HasProperty(const std::string &strKey) const
 
 void CGUIListItem::ClearProperty(const std::string &strKey)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::iterator iter = FindProperty(strKey);
   if (iter != m_mapProperties.end())
   {
     m_mapProperties.erase(iter);
@@ -29,7 +29,10 @@
  */
 
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 //  Forward
 class CGUIListItemLayout;
@@ -186,19 +189,25 @@ protected:
   CGUIListItemLayout *m_focusedLayout;
   bool m_bSelected;     // item is selected or not
 
-  struct icompare
-  {
-    bool operator()(const std::string &s1, const std::string &s2) const;
-  };
-
-  typedef std::map<std::string, CVariant, icompare> PropertyMap;
+  /*! \brief Names are compared ignoring case and keep the case they were
+   set with. Items only have a few properties, so a vector is both smaller and
+   faster to search than a map.
+   */
+  typedef std::vector<std::pair<std::string, CVariant> > PropertyMap;
   PropertyMap m_mapProperties;
 private:
+  PropertyMap::iterator FindProperty(const std::string &strKey);
+  PropertyMap::const_iterator FindProperty(const std::string &strKey) const;
+
+  ArtMap &GetMutableArt();
+  ArtMap &GetMutableArtFallbacks();
+
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
 
-  ArtMap m_art;
-  ArtMap m_artFallbacks;
+  // shared between copies of the item until one of them changes them
+  std::shared_ptr<ArtMap> m_art;
+  std::shared_ptr<ArtMap> m_artFallbacks;
 };
 #endif
 
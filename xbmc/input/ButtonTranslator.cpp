@@ -21,6 +21,7 @@
 #include "ButtonTranslator.h"
 
 #include <algorithm>
+#include <set>
 #include <utility>
 
 #include "FileItem.h"
@@ -500,6 +501,17 @@ static const ActionMapping appcommands[] =
 };
 #endif
 
+// the action and window names are looked up for every mapping while loading the keymaps
+template<size_t N>
+static std::unordered_map<std::string, int> IndexByName(const ActionMapping (&mappings)[N])
+{
+  std::unordered_map<std::string, int> index;
+  // insert() keeps the first of duplicate names, like searching the table did
+  for (unsigned int i = 0; i < N; ++i)
+    index.insert(std::make_pair(std::string(mappings[i].name), mappings[i].action));
+  return index;
+}
+
 CButtonTranslator& CButtonTranslator::GetInstance()
 {
   static CButtonTranslator sl_instance;
@@ -620,6 +632,7 @@ bool CButtonTranslator::Load(bool AlwaysLoad)
   if (!success)
   {
     CLog::Log(LOGERROR, "Error loading keymaps from: %s or %s or %s", DIRS_TO_CHECK[0], DIRS_TO_CHECK[1], DIRS_TO_CHECK[2]);
+    m_compiledMap.clear();
     return false;
   }
 
@@ -652,6 +665,8 @@ bool CButtonTranslator::Load(bool AlwaysLoad)
     m_translatorMap[WINDOW_DIALOG_DSPLAYER_PROCESS_INFO] = m_translatorMap[WINDOW_DIALOG_PLAYER_PROCESS_INFO];
 #endif
 
+  CompileMaps();
+
   // Done!
   m_Loaded = true;
   return true;
@@ -923,22 +938,17 @@ int CButtonTranslator::GetFallbackWindow(int windowID)
 
 CAction CButtonTranslator::GetAction(int window, const CKey &key, bool fallback)
 {
-  std::string strAction;
-  // try to get the action from the current window
-  int actionID = GetActionCode(window, key, strAction);
-  // if it's invalid, try to get it from the global map
-  if (actionID == 0 && fallback)
-  {
-    int fallbackWindow = GetFallbackWindow(window);
-    if (fallbackWindow > -1)
-      actionID = GetActionCode(fallbackWindow, key, strAction);
-    // still no valid action? use global map
-    if (actionID == 0)
-      actionID = GetActionCode( -1, key, strAction);
-  }
+  // the compiled map already contains the fallback window and global mappings
+  const CButtonAction *button;
+  if (fallback)
+    button = GetCompiledButtonAction(window, key.GetButtonCode());
+  else
+    button = GetButtonAction(window, key.GetButtonCode());
+
   // Now fill our action structure
-  CAction action(actionID, strAction, key);
-  return action;
+  if (!button)
+    return CAction(0, "", key);
+  return CAction(button->id, button->strID, key);
 }
 
 CAction CButtonTranslator::GetGlobalAction(const CKey &key)
@@ -985,40 +995,115 @@ bool CButtonTranslator::HasLonpressMapping(int window, const CKey &key)
   return false;
 }
 
-int CButtonTranslator::GetActionCode(int window, const CKey &key, std::string &strAction) const
+const CButtonAction* CButtonTranslator::GetButtonAction(int window, uint32_t code) const
 {
-  uint32_t code = key.GetButtonCode();
-
   std::map<int, buttonMap>::const_iterator it = m_translatorMap.find(window);
   if (it == m_translatorMap.end())
-    return 0;
+    return NULL;
   buttonMap::const_iterator it2 = (*it).second.find(code);
-  int action = 0;
   if (it2 == (*it).second.end() && code & CKey::MODIFIER_LONG) // If long action not found, try short one
   {
     code &= ~CKey::MODIFIER_LONG;
     it2 = (*it).second.find(code);
   }
   if (it2 != (*it).second.end())
-  {
-    action = (*it2).second.id;
-    strAction = (*it2).second.strID;
-  }
+    return &(*it2).second;
 #ifdef TARGET_POSIX
   // Some buttoncodes changed in Hardy
-  if (action == 0 && (code & KEY_VKEY) == KEY_VKEY && (code & 0x0F00))
+  if ((code & KEY_VKEY) == KEY_VKEY && (code & 0x0F00))
   {
-    CLog::Log(LOGDEBUG, "%s: Trying Hardy keycode for %#04x", __FUNCTION__, code);
     code &= ~0x0F00;
     it2 = (*it).second.find(code);
     if (it2 != (*it).second.end())
+      return &(*it2).second;
+  }
+#endif
+  return NULL;
+}
+
+const CButtonAction* CButtonTranslator::ResolveButtonAction(int window, uint32_t code) const
+{
+  // try to get the action from the current window
+  const CButtonAction *button = GetButtonAction(window, code);
+  if (!button)
+  {
+    int fallbackWindow = GetFallbackWindow(window);
+    if (fallbackWindow > -1)
+      button = GetButtonAction(fallbackWindow, code);
+    // still no valid action? use global map
+    if (!button)
+      button = GetButtonAction(-1, code);
+  }
+  return button;
+}
+
+const CButtonAction* CButtonTranslator::GetCompiledButtonAction(int window, uint32_t code) const
+{
+  std::unordered_map<int, compiledButtonMap>::const_iterator it = m_compiledMap.find(window);
+  if (it == m_compiledMap.end())
+  {
+    // no mappings of its own, so it's the same as its fallback window or the global map
+    int fallbackWindow = GetFallbackWindow(window);
+    it = m_compiledMap.find(fallbackWindow > -1 ? fallbackWindow : -1);
+    if (it == m_compiledMap.end())
+      return NULL;
+  }
+
+  compiledButtonMap::const_iterator it2 = it->second.find(code);
+  if (it2 != it->second.end())
+    return it2->second;
+
+#ifdef TARGET_POSIX
+  // Some buttoncodes changed in Hardy. The older code is tried window by window
+  // along the fallback chain, so the window's older code wins over the code itself
+  // in a fallback window. Codes mapped anywhere are compiled, so this is rare.
+  if ((code & KEY_VKEY) == KEY_VKEY && (code & 0x0F00))
+  {
+    CLog::Log(LOGDEBUG, "%s: Trying Hardy keycode for %#04x", __FUNCTION__, code);
+    return ResolveButtonAction(window, code);
+  }
+#endif
+  return NULL;
+}
+
+void CButtonTranslator::CompileMaps()
+{
+  m_compiledMap.clear();
+
+  // windows without mappings of their own are looked up in the map of their fallback window
+  std::set<int> windows;
+  for (std::map<int, buttonMap>::const_iterator it = m_translatorMap.begin(); it != m_translatorMap.end(); ++it)
+    windows.insert(it->first);
+  for (unsigned int index = 0; index < ARRAY_SIZE(fallbackWindows); ++index)
+    windows.insert(fallbackWindows[index].origin);
+  windows.insert(WINDOW_ADDON_START);
+  windows.insert(-1);
+
+  for (std::set<int>::const_iterator window = windows.begin(); window != windows.end(); ++window)
+  {
+    const int chain[] = { *window, GetFallbackWindow(*window), -1 };
+    compiledButtonMap &compiled = m_compiledMap[*window];
+    for (unsigned int index = 0; index < ARRAY_SIZE(chain); ++index)
     {
-      action = (*it2).second.id;
-      strAction = (*it2).second.strID;
+      std::map<int, buttonMap>::const_iterator it = m_translatorMap.find(chain[index]);
+      if (it == m_translatorMap.end())
+        continue;
+
+      for (buttonMap::const_iterator it2 = it->second.begin(); it2 != it->second.end(); ++it2)
+      {
+        // a long press falls back to the short one
+        const uint32_t codes[] = { it2->first, it2->first | CKey::MODIFIER_LONG };
+        for (unsigned int codeIndex = 0; codeIndex < ARRAY_SIZE(codes); ++codeIndex)
+        {
+          if (compiled.find(codes[codeIndex]) != compiled.end())
+            continue;
+          const CButtonAction *button = ResolveButtonAction(*window, codes[codeIndex]);
+          if (button)
+            compiled[codes[codeIndex]] = button;
+        }
+      }
     }
   }
-#endif
-  return action;
 }
 
 void CButtonTranslator::MapAction(uint32_t buttonCode, const char *szAction, buttonMap &map)
@@ -1188,14 +1273,10 @@ bool CButtonTranslator::TranslateActionString(const char *szAction, int &action)
   if (CBuiltins::GetInstance().HasCommand(strAction))
     action = ACTION_BUILT_IN_FUNCTION;
 
-  for (unsigned int index=0;index < ARRAY_SIZE(actions);++index)
-  {
-    if (strAction == actions[index].name)
-    {
-      action = actions[index].action;
-      break;
-    }
-  }
+  static const std::unordered_map<std::string, int> actionsByName = IndexByName(actions);
+  std::unordered_map<std::string, int>::const_iterator it = actionsByName.find(strAction);
+  if (it != actionsByName.end())
+    action = it->second;
 
   if (action == ACTION_NONE)
   {
@@ -1240,12 +1321,10 @@ int CButtonTranslator::TranslateWindow(const std::string &window)
     return WINDOW_HOME + iWindow;
   }
 
-  // run through the window structure
-  for (unsigned int index = 0; index < ARRAY_SIZE(windows); ++index)
-  {
-    if (strWindow == windows[index].name)
-      return windows[index].action;
-  }
+  static const std::unordered_map<std::string, int> windowsByName = IndexByName(windows);
+  std::unordered_map<std::string, int>::const_iterator it = windowsByName.find(strWindow);
+  if (it != windowsByName.end())
+    return it->second;
 
   CLog::Log(LOGERROR, "Window Translator: Can't find window %s", strWindow.c_str());
   return WINDOW_INVALID;
@@ -1515,6 +1594,7 @@ uint32_t CButtonTranslator::TranslateMouseCommand(TiXmlElement *pButton)
 void CButtonTranslator::Clear()
 {
   m_translatorMap.clear();
+  m_compiledMap.clear();
 #if defined(HAS_LIRC) || defined(HAS_IRSERVERSUITE)
   ClearLircButtonMapEntries();
   lircRemotesMap.clear();
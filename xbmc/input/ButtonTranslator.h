@@ -25,6 +25,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "system.h" // for HAS_EVENT_SERVER
 
@@ -50,6 +51,7 @@ class CButtonTranslator
 #ifdef HAS_EVENT_SERVER
   friend class EVENTCLIENT::CEventButtonState;
 #endif
+  friend class TestButtonTranslatorHelper;
 
 private:
   //private construction, and no assignments; use the provided singleton methods
@@ -125,9 +127,20 @@ private:
   // m_deviceList contains the list of connected HID devices
   std::list<std::string> m_deviceList;
 
+  // m_compiledMap contains, for every window with mappings, the action every button
+  // resolves to with the mappings of its fallback window and the global ones merged in
+  typedef std::unordered_map<uint32_t, const CButtonAction*> compiledButtonMap;
+  std::unordered_map<int, compiledButtonMap> m_compiledMap;
+
   int GetActionCode(int window, int action);
-  int GetActionCode(int window, const CKey &key, std::string &strAction) const;
-  int GetFallbackWindow(int windowID);
+  const CButtonAction* GetButtonAction(int window, uint32_t code) const;
+  const CButtonAction* ResolveButtonAction(int window, uint32_t code) const;
+  const CButtonAction* GetCompiledButtonAction(int window, uint32_t code) const;
+  static int GetFallbackWindow(int windowID);
+
+  /*! \brief Builds m_compiledMap from m_translatorMap, must be called whenever the latter changed
+   */
+  void CompileMaps();
 
   static uint32_t TranslateGamepadString(const char *szButton);
   static uint32_t TranslateRemoteString(const char *szButton);
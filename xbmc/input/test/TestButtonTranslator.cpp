@@ -0,0 +1,174 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "guilib/WindowIDs.h"
+#include "input/ButtonTranslator.h"
+#include "input/Key.h"
+
+#include "gtest/gtest.h"
+
+class TestButtonTranslatorHelper
+{
+public:
+  typedef CButtonTranslator::buttonMap ButtonMap;
+
+  // every window with mappings, every named window and an add-on window without mappings
+  static std::set<int> GetWindows(const CButtonTranslator &translator)
+  {
+    std::set<int> windows;
+    for (const auto &window : translator.m_translatorMap)
+      windows.insert(window.first);
+
+    std::vector<std::string> windowNames;
+    CButtonTranslator::GetWindows(windowNames);
+    for (const auto &windowName : windowNames)
+      windows.insert(CButtonTranslator::TranslateWindow(windowName));
+
+    windows.insert(WINDOW_ADDON_START + 5);
+    windows.insert(-1);
+    return windows;
+  }
+
+  // every mapped code, its long press, older Hardy codes and one code that isn't mapped
+  static std::set<uint32_t> GetCodes(const CButtonTranslator &translator)
+  {
+    std::set<uint32_t> codes;
+    for (const auto &window : translator.m_translatorMap)
+    {
+      for (const auto &button : window.second)
+      {
+        uint32_t code = button.first & ~CKey::MODIFIER_LONG;
+        codes.insert(code);
+        codes.insert(code | CKey::MODIFIER_LONG);
+        if ((code & KEY_VKEY) == KEY_VKEY && !(code & 0x0F00))
+        {
+          codes.insert(code | 0x0100);
+          codes.insert(code | 0x0100 | CKey::MODIFIER_LONG);
+        }
+      }
+    }
+    codes.insert(0x12345678);
+    return codes;
+  }
+
+  static const CButtonAction* Resolve(const CButtonTranslator &translator, int window, uint32_t code)
+  {
+    return translator.ResolveButtonAction(window, code);
+  }
+
+  static void SetMaps(CButtonTranslator &translator, const std::map<int, ButtonMap> &maps)
+  {
+    translator.m_translatorMap = maps;
+    translator.CompileMaps();
+  }
+
+  static ButtonMap CreateMap(uint32_t code, int action)
+  {
+    CButtonAction button;
+    button.id = action;
+    ButtonMap map;
+    map.insert(std::make_pair(code, button));
+    return map;
+  }
+
+  static const CButtonAction* GetCompiled(const CButtonTranslator &translator, int window, uint32_t code)
+  {
+    return translator.GetCompiledButtonAction(window, code);
+  }
+};
+
+TEST(TestButtonTranslator, CompiledMapsMatchFallbackChain)
+{
+  CButtonTranslator &translator = CButtonTranslator::GetInstance();
+  ASSERT_TRUE(translator.Load(true));
+
+  std::set<int> windows = TestButtonTranslatorHelper::GetWindows(translator);
+  std::set<uint32_t> codes = TestButtonTranslatorHelper::GetCodes(translator);
+  ASSERT_FALSE(codes.empty());
+
+  unsigned int mapped = 0;
+  for (int window : windows)
+  {
+    for (uint32_t code : codes)
+    {
+      const CButtonAction *expected = TestButtonTranslatorHelper::Resolve(translator, window, code);
+      EXPECT_EQ(expected, TestButtonTranslatorHelper::GetCompiled(translator, window, code))
+        << "window " << window << ", button code " << std::hex << code;
+      if (expected)
+        ++mapped;
+    }
+  }
+  EXPECT_GT(mapped, 0u);
+
+  translator.Clear();
+}
+
+#ifdef TARGET_POSIX
+TEST(TestButtonTranslator, HardyCodesKeepWindowPrecedence)
+{
+  const uint32_t oldCode = KEY_VKEY | 0x25;
+  const uint32_t newCode = KEY_VKEY | 0x0100 | 0x25;
+
+  std::map<int, TestButtonTranslatorHelper::ButtonMap> maps;
+  maps[WINDOW_HOME] = TestButtonTranslatorHelper::CreateMap(oldCode, ACTION_MOVE_LEFT);
+  maps[-1] = TestButtonTranslatorHelper::CreateMap(newCode, ACTION_SELECT_ITEM);
+
+  CButtonTranslator &translator = CButtonTranslator::GetInstance();
+  TestButtonTranslatorHelper::SetMaps(translator, maps);
+
+  // the older code in the window comes before the code itself in the global map
+  const CButtonAction *button = TestButtonTranslatorHelper::GetCompiled(translator, WINDOW_HOME, newCode);
+  ASSERT_TRUE(button != NULL);
+  EXPECT_EQ(ACTION_MOVE_LEFT, button->id);
+
+  button = TestButtonTranslatorHelper::GetCompiled(translator, WINDOW_HOME, newCode | CKey::MODIFIER_LONG);
+  ASSERT_TRUE(button != NULL);
+  EXPECT_EQ(ACTION_MOVE_LEFT, button->id);
+
+  // codes mapped nowhere are resolved the same way
+  button = TestButtonTranslatorHelper::GetCompiled(translator, WINDOW_HOME, KEY_VKEY | 0x0200 | 0x25);
+  ASSERT_TRUE(button != NULL);
+  EXPECT_EQ(ACTION_MOVE_LEFT, button->id);
+
+  button = TestButtonTranslatorHelper::GetCompiled(translator, WINDOW_SETTINGS_MENU, newCode);
+  ASSERT_TRUE(button != NULL);
+  EXPECT_EQ(ACTION_SELECT_ITEM, button->id);
+
+  translator.Clear();
+}
+#endif
+
+TEST(TestButtonTranslator, TranslateNames)
+{
+  int action;
+  EXPECT_TRUE(CButtonTranslator::TranslateActionString("left", action));
+  EXPECT_EQ(ACTION_MOVE_LEFT, action);
+  EXPECT_TRUE(CButtonTranslator::TranslateActionString("ParentDir", action));
+  EXPECT_EQ(ACTION_NAV_BACK, action);
+  EXPECT_FALSE(CButtonTranslator::TranslateActionString("nosuchaction", action));
+
+  EXPECT_EQ(WINDOW_HOME, CButtonTranslator::TranslateWindow("Home.xml"));
+  EXPECT_EQ(WINDOW_INVALID, CButtonTranslator::TranslateWindow("nosuchwindow"));
+}
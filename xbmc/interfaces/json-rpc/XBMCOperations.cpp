@@ -20,6 +20,7 @@
 
 #include "XBMCOperations.h"
 #include "messaging/ApplicationMessenger.h"
+#include "utils/JobManager.h"
 #include "utils/Variant.h"
 #include "powermanagement/PowerManager.h"
 
@@ -95,3 +96,35 @@ JSONRPC_STATUS CXBMCOperations::GetInfoBooleans(const std::string &method, ITran
 
   return OK;
 }
+
+static CVariant SerializeJobStats(const JobStats &stats)
+{
+  CVariant result(CVariant::VariantTypeObject);
+  result["queued"] = stats.queued;
+  result["processing"] = stats.processing;
+  result["completed"] = stats.completed;
+  result["averagewaittime"] = stats.completed > 0 ? stats.totalWaitTime / stats.completed : 0;
+  result["maxwaittime"] = stats.maxWaitTime;
+  result["averageruntime"] = stats.completed > 0 ? stats.totalRunTime / stats.completed : 0;
+  result["maxruntime"] = stats.maxRunTime;
+  return result;
+}
+
+JSONRPC_STATUS CXBMCOperations::GetJobStats(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  static const char* const priorityNames[] = { "lowpausable", "low", "normal", "high", "dedicated" };
+
+  std::map<std::string, JobStats> types;
+  std::vector<JobStats> priorities;
+  CJobManager::GetInstance().GetStats(types, priorities);
+
+  result["priorities"] = CVariant(CVariant::VariantTypeObject);
+  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED && priority < priorities.size(); ++priority)
+    result["priorities"][priorityNames[priority]] = SerializeJobStats(priorities[priority]);
+
+  result["types"] = CVariant(CVariant::VariantTypeObject);
+  for (const auto& type : types)
+    result["types"][type.first] = SerializeJobStats(type.second);
+
+  return OK;
+}
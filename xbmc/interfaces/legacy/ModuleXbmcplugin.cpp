@@ -20,9 +20,12 @@
 
 #include "ModuleXbmcplugin.h"
 
+#include "LanguageHook.h"
 #include "filesystem/PluginDirectory.h"
 #include "FileItem.h"
 
+#include <map>
+
 namespace XBMCAddon
 {
 
@@ -43,17 +46,45 @@ namespace XBMCAddon
                            const std::vector<Tuple<String,const XBMCAddon::xbmcgui::ListItem*,bool> >& items, 
                            int totalItems)
     {
-      CFileItemList fitems;
+      // take the items out of the list items while we still hold the GIL.
+      // the script gets fresh, empty items back so nothing it does later can
+      // touch what the listing owns. a list item passed more than once is only
+      // taken once, the repeats are copies of it.
+      std::vector<CFileItemPtr> fileItems;
+      std::map<const XBMCAddon::xbmcgui::ListItem*, CFileItemPtr> taken;
+      fileItems.reserve(items.size());
       for (std::vector<Tuple<String,const XBMCAddon::xbmcgui::ListItem*,bool> >::const_iterator item = items.begin();
            item < items.end(); ++item )
       {
-        const Tuple<String,const XBMCAddon::xbmcgui::ListItem*,bool>* pItem = &(*item);
-        const String& url = pItem->first();
-        const XBMCAddon::xbmcgui::ListItem *pListItem = pItem->second();
-        bool bIsFolder = pItem->GetNumValuesSet() > 2 ? pItem->third() : false;
-        pListItem->item->SetPath(url);
-        pListItem->item->m_bIsFolder = bIsFolder;
-        fitems.Add(pListItem->item);
+        const XBMCAddon::xbmcgui::ListItem *pListItem = item->second();
+        std::map<const XBMCAddon::xbmcgui::ListItem*, CFileItemPtr>::const_iterator it = taken.find(pListItem);
+        if (it != taken.end())
+        {
+          fileItems.push_back(CFileItemPtr());
+          continue;
+        }
+
+        CFileItemPtr fileItem(new CFileItem());
+        const_cast<XBMCAddon::xbmcgui::ListItem*>(pListItem)->item.swap(fileItem);
+        taken.insert(std::make_pair(pListItem, fileItem));
+        fileItems.push_back(fileItem);
+      }
+
+      // the items are ours now, let other python threads run while we convert
+      // and hand them over
+      DelayedCallGuard dg;
+
+      CFileItemList fitems;
+      for (size_t i = 0; i < items.size(); ++i)
+      {
+        const Tuple<String,const XBMCAddon::xbmcgui::ListItem*,bool>& item = items[i];
+        CFileItemPtr fileItem = fileItems[i];
+        if (!fileItem)
+          fileItem.reset(new CFileItem(*taken[item.second()]));
+
+        fileItem->SetPath(item.first());
+        fileItem->m_bIsFolder = item.GetNumValuesSet() > 2 ? item.third() : false;
+        fitems.Add(fileItem);
       }
 
       // call the directory class to add our items
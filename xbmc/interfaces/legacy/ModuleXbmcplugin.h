@@ -97,7 +97,10 @@ namespace XBMCAddon
     /// @return                     Returns a bool for successful completion.
     ///
     /// @remark Large lists benefit over using the standard addDirectoryItem().
-    /// You may call this more than once to add items in chunks.
+    /// You may call this more than once to add items in chunks, each chunk
+    /// counts towards the progress shown while the listing is retrieved.
+    /// The items are only shown once the plugin ends the directory.
+    /// The list items are handed over to Kodi, afterwards they are empty.
     ///
     ///
     /// ------------------------------------------------------------------------
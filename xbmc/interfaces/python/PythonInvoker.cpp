@@ -31,6 +31,7 @@
 #include "Application.h"
 #include "messaging/ApplicationMessenger.h"
 #include "addons/AddonManager.h"
+#include "addons/PluginSource.h"
 #include "dialogs/GUIDialogKaiToast.h"
 #include "filesystem/File.h"
 #include "filesystem/SpecialProtocol.h"
@@ -161,9 +162,21 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
 
   CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): start processing", GetId(), m_sourceFile.c_str());
 
+  // add-ons can ask for their interpreter to be kept alive between invocations
+  // which saves setting it up and importing all modules again
+  unsigned int idleTimeout = 0;
+  std::shared_ptr<ADDON::CPluginSource> plugin = std::dynamic_pointer_cast<ADDON::CPluginSource>(m_addon);
+  if (plugin)
+    idleTimeout = plugin->GetInterpreterIdleTimeout();
+  PyInterpreterState* interp = NULL;
+  if (idleTimeout > 0)
+    interp = static_cast<PyInterpreterState*>(g_pythonParser.AcquireInterpreter(m_addon->ID()));
+  bool reused = interp != NULL;
+
   // get the global lock
   PyEval_AcquireLock();
-  PyThreadState* state = Py_NewInterpreter();
+  // a kept interpreter gets a new thread state for the thread we run on
+  PyThreadState* state = reused ? PyThreadState_New(interp) : Py_NewInterpreter();
   if (state == NULL)
   {
     PyEval_ReleaseLock();
@@ -173,9 +186,25 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
   // swap in my thread state
   PyThreadState_Swap(state);
 
-  XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> languageHook(new XBMCAddon::Python::PythonLanguageHook(state->interp));
-  languageHook->RegisterMe();
+  XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> languageHook;
+  if (reused)
+  {
+    CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): reusing the interpreter of the previous invocation", GetId(), m_sourceFile.c_str());
+    languageHook = XBMCAddon::Python::PythonLanguageHook::GetIfExists(state->interp);
+
+    // undo the end of the last run, the modules are initialized again below
+    PyObject *m = PyImport_AddModule((char*)"xbmc");
+    if (m == NULL || PyObject_SetAttrString(m, (char*)"abortRequested", Py_False))
+      CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): failed to reset abortRequested", GetId(), m_sourceFile.c_str());
+  }
+  else
+  {
+    languageHook = new XBMCAddon::Python::PythonLanguageHook(state->interp);
+    languageHook->RegisterMe();
+  }
 
+  // onDeinitialization() ran at the end of the last run of a kept interpreter,
+  // so the modules and the initialization script are set up on every run
   onInitialization();
   setState(InvokerStateInitialized);
 
@@ -231,6 +260,17 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
 
   Py_DECREF(sysMod); // release ref to sysMod
 
+  // a reused interpreter still has the paths of its last run in sys.path,
+  // keep each path once so sys.path doesn't grow with every invocation
+  std::vector<std::string> pythonPaths = StringUtils::Split(m_pythonPath, std::string(1, PY_PATH_SEP));
+  std::set<std::string> uniquePaths;
+  m_pythonPath.clear();
+  for (std::vector<std::string>::const_iterator it = pythonPaths.begin(); it != pythonPaths.end(); ++it)
+  {
+    if (uniquePaths.insert(*it).second)
+      addNativePath(*it);
+  }
+
   // set current directory and python's path.
   if (m_argv != NULL)
     PySys_SetArgv(m_argc, m_argv);
@@ -411,6 +451,36 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
       PyRun_SimpleString(GC_SCRIPT) == -1)
     CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): failed to run the gc to clean up after running prior to shutting down the Interpreter", GetId(), m_sourceFile.c_str());
 
+  // keep the interpreter for the next invocation if the script finished
+  // cleanly and left nothing behind that could call back into it
+  if (idleTimeout > 0 && stateToSet == InvokerStateDone && !m_stop && !languageHook->HasRegisteredAddonClasses())
+  {
+    // the next run starts with an empty __main__, imported modules stay loaded
+    PyDict_Clear(moduleDict);
+    PyDict_SetItemString(moduleDict, "__builtins__", PyEval_GetBuiltins());
+    PyObject *name = PyString_FromString("__main__");
+    PyDict_SetItemString(moduleDict, "__name__", name);
+    Py_DECREF(name);
+
+    // the thread state belongs to this thread, the next run creates its own
+    interp = state->interp;
+    PyThreadState_Clear(state);
+    PyThreadState_Swap(NULL);
+    PyThreadState_Delete(state);
+    PyEval_ReleaseLock();
+
+    if (g_pythonParser.ReleaseInterpreter(m_addon->ID(), interp, idleTimeout))
+    {
+      CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): keeping the interpreter for %u seconds", GetId(), m_sourceFile.c_str(), idleTimeout);
+      setState(stateToSet);
+      return true;
+    }
+
+    PyEval_AcquireLock();
+    state = PyThreadState_New(interp);
+    PyThreadState_Swap(state);
+  }
+
   Py_EndInterpreter(state);
 
   // If we still have objects left around, produce an error message detailing what's been left behind
@@ -48,6 +48,7 @@
 #include "interfaces/legacy/Monitor.h"
 #include "interfaces/legacy/AddonUtils.h"
 #include "interfaces/python/AddonPythonInvoker.h"
+#include "interfaces/python/LanguageHook.h"
 #include "interfaces/python/PythonInvoker.h"
 
 using namespace ANNOUNCEMENT;
@@ -500,6 +501,8 @@ void XBPython::Uninitialize()
 
   // cleanup threads that are still running
   tmpvec.clear(); // boost releases the XBPyThreads which, if deleted, calls OnScriptFinalized
+
+  EndIdleInterpreters(true);
 }
 
 void XBPython::Process()
@@ -524,14 +527,78 @@ void XBPython::Process()
     //delete scripts which are done
     tmpvec.clear(); // boost releases the XBPyThreads which, if deleted, calls OnScriptFinalized
 
+    EndIdleInterpreters(false);
+
     CSingleLock l2(m_critSection);
-    if(m_iDllScriptCounter == 0 && (XbmcThreads::SystemClockMillis() - m_endtime) > 10000 )
+    if(m_iDllScriptCounter == 0 && m_idleInterpreters.empty() && (XbmcThreads::SystemClockMillis() - m_endtime) > 10000 )
     {
       Finalize();
     }
   }
 }
 
+void* XBPython::AcquireInterpreter(const std::string &addonId)
+{
+  CSingleLock lock(m_critSection);
+  std::map<std::string, IdleInterpreter>::iterator it = m_idleInterpreters.find(addonId);
+  if (it == m_idleInterpreters.end())
+    return NULL;
+
+  void* interp = it->second.interp;
+  m_idleInterpreters.erase(it);
+  return interp;
+}
+
+bool XBPython::ReleaseInterpreter(const std::string &addonId, void* interp, unsigned int idleTimeout)
+{
+  CSingleLock lock(m_critSection);
+  // keep a single interpreter per add-on, concurrent invocations end theirs
+  if (!m_bInitialized || interp == NULL || m_idleInterpreters.find(addonId) != m_idleInterpreters.end())
+    return false;
+
+  IdleInterpreter interpreter;
+  interpreter.interp = interp;
+  interpreter.idleTimeout = idleTimeout * 1000;
+  interpreter.idleSince = XbmcThreads::SystemClockMillis();
+  m_idleInterpreters.insert(std::make_pair(addonId, interpreter));
+  return true;
+}
+
+void XBPython::EndIdleInterpreters(bool all)
+{
+  std::vector<std::pair<std::string, void*> > expired;
+  {
+    CSingleLock lock(m_critSection);
+    unsigned int now = XbmcThreads::SystemClockMillis();
+    for (std::map<std::string, IdleInterpreter>::iterator it = m_idleInterpreters.begin(); it != m_idleInterpreters.end();)
+    {
+      if (all || now - it->second.idleSince > it->second.idleTimeout)
+      {
+        expired.push_back(std::make_pair(it->first, it->second.interp));
+        it = m_idleInterpreters.erase(it);
+      }
+      else
+        ++it;
+    }
+  }
+
+  // the GIL must not be taken while holding m_critSection
+  for (std::vector<std::pair<std::string, void*> >::const_iterator it = expired.begin(); it != expired.end(); ++it)
+  {
+    CLog::Log(LOGDEBUG, "Python, ending idle interpreter of %s", it->first.c_str());
+    PyInterpreterState* interp = static_cast<PyInterpreterState*>(it->second);
+    PyEval_AcquireLock();
+    // kept interpreters have no thread state, end them from one of this thread
+    PyThreadState* state = PyThreadState_New(interp);
+    PyThreadState_Swap(state);
+    XBMCAddon::AddonClass::Ref<XBMCAddon::Python::PythonLanguageHook> languageHook =
+      XBMCAddon::Python::PythonLanguageHook::GetIfExists(interp);
+    Py_EndInterpreter(state);
+    languageHook->UnregisterMe();
+    PyEval_ReleaseLock();
+  }
+}
+
 bool XBPython::OnScriptInitialized(ILanguageInvoker *invoker)
 {
   if (invoker == NULL)
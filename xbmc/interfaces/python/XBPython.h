@@ -28,7 +28,9 @@
 #include "interfaces/generic/ILanguageInvocationHandler.h"
 #include "ServiceBroker.h"
 
+#include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #define g_pythonParser CServiceBroker::GetXBPython()
@@ -106,12 +108,39 @@ public:
 
   bool WaitForEvent(CEvent& hEvent, unsigned int milliseconds);
 
+  /*!
+   \brief Take the warm interpreter kept for an add-on out of the pool
+   \param addonId the add-on the interpreter has been initialized for
+   \return the PyInterpreterState, NULL if there is none waiting. The caller
+           creates a thread state for it on its own thread.
+   */
+  void* AcquireInterpreter(const std::string &addonId);
+
+  /*!
+   \brief Keep an interpreter alive for the next invocation of an add-on
+   The GIL must not be held when calling this and the caller must have deleted
+   its thread state. Interpreters idle for longer than idleTimeout are ended by Process().
+   \param addonId the add-on the interpreter has been initialized for
+   \param interp the PyInterpreterState
+   \param idleTimeout seconds to keep the interpreter around
+   \return false if the pool doesn't take the interpreter and the caller has to end it
+   */
+  bool ReleaseInterpreter(const std::string &addonId, void* interp, unsigned int idleTimeout);
+
   void RegisterExtensionLib(LibraryLoader *pLib);
   void UnregisterExtensionLib(LibraryLoader *pLib);
   void UnloadExtensionLibs();
 
 private:
   void Finalize();
+  void EndIdleInterpreters(bool all);
+
+  struct IdleInterpreter
+  {
+    void*        interp;      // PyInterpreterState without thread states
+    unsigned int idleTimeout; // ms
+    unsigned int idleSince;
+  };
 
   CCriticalSection    m_critSection;
   bool              FileExist(const char* strFile);
@@ -121,6 +150,7 @@ private:
   bool              m_bInitialized;
   int               m_iDllScriptCounter; // to keep track of the total scripts running that need the dll
   unsigned int      m_endtime;
+  std::map<std::string, IdleInterpreter> m_idleInterpreters; // warm interpreters per add-on, protected by m_critSection
 
   //Vector with list of threads used for running scripts
   PyList              m_vecPyList;
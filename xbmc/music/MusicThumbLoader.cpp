@@ -68,12 +68,15 @@ bool CMusicThumbLoader::LoadItemCached(CFileItem* pItem)
   if (pItem->m_bIsShareOrDrive)
     return false;
 
+  // tags are only read here, see CFileItem::m_musicInfoTag
+  const CFileItem &constItem = *pItem;
+
   if (pItem->HasMusicInfoTag() && pItem->GetArt().empty())
   {
     if (FillLibraryArt(*pItem))
       return true;
       
-    if (pItem->GetMusicInfoTag()->GetType() == MediaTypeArtist)
+    if (constItem.GetMusicInfoTag()->GetType() == MediaTypeArtist)
       return false; // No fallback
   }
 
@@ -98,9 +101,9 @@ bool CMusicThumbLoader::LoadItemCached(CFileItem* pItem)
     {
       pItem->SetArt("fanart", art);
     }
-    else if (pItem->HasMusicInfoTag() && !pItem->GetMusicInfoTag()->GetArtist().empty())
+    else if (pItem->HasMusicInfoTag() && !constItem.GetMusicInfoTag()->GetArtist().empty())
     {
-      std::string artist = pItem->GetMusicInfoTag()->GetArtist()[0];
+      std::string artist = constItem.GetMusicInfoTag()->GetArtist()[0];
       m_musicDatabase->Open();
       int idArtist = m_musicDatabase->GetArtistByName(artist);
       if (idArtist >= 0)
@@ -111,12 +114,12 @@ bool CMusicThumbLoader::LoadItemCached(CFileItem* pItem)
           pItem->SetArt("artist.fanart", fanart);
           pItem->SetArtFallback("fanart", "artist.fanart");
         }
-        else if (!pItem->GetMusicInfoTag()->GetAlbumArtist().empty() &&
-                 pItem->GetMusicInfoTag()->GetAlbumArtist()[0] != artist)
+        else if (!constItem.GetMusicInfoTag()->GetAlbumArtist().empty() &&
+                 constItem.GetMusicInfoTag()->GetAlbumArtist()[0] != artist)
         {
           // If no artist fanart and the album artist is different to the artist,
           // try to get fanart from the album artist
-          artist = pItem->GetMusicInfoTag()->GetAlbumArtist()[0];
+          artist = constItem.GetMusicInfoTag()->GetAlbumArtist()[0];
           idArtist = m_musicDatabase->GetArtistByName(artist);
           if (idArtist >= 0)
           {
@@ -141,7 +144,9 @@ bool CMusicThumbLoader::LoadItemLookup(CFileItem* pItem)
   if (pItem->m_bIsShareOrDrive)
     return false;
 
-  if (pItem->HasMusicInfoTag() && pItem->GetMusicInfoTag()->GetType() == MediaTypeArtist) // No fallback for artist
+  const CFileItem &constItem = *pItem;
+
+  if (pItem->HasMusicInfoTag() && constItem.GetMusicInfoTag()->GetType() == MediaTypeArtist) // No fallback for artist
     return false;
 
   if (pItem->HasVideoInfoTag())
@@ -154,7 +159,7 @@ bool CMusicThumbLoader::LoadItemLookup(CFileItem* pItem)
   if (!pItem->HasArt("thumb"))
   {
     // Look for embedded art
-    if (pItem->HasMusicInfoTag() && !pItem->GetMusicInfoTag()->GetCoverArtInfo().empty())
+    if (pItem->HasMusicInfoTag() && !constItem.GetMusicInfoTag()->GetCoverArtInfo().empty())
     {
       // The item has got embedded art but user thumbs overrule, so check for those first
       if (!FillThumb(*pItem, false)) // Check for user thumbs but ignore folder thumbs
@@ -192,7 +197,11 @@ bool CMusicThumbLoader::FillThumb(CFileItem &item, bool folderThumbs /* = true *
 
 bool CMusicThumbLoader::FillLibraryArt(CFileItem &item)
 {
-  CMusicInfoTag &tag = *item.GetMusicInfoTag();
+  if (!item.HasMusicInfoTag())
+    return !item.GetArt().empty();
+
+  // see LoadItemCached()
+  const CMusicInfoTag &tag = *static_cast<const CFileItem&>(item).GetMusicInfoTag();
   if (tag.GetDatabaseId() > -1 && !tag.GetType().empty())
   {
     m_musicDatabase->Open();
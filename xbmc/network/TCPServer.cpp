@@ -19,11 +19,20 @@
  */
 
 #include "TCPServer.h"
+#include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#if defined(TARGET_POSIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+#include <sys/epoll.h>
+#define TCPSERVER_USE_EPOLL
+#endif
 
 #include "settings/AdvancedSettings.h"
 #include "interfaces/json-rpc/JSONRPC.h"
@@ -57,6 +66,20 @@ using namespace JSONRPC;
 using namespace ANNOUNCEMENT;
 
 #define RECEIVEBUFFER 1024
+#define EPOLL_MAX_EVENTS 64
+
+// a client with more than this waiting to be sent is disconnected instead of
+// being sent further notifications
+#define SENDBUFFER_LIMIT (4 * 1024 * 1024)
+// no further requests are read from a client while more than this of its
+// responses and notifications wait to be sent
+#define SENDBUFFER_READ_LIMIT (256 * 1024)
+
+#if defined(MSG_NOSIGNAL)
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
 
 CTCPServer *CTCPServer::ServerInstance = NULL;
 
@@ -108,11 +131,24 @@ bool CTCPServer::IsRunning()
   return ((CThread*)ServerInstance)->IsRunning();
 }
 
+static bool SetNonBlocking(SOCKET socket)
+{
+#if defined(TARGET_WINDOWS)
+  u_long nonBlocking = 1;
+  return ioctlsocket(socket, FIONBIO, &nonBlocking) == 0;
+#else
+  int flags = fcntl(socket, F_GETFL, 0);
+  return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
 CTCPServer::CTCPServer(int port, bool nonlocal) : CThread("TCPServer")
 {
   m_port = port;
   m_nonlocal = nonlocal;
   m_sdpd = NULL;
+  m_epoll = -1;
+  m_wakeup[0] = m_wakeup[1] = -1;
 }
 
 void CTCPServer::Process()
@@ -121,110 +157,278 @@ void CTCPServer::Process()
 
   while (!m_bStop)
   {
-    SOCKET          max_fd = 0;
-    fd_set          rfds;
-    struct timeval  to     = {1, 0};
-    FD_ZERO(&rfds);
+    if (!WaitForEvents(1000))
+    {
+      CLog::Log(LOGERROR, "JSONRPC Server: Waiting for connections failed");
+      Sleep(1000);
+      Initialize();
+      continue;
+    }
 
-    for (std::vector<SOCKET>::iterator it = m_servers.begin(); it != m_servers.end(); ++it)
+    ServiceConnections();
+  }
+
+  Deinitialize();
+}
+
+bool CTCPServer::WaitForEvents(int timeoutMs)
+{
+#if defined(TCPSERVER_USE_EPOLL)
+  struct epoll_event events[EPOLL_MAX_EVENTS];
+  int res = epoll_wait(m_epoll, events, EPOLL_MAX_EVENTS, timeoutMs);
+  if (res < 0)
+    return errno == EINTR;
+
+  for (int i = 0; i < res; i++)
+  {
+    int fd = events[i].data.fd;
+    if (fd == m_wakeup[0])
     {
-      FD_SET(*it, &rfds);
-      if ((intptr_t)*it > (intptr_t)max_fd)
-        max_fd = *it;
+      char buffer[64];
+      while (read(m_wakeup[0], buffer, sizeof(buffer)) > 0);
+      continue;
     }
 
-    for (unsigned int i = 0; i < m_connections.size(); i++)
+    std::unordered_map<SOCKET, CTCPClient*>::const_iterator connection = m_sockets.find(fd);
+    if (connection == m_sockets.end())
     {
+      // a listening socket that fails doesn't keep the others from being served
+      if (!AcceptConnection(fd))
+      {
+        CLog::Log(LOGERROR, "JSONRPC Server: Listening socket %d failed, no longer watching it", fd);
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, NULL);
+      }
+      continue;
+    }
+
+    // a hang up or error is reported by recv() as well
+    CTCPClient *client = connection->second;
+    bool close = false;
+    if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+      close = !ReadFromConnection(client);
+    if (!close && (events[i].events & EPOLLOUT))
+      close = !client->Flush();
+
+    if (close)
+      CloseConnection(client);
+  }
+#else
+  SOCKET          max_fd = 0;
+  fd_set          rfds, wfds;
+  struct timeval  to     = {timeoutMs / 1000, (timeoutMs % 1000) * 1000};
+  FD_ZERO(&rfds);
+  FD_ZERO(&wfds);
+
+  for (std::vector<SOCKET>::iterator it = m_servers.begin(); it != m_servers.end(); ++it)
+  {
+    FD_SET(*it, &rfds);
+    if ((intptr_t)*it > (intptr_t)max_fd)
+      max_fd = *it;
+  }
+
+#if defined(TARGET_POSIX)
+  if (m_wakeup[0] >= 0)
+  {
+    FD_SET(m_wakeup[0], &rfds);
+    if ((intptr_t)m_wakeup[0] > (intptr_t)max_fd)
+      max_fd = m_wakeup[0];
+  }
+#endif
+
+  for (unsigned int i = 0; i < m_connections.size(); i++)
+  {
+    size_t queued = m_connections[i]->GetQueuedSize();
+    if (queued < SENDBUFFER_READ_LIMIT)
       FD_SET(m_connections[i]->m_socket, &rfds);
-      if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
-        max_fd = m_connections[i]->m_socket;
+    if (queued > 0)
+      FD_SET(m_connections[i]->m_socket, &wfds);
+    if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
+      max_fd = m_connections[i]->m_socket;
+  }
+
+  int res = select((intptr_t)max_fd+1, &rfds, &wfds, NULL, &to);
+  if (res < 0)
+    return false;
+  else if (res > 0)
+  {
+#if defined(TARGET_POSIX)
+    if (m_wakeup[0] >= 0 && FD_ISSET(m_wakeup[0], &rfds))
+    {
+      char buffer[64];
+      while (read(m_wakeup[0], buffer, sizeof(buffer)) > 0);
     }
+#endif
 
-    int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
-    if (res < 0)
+    for (int i = m_connections.size() - 1; i >= 0; i--)
     {
-      CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
-      Sleep(1000);
-      Initialize();
+      CTCPClient *client = m_connections[i];
+      bool close = false;
+      if (FD_ISSET(client->m_socket, &rfds))
+        close = !ReadFromConnection(client);
+      if (!close && FD_ISSET(client->m_socket, &wfds))
+        close = !client->Flush();
+
+      if (close)
+        CloseConnection(client);
     }
-    else if (res > 0)
+
+    for (std::vector<SOCKET>::iterator it = m_servers.begin(); it != m_servers.end(); ++it)
     {
-      for (int i = m_connections.size() - 1; i >= 0; i--)
-      {
-        int socket = m_connections[i]->m_socket;
-        if (FD_ISSET(socket, &rfds))
-        {
-          char buffer[RECEIVEBUFFER] = {};
-          int  nread = 0;
-          nread = recv(socket, (char*)&buffer, RECEIVEBUFFER, 0);
-          bool close = false;
-          if (nread > 0)
-          {
-            std::string response;
-            if (m_connections[i]->IsNew())
-            {
-              CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
-
-              if (!response.empty())
-                m_connections[i]->Send(response.c_str(), response.size());
-
-              if (websocket != NULL)
-              {
-                // Replace the CTCPClient with a CWebSocketClient
-                CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *(m_connections[i]));
-                delete m_connections[i];
-                m_connections.erase(m_connections.begin() + i);
-                m_connections.insert(m_connections.begin() + i, websocketClient);
-              }
-            }
-
-            if (response.size() <= 0)
-              m_connections[i]->PushBuffer(this, buffer, nread);
-
-            close = m_connections[i]->Closing();
-          }
-          else
-            close = true;
-
-          if (close)
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
-            m_connections[i]->Disconnect();
-            delete m_connections[i];
-            m_connections.erase(m_connections.begin() + i);
-          }
-        }
-      }
+      if (FD_ISSET(*it, &rfds) && !AcceptConnection(*it))
+        return false;
+    }
+  }
+#endif
 
-      for (std::vector<SOCKET>::iterator it = m_servers.begin(); it != m_servers.end(); ++it)
-      {
-        if (FD_ISSET(*it, &rfds))
-        {
-          CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
-          CTCPClient *newconnection = new CTCPClient();
-          newconnection->m_socket = accept(*it, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
-
-          if (newconnection->m_socket == INVALID_SOCKET)
-          {
-            CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: %d", errno);
-            if (EBADF == errno)
-            {
-              Sleep(1000);
-              Initialize();
-              break;
-            }
-          }
-          else
-          {
-            CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
-            m_connections.push_back(newconnection);
-          }
-        }
-      }
+  return true;
+}
+
+bool CTCPServer::AcceptConnection(SOCKET server)
+{
+  CLog::Log(LOGDEBUG, "JSONRPC Server: New connection detected");
+  CTCPClient *newconnection = new CTCPClient();
+  newconnection->m_socket = accept(server, (sockaddr*)&newconnection->m_cliaddr, &newconnection->m_addrlen);
+
+  if (newconnection->m_socket == INVALID_SOCKET)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Accept of new connection failed: %d", errno);
+    delete newconnection;
+    return EBADF != errno;
+  }
+
+  // responses and notifications are written when the socket accepts them
+  // so a client that doesn't read them can't block the server
+  if (!SetNonBlocking(newconnection->m_socket))
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Failed to make new connection non-blocking");
+    closesocket(newconnection->m_socket);
+    delete newconnection;
+    return true;
+  }
+  newconnection->m_server = this;
+
+#if defined(TCPSERVER_USE_EPOLL)
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = newconnection->m_socket;
+  if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, newconnection->m_socket, &event) < 0)
+  {
+    CLog::Log(LOGERROR, "JSONRPC Server: Failed to watch new connection: %d", errno);
+    closesocket(newconnection->m_socket);
+    delete newconnection;
+    return true;
+  }
+  newconnection->m_events = event.events;
+#endif
+
+  CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
+  m_sockets[newconnection->m_socket] = newconnection;
+  CSingleLock lock(m_connectionsSection);
+  m_connections.push_back(newconnection);
+  return true;
+}
+
+bool CTCPServer::ReadFromConnection(CTCPClient *&client)
+{
+  char buffer[RECEIVEBUFFER] = {};
+  int  nread = 0;
+  nread = recv(client->m_socket, (char*)&buffer, RECEIVEBUFFER, 0);
+#if !defined(TARGET_WINDOWS)
+  if (nread < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+    return true;
+#endif
+  if (nread <= 0)
+    return false;
+
+  std::string response;
+  if (client->IsNew())
+  {
+    CWebSocket *websocket = CWebSocketManager::Handle(buffer, nread, response);
+
+    if (!response.empty())
+      client->Send(response.c_str(), response.size());
+
+    if (websocket != NULL)
+    {
+      // Replace the CTCPClient with a CWebSocketClient
+      CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *client);
+      m_sockets[client->m_socket] = websocketClient;
+      CSingleLock lock(m_connectionsSection);
+      *std::find(m_connections.begin(), m_connections.end(), client) = websocketClient;
+      delete client;
+      client = websocketClient;
     }
   }
 
-  Deinitialize();
+  if (response.size() <= 0)
+    client->PushBuffer(this, buffer, nread);
+
+  return !client->Closing();
+}
+
+void CTCPServer::ServiceConnections()
+{
+  for (int i = m_connections.size() - 1; i >= 0; i--)
+  {
+    CTCPClient *client = m_connections[i];
+    if (client->IsSlow())
+    {
+      CLog::Log(LOGWARNING, "JSONRPC Server: Client doesn't keep up with notifications");
+      CloseConnection(client);
+      continue;
+    }
+
+    if (!client->Flush())
+    {
+      CloseConnection(client);
+      continue;
+    }
+
+#if defined(TCPSERVER_USE_EPOLL)
+    // stop reading requests from a client which doesn't read the responses
+    size_t queued = client->GetQueuedSize();
+    unsigned int events = (queued < SENDBUFFER_READ_LIMIT ? EPOLLIN : 0) | (queued > 0 ? EPOLLOUT : 0);
+    if (events != client->m_events)
+    {
+      struct epoll_event event = {};
+      event.events = events;
+      event.data.fd = client->m_socket;
+      if (epoll_ctl(m_epoll, EPOLL_CTL_MOD, client->m_socket, &event) == 0)
+        client->m_events = events;
+    }
+#endif
+  }
+}
+
+void CTCPServer::CloseConnection(CTCPClient *client)
+{
+  CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+
+#if defined(TCPSERVER_USE_EPOLL)
+  if (m_epoll >= 0 && client->m_socket != INVALID_SOCKET)
+    epoll_ctl(m_epoll, EPOLL_CTL_DEL, client->m_socket, NULL);
+#endif
+  m_sockets.erase(client->m_socket);
+  client->Disconnect();
+
+  CSingleLock lock(m_connectionsSection);
+  m_connections.erase(std::find(m_connections.begin(), m_connections.end(), client));
+  delete client;
+}
+
+bool CTCPServer::WakeUp()
+{
+#if defined(TARGET_POSIX)
+  CSingleLock lock(m_connectionsSection);
+  if (m_wakeup[1] < 0)
+    return false;
+
+  // a full pipe will wake up the server thread just as well
+  char c = 0;
+  return write(m_wakeup[1], &c, 1) == 1 || errno == EAGAIN;
+#else
+  return false;
+#endif
 }
 
 bool CTCPServer::PrepareDownload(const char *path, CVariant &details, std::string &protocol)
@@ -246,6 +450,9 @@ void CTCPServer::Announce(AnnouncementFlag flag, const char *sender, const char
 {
   std::string str = IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, g_advancedSettings.m_jsonOutputCompact);
 
+  // only queue the notification, the server thread writes it to every client
+  // as fast as that client reads so a slow one doesn't hold up the others
+  CSingleLock connectionsLock(m_connectionsSection);
   for (unsigned int i = 0; i < m_connections.size(); i++)
   {
     {
@@ -254,7 +461,14 @@ void CTCPServer::Announce(AnnouncementFlag flag, const char *sender, const char
         continue;
     }
 
-    m_connections[i]->Send(str.c_str(), str.size());
+    m_connections[i]->SendNotification(str.c_str(), str.size());
+  }
+
+  // without a way to wake up the server thread write what the sockets accept right away
+  if (!WakeUp())
+  {
+    for (unsigned int i = 0; i < m_connections.size(); i++)
+      m_connections[i]->Flush();
   }
 }
 
@@ -269,6 +483,40 @@ bool CTCPServer::Initialize()
 
   if (started)
   {
+#if defined(TARGET_POSIX)
+    if (pipe(m_wakeup) == 0)
+    {
+      for (int i = 0; i < 2; i++)
+      {
+        SetNonBlocking(m_wakeup[i]);
+        fcntl(m_wakeup[i], F_SETFD, FD_CLOEXEC);
+      }
+    }
+    else
+      m_wakeup[0] = m_wakeup[1] = -1;
+#endif
+
+#if defined(TCPSERVER_USE_EPOLL)
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll < 0)
+    {
+      CLog::Log(LOGERROR, "JSONRPC Server: Failed to create epoll instance: %d", errno);
+      Deinitialize();
+      return false;
+    }
+
+    std::vector<SOCKET> fds(m_servers);
+    if (m_wakeup[0] >= 0)
+      fds.push_back(m_wakeup[0]);
+    for (std::vector<SOCKET>::const_iterator fd = fds.begin(); fd != fds.end(); ++fd)
+    {
+      struct epoll_event event = {};
+      event.events = EPOLLIN;
+      event.data.fd = *fd;
+      epoll_ctl(m_epoll, EPOLL_CTL_ADD, *fd, &event);
+    }
+#endif
+
     CAnnouncementManager::GetInstance().AddAnnouncer(this);
     CLog::Log(LOGINFO, "JSONRPC Server: Successfully initialized");
     return true;
@@ -472,6 +720,7 @@ bool CTCPServer::InitializeTCP()
 
 void CTCPServer::Deinitialize()
 {
+  CSingleLock lock(m_connectionsSection);
   for (unsigned int i = 0; i < m_connections.size(); i++)
   {
     m_connections[i]->Disconnect();
@@ -479,6 +728,22 @@ void CTCPServer::Deinitialize()
   }
 
   m_connections.clear();
+  m_sockets.clear();
+
+#if defined(TCPSERVER_USE_EPOLL)
+  if (m_epoll >= 0)
+    close(m_epoll);
+  m_epoll = -1;
+#endif
+
+#if defined(TARGET_POSIX)
+  for (int i = 0; i < 2; i++)
+  {
+    if (m_wakeup[i] >= 0)
+      close(m_wakeup[i]);
+    m_wakeup[i] = -1;
+  }
+#endif
 
   for (unsigned int i = 0; i < m_servers.size(); i++)
     closesocket(m_servers[i]);
@@ -496,6 +761,10 @@ void CTCPServer::Deinitialize()
 
 CTCPServer::CTCPClient::CTCPClient()
 {
+  m_server = NULL;
+  m_events = 0;
+  m_sendOffset = 0;
+  m_slow = false;
   m_new = true;
   m_announcementflags = ANNOUNCE_ALL;
   m_socket = INVALID_SOCKET;
@@ -536,12 +805,86 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
 
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
-  unsigned int sent = 0;
-  do
+  Queue(data, size, false);
+
+  // the server thread flushes all clients after handling their requests
+  if (m_server != NULL && !m_server->IsCurrentThread())
+    m_server->WakeUp();
+}
+
+bool CTCPServer::CTCPClient::SendNotification(const char *data, unsigned int size)
+{
+  return Queue(data, size, true);
+}
+
+bool CTCPServer::CTCPClient::Queue(const char *data, unsigned int size, bool notification)
+{
+  CSingleLock lock (m_critSection);
+  if (m_slow)
+    return false;
+
+  // responses are limited by not reading further requests, notifications
+  // are not and a client that doesn't read them gets disconnected
+  if (notification && m_sendBuffer.size() - m_sendOffset + size > SENDBUFFER_LIMIT)
   {
-    CSingleLock lock (m_critSection);
-    sent += send(m_socket, data + sent, size - sent, 0);
-  } while (sent < size);
+    m_slow = true;
+    return false;
+  }
+
+  m_sendBuffer.append(data, size);
+  return true;
+}
+
+bool CTCPServer::CTCPClient::Flush()
+{
+  CSingleLock lock (m_critSection);
+  while (m_sendOffset < m_sendBuffer.size())
+  {
+    if (m_socket == INVALID_SOCKET)
+      return false;
+
+    int sent = send(m_socket, m_sendBuffer.c_str() + m_sendOffset, m_sendBuffer.size() - m_sendOffset, SEND_FLAGS);
+    if (sent < 0)
+    {
+#if defined(TARGET_WINDOWS)
+      if (WSAGetLastError() == WSAEWOULDBLOCK)
+        break;
+#else
+      if (errno == EINTR)
+        continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+        break;
+#endif
+      return false;
+    }
+
+    m_sendOffset += sent;
+  }
+
+  if (m_sendOffset == m_sendBuffer.size())
+  {
+    m_sendBuffer.clear();
+    m_sendOffset = 0;
+  }
+  else if (m_sendOffset > m_sendBuffer.size() / 2)
+  {
+    m_sendBuffer.erase(0, m_sendOffset);
+    m_sendOffset = 0;
+  }
+
+  return true;
+}
+
+size_t CTCPServer::CTCPClient::GetQueuedSize()
+{
+  CSingleLock lock (m_critSection);
+  return m_sendBuffer.size() - m_sendOffset;
+}
+
+bool CTCPServer::CTCPClient::IsSlow()
+{
+  CSingleLock lock (m_critSection);
+  return m_slow;
 }
 
 void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
@@ -586,6 +929,8 @@ void CTCPServer::CTCPClient::Disconnect()
   if (m_socket > 0)
   {
     CSingleLock lock (m_critSection);
+    // last chance for anything still queued, e.g. the close frame of a websocket
+    Flush();
     shutdown(m_socket, SHUT_RDWR);
     closesocket(m_socket);
     m_socket = INVALID_SOCKET;
@@ -604,6 +949,11 @@ void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
   m_beginChar         = client.m_beginChar;
   m_endChar           = client.m_endChar;
   m_buffer            = client.m_buffer;
+  m_sendBuffer        = client.m_sendBuffer;
+  m_sendOffset        = client.m_sendOffset;
+  m_slow              = client.m_slow;
+  m_server            = client.m_server;
+  m_events            = client.m_events;
 }
 
 CTCPServer::CWebSocketClient::CWebSocketClient(CWebSocket *websocket)
@@ -646,6 +996,23 @@ void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
   std::vector<const CWebSocketFrame *> frames = msg->GetFrames();
   for (unsigned int index = 0; index < frames.size(); index++)
     CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
+
+  delete msg;
+}
+
+bool CTCPServer::CWebSocketClient::SendNotification(const char *data, unsigned int size)
+{
+  const CWebSocketMessage *msg = m_websocket->Send(WebSocketTextFrame, data, size);
+  if (msg == NULL || !msg->IsComplete())
+    return true;
+
+  bool queued = true;
+  std::vector<const CWebSocketFrame *> frames = msg->GetFrames();
+  for (unsigned int index = 0; index < frames.size() && queued; index++)
+    queued = Queue(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength(), true);
+
+  delete msg;
+  return queued;
 }
 
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
@@ -19,6 +19,7 @@
  *
  */
 
+#include <unordered_map>
 #include <vector>
 #include <sys/socket.h>
 
@@ -31,11 +32,14 @@
 #include "websocket/WebSocket.h"
 
 class CVariant;
+class TestTCPServerHelper;
 
 namespace JSONRPC
 {
   class CTCPServer : public ITransportLayer, public JSONRPC::IJSONRPCAnnouncer, public CThread
   {
+    friend class ::TestTCPServerHelper;
+
   public:
     static bool StartServer(int port, bool nonlocal);
     static void StopServer(bool bWait);
@@ -49,12 +53,21 @@ namespace JSONRPC
   protected:
     void Process();
   private:
+    class CTCPClient;
+
     CTCPServer(int port, bool nonlocal);
     bool Initialize();
     bool InitializeBlue();
     bool InitializeTCP();
     void Deinitialize();
 
+    bool WaitForEvents(int timeoutMs);
+    bool AcceptConnection(SOCKET server);
+    bool ReadFromConnection(CTCPClient *&client);
+    void ServiceConnections();
+    void CloseConnection(CTCPClient *client);
+    bool WakeUp();
+
     class CTCPClient : public IClient
     {
     public:
@@ -70,25 +83,44 @@ namespace JSONRPC
       virtual bool SetAnnouncementFlags(int flags);
 
       virtual void Send(const char *data, unsigned int size);
+      /*!
+       \brief Queue a notification without waking up the server
+       \return false if the client couldn't keep up and has been marked as slow
+       */
+      virtual bool SendNotification(const char *data, unsigned int size);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
       virtual void Disconnect();
 
       virtual bool IsNew() const { return m_new; }
       virtual bool Closing() const { return false; }
 
+      /*!
+       \brief Write as much of the queued data as the socket accepts without blocking
+       \return false if the connection is broken
+       */
+      bool Flush();
+      size_t GetQueuedSize();
+      bool IsSlow();
+
       SOCKET           m_socket;
       sockaddr_storage m_cliaddr;
       socklen_t        m_addrlen;
       CCriticalSection m_critSection;
+      CTCPServer      *m_server;
+      unsigned int     m_events;
 
     protected:
       void Copy(const CTCPClient& client);
+      bool Queue(const char *data, unsigned int size, bool notification);
     private:
       bool m_new;
       int m_announcementflags;
       int m_beginBrackets, m_endBrackets;
       char m_beginChar, m_endChar;
       std::string m_buffer;
+      std::string m_sendBuffer;
+      size_t m_sendOffset;
+      bool m_slow;
     };
 
     class CWebSocketClient : public CTCPClient
@@ -101,6 +133,7 @@ namespace JSONRPC
       ~CWebSocketClient();
 
       virtual void Send(const char *data, unsigned int size);
+      virtual bool SendNotification(const char *data, unsigned int size);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
       virtual void Disconnect();
 
@@ -111,8 +144,14 @@ namespace JSONRPC
       CWebSocket *m_websocket;
     };
 
+    // only modified by the server thread, which doesn't need to lock for reading it
     std::vector<CTCPClient*> m_connections;
+    CCriticalSection m_connectionsSection;
+    // the connections by socket, only used by the server thread
+    std::unordered_map<SOCKET, CTCPClient*> m_sockets;
     std::vector<SOCKET> m_servers;
+    int m_epoll;
+    int m_wakeup[2];
     int m_port;
     bool m_nonlocal;
     void* m_sdpd;
@@ -26,15 +26,20 @@
 
 #ifdef HAS_WEB_SERVER
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <stdexcept>
 #include <utility>
 
 #if defined(TARGET_POSIX)
+#include <fcntl.h>
 #include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 #include "settings/AdvancedSettings.h"
@@ -116,6 +121,76 @@ static MHD_Response* create_response(size_t size, void* data, int free, int copy
 #endif
 }
 
+static bool IsETag(const std::string &value)
+{
+  return StringUtils::StartsWith(value, "\"") || StringUtils::StartsWith(value, "W/\"");
+}
+
+static bool MatchesETag(const std::string &header, const std::string &etag, bool strong)
+{
+  // weak entity tags never match in a strong comparison
+  if (strong && StringUtils::StartsWith(etag, "W/"))
+    return false;
+  std::string opaqueTag = StringUtils::StartsWith(etag, "W/") ? etag.substr(2) : etag;
+
+  std::vector<std::string> tags = StringUtils::Split(header, ",");
+  for (std::vector<std::string>::iterator tag = tags.begin(); tag != tags.end(); ++tag)
+  {
+    StringUtils::Trim(*tag);
+    if (*tag == "*" && !strong)
+      return true;
+
+    if (StringUtils::StartsWith(*tag, "W/"))
+    {
+      if (strong)
+        continue;
+      tag->erase(0, 2);
+    }
+
+    if (*tag == opaqueTag)
+      return true;
+  }
+
+  return false;
+}
+
+static struct MHD_Response* CreateLocalFileResponse(const std::string &filePath, uint64_t offset, uint64_t length)
+{
+#if defined(TARGET_POSIX)
+  // anything not directly on the local filesystem has to go through CFile
+  std::string path = CSpecialProtocol::TranslatePath(filePath);
+  if (!CURL(path).GetProtocol().empty())
+    return nullptr;
+
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return nullptr;
+
+  struct stat64 statBuffer;
+  if (fstat64(fd, &statBuffer) != 0 || !S_ISREG(statBuffer.st_mode) ||
+      static_cast<uint64_t>(statBuffer.st_size) < offset + length)
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  // MHD takes over the file descriptor and closes it with the response
+#if (MHD_VERSION >= 0x00094400)
+  struct MHD_Response *response = MHD_create_response_from_fd_at_offset64(length, fd, offset);
+#else
+  struct MHD_Response *response = nullptr;
+  if (length <= SIZE_MAX && offset <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()))
+    response = MHD_create_response_from_fd_at_offset(static_cast<size_t>(length), fd, static_cast<off_t>(offset));
+#endif
+  if (response == nullptr)
+    close(fd);
+
+  return response;
+#else
+  return nullptr;
+#endif
+}
+
 int CWebServer::AskForAuthentication(struct MHD_Connection *connection) const
 {
   struct MHD_Response *response = create_response(0, nullptr, MHD_NO, MHD_NO);
@@ -284,8 +359,28 @@ int CWebServer::HandlePartialRequest(struct MHD_Connection *connection, Connecti
                 cacheable = false;
             }
 
+            // handle If-None-Match which takes precedence over If-Modified-Since
+            std::string etag;
+            bool hasETag = handler->GetETag(etag);
+            std::string ifNoneMatch = HTTPRequestHandlerUtils::GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_NONE_MATCH);
+            if (cacheable && hasETag && !ifNoneMatch.empty())
+            {
+              if (MatchesETag(ifNoneMatch, etag, false))
+              {
+                struct MHD_Response *response = create_response(0, nullptr, MHD_NO, MHD_NO);
+                if (response == nullptr)
+                {
+                  CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP 304 response", m_port);
+                  return MHD_NO;
+                }
+
+                return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
+              }
+            }
+
             CDateTime lastModified;
-            if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
+            if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid() &&
+                (ifNoneMatch.empty() || !hasETag))
             {
               // handle If-Modified-Since or If-Unmodified-Since
               std::string ifModifiedSince = HTTPRequestHandlerUtils::GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_MODIFIED_SINCE);
@@ -313,10 +408,17 @@ int CWebServer::HandlePartialRequest(struct MHD_Connection *connection, Connecti
                 return SendErrorResponse(connection, MHD_HTTP_PRECONDITION_FAILED, request.method);
             }
 
+            // handle If-Range header containing an entity tag
+            std::string ifRange = HTTPRequestHandlerUtils::GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_RANGE);
+            if (ranged && IsETag(ifRange))
+            {
+              // serve the whole file if the entity tag doesn't match
+              if (!hasETag || !MatchesETag(ifRange, etag, true))
+                ranges.Clear();
+            }
             // handle If-Range header but only if the Range header is present
-            if (ranged && lastModified.IsValid())
+            else if (ranged && lastModified.IsValid())
             {
-              std::string ifRange = HTTPRequestHandlerUtils::GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_RANGE);
               if (!ifRange.empty() && lastModified.IsValid())
               {
                 CDateTime ifRangeDate;
@@ -537,6 +639,11 @@ int CWebServer::FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler>& hand
   if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
     handler->AddResponseHeader(MHD_HTTP_HEADER_LAST_MODIFIED, lastModified.GetAsRFC1123DateTime());
 
+  // if the request handler has set an entity tag add it
+  std::string etag;
+  if (handler->CanBeCached() && handler->GetETag(etag))
+    handler->AddResponseHeader(MHD_HTTP_HEADER_ETAG, etag);
+
   // check if the request handler has set Cache-Control and add it if not
   if (!handler->HasResponseHeader(MHD_HTTP_HEADER_CACHE_CONTROL))
   {
@@ -850,18 +957,26 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
     // set the initial write position
     context->ranges.GetFirstPosition(context->writePosition);
 
-    // create the response object
-    response = MHD_create_response_from_callback(totalLength, 2048,
-                                                  &CWebServer::ContentReaderCallback,
-                                                  context.get(),
-                                                  &CWebServer::ContentReaderFreeCallback);
+    // a single range of a file on the local filesystem is handed to MHD as a
+    // file descriptor so that it can be sent without copying it through us
+    if (context->rangeCountTotal == 1)
+      response = CreateLocalFileResponse(filePath, context->writePosition, totalLength);
+
     if (response == nullptr)
     {
-      CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP response for %s to be filled from %s", m_port, request.pathUrl.c_str(), filePath.c_str());
-      return MHD_NO;
-    }
+      // create the response object
+      response = MHD_create_response_from_callback(totalLength, 2048,
+                                                    &CWebServer::ContentReaderCallback,
+                                                    context.get(),
+                                                    &CWebServer::ContentReaderFreeCallback);
+      if (response == nullptr)
+      {
+        CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP response for %s to be filled from %s", m_port, request.pathUrl.c_str(), filePath.c_str());
+        return MHD_NO;
+      }
 
-    context.release(); // ownership was passed to mhd
+      context.release(); // ownership was passed to mhd
+    }
 
     // add Content-Range header
     if (ranged)
@@ -18,11 +18,13 @@
  *
  */
 
+#include <inttypes.h>
 #include <map>
 
 #include "HTTPImageTransformationHandler.h"
-#include "TextureCacheJob.h"
+#include "TextureCache.h"
 #include "URL.h"
+#include "filesystem/File.h"
 #include "filesystem/ImageFile.h"
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
@@ -38,17 +40,19 @@ static const std::string ImageBasePath = "/image/";
 
 CHTTPImageTransformationHandler::CHTTPImageTransformationHandler()
   : m_url(),
+    m_imagePath(),
     m_lastModified(),
-    m_buffer(NULL),
-    m_responseData()
+    m_cachedFile(),
+    m_etag()
 { }
 
 CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPRequest &request)
   : IHTTPRequestHandler(request),
     m_url(),
+    m_imagePath(),
     m_lastModified(),
-    m_buffer(NULL),
-    m_responseData()
+    m_cachedFile(),
+    m_etag()
 {
   m_url = m_request.pathUrl.substr(ImageBasePath.size());
   if (m_url.empty())
@@ -67,7 +71,7 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
     return;
   }
 
-  m_response.type = HTTPMemoryDownloadNoFreeCopy;
+  m_response.type = HTTPFileDownload;
   m_response.status = MHD_HTTP_OK;
 
   // determine the content type
@@ -75,6 +79,38 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   StringUtils::ToLower(ext);
   m_response.contentType = CMime::GetMimeType(ext);
 
+  // get the transformation options
+  std::map<std::string, std::string> options;
+  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
+
+  std::vector<std::string> urlOptions;
+  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
+
+  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
+
+  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
+  if (option != options.end())
+    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
+
+  // the transformed image is cached under the URL including the options
+  m_imagePath = m_url;
+  if (!urlOptions.empty())
+  {
+    m_imagePath += "?";
+    m_imagePath += StringUtils::Join(urlOptions, "&");
+  }
+
+  // if the transformation is already cached the client can revalidate its
+  // copy against the ETag without the image being touched at all
+  bool needsRecaching = false;
+  std::string cachedFile = CTextureCache::GetInstance().CheckCachedImage(m_imagePath, needsRecaching);
+  if (!cachedFile.empty() && !needsRecaching)
+    SetCachedFile(cachedFile);
+
   //! @todo determine the maximum age
 
   // determine the last modified date
@@ -96,11 +132,7 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
 }
 
 CHTTPImageTransformationHandler::~CHTTPImageTransformationHandler()
-{
-  m_responseData.clear();
-  delete m_buffer;
-  m_buffer = NULL;
-}
+{ }
 
 bool CHTTPImageTransformationHandler::CanHandleRequest(const HTTPRequest &request)
 {
@@ -121,8 +153,8 @@ int CHTTPImageTransformationHandler::HandleRequest()
   if (m_response.type == HTTPError)
     return MHD_YES;
 
-  // nothing else to do if this is a HEAD request
-  if (m_request.method == HEAD)
+  // nothing else to do if this is a HEAD request for a transformation which hasn't been cached yet
+  if (m_request.method == HEAD && m_cachedFile.empty())
   {
     m_response.status = MHD_HTTP_OK;
     m_response.type = HTTPMemoryDownloadNoFreeNoCopy;
@@ -130,53 +162,21 @@ int CHTTPImageTransformationHandler::HandleRequest()
     return MHD_YES;
   }
 
-  // get the transformation options
-  std::map<std::string, std::string> options;
-  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
-
-  std::vector<std::string> urlOptions;
-  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
-
-  std::string imagePath = m_url;
-  if (!urlOptions.empty())
-  {
-    imagePath += "?";
-    imagePath += StringUtils::Join(urlOptions, "&");
-  }
-
-  // resize the image into the local buffer
-  size_t bufferSize;
-  if (!CTextureCacheJob::ResizeTexture(imagePath, m_buffer, bufferSize))
+  // resize the image into the texture cache unless that has already been done
+  if (m_cachedFile.empty())
   {
-    m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
-    m_response.type = HTTPError;
-
-    return MHD_YES;
-  }
+    CTextureDetails details;
+    if (!CTextureCache::GetInstance().CacheResizedImage(m_imagePath, details))
+    {
+      m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
+      m_response.type = HTTPError;
 
-  // store the size of the image
-  m_response.totalLength = bufferSize;
+      return MHD_YES;
+    }
 
-  // nothing else to do if the request is not ranged
-  if (!GetRequestedRanges(m_response.totalLength))
-  {
-    m_responseData.push_back(CHttpResponseRange(m_buffer, 0, m_response.totalLength - 1));
-    return MHD_YES;
+    SetCachedFile(CTextureCache::GetCachedPath(details.file));
   }
 
-  for (HttpRanges::const_iterator range = m_request.ranges.Begin(); range != m_request.ranges.End(); ++range)
-    m_responseData.push_back(CHttpResponseRange(m_buffer + range->GetFirstPosition(), range->GetFirstPosition(), range->GetLastPosition()));
-
   return MHD_YES;
 }
 
@@ -188,3 +188,24 @@ bool CHTTPImageTransformationHandler::GetLastModifiedDate(CDateTime &lastModifie
   lastModified = m_lastModified;
   return true;
 }
+
+bool CHTTPImageTransformationHandler::GetETag(std::string &etag) const
+{
+  if (m_etag.empty())
+    return false;
+
+  etag = m_etag;
+  return true;
+}
+
+void CHTTPImageTransformationHandler::SetCachedFile(const std::string &cachedFile)
+{
+  m_cachedFile = cachedFile;
+
+  // the cached file is only ever replaced as a whole so its name, size and
+  // modification time identify its content
+  struct __stat64 statBuffer;
+  if (XFILE::CFile::Stat(m_cachedFile, &statBuffer) == 0)
+    m_etag = StringUtils::Format("\"%s-%" PRIx64 "-%" PRIx64 "\"", URIUtils::GetFileName(m_cachedFile).c_str(),
+                                 static_cast<uint64_t>(statBuffer.st_size), static_cast<uint64_t>(statBuffer.st_mtime));
+}
@@ -19,7 +19,6 @@
  *
  */
 
-#include <stdint.h>
 #include <string>
 
 #include "XBDateTime.h"
@@ -39,8 +38,9 @@ public:
   virtual bool CanHandleRanges() const { return true; }
   virtual bool CanBeCached() const { return true; }
   virtual bool GetLastModifiedDate(CDateTime &lastModified) const;
+  virtual bool GetETag(std::string &etag) const;
 
-  virtual HttpResponseRanges GetResponseData() const { return m_responseData; }
+  virtual std::string GetResponseFile() const { return m_cachedFile; }
 
   // priority must be higher than the one of CHTTPImageHandler
   virtual int GetPriority() const { return 6; }
@@ -49,9 +49,12 @@ protected:
   explicit CHTTPImageTransformationHandler(const HTTPRequest &request);
 
 private:
+  void SetCachedFile(const std::string &cachedFile);
+
   std::string m_url;
+  std::string m_imagePath;
   CDateTime m_lastModified;
 
-  uint8_t* m_buffer;
-  HttpResponseRanges m_responseData;
+  std::string m_cachedFile;
+  std::string m_etag;
 };
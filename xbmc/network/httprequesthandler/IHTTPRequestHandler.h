@@ -150,6 +150,13 @@ public:
   * \details This is only used if the response can be cached.
   */
   virtual bool GetLastModifiedDate(CDateTime &lastModified) const { return false; }
+
+  /*!
+  * \brief Returns the (quoted) entity tag of the response data.
+  *
+  * \details This is only used if the response can be cached.
+  */
+  virtual bool GetETag(std::string &etag) const { return false; }
  
   /*!
    * \brief Returns the ranges with raw data belonging to the response.
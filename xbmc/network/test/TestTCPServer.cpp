@@ -0,0 +1,202 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "network/TCPServer.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/Variant.h"
+
+#include "gtest/gtest.h"
+
+#define TCPSERVER_PORT          23457
+#define TCPSERVER_READERS       4
+#define TCPSERVER_NOTIFICATION  (64 * 1024)
+// the server disconnects a client with more than this waiting to be sent
+#define TCPSERVER_SEND_LIMIT    (4 * 1024 * 1024)
+
+using namespace JSONRPC;
+
+class TestTCPServerHelper
+{
+public:
+  static size_t GetConnections()
+  {
+    CSingleLock lock(CTCPServer::ServerInstance->m_connectionsSection);
+    return CTCPServer::ServerInstance->m_connections.size();
+  }
+
+  static void Announce(const CVariant &data)
+  {
+    CTCPServer::ServerInstance->Announce(ANNOUNCEMENT::Other, "xbmc", "OnTest", data);
+  }
+};
+
+namespace
+{
+// a local connection to the server, which either reads and counts the
+// notifications or never reads anything
+class CTestClient
+{
+public:
+  CTestClient() : m_socket(-1), m_received(0) {}
+
+  ~CTestClient()
+  {
+    if (m_socket >= 0)
+      shutdown(m_socket, SHUT_RDWR);
+    if (m_reader.joinable())
+      m_reader.join();
+    if (m_socket >= 0)
+      close(m_socket);
+  }
+
+  bool Connect(bool reads)
+  {
+    m_socket = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_socket < 0)
+      return false;
+
+    // keep what the kernel buffers for a client that doesn't read small
+    if (!reads)
+    {
+      int size = 4096;
+      setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+    }
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(TCPSERVER_PORT);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(m_socket, (sockaddr*)&address, sizeof(address)) < 0)
+      return false;
+
+    if (reads)
+      m_reader = std::thread([this]() { Read(); });
+    return true;
+  }
+
+  int GetReceived() const { return m_received; }
+
+private:
+  void Read()
+  {
+    static const std::string method = "Other.OnTest";
+    std::string data;
+    char buffer[16 * 1024];
+    int read;
+    while ((read = recv(m_socket, buffer, sizeof(buffer), 0)) > 0)
+    {
+      data.append(buffer, read);
+
+      size_t pos;
+      while ((pos = data.find(method)) != std::string::npos)
+      {
+        data.erase(0, pos + method.size());
+        m_received++;
+      }
+
+      // keep what could be the start of the next method name
+      if (data.size() > method.size())
+        data.erase(0, data.size() - method.size());
+    }
+  }
+
+  int m_socket;
+  std::atomic<int> m_received;
+  std::thread m_reader;
+};
+
+bool WaitFor(const std::function<bool()> &condition, unsigned int timeoutMs)
+{
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  while (!condition())
+  {
+    if (XbmcThreads::SystemClockMillis() - start > timeoutMs)
+      return false;
+    usleep(1000);
+  }
+  return true;
+}
+}
+
+class TestTCPServer : public testing::Test
+{
+protected:
+  virtual void SetUp()
+  {
+    ASSERT_TRUE(CTCPServer::StartServer(TCPSERVER_PORT, false));
+  }
+
+  virtual void TearDown()
+  {
+    CTCPServer::StopServer(true);
+  }
+};
+
+TEST_F(TestTCPServer, SlowClientDoesNotHoldUpOthers)
+{
+  std::vector<std::unique_ptr<CTestClient>> readers;
+  for (int i = 0; i < TCPSERVER_READERS; ++i)
+  {
+    readers.push_back(std::unique_ptr<CTestClient>(new CTestClient()));
+    ASSERT_TRUE(readers.back()->Connect(true));
+  }
+  CTestClient slow;
+  ASSERT_TRUE(slow.Connect(false));
+  ASSERT_TRUE(WaitFor([]() { return TestTCPServerHelper::GetConnections() == (size_t)TCPSERVER_READERS + 1; }, 5000));
+
+  CVariant data;
+  data["payload"] = std::string(TCPSERVER_NOTIFICATION, 'x');
+
+  // notify until the slow client is disconnected, but at most for five times
+  // what the server keeps for it
+  const int maxNotifications = 5 * TCPSERVER_SEND_LIMIT / TCPSERVER_NOTIFICATION;
+  int sent = 0;
+  while (sent < maxNotifications && TestTCPServerHelper::GetConnections() > (size_t)TCPSERVER_READERS)
+  {
+    TestTCPServerHelper::Announce(data);
+    sent++;
+
+    // the others get every notification while the slow client falls behind
+    for (const auto &reader : readers)
+    {
+      CTestClient *client = reader.get();
+      ASSERT_TRUE(WaitFor([client, sent]() { return client->GetReceived() >= sent; }, 5000))
+        << "notification " << sent << " wasn't received";
+    }
+  }
+
+  EXPECT_EQ((size_t)TCPSERVER_READERS, TestTCPServerHelper::GetConnections());
+  EXPECT_GE((int64_t)sent * TCPSERVER_NOTIFICATION, TCPSERVER_SEND_LIMIT);
+  for (const auto &reader : readers)
+    EXPECT_EQ(sent, reader->GetReceived());
+}
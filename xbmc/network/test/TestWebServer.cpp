@@ -787,4 +787,58 @@ TEST_F(TestWebServer, CanGetCachedRangedFileWithNewerIfRange)
   curl.SetRequestHeader(MHD_HTTP_HEADER_IF_RANGE, lastModifiedNewer.GetAsRFC1123DateTime());
   ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
   CheckRangesTestFileResponse(curl, result, ranges);
-}
\ No newline at end of file
+}
+
+TEST_F(TestWebServer, CanGetLargeLocalFile)
+{
+  const size_t blockSize = 1024 * 1024;
+  const size_t blockCount = 64;
+
+  // create a file large enough to be sent in many chunks
+  XFILE::CFile *file = XBMC_CREATETEMPFILE(".bin");
+  ASSERT_TRUE(file != NULL);
+  std::string block(blockSize, '\0');
+  for (size_t i = 0; i < blockCount; i++)
+  {
+    for (size_t j = 0; j < blockSize; j++)
+      block[j] = static_cast<char>((i * blockSize + j) % 251);
+    ASSERT_EQ(static_cast<ssize_t>(blockSize), file->Write(block.c_str(), blockSize));
+  }
+  file->Flush();
+
+  // share the directory of the file
+  const std::string filePath = XBMC_TEMPFILEPATH(file);
+  CMediaSource source;
+  source.strName = "WebServer Temp Share";
+  source.strPath = URIUtils::GetDirectory(filePath);
+  source.vecPaths.push_back(source.strPath);
+  source.m_allowSharing = true;
+  source.m_iDriveType = CMediaSource::SOURCE_TYPE_LOCAL;
+  source.m_iLockMode = LOCK_MODE_EVERYONE;
+  source.m_ignore = true;
+  CMediaSourceSettings::GetInstance().AddShare("videos", source);
+
+  const std::string url = GetUrl(URIUtils::AddFileToFolder("vfs", CURL::Encode(filePath)));
+
+  // get the whole file
+  std::string result;
+  CCurlFile curl;
+  ASSERT_TRUE(curl.Get(url, result));
+  ASSERT_EQ(blockSize * blockCount, result.size());
+  for (size_t i = 0; i < result.size(); i += 4093)
+    ASSERT_EQ(static_cast<char>(i % 251), result[i]);
+
+  // get a single range from the middle of the file
+  const uint64_t firstPosition = blockSize * blockCount / 2 + 17;
+  const uint64_t lastPosition = firstPosition + blockSize - 1;
+  CCurlFile curlRanged;
+  curlRanged.SetRequestHeader(MHD_HTTP_HEADER_RANGE, StringUtils::Format("bytes=%" PRIu64 "-%" PRIu64, firstPosition, lastPosition));
+  ASSERT_TRUE(curlRanged.Get(url, result));
+  ASSERT_EQ(blockSize, result.size());
+  for (size_t i = 0; i < result.size(); i++)
+    ASSERT_EQ(static_cast<char>((firstPosition + i) % 251), result[i]);
+  EXPECT_STREQ(StringUtils::Format("bytes %" PRIu64 "-%" PRIu64 "/%" PRIu64, firstPosition, lastPosition, static_cast<uint64_t>(blockSize * blockCount)).c_str(),
+               curlRanged.GetHttpHeader().GetValue(MHD_HTTP_HEADER_CONTENT_RANGE).c_str());
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
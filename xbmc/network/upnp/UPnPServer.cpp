@@ -28,6 +28,7 @@
 #include "music/MusicThumbLoader.h"
 #include "interfaces/AnnouncementManager.h"
 #include "filesystem/Directory.h"
+#include "filesystem/LibraryDirectory.h"
 #include "filesystem/MusicDatabaseDirectory.h"
 #include "filesystem/SpecialProtocol.h"
 #include "filesystem/VideoDatabaseDirectory.h"
@@ -58,6 +59,9 @@ namespace UPNP
 
 NPT_UInt32 CUPnPServer::m_MaxReturnedItems = 0;
 
+#define UPNP_RESULT_CACHE_SIZE    8
+#define UPNP_RESULT_CACHE_TIMEOUT 30000 // ms
+
 const char* audio_containers[] = { "musicdb://genres/", "musicdb://artists/", "musicdb://albums/",
                                    "musicdb://songs/", "musicdb://recentlyaddedalbums/", "musicdb://years/",
                                    "musicdb://singles/" };
@@ -150,6 +154,10 @@ CUPnPServer::UpdateContainer(const std::string& id)
     if (itr != m_UpdateIDs.end())
         count = ++itr->second.second;
     m_UpdateIDs[id] = std::make_pair(true, count);
+
+    { NPT_AutoLock lock(m_ResultCacheMutex);
+      m_ResultCache.clear();
+    }
     PropagateUpdates();
 }
 
@@ -633,7 +641,6 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
                                     const char*                   sort_criteria,
                                     const PLT_HttpRequestContext& context)
 {
-    CFileItemList items;
     NPT_String    parent_id = TranslateWMPObjectId(object_id);
 
     CLog::Log(LOGINFO, "UPnP: Received Browse DirectChildren request for object '%s', with sort criteria %s", object_id, sort_criteria);
@@ -643,82 +650,240 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
         return NPT_FAILURE;
     }
 
-    items.SetPath(std::string(parent_id));
-
-    // guard against loading while saving to the same cache file
-    // as CArchive currently performs no locking itself
-    bool load;
-    { NPT_AutoLock lock(m_CacheMutex);
-      load = items.Load();
+    // Don't pass parent_id if action is Search not BrowseDirectChildren, as
+    // we want the engine to determine the best parent id, not necessarily the one
+    // passed
+    NPT_String action_name = action->GetActionDesc().GetName();
+    const char* response_parent_id = (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars();
+
+    NPT_UInt32 max_count = (requested_count == 0)?m_MaxReturnedItems:std::min((unsigned long)requested_count, (unsigned long)m_MaxReturnedItems);
+
+    // library title listings can hold tens of thousands of items, only fetch
+    // the requested page from the database
+    CFileItemList page;
+    if (GetLibraryPage(std::string(parent_id), starting_index, max_count, page)) {
+        return BuildResponse(
+            action,
+            page,
+            filter,
+            starting_index,
+            requested_count,
+            sort_criteria,
+            context,
+            response_parent_id,
+            (int)page.GetProperty("total").asInteger());
     }
 
-    if (!load) {
-        // cache anything that takes more than a second to retrieve
-        unsigned int time = XbmcThreads::SystemClockMillis();
+    std::string cache_key = std::string(parent_id) + "|" + sort_criteria;
+    std::shared_ptr<CFileItemList> listing = GetCachedResult(cache_key);
+    if (!listing) {
+        listing.reset(new CFileItemList);
+        CFileItemList& items = *listing;
+        items.SetPath(std::string(parent_id));
+
+        // guard against loading while saving to the same cache file
+        // as CArchive currently performs no locking itself
+        bool load;
+        { NPT_AutoLock lock(m_CacheMutex);
+          load = items.Load();
+        }
+
+        if (!load) {
+            // cache anything that takes more than a second to retrieve
+            unsigned int time = XbmcThreads::SystemClockMillis();
 
-        if (parent_id.StartsWith("virtualpath://upnproot")) {
-            CFileItemPtr item;
+            if (parent_id.StartsWith("virtualpath://upnproot")) {
+                CFileItemPtr item;
 
-            // music library
-            item.reset(new CFileItem("musicdb://", true));
-            item->SetLabel("Music Library");
-            item->SetLabelPreformated(true);
-            items.Add(item);
+                // music library
+                item.reset(new CFileItem("musicdb://", true));
+                item->SetLabel("Music Library");
+                item->SetLabelPreformated(true);
+                items.Add(item);
 
-            // video library
-            item.reset(new CFileItem("library://video/", true));
-            item->SetLabel("Video Library");
-            item->SetLabelPreformated(true);
-            items.Add(item);
+                // video library
+                item.reset(new CFileItem("library://video/", true));
+                item->SetLabel("Video Library");
+                item->SetLabelPreformated(true);
+                items.Add(item);
 
-            items.Sort(SortByLabel, SortOrderAscending);
-        } else {
-            // this is the only way to hide unplayable items in the 'files'
-            // view as we cannot tell what context (eg music vs video) the
-            // request came from
-            std::string supported = g_advancedSettings.m_pictureExtensions + "|"
-                                  + g_advancedSettings.m_videoExtensions + "|"
-                                  + g_advancedSettings.GetMusicExtensions() + "|"
-                                  + g_advancedSettings.m_discStubExtensions;
-            CDirectory::GetDirectory((const char*)parent_id, items, supported);
-            DefaultSortItems(items);
+                items.Sort(SortByLabel, SortOrderAscending);
+            } else {
+                // this is the only way to hide unplayable items in the 'files'
+                // view as we cannot tell what context (eg music vs video) the
+                // request came from
+                std::string supported = g_advancedSettings.m_pictureExtensions + "|"
+                                      + g_advancedSettings.m_videoExtensions + "|"
+                                      + g_advancedSettings.GetMusicExtensions() + "|"
+                                      + g_advancedSettings.m_discStubExtensions;
+                CDirectory::GetDirectory((const char*)parent_id, items, supported);
+                DefaultSortItems(items);
+            }
+
+            if (items.CacheToDiscAlways() || (items.CacheToDiscIfSlow() && (XbmcThreads::SystemClockMillis() - time) > 1000 )) {
+                NPT_AutoLock lock(m_CacheMutex);
+                items.Save();
+            }
         }
 
-        if (items.CacheToDiscAlways() || (items.CacheToDiscIfSlow() && (XbmcThreads::SystemClockMillis() - time) > 1000 )) {
-            NPT_AutoLock lock(m_CacheMutex);
-            items.Save();
+        // this isn't pretty but needed to properly hide the addons node from clients
+        if (StringUtils::StartsWith(items.GetPath(), "library")) {
+            for (int i=0; i<items.Size(); i++) {
+                if (StringUtils::StartsWith(items[i]->GetPath(), "addons") ||
+                    StringUtils::EndsWith(items[i]->GetPath(), "/addons.xml/"))
+                    items.Remove(i--);
+            }
         }
-    }
 
-    // as there's no library://music support, manually add playlists and music
-    // video nodes
-    if (items.GetPath() == "musicdb://") {
-      CFileItemPtr playlists(new CFileItem("special://musicplaylists/", true));
-      playlists->SetLabel(g_localizeStrings.Get(136));
-      items.Add(playlists);
+        // as there's no library://music support, manually add playlists and music
+        // video nodes
+        if (items.GetPath() == "musicdb://") {
+          CFileItemPtr playlists(new CFileItem("special://musicplaylists/", true));
+          playlists->SetLabel(g_localizeStrings.Get(136));
+          items.Add(playlists);
+
+          CVideoDatabase database;
+          database.Open();
+          if (database.HasContent(VIDEODB_CONTENT_MUSICVIDEOS)) {
+              CFileItemPtr mvideos(new CFileItem("library://video/musicvideos/", true));
+              mvideos->SetLabel(g_localizeStrings.Get(20389));
+              items.Add(mvideos);
+          }
+        }
 
-      CVideoDatabase database;
-      database.Open();
-      if (database.HasContent(VIDEODB_CONTENT_MUSICVIDEOS)) {
-          CFileItemPtr mvideos(new CFileItem("library://video/musicvideos/", true));
-          mvideos->SetLabel(g_localizeStrings.Get(20389));
-          items.Add(mvideos);
-      }
+        CacheResult(cache_key, listing);
     }
 
-    // Don't pass parent_id if action is Search not BrowseDirectChildren, as
-    // we want the engine to determine the best parent id, not necessarily the one
-    // passed
-    NPT_String action_name = action->GetActionDesc().GetName();
+    // only copy the requested slice, the cached items are shared with other
+    // requests and building the response modifies the items it is given
+    NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)listing->Size());
+    page.Copy(*listing, false);
+    for (NPT_UInt32 i=starting_index; i<stop_index; ++i)
+        page.Add(CFileItemPtr(new CFileItem(*listing->Get(i))));
+
     return BuildResponse(
         action,
-        items,
+        page,
         filter,
         starting_index,
         requested_count,
         sort_criteria,
         context,
-        (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars());
+        response_parent_id,
+        listing->Size());
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetLibraryPage
++---------------------------------------------------------------------*/
+bool
+CUPnPServer::GetLibraryPage(const std::string& path,
+                            NPT_UInt32         starting_index,
+                            NPT_UInt32         count,
+                            CFileItemList&     items)
+{
+    std::string db_path = path;
+    if (StringUtils::StartsWithNoCase(db_path, "library://")) {
+        CLibraryDirectory library;
+        db_path = library.GetFolderPath(CURL(db_path));
+    }
+
+    bool paged = false;
+    if (URIUtils::IsVideoDb(db_path)) {
+        VIDEODATABASEDIRECTORY::NODE_TYPE type = CVideoDatabaseDirectory::GetDirectoryType(db_path);
+        paged = type == VIDEODATABASEDIRECTORY::NODE_TYPE_TITLE_MOVIES ||
+                type == VIDEODATABASEDIRECTORY::NODE_TYPE_TITLE_TVSHOWS ||
+                type == VIDEODATABASEDIRECTORY::NODE_TYPE_TITLE_MUSICVIDEOS;
+    }
+    else if (URIUtils::IsMusicDb(db_path)) {
+        MUSICDATABASEDIRECTORY::NODE_TYPE type = CMusicDatabaseDirectory::GetDirectoryType(db_path);
+        paged = type == MUSICDATABASEDIRECTORY::NODE_TYPE_ARTIST ||
+                type == MUSICDATABASEDIRECTORY::NODE_TYPE_ALBUM ||
+                type == MUSICDATABASEDIRECTORY::NODE_TYPE_SONG;
+    }
+    if (!paged)
+        return false;
+
+    // sort the same way DefaultSortItems() would, but let the database
+    // apply it together with the limits
+    items.SetPath(db_path);
+    SortDescription sorting;
+    CGUIViewState* viewState = CGUIViewState::GetViewState(items.IsVideoDb() ? WINDOW_VIDEO_NAV : -1, items);
+    if (viewState) {
+        sorting = viewState->GetSortMethod();
+        delete viewState;
+    }
+    sorting.limitStart = starting_index;
+    sorting.limitEnd   = starting_index + count;
+
+    bool result;
+    if (items.IsVideoDb()) {
+        CVideoDatabase database;
+        if (!database.Open())
+            return false;
+        result = database.GetItems(db_path, items, CDatabase::Filter(), sorting);
+    }
+    else {
+        CMusicDatabase database;
+        if (!database.Open())
+            return false;
+        result = database.GetItems(db_path, items, CDatabase::Filter(), sorting);
+    }
+    if (!result) {
+        items.Clear();
+        return false;
+    }
+
+    // the thumb loader picks the library type from the path
+    items.SetPath(path);
+    if (!items.HasProperty("total"))
+        items.SetProperty("total", items.Size());
+    return true;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetCachedResult
++---------------------------------------------------------------------*/
+std::shared_ptr<CFileItemList>
+CUPnPServer::GetCachedResult(const std::string& key)
+{
+    NPT_AutoLock lock(m_ResultCacheMutex);
+    std::map<std::string, CachedResult>::iterator itr = m_ResultCache.find(key);
+    if (itr == m_ResultCache.end())
+        return std::shared_ptr<CFileItemList>();
+
+    if ((int)(itr->second.expires - XbmcThreads::SystemClockMillis()) <= 0) {
+        m_ResultCache.erase(itr);
+        return std::shared_ptr<CFileItemList>();
+    }
+    return itr->second.items;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::CacheResult
++---------------------------------------------------------------------*/
+void
+CUPnPServer::CacheResult(const std::string& key, const std::shared_ptr<CFileItemList>& items)
+{
+    unsigned int now = XbmcThreads::SystemClockMillis();
+
+    NPT_AutoLock lock(m_ResultCacheMutex);
+    std::map<std::string, CachedResult>::iterator oldest = m_ResultCache.end();
+    for (std::map<std::string, CachedResult>::iterator itr = m_ResultCache.begin(); itr != m_ResultCache.end();) {
+        if ((int)(itr->second.expires - now) <= 0) {
+            m_ResultCache.erase(itr++);
+            continue;
+        }
+        if (oldest == m_ResultCache.end() || (int)(itr->second.expires - oldest->second.expires) < 0)
+            oldest = itr;
+        ++itr;
+    }
+    if (m_ResultCache.size() >= UPNP_RESULT_CACHE_SIZE && oldest != m_ResultCache.end())
+        m_ResultCache.erase(oldest);
+
+    CachedResult& result = m_ResultCache[key];
+    result.items   = items;
+    result.expires = now + UPNP_RESULT_CACHE_TIMEOUT;
 }
 
 /*----------------------------------------------------------------------
@@ -732,7 +897,8 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
                            NPT_UInt32                    requested_count,
                            const char*                   sort_criteria,
                            const PLT_HttpRequestContext& context,
-                           const char*                   parent_id /* = NULL */)
+                           const char*                   parent_id /* = NULL */,
+                           int                           total_matches /* = -1 */)
 {
     NPT_COMPILER_UNUSED(sort_criteria);
 
@@ -759,26 +925,20 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
         thumb_loader->OnLoaderStart();
     }
 
-    // this isn't pretty but needed to properly hide the addons node from clients
-    if (StringUtils::StartsWith(items.GetPath(), "library")) {
-        for (int i=0; i<items.Size(); i++) {
-            if (StringUtils::StartsWith(items[i]->GetPath(), "addons") ||
-                StringUtils::EndsWith(items[i]->GetPath(), "/addons.xml/"))
-                items.Remove(i);
-        }
-    }
+    // with total_matches given, items only hold the page starting at starting_index
+    NPT_UInt32 offset = (total_matches < 0)?0:starting_index;
 
     // won't return more than UPNP_MAX_RETURNED_ITEMS items at a time to keep things smooth
     // 0 requested means as many as possible
     NPT_UInt32 max_count  = (requested_count == 0)?m_MaxReturnedItems:std::min((unsigned long)requested_count, (unsigned long)m_MaxReturnedItems);
-    NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)items.Size()); // don't return more than we can
+    NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)(offset + items.Size())); // don't return more than we can
 
     NPT_Cardinal count = 0;
-    NPT_Cardinal total = items.Size();
+    NPT_Cardinal total = (total_matches < 0)?items.Size():total_matches;
     NPT_String didl = didl_header;
     PLT_MediaObjectReference object;
     for (unsigned long i=starting_index; i<stop_index; ++i) {
-        object = Build(items[i], true, context, thumb_loader, parent_id);
+        object = Build(items[i - offset], true, context, thumb_loader, parent_id);
         if (object.IsNull()) {
             // don't tell the client this item ever existed
             --total;
@@ -18,6 +18,9 @@
  *
  */
 #pragma once
+#include <map>
+#include <memory>
+#include <string>
 #include <utility>
 #include <Platinum/Source/Devices/MediaConnect/PltMediaConnect.h>
 
@@ -121,7 +124,14 @@ private:
                                    NPT_UInt32                    requested_count,
                                    const char*                   sort_criteria,
                                    const PLT_HttpRequestContext& context,
-                                   const char*                   parent_id /* = NULL */);
+                                   const char*                   parent_id /* = NULL */,
+                                   int                           total_matches = -1);
+    bool             GetLibraryPage(const std::string& path,
+                                    NPT_UInt32         starting_index,
+                                    NPT_UInt32         count,
+                                    CFileItemList&     items);
+    std::shared_ptr<CFileItemList> GetCachedResult(const std::string& key);
+    void             CacheResult(const std::string& key, const std::shared_ptr<CFileItemList>& items);
 
     // class methods
     static bool SortItems(CFileItemList& items, const char* sort_criteria);
@@ -135,6 +145,15 @@ private:
 
     NPT_Mutex                       m_CacheMutex;
 
+    // listings kept around for a little while so the following Browse
+    // requests of a client paging through a container don't list it again
+    struct CachedResult {
+        std::shared_ptr<CFileItemList> items;
+        unsigned int                   expires;
+    };
+    NPT_Mutex                           m_ResultCacheMutex;
+    std::map<std::string, CachedResult> m_ResultCache;
+
     NPT_Mutex                       m_FileMutex;
     NPT_Map<NPT_String, NPT_String> m_FileMap;
 
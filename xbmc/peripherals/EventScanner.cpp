@@ -49,6 +49,11 @@ void CEventScanner::Stop(void)
   StopThread(true);
 }
 
+void CEventScanner::Wake(void)
+{
+  m_scanEvent.Set();
+}
+
 EventRateHandle CEventScanner::SetRate(double rateHz)
 {
   CSingleLock lock(m_mutex);
@@ -92,6 +97,14 @@ void CEventScanner::Process(void)
 
     m_callback->ProcessEvents();
 
+    if (!m_callback->NeedsEventScanning())
+    {
+      // Nothing to poll, sleep until there are events
+      AbortableWait(m_scanEvent);
+      nextScanMs = static_cast<double>(SystemClockMillis());
+      continue;
+    }
+
     const double nowMs = static_cast<double>(SystemClockMillis());
     const double scanIntervalMs = GetScanIntervalMs();
 
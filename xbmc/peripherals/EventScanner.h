@@ -34,6 +34,14 @@ namespace PERIPHERALS
     virtual ~IEventScannerCallback(void) { }
 
     virtual void ProcessEvents(void) = 0;
+
+    /*!
+     * \brief Check if events have to be scanned for periodically
+     *
+     * \return False if all sources of events wake the scanner when they
+     *         have events, true otherwise
+     */
+    virtual bool NeedsEventScanning(void) = 0;
   };
 
   /*!
@@ -45,6 +53,9 @@ namespace PERIPHERALS
    *
    * If two instances hold handles from SetRate(), the one with the higher
    * rate wins.
+   *
+   * Events are also processed as soon as Wake() is called. While the
+   * callback doesn't need periodic scans, the scanner sleeps until then.
    */
   class CEventScanner : public IEventRateCallback,
                         protected CThread
@@ -59,6 +70,14 @@ namespace PERIPHERALS
 
     EventRateHandle SetRate(double rateHz);
 
+    /*!
+     * \brief Process events now instead of at the next scan
+     *
+     * Call when events arrived or when the callback's need for periodic
+     * scans changed.
+     */
+    void Wake(void);
+
     // implementation of IEventRateCallback
     virtual void Release(CEventRateHandle* handle) override;
 
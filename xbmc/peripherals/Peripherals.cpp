@@ -787,6 +787,19 @@ void CPeripherals::ProcessEvents(void)
     bus->ProcessEvents();
 }
 
+bool CPeripherals::NeedsEventScanning(void)
+{
+  CSingleLock lock(m_critSectionBusses);
+
+  for (const PeripheralBusPtr& bus : m_busses)
+  {
+    if (bus->NeedsEventScanning())
+      return true;
+  }
+
+  return false;
+}
+
 bool CPeripherals::EnableButtonMapping()
 {
   bool bEnabled = false;
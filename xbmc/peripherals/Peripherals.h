@@ -222,6 +222,12 @@ namespace PERIPHERALS
      */
     EventRateHandle SetEventScanRate(double rateHz) { return m_eventScanner.SetRate(rateHz); }
 
+    /*!
+     * @brief Process peripheral events now. Called by busses that are notified
+     * of input, or whose need for periodic event scans changed.
+     */
+    void WakeEventScanner(void) { m_eventScanner.Wake(); }
+
     /*!
      * 
      */
@@ -244,6 +250,7 @@ namespace PERIPHERALS
 
     // implementation of IEventScannerCallback
     virtual void ProcessEvents(void) override;
+    virtual bool NeedsEventScanning(void) override;
 
     /*!
      * \brief Initialize button mapping
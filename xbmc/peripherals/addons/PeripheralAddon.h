@@ -85,6 +85,7 @@ namespace PERIPHERALS
     //@{
     bool GetJoystickProperties(unsigned int index, CPeripheralJoystick& joystick);
     bool HasButtonMaps(void) const { return m_bProvidesButtonMaps; }
+    bool ProvidesJoysticks(void) const { return m_bProvidesJoysticks; }
     bool GetFeatures(const CPeripheral* device, const std::string& strControllerId, FeatureMap& features);
     bool MapFeature(const CPeripheral* device, const std::string& strControllerId, const ADDON::JoystickFeature& feature);
     bool GetIgnoredPrimitives(const CPeripheral* device, PrimitiveVector& primitives);
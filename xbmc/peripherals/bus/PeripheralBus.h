@@ -168,6 +168,17 @@ namespace PERIPHERALS
      */
     virtual void ProcessEvents(void) { }
 
+    /*!
+     * \brief Check if ProcessEvents() has to be called periodically
+     *
+     * Busses that are notified of input call CPeripherals::WakeEventScanner()
+     * instead. The default ProcessEvents() does nothing, so it doesn't need to
+     * be called at all.
+     *
+     * \return True if the event scanner has to poll this bus, false otherwise
+     */
+    virtual bool NeedsEventScanning(void) const { return false; }
+
     /*!
     * \brief Initialize button mapping
     * \return True if button mapping is enabled for this bus
@@ -25,6 +25,7 @@
 #include "input/joysticks/JoystickTypes.h"
 #include "peripherals/addons/PeripheralAddonTranslator.h"
 #include "peripherals/devices/PeripheralJoystick.h"
+#include "peripherals/Peripherals.h"
 #include "platform/android/activity/XBMCApp.h"
 #include "platform/android/jni/View.h"
 #include "threads/SingleLock.h"
@@ -170,6 +171,13 @@ void CPeripheralBusAndroid::ProcessEvents()
   }
 }
 
+bool CPeripheralBusAndroid::NeedsEventScanning() const
+{
+  // input is pushed, but held buttons and axes still have to be processed periodically
+  CSingleLock lock(m_critSectionStates);
+  return !m_joystickStates.empty();
+}
+
 void CPeripheralBusAndroid::OnInputDeviceAdded(int deviceId)
 {
   const std::string deviceLocation = GetDeviceLocation(deviceId);
@@ -199,6 +207,9 @@ void CPeripheralBusAndroid::OnInputDeviceAdded(int deviceId)
 
   CLog::Log(LOGDEBUG, "CPeripheralBusAndroid: input device with ID %d added", deviceId);
   OnDeviceAdded(deviceLocation);
+
+  // the state of the new joystick has to be scanned from now on
+  m_manager->WakeEventScanner();
 }
 
 void CPeripheralBusAndroid::OnInputDeviceChanged(int deviceId)
@@ -269,19 +280,27 @@ bool CPeripheralBusAndroid::OnInputDeviceEvent(const AInputEvent* event)
   if (event == nullptr)
     return false;
 
-  CSingleLock lock(m_critSectionStates);
-  // get the id of the input device which generated the event
-  int32_t deviceId = AInputEvent_getDeviceId(event);
-
-  // find the matching joystick state
-  auto joystickState = m_joystickStates.find(deviceId);
-  if (joystickState == m_joystickStates.end())
   {
-    CLog::Log(LOGWARNING, "CPeripheralBusAndroid: ignoring input event for unknown input device with ID %d", deviceId);
-    return false;
+    CSingleLock lock(m_critSectionStates);
+    // get the id of the input device which generated the event
+    int32_t deviceId = AInputEvent_getDeviceId(event);
+
+    // find the matching joystick state
+    auto joystickState = m_joystickStates.find(deviceId);
+    if (joystickState == m_joystickStates.end())
+    {
+      CLog::Log(LOGWARNING, "CPeripheralBusAndroid: ignoring input event for unknown input device with ID %d", deviceId);
+      return false;
+    }
+
+    if (!joystickState->second.ProcessEvent(event))
+      return false;
   }
 
-  return joystickState->second.ProcessEvent(event);
+  // handle the event now instead of at the next scan
+  m_manager->WakeEventScanner();
+
+  return true;
 }
 
 bool CPeripheralBusAndroid::PerformDeviceScan(PeripheralScanResults &results)
@@ -45,6 +45,7 @@ namespace PERIPHERALS
     bool InitializeProperties(CPeripheral& peripheral) override;
     void Initialise(void) override;
     void ProcessEvents() override;
+    bool NeedsEventScanning() const override;
 
     // implementations of IInputDeviceCallbacks
     void OnInputDeviceAdded(int deviceId) override;
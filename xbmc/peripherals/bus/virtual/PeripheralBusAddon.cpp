@@ -202,6 +202,18 @@ void CPeripheralBusAddon::ProcessEvents(void)
     addon->ProcessEvents();
 }
 
+bool CPeripheralBusAddon::NeedsEventScanning(void) const
+{
+  CSingleLock lock(m_critSection);
+
+  // add-ons can only be asked for the events of their joysticks
+  return std::any_of(m_addons.begin(), m_addons.end(),
+    [](const PeripheralAddonPtr& addon)
+    {
+      return addon->ProvidesJoysticks() && addon->GetNumberOfPeripherals() > 0;
+    });
+}
+
 bool CPeripheralBusAddon::EnableButtonMapping()
 {
   using namespace ADDON;
@@ -250,7 +262,10 @@ void CPeripheralBusAddon::Register(const PeripheralPtr& peripheral)
   if (SplitLocation(peripheral->Location(), addon, peripheralIndex))
   {
     if (addon->Register(peripheralIndex, peripheral))
+    {
       m_manager->OnDeviceAdded(*this, *peripheral);
+      m_manager->WakeEventScanner();
+    }
   }
 }
 
@@ -83,6 +83,7 @@ namespace PERIPHERALS
     virtual size_t       GetNumberOfPeripheralsWithId(const int iVendorId, const int iProductId) const override;
     virtual void         GetDirectory(const std::string &strPath, CFileItemList &items) const override;
     virtual void         ProcessEvents(void) override;
+    virtual bool         NeedsEventScanning(void) const override;
     virtual bool         EnableButtonMapping() override;
 
     // implementation of IAddonMgrCallback
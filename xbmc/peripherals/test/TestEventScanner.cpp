@@ -0,0 +1,85 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "peripherals/EventScanner.h"
+#include "peripherals/test/TestHelpers.h"
+#ifdef TARGET_POSIX
+#include "linux/XTimeUtils.h"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace PERIPHERALS;
+
+namespace
+{
+// long enough to never expire while the test runs fine
+const unsigned int WAIT_MS = 10000;
+}
+
+TEST(TestEventScanner, WakeProcessesEvents)
+{
+  CVirtualInput input(false);
+  CEventScanner scanner(&input);
+  scanner.Start();
+  ASSERT_TRUE(input.WaitScans(1, WAIT_MS));
+
+  // nothing is scanned, so every press is processed because of its wake
+  for (unsigned int i = 0; i < 20; ++i)
+  {
+    input.Press(scanner);
+    ASSERT_TRUE(input.WaitProcessed(WAIT_MS));
+  }
+
+  scanner.Stop();
+
+  EXPECT_EQ(20u, input.Latencies().size());
+  // once when starting and once per wake
+  EXPECT_EQ(21u, input.Scans());
+}
+
+TEST(TestEventScanner, SleepsWithoutScanning)
+{
+  CVirtualInput input(false);
+  CEventScanner scanner(&input);
+  scanner.Start();
+  ASSERT_TRUE(input.WaitScans(1, WAIT_MS));
+
+  // a scanner that polls would have scanned several times meanwhile
+  Sleep(100);
+  scanner.Stop();
+
+  EXPECT_EQ(1u, input.Scans());
+}
+
+TEST(TestEventScanner, ScansWhenNeeded)
+{
+  CVirtualInput input(true);
+  CEventScanner scanner(&input);
+  scanner.Start();
+
+  // scanned on its own, without any wake
+  EXPECT_TRUE(input.WaitScans(5, WAIT_MS));
+
+  input.Press(scanner);
+  EXPECT_TRUE(input.WaitProcessed(WAIT_MS));
+
+  scanner.Stop();
+}
@@ -0,0 +1,111 @@
+#pragma once
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "peripherals/EventScanner.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+
+/*!
+ * Stands in for the busses: an input source that either has to be polled or
+ * wakes the scanner when a button is pressed, and remembers how long it took
+ * until the press was processed.
+ */
+class CVirtualInput : public PERIPHERALS::IEventScannerCallback
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  explicit CVirtualInput(bool bNeedsScanning) :
+    m_bNeedsScanning(bNeedsScanning),
+    m_bPressed(false),
+    m_processed(false),
+    m_scanned(false),
+    m_iScans(0)
+  {
+  }
+
+  virtual void ProcessEvents(void) override
+  {
+    {
+      CSingleLock lock(m_critSection);
+      if (m_bPressed)
+      {
+        m_latenciesUs.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_pressTime).count());
+        m_bPressed = false;
+        m_processed.Set();
+      }
+    }
+
+    ++m_iScans;
+    m_scanned.Set();
+  }
+
+  virtual bool NeedsEventScanning(void) override { return m_bNeedsScanning; }
+
+  void Press(PERIPHERALS::CEventScanner &scanner)
+  {
+    {
+      CSingleLock lock(m_critSection);
+      m_pressTime = Clock::now();
+      m_bPressed = true;
+    }
+    if (!m_bNeedsScanning)
+      scanner.Wake();
+  }
+
+  bool WaitProcessed(unsigned int iTimeoutMs) { return m_processed.WaitMSec(iTimeoutMs); }
+
+  /*!
+   * Waits until the events were processed at least iScans times, at most
+   * iTimeoutMs between two scans.
+   */
+  bool WaitScans(unsigned int iScans, unsigned int iTimeoutMs)
+  {
+    while (m_iScans < iScans)
+    {
+      if (!m_scanned.WaitMSec(iTimeoutMs))
+        return false;
+    }
+    return true;
+  }
+
+  unsigned int Scans(void) const { return m_iScans; }
+
+  std::vector<long long> Latencies(void)
+  {
+    CSingleLock lock(m_critSection);
+    return m_latenciesUs;
+  }
+
+private:
+  const bool m_bNeedsScanning;
+  bool m_bPressed;
+  Clock::time_point m_pressTime;
+  CEvent m_processed;
+  CEvent m_scanned;
+  std::atomic<unsigned int> m_iScans;
+  std::vector<long long> m_latenciesUs;
+  CCriticalSection m_critSection;
+};
@@ -354,6 +354,7 @@ void CProfilesManager::CreateProfileFolders()
   CDirectory::Create(GetThumbnailsFolder());
   CDirectory::Create(GetVideoThumbFolder());
   CDirectory::Create(GetBookmarksThumbFolder());
+  CDirectory::Create(GetKeyframesFolder());
   for (size_t hex = 0; hex < 16; hex++)
     CDirectory::Create(URIUtils::AddFileToFolder(GetThumbnailsFolder(), StringUtils::Format("%lx", hex)));
 
@@ -500,6 +501,11 @@ std::string CProfilesManager::GetBookmarksThumbFolder() const
   return URIUtils::AddFileToFolder(GetVideoThumbFolder(), "Bookmarks");
 }
 
+std::string CProfilesManager::GetKeyframesFolder() const
+{
+  return URIUtils::AddFileToFolder(GetVideoThumbFolder(), "Keyframes");
+}
+
 std::string CProfilesManager::GetLibraryFolder() const
 {
   if (GetCurrentProfile().hasDatabases())
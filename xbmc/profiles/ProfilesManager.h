@@ -170,6 +170,7 @@ public:
   std::string GetThumbnailsFolder() const;
   std::string GetVideoThumbFolder() const;
   std::string GetBookmarksThumbFolder() const;
+  std::string GetKeyframesFolder() const;
   std::string GetLibraryFolder() const;
   std::string GetSettingsFile() const;
 
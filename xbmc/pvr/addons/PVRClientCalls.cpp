@@ -0,0 +1,217 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "PVRClientCalls.h"
+
+#include "addons/PVRClient.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "threads/ThreadLocal.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+using namespace PVR;
+
+namespace
+{
+struct SCall
+{
+  SCall() : done(true), error(PVR_ERROR_UNKNOWN) {}
+
+  CEvent done;
+  PVR_ERROR error;
+  CCriticalSection transfersSection;
+  std::vector<std::function<void()>> transfers;
+};
+
+// the call the current thread executes for Run()
+XbmcThreads::ThreadLocal<SCall> currentCall;
+
+/*!
+ * @brief The calls that are executed, at most one per client. A client that
+ * hangs is not called again before it answered, so it can't occupy a worker
+ * for every call made meanwhile.
+ */
+class CCallsInFlight
+{
+public:
+  static CCallsInFlight &GetInstance()
+  {
+    static CCallsInFlight callsInFlight;
+    return callsInFlight;
+  }
+
+  /*!
+   * @brief Make call the call in flight for a client.
+   * @return nullptr on success, the call the client still executes otherwise.
+   */
+  std::shared_ptr<SCall> Claim(int iClientId, const std::shared_ptr<SCall> &call)
+  {
+    CSingleLock lock(m_critSection);
+    std::shared_ptr<SCall> &inFlight = m_calls[iClientId];
+    if (inFlight && !inFlight->done.WaitMSec(0))
+      return inFlight;
+
+    inFlight = call;
+    return std::shared_ptr<SCall>();
+  }
+
+  std::shared_ptr<SCall> Get(int iClientId)
+  {
+    CSingleLock lock(m_critSection);
+    auto it = m_calls.find(iClientId);
+    return it != m_calls.end() ? it->second : std::shared_ptr<SCall>();
+  }
+
+  void Release(int iClientId, const std::shared_ptr<SCall> &call)
+  {
+    CSingleLock lock(m_critSection);
+    auto it = m_calls.find(iClientId);
+    if (it != m_calls.end() && it->second == call)
+      m_calls.erase(it);
+  }
+
+private:
+  CCriticalSection m_critSection;
+  std::map<int, std::shared_ptr<SCall>> m_calls;
+};
+
+void Submit(int iClientId, const std::shared_ptr<SCall> &call, const CPVRClientCalls::Call &function)
+{
+  CJobManager::GetInstance().Submit([iClientId, call, function]() {
+    currentCall.set(call.get());
+    call->error = function();
+    currentCall.set(NULL);
+    CCallsInFlight::GetInstance().Release(iClientId, call);
+    call->done.Set();
+  }, CJob::PRIORITY_DEDICATED);
+}
+}
+
+CPVRClientCalls::CPVRClientCalls(unsigned int iTimeoutMs) :
+  m_iTimeoutMs(iTimeoutMs)
+{
+}
+
+void CPVRClientCalls::Add(int iClientId, const Call &call)
+{
+  m_calls.push_back(std::make_pair(iClientId, call));
+}
+
+void CPVRClientCalls::Transfer(const std::function<void()> &transfer)
+{
+  SCall *call = currentCall.get();
+  if (!call)
+  {
+    transfer();
+    return;
+  }
+
+  CSingleLock lock(call->transfersSection);
+  call->transfers.push_back(transfer);
+}
+
+bool CPVRClientCalls::WaitForClient(int iClientId, unsigned int iTimeoutMs)
+{
+  std::shared_ptr<SCall> inFlight = CCallsInFlight::GetInstance().Get(iClientId);
+  return !inFlight || inFlight->done.WaitMSec(iTimeoutMs);
+}
+
+std::map<int, PVR_ERROR> CPVRClientCalls::Run()
+{
+  std::map<int, PVR_ERROR> results;
+  XbmcThreads::EndTime timeout(m_iTimeoutMs);
+
+  // the state is shared with the jobs, a job that times out still has it to write to
+  std::vector<std::shared_ptr<SCall>> calls;
+  std::vector<size_t> busy;
+  for (size_t i = 0; i < m_calls.size(); ++i)
+  {
+    std::shared_ptr<SCall> call = std::make_shared<SCall>();
+    calls.push_back(call);
+
+    if (CCallsInFlight::GetInstance().Claim(m_calls[i].first, call))
+      busy.push_back(i);
+    else
+      Submit(m_calls[i].first, call, m_calls[i].second);
+  }
+
+  // clients still busy with an earlier call are called once they answered it
+  for (size_t i : busy)
+  {
+    int iClientId = m_calls[i].first;
+    std::shared_ptr<SCall> inFlight;
+    while ((inFlight = CCallsInFlight::GetInstance().Claim(iClientId, calls[i])) &&
+           inFlight->done.WaitMSec(timeout.MillisLeft()))
+      ;
+
+    if (inFlight)
+    {
+      CLog::Log(LOGERROR, "PVR - %s - client '%d' did not answer an earlier call within %u ms", __FUNCTION__, iClientId, m_iTimeoutMs);
+      results[iClientId] = PVR_ERROR_SERVER_TIMEOUT;
+      continue;
+    }
+
+    Submit(iClientId, calls[i], m_calls[i].second);
+  }
+
+  for (size_t i = 0; i < calls.size(); ++i)
+  {
+    int iClientId = m_calls[i].first;
+    if (results.find(iClientId) != results.end())
+      continue;
+
+    SCall &call = *calls[i];
+    if (!call.done.WaitMSec(timeout.MillisLeft()))
+    {
+      CLog::Log(LOGERROR, "PVR - %s - client '%d' did not answer within %u ms", __FUNCTION__, iClientId, m_iTimeoutMs);
+      results[iClientId] = PVR_ERROR_SERVER_TIMEOUT;
+      continue;
+    }
+
+    results[iClientId] = call.error;
+
+    // the job is done with them, no need to lock
+    for (const auto &transfer : call.transfers)
+      transfer();
+    call.transfers.clear();
+  }
+
+  return results;
+}
+
+PVR_ERROR CPVRClientCalls::Run(const char *strWhat, std::vector<int> &failedClients)
+{
+  PVR_ERROR error(PVR_ERROR_NO_ERROR);
+  for (const auto &result : Run())
+  {
+    if (result.second != PVR_ERROR_NOT_IMPLEMENTED &&
+        result.second != PVR_ERROR_NO_ERROR)
+    {
+      CLog::Log(LOGERROR, "PVR - %s - cannot get %s from client '%d': %s", __FUNCTION__, strWhat, result.first, CPVRClient::ToString(result.second));
+      error = result.second;
+      failedClients.push_back(result.first);
+    }
+  }
+
+  return error;
+}
@@ -0,0 +1,95 @@
+#pragma once
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "addons/kodi-addon-dev-kit/include/kodi/xbmc_pvr_types.h"
+
+namespace PVR
+{
+  /*!
+   * @brief Calls several clients at once and waits for all of them, but at most
+   * for a timeout, instead of waiting for one client after the other.
+   *
+   * The entries a client transfers during the call must be handed to
+   * Transfer(). They are applied to their container by the thread that waits,
+   * after all clients answered, so containers are never changed by two
+   * clients at once and the waiting thread may keep containers locked. The
+   * entries of a client that didn't answer in time are dropped.
+   *
+   * A client is never executing more than one call. A client that still
+   * executes an earlier call, e.g. one that timed out, is called once it
+   * answered that one, within the same timeout.
+   */
+  class CPVRClientCalls
+  {
+  public:
+    typedef std::function<PVR_ERROR()> Call;
+
+    /*!
+     * @param iTimeoutMs the time to wait for the clients to answer
+     */
+    explicit CPVRClientCalls(unsigned int iTimeoutMs);
+
+    /*!
+     * @brief Add the call for a client.
+     * @param iClientId the id of the client.
+     * @param call the call, only executed by Run().
+     */
+    void Add(int iClientId, const Call &call);
+
+    /*!
+     * @brief Execute all calls and apply the entries transferred by them.
+     * @return the result of every call, PVR_ERROR_SERVER_TIMEOUT for the clients that didn't answer in time.
+     */
+    std::map<int, PVR_ERROR> Run();
+
+    /*!
+     * @brief Execute all calls and apply the entries transferred by them.
+     * @param strWhat what the calls get, for the log.
+     * @param failedClients the ids of the clients that returned an error or didn't answer in time are added to this.
+     * @return PVR_ERROR_NO_ERROR if all clients answered fine or didn't implement the call, the error of a failed client otherwise.
+     */
+    PVR_ERROR Run(const char *strWhat, std::vector<int> &failedClients);
+
+    /*!
+     * @brief Apply an entry transferred by a client.
+     * @param transfer the function that adds the entry to its container. Executed
+     * right away unless the current thread executes a call for Run().
+     */
+    static void Transfer(const std::function<void()> &transfer);
+
+    /*!
+     * @brief Wait until a client answered the call it executes, e.g. one that timed out.
+     * @param iClientId the id of the client.
+     * @param iTimeoutMs the time to wait at most.
+     * @return true if the client doesn't execute a call, false if it still does.
+     */
+    static bool WaitForClient(int iClientId, unsigned int iTimeoutMs);
+
+  private:
+    unsigned int m_iTimeoutMs;
+    std::vector<std::pair<int, Call>> m_calls;
+  };
+}
@@ -35,11 +35,13 @@
 #include "guilib/GUIWindowManager.h"
 #include "GUIUserMessages.h"
 #include "messaging/ApplicationMessenger.h"
+#include "pvr/addons/PVRClientCalls.h"
 #include "pvr/channels/PVRChannelGroupInternal.h"
 #include "pvr/channels/PVRChannelGroups.h"
 #include "pvr/PVRManager.h"
 #include "pvr/recordings/PVRRecordings.h"
 #include "pvr/timers/PVRTimers.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "utils/Variant.h"
 
@@ -360,6 +362,22 @@ int CPVRClients::GetCreatedClients(PVR_CLIENTMAP &clients) const
   return iReturn;
 }
 
+PVR_ERROR CPVRClients::CallCreatedClients(const char *strWhat, const std::function<PVR_ERROR(const PVR_CLIENT &client)> &call, std::vector<int> &failedClients) const
+{
+  PVR_CLIENTMAP clients;
+  GetCreatedClients(clients);
+
+  /* a slow backend shouldn't hold up the others */
+  CPVRClientCalls calls(g_advancedSettings.m_iPVRClientTimeout * 1000);
+  for (const auto &client : clients)
+  {
+    PVR_CLIENT pvrClient = client.second;
+    calls.Add(client.first, [call, pvrClient]() { return call(pvrClient); });
+  }
+
+  return calls.Run(strWhat, failedClients);
+}
+
 int CPVRClients::GetPlayingClientID(void) const
 {
   CSingleLock lock(m_critSection);
@@ -472,24 +490,10 @@ bool CPVRClients::HasTimerSupport(int iClientId)
 
 bool CPVRClients::GetTimers(CPVRTimers *timers, std::vector<int> &failedClients)
 {
-  bool bSuccess(true);
-  PVR_CLIENTMAP clients;
-  GetCreatedClients(clients);
-
   /* get the timer list from each client */
-  for (const auto &client : clients)
-  {
-    PVR_ERROR currentError = client.second->GetTimers(timers);
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      CLog::Log(LOGERROR, "PVR - %s - cannot get timers from client '%d': %s",__FUNCTION__, client.first, CPVRClient::ToString(currentError));
-      bSuccess = false;
-      failedClients.push_back(client.first);
-    }
-  }
-
-  return bSuccess;
+  return CallCreatedClients("timers", [timers](const PVR_CLIENT &client) {
+    return client->GetTimers(timers);
+  }, failedClients) == PVR_ERROR_NO_ERROR;
 }
 
 PVR_ERROR CPVRClients::AddTimer(const CPVRTimerInfoTag &timer)
@@ -586,24 +590,11 @@ PVR_ERROR CPVRClients::GetTimerTypes(CPVRTimerTypes& results, int iClientId) con
   return error;
 }
 
-PVR_ERROR CPVRClients::GetRecordings(CPVRRecordings *recordings, bool deleted)
+PVR_ERROR CPVRClients::GetRecordings(CPVRRecordings *recordings, bool deleted, std::vector<int> &failedClients)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetCreatedClients(clients);
-
-  for (const auto &client : clients)
-  {
-    PVR_ERROR currentError = client.second->GetRecordings(recordings, deleted);
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      CLog::Log(LOGERROR, "PVR - %s - cannot get recordings from client '%d': %s",__FUNCTION__, client.first, CPVRClient::ToString(currentError));
-      error = currentError;
-    }
-  }
-
-  return error;
+  return CallCreatedClients(deleted ? "deleted recordings" : "recordings", [recordings, deleted](const PVR_CLIENT &client) {
+    return client->GetRecordings(recordings, deleted);
+  }, failedClients);
 }
 
 PVR_ERROR CPVRClients::RenameRecording(const CPVRRecording &recording)
@@ -825,66 +816,28 @@ PVR_ERROR CPVRClients::SetEPGTimeFrame(int iDays)
   return error;
 }
 
-PVR_ERROR CPVRClients::GetChannels(CPVRChannelGroupInternal *group)
+PVR_ERROR CPVRClients::GetChannels(CPVRChannelGroupInternal *group, std::vector<int> &failedClients)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetCreatedClients(clients);
-
   /* get the channel list from each client */
-  for (const auto &client : clients)
-  {
-    PVR_ERROR currentError = client.second->GetChannels(*group, group->IsRadio());
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      error = currentError;
-      CLog::Log(LOGERROR, "PVR - %s - cannot get channels from client '%d': %s",__FUNCTION__, client.first, CPVRClient::ToString(error));
-    }
-  }
-
-  return error;
+  bool bRadio = group->IsRadio();
+  return CallCreatedClients("channels", [group, bRadio](const PVR_CLIENT &client) {
+    return client->GetChannels(*group, bRadio);
+  }, failedClients);
 }
 
-PVR_ERROR CPVRClients::GetChannelGroups(CPVRChannelGroups *groups)
+PVR_ERROR CPVRClients::GetChannelGroups(CPVRChannelGroups *groups, std::vector<int> &failedClients)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetCreatedClients(clients);
-
-  for (const auto &client : clients)
-  {
-    PVR_ERROR currentError = client.second->GetChannelGroups(groups);
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      error = currentError;
-      CLog::Log(LOGERROR, "PVR - %s - cannot get groups from client '%d': %s",__FUNCTION__, client.first, CPVRClient::ToString(error));
-    }
-  }
-
-  return error;
+  return CallCreatedClients("groups", [groups](const PVR_CLIENT &client) {
+    return client->GetChannelGroups(groups);
+  }, failedClients);
 }
 
-PVR_ERROR CPVRClients::GetChannelGroupMembers(CPVRChannelGroup *group)
+PVR_ERROR CPVRClients::GetChannelGroupMembers(CPVRChannelGroup *group, std::vector<int> &failedClients)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetCreatedClients(clients);
-
   /* get the member list from each client */
-  for (const auto &client : clients)
-  {
-    PVR_ERROR currentError = client.second->GetChannelGroupMembers(group);
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      error = currentError;
-      CLog::Log(LOGERROR, "PVR - %s - cannot get group members from client '%d': %s",__FUNCTION__, client.first, CPVRClient::ToString(error));
-    }
-  }
-
-  return error;
+  return CallCreatedClients("group members", [group](const PVR_CLIENT &client) {
+    return client->GetChannelGroupMembers(group);
+  }, failedClients);
 }
 
 bool CPVRClients::HasMenuHooks(int iClientID, PVR_MENUHOOK_CAT cat)
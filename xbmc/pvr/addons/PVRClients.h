@@ -29,6 +29,7 @@
 #include "addons/PVRClient.h"
 
 #include <deque>
+#include <functional>
 #include <vector>
 
 namespace EPG
@@ -407,9 +408,10 @@ namespace PVR
      * @brief Get all recordings from clients
      * @param recordings Store the recordings in this container.
      * @param deleted Return deleted recordings
+     * @param failedClients in case of errors will contain the ids of the clients for which the recordings could not be obtained.
      * @return The amount of recordings that were added.
      */
-    PVR_ERROR GetRecordings(CPVRRecordings *recordings, bool deleted);
+    PVR_ERROR GetRecordings(CPVRRecordings *recordings, bool deleted, std::vector<int> &failedClients);
 
     /*!
      * @brief Rename a recordings on the backend.
@@ -525,10 +527,10 @@ namespace PVR
     /*!
      * @brief Get all channels from backends.
      * @param group The container to store the channels in.
-     * @param error An error if it occured.
+     * @param failedClients in case of errors will contain the ids of the clients for which the channels could not be obtained.
      * @return The amount of channels that were added.
      */
-    PVR_ERROR GetChannels(CPVRChannelGroupInternal *group);
+    PVR_ERROR GetChannels(CPVRChannelGroupInternal *group, std::vector<int> &failedClients);
 
     /*!
      * @brief Check whether a client supports channel groups.
@@ -540,18 +542,18 @@ namespace PVR
     /*!
      * @brief Get all channel groups from backends.
      * @param groups Store the channel groups in this container.
-     * @param error An error if it occured.
+     * @param failedClients in case of errors will contain the ids of the clients for which the groups could not be obtained.
      * @return The amount of groups that were added.
      */
-    PVR_ERROR GetChannelGroups(CPVRChannelGroups *groups);
+    PVR_ERROR GetChannelGroups(CPVRChannelGroups *groups, std::vector<int> &failedClients);
 
     /*!
      * @brief Get all group members of a channel group.
      * @param group The group to get the member for.
-     * @param error An error if it occured.
+     * @param failedClients in case of errors will contain the ids of the clients for which the members could not be obtained.
      * @return The amount of channels that were added.
      */
-    PVR_ERROR GetChannelGroupMembers(CPVRChannelGroup *group);
+    PVR_ERROR GetChannelGroupMembers(CPVRChannelGroup *group, std::vector<int> &failedClients);
 
     //@}
 
@@ -699,6 +701,15 @@ namespace PVR
      */
     int GetCreatedClients(PVR_CLIENTMAP &clients) const;
 
+    /*!
+     * @brief Call all created clients at once.
+     * @param strWhat what is fetched, for the log.
+     * @param call the call for one client.
+     * @param failedClients the ids of the clients that returned an error or didn't answer in time are added to this.
+     * @return PVR_ERROR_NO_ERROR if all clients succeeded or don't implement the call, the error of a failed client otherwise.
+     */
+    PVR_ERROR CallCreatedClients(const char *strWhat, const std::function<PVR_ERROR(const PVR_CLIENT &client)> &call, std::vector<int> &failedClients) const;
+
     /*!
      * @brief Check whether a client is registered.
      * @param client The client to check.
@@ -0,0 +1,76 @@
+#pragma once
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "pvr/addons/PVRClientCalls.h"
+#include "threads/Event.h"
+
+/*!
+ * Behaves like a PVR add-on: a call transfers its entries, then takes the
+ * latency of the backend before it answers with the error the client was
+ * created with. Release() ends the latency of all calls early.
+ */
+class CStubPVRClient
+{
+public:
+  CStubPVRClient(unsigned int iLatencyMs, PVR_ERROR error = PVR_ERROR_NO_ERROR) :
+    m_iLatencyMs(iLatencyMs),
+    m_error(error),
+    m_release(std::make_shared<CEvent>(true)),
+    m_answered(std::make_shared<CEvent>(true)),
+    m_calls(std::make_shared<std::atomic<int>>(0))
+  {
+  }
+
+  /*!
+   * @brief A call that transfers iEntries entries, transfer(i) adds the entry i to its container.
+   */
+  PVR::CPVRClientCalls::Call Call(int iEntries, const std::function<void(int)> &transfer) const
+  {
+    unsigned int iLatencyMs = m_iLatencyMs;
+    PVR_ERROR error = m_error;
+    std::shared_ptr<CEvent> release = m_release;
+    std::shared_ptr<CEvent> answered = m_answered;
+    std::shared_ptr<std::atomic<int>> calls = m_calls;
+    return [iEntries, transfer, iLatencyMs, error, release, answered, calls]() {
+      ++*calls;
+      for (int i = 0; i < iEntries; ++i)
+        PVR::CPVRClientCalls::Transfer([transfer, i]() { transfer(i); });
+      release->WaitMSec(iLatencyMs);
+      answered->Set();
+      return error;
+    };
+  }
+
+  void Release() { m_release->Set(); }
+  bool WaitAnswered(unsigned int iTimeoutMs) { return m_answered->WaitMSec(iTimeoutMs); }
+  int Calls() const { return *m_calls; }
+
+private:
+  unsigned int m_iLatencyMs;
+  PVR_ERROR m_error;
+  std::shared_ptr<CEvent> m_release;
+  std::shared_ptr<CEvent> m_answered;
+  std::shared_ptr<std::atomic<int>> m_calls;
+};
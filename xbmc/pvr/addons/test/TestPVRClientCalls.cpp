@@ -0,0 +1,160 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <thread>
+#include <vector>
+
+#include "pvr/addons/PVRClientCalls.h"
+#include "pvr/addons/test/TestHelpers.h"
+#include "threads/SystemClock.h"
+
+#include "gtest/gtest.h"
+
+using namespace PVR;
+
+namespace
+{
+// long enough to never expire while the test runs fine
+const unsigned int WAIT_MS = 10000;
+}
+
+TEST(TestPVRClientCalls, CallsClientsInParallel)
+{
+  const int CLIENTS = 4;
+  const unsigned int LATENCY_MS = 500;
+  std::vector<int> transferred;
+  std::vector<CStubPVRClient> clients;
+  for (int i = 0; i < CLIENTS; ++i)
+    clients.emplace_back(LATENCY_MS);
+
+  CPVRClientCalls calls(WAIT_MS);
+  for (int iClientId = 1; iClientId <= CLIENTS; ++iClientId)
+    calls.Add(iClientId, clients[iClientId - 1].Call(10, [&transferred](int i) { transferred.push_back(i); }));
+
+  // one after the other they would take the sum of the latencies
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  std::map<int, PVR_ERROR> results = calls.Run();
+  unsigned int elapsed = XbmcThreads::SystemClockMillis() - start;
+
+  ASSERT_EQ(4u, results.size());
+  for (const auto &result : results)
+    EXPECT_EQ(PVR_ERROR_NO_ERROR, result.second);
+  EXPECT_EQ(40u, transferred.size());
+  EXPECT_LT(elapsed, (CLIENTS - 1) * LATENCY_MS);
+}
+
+TEST(TestPVRClientCalls, TransfersAreAppliedByRun)
+{
+  std::vector<int> transferred;
+  std::thread::id runThread = std::this_thread::get_id();
+  CStubPVRClient client(10);
+  CStubPVRClient unsupported(10, PVR_ERROR_NOT_IMPLEMENTED);
+
+  CPVRClientCalls calls(WAIT_MS);
+  calls.Add(11, client.Call(3, [&transferred, runThread](int i) {
+    EXPECT_EQ(runThread, std::this_thread::get_id());
+    transferred.push_back(i);
+  }));
+  calls.Add(12, unsupported.Call(0, [](int i) {}));
+
+  std::map<int, PVR_ERROR> results = calls.Run();
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, results[11]);
+  EXPECT_EQ(PVR_ERROR_NOT_IMPLEMENTED, results[12]);
+  EXPECT_EQ(3u, transferred.size());
+}
+
+TEST(TestPVRClientCalls, TimeoutDropsTransfers)
+{
+  std::vector<int> fast;
+  std::vector<int> slow;
+  CStubPVRClient fastClient(10);
+  CStubPVRClient slowClient(WAIT_MS);
+
+  CPVRClientCalls calls(100);
+  calls.Add(21, fastClient.Call(5, [&fast](int i) { fast.push_back(i); }));
+  calls.Add(22, slowClient.Call(5, [&slow](int i) { slow.push_back(i); }));
+
+  std::vector<int> failedClients;
+  EXPECT_EQ(PVR_ERROR_SERVER_TIMEOUT, calls.Run("entries", failedClients));
+  EXPECT_EQ(std::vector<int>({ 22 }), failedClients);
+  EXPECT_EQ(5u, fast.size());
+
+  // the late client must not touch the entries after Run() returned
+  slowClient.Release();
+  ASSERT_TRUE(slowClient.WaitAnswered(WAIT_MS));
+  EXPECT_TRUE(slow.empty());
+}
+
+TEST(TestPVRClientCalls, SingleClientTimesOut)
+{
+  std::vector<int> transferred;
+  CStubPVRClient client(WAIT_MS);
+
+  CPVRClientCalls calls(100);
+  calls.Add(31, client.Call(1, [&transferred](int i) { transferred.push_back(i); }));
+
+  std::map<int, PVR_ERROR> results = calls.Run();
+  EXPECT_EQ(PVR_ERROR_SERVER_TIMEOUT, results[31]);
+
+  client.Release();
+  ASSERT_TRUE(client.WaitAnswered(WAIT_MS));
+  EXPECT_TRUE(transferred.empty());
+}
+
+TEST(TestPVRClientCalls, BusyClientIsNotCalledAgain)
+{
+  std::vector<int> transferred;
+  CStubPVRClient client(WAIT_MS);
+  CPVRClientCalls::Call call = client.Call(1, [&transferred](int i) { transferred.push_back(i); });
+
+  CPVRClientCalls hanging(100);
+  hanging.Add(41, call);
+  EXPECT_EQ(PVR_ERROR_SERVER_TIMEOUT, hanging.Run()[41]);
+
+  // still busy with the first call, so not called
+  CPVRClientCalls skipped(100);
+  skipped.Add(41, call);
+  EXPECT_EQ(PVR_ERROR_SERVER_TIMEOUT, skipped.Run()[41]);
+  EXPECT_EQ(1, client.Calls());
+
+  // called as soon as it answered the first call, which ends the latency of the second one too
+  CPVRClientCalls waiting(WAIT_MS);
+  waiting.Add(41, call);
+  client.Release();
+  EXPECT_EQ(PVR_ERROR_NO_ERROR, waiting.Run()[41]);
+  EXPECT_EQ(2, client.Calls());
+  EXPECT_EQ(1u, transferred.size());
+}
+
+TEST(TestPVRClientCalls, WaitForClientInFlight)
+{
+  CStubPVRClient client(WAIT_MS);
+  CPVRClientCalls calls(100);
+  calls.Add(51, client.Call(0, [](int i) {}));
+  EXPECT_EQ(PVR_ERROR_SERVER_TIMEOUT, calls.Run()[51]);
+
+  // the add-on mustn't be destroyed while it executes the call that timed out
+  EXPECT_FALSE(CPVRClientCalls::WaitForClient(51, 100));
+  client.Release();
+  EXPECT_TRUE(CPVRClientCalls::WaitForClient(51, WAIT_MS));
+
+  // clients without a call in flight don't wait
+  EXPECT_TRUE(CPVRClientCalls::WaitForClient(52, 0));
+}
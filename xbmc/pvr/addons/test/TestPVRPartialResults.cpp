@@ -0,0 +1,160 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "pvr/addons/PVRClientCalls.h"
+#include "pvr/addons/test/TestHelpers.h"
+#include "pvr/channels/PVRChannelGroup.h"
+#include "pvr/recordings/PVRRecordings.h"
+#include "utils/StringUtils.h"
+
+#include "gtest/gtest.h"
+
+using namespace PVR;
+
+namespace
+{
+// long enough to never expire while the test runs fine
+const unsigned int WAIT_MS = 10000;
+const unsigned int TIMEOUT_MS = 200;
+
+class CTestChannelGroup : public CPVRChannelGroup
+{
+public:
+  CTestChannelGroup() : CPVRChannelGroup(false, 1, "test") {}
+
+  void AddChannel(int iClientId, int iUniqueId)
+  {
+    PVR_CHANNEL channel;
+    memset(&channel, 0, sizeof(channel));
+    channel.iUniqueId = iUniqueId;
+    CPVRChannelPtr tag(new CPVRChannel(channel, iClientId));
+
+    PVRChannelGroupMember member = { tag, static_cast<unsigned int>(m_sortedMembers.size() + 1), 0 };
+    m_sortedMembers.push_back(member);
+    m_members.insert(std::make_pair(tag->StorageId(), member));
+  }
+
+  bool HasChannel(int iClientId, int iUniqueId) const
+  {
+    return m_members.find(std::make_pair(iClientId, iUniqueId)) != m_members.end();
+  }
+
+  std::vector<int> &FailedClients() { return m_failedClients; }
+
+  bool RemoveDeleted(const CTestChannelGroup &channels) { return RemoveDeletedChannels(channels); }
+};
+
+class CTestRecordings : public CPVRRecordings
+{
+public:
+  void Reload(const std::function<void(std::vector<int> &failedClients)> &getRecordings) { ReloadFromClients(getRecordings); }
+
+  void Add(int iClientId, int i)
+  {
+    CPVRRecordingPtr tag(new CPVRRecording);
+    tag->m_iClientId = iClientId;
+    tag->m_strRecordingId = StringUtils::Format("%d-%d", iClientId, i);
+    UpdateFromClient(tag);
+  }
+
+  bool Has(int iClientId, int i) const
+  {
+    return GetById(iClientId, StringUtils::Format("%d-%d", iClientId, i)) != nullptr;
+  }
+};
+}
+
+TEST(TestPVRPartialResults, ChannelsOfFailedClientsAreKept)
+{
+  CTestChannelGroup group;
+  for (int iClientId = 1; iClientId <= 3; ++iClientId)
+    for (int i = 0; i < 3; ++i)
+      group.AddChannel(iClientId, i);
+
+  // client 1 deleted its last channel, client 2 is too slow and client 3 fails
+  CStubPVRClient healthy(10);
+  CStubPVRClient slow(WAIT_MS);
+  CStubPVRClient failing(10, PVR_ERROR_SERVER_ERROR);
+
+  CTestChannelGroup channels;
+  CPVRClientCalls calls(TIMEOUT_MS);
+  calls.Add(1, healthy.Call(2, [&channels](int i) { channels.AddChannel(1, i); }));
+  calls.Add(2, slow.Call(3, [&channels](int i) { channels.AddChannel(2, i); }));
+  calls.Add(3, failing.Call(1, [&channels](int i) { channels.AddChannel(3, i); }));
+  EXPECT_NE(PVR_ERROR_NO_ERROR, calls.Run("channels", channels.FailedClients()));
+
+  std::vector<int> failedClients(channels.FailedClients());
+  std::sort(failedClients.begin(), failedClients.end());
+  EXPECT_EQ(std::vector<int>({ 2, 3 }), failedClients);
+
+  EXPECT_TRUE(group.RemoveDeleted(channels));
+  EXPECT_EQ(8u, group.Size());
+  EXPECT_TRUE(group.HasChannel(1, 1));
+  EXPECT_FALSE(group.HasChannel(1, 2));
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_TRUE(group.HasChannel(2, i));
+    EXPECT_TRUE(group.HasChannel(3, i));
+  }
+
+  slow.Release();
+  EXPECT_TRUE(slow.WaitAnswered(WAIT_MS));
+}
+
+TEST(TestPVRPartialResults, RecordingsOfFailedClientsAreKept)
+{
+  CStubPVRClient healthy(10);
+  CStubPVRClient slow(WAIT_MS);
+  CStubPVRClient failing(10, PVR_ERROR_SERVER_ERROR);
+
+  CTestRecordings recordings;
+  recordings.Reload([&recordings](std::vector<int> &failedClients) {
+    for (int iClientId = 1; iClientId <= 3; ++iClientId)
+      for (int i = 0; i < 4; ++i)
+        recordings.Add(iClientId, i);
+  });
+  ASSERT_EQ(12, recordings.GetNumTVRecordings());
+
+  // client 1 deleted its last recording, client 2 is too slow and client 3 fails
+  recordings.Reload([&](std::vector<int> &failedClients) {
+    CPVRClientCalls calls(TIMEOUT_MS);
+    calls.Add(1, healthy.Call(3, [&recordings](int i) { recordings.Add(1, i); }));
+    calls.Add(2, slow.Call(4, [&recordings](int i) { recordings.Add(2, i); }));
+    calls.Add(3, failing.Call(1, [&recordings](int i) { recordings.Add(3, i); }));
+    calls.Run("recordings", failedClients);
+  });
+
+  EXPECT_EQ(11, recordings.GetNumTVRecordings());
+  EXPECT_TRUE(recordings.Has(1, 2));
+  EXPECT_FALSE(recordings.Has(1, 3));
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(recordings.Has(2, i));
+    EXPECT_TRUE(recordings.Has(3, i));
+  }
+
+  slow.Release();
+  EXPECT_TRUE(slow.WaitAnswered(WAIT_MS));
+}
@@ -23,6 +23,8 @@
 #include "PVRChannelGroup.h"
 #include "PVRChannelGroupsContainer.h"
 
+#include <algorithm>
+
 #include "Util.h"
 #include "dialogs/GUIDialogExtendedProgressBar.h"
 #include "epg/EpgContainer.h"
@@ -599,7 +601,8 @@ int CPVRChannelGroup::LoadFromDb(bool bCompress /* = false */)
 bool CPVRChannelGroup::LoadFromClients(void)
 {
   /* get the channels from the backends */
-  return g_PVRClients->GetChannelGroupMembers(this) == PVR_ERROR_NO_ERROR;
+  m_failedClients.clear();
+  return g_PVRClients->GetChannelGroupMembers(this, m_failedClients) == PVR_ERROR_NO_ERROR;
 }
 
 bool CPVRChannelGroup::AddAndUpdateChannels(const CPVRChannelGroup &channels, bool bUseBackendChannelNumbers)
@@ -641,7 +644,7 @@ bool CPVRChannelGroup::AddAndUpdateChannels(const CPVRChannelGroup &channels, bo
 bool CPVRChannelGroup::RemoveDeletedChannels(const CPVRChannelGroup &channels)
 {
   bool bReturn(false);
-  CPVRChannelGroups *groups = g_PVRChannelGroups->Get(m_bRadio);
+  CPVRChannelGroups *groups = IsInternalGroup() ? g_PVRChannelGroups->Get(m_bRadio) : nullptr;
 
   CSingleLock lock(m_critSection);
 
@@ -649,7 +652,8 @@ bool CPVRChannelGroup::RemoveDeletedChannels(const CPVRChannelGroup &channels)
   for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::iterator it = m_sortedMembers.begin(); it != m_sortedMembers.end();)
   {
     CSingleLock lock(channels.m_critSection);
-    if (channels.m_members.find((*it).channel->StorageId()) == channels.m_members.end())
+    if (channels.m_members.find((*it).channel->StorageId()) == channels.m_members.end() &&
+        std::find(channels.m_failedClients.begin(), channels.m_failedClients.end(), (*it).channel->ClientID()) == channels.m_failedClients.end())
     {
       /* channel was not found */
       CLog::Log(LOGINFO,"PVRChannelGroup - %s - deleted %s channel '%s' from group '%s'",
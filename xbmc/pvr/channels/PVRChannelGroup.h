@@ -478,8 +478,8 @@ namespace PVR
     virtual void Unload(void);
 
     /*!
-     * @brief Load the channels from the clients.
-     * @return True when loaded successfully, false otherwise.
+     * @brief Load the channels from the clients. The ids of the clients that failed are stored in m_failedClients.
+     * @return True when loaded successfully from all clients, false otherwise.
      */
     virtual bool LoadFromClients(void);
 
@@ -521,6 +521,7 @@ namespace PVR
     int              m_iPosition;                   /*!< the position of this group within the group list */
     PVR_CHANNEL_GROUP_SORTED_MEMBERS m_sortedMembers; /*!< members sorted by channel number */
     PVR_CHANNEL_GROUP_MEMBERS        m_members;       /*!< members with key clientid+uniqueid */
+    std::vector<int>                 m_failedClients; /*!< clients LoadFromClients() got no channels from, their channels are kept */
     CCriticalSection m_critSection;
 
   private:
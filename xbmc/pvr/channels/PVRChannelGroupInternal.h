@@ -105,8 +105,8 @@ namespace PVR
     int LoadFromDb(bool bCompress = false);
 
     /*!
-     * @brief Load all channels from the clients.
-     * @return True when updated succesfully, false otherwise.
+     * @brief Load all channels from the clients. The ids of the clients that failed are stored in m_failedClients.
+     * @return True when updated succesfully from all clients, false otherwise.
      */
     bool LoadFromClients(void);
 
@@ -56,7 +56,9 @@ bool CPVRChannelGroups::GetGroupsFromClients(void)
   if (! CSettings::GetInstance().GetBool(CSettings::SETTING_PVRMANAGER_SYNCCHANNELGROUPS))
     return true;
 
-  return g_PVRClients->GetChannelGroups(this) == PVR_ERROR_NO_ERROR;
+  /* groups are only added here, so those of the clients that failed stay */
+  std::vector<int> failedClients;
+  return g_PVRClients->GetChannelGroups(this, failedClients) == PVR_ERROR_NO_ERROR;
 }
 
 bool CPVRChannelGroups::Update(const CPVRChannelGroup &group, bool bUpdateFromClient /* = false */)
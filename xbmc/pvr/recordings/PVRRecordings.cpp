@@ -20,6 +20,7 @@
 
 #include "PVRRecordings.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "epg/EpgContainer.h"
@@ -58,11 +59,43 @@ CPVRRecordings::~CPVRRecordings()
 }
 
 void CPVRRecordings::UpdateFromClients(void)
+{
+  ReloadFromClients([this](std::vector<int> &failedClients) {
+    g_PVRClients->GetRecordings(this, false, failedClients);
+    g_PVRClients->GetRecordings(this, true, failedClients);
+  });
+}
+
+void CPVRRecordings::ReloadFromClients(const std::function<void(std::vector<int> &failedClients)> &getRecordings)
 {
   CSingleLock lock(m_critSection);
+  PVR_RECORDINGMAP previousRecordings(m_recordings);
   Clear();
-  g_PVRClients->GetRecordings(this, false);
-  g_PVRClients->GetRecordings(this, true);
+
+  std::vector<int> failedClients;
+  getRecordings(failedClients);
+
+  /* keep the recordings of the clients that failed */
+  for (const auto &recording : previousRecordings)
+  {
+    const CPVRRecordingPtr &tag = recording.second;
+    if (std::find(failedClients.begin(), failedClients.end(), tag->m_iClientId) == failedClients.end() ||
+        !m_recordings.insert(recording).second)
+      continue;
+
+    if (tag->IsDeleted())
+    {
+      if (tag->IsRadio())
+        m_bDeletedRadioRecordings = true;
+      else
+        m_bDeletedTVRecordings = true;
+    }
+
+    if (tag->IsRadio())
+      ++m_iRadioRecordings;
+    else
+      ++m_iTVRecordings;
+  }
 }
 
 std::string CPVRRecordings::TrimSlashes(const std::string &strOrig) const
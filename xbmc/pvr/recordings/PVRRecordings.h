@@ -19,8 +19,10 @@
  *
  */
 
+#include <functional>
 #include <memory>
 #include <map>
+#include <vector>
 
 #include "FileItem.h"
 #include "video/VideoDatabase.h"
@@ -80,6 +82,13 @@ namespace PVR
      */
     bool ChangeRecordingsPlayCount(const CFileItemPtr &item, int count);
 
+  protected:
+    /*!
+     * @brief Replace the recordings by those of the clients, but keep the recordings of the clients that failed.
+     * @param getRecordings transfers the recordings of all clients and adds the ids of the clients that failed.
+     */
+    void ReloadFromClients(const std::function<void(std::vector<int> &failedClients)> &getRecordings);
+
   public:
     CPVRRecordings(void);
     virtual ~CPVRRecordings(void);
@@ -125,6 +125,8 @@ void CAdvancedSettings::Initialize()
 
   m_audioDefaultPlayer = "paplayer";
   m_audioPlayCountMinimumPercent = 90.0f;
+  m_audioPrefetchNextFile = true;
+  m_audioPrefetchBufferSize = 8192;
 
   m_videoSubsDelayRange = 60;
   m_videoAudioDelayRange = 10;
@@ -142,6 +144,9 @@ void CAdvancedSettings::Initialize()
   m_videoPPFFmpegPostProc = "ha:128:7,va,dr";
   m_videoDefaultPlayer = "VideoPlayer";
   m_videoIgnoreSecondsAtStart = 3*60;
+  m_videoSeekPreviews = 0;
+  m_videoSeekPreviewWidth = 320;
+  m_videoFastThumbs = true;
   m_videoIgnorePercentAtEnd   = 8.0f;
   m_videoPlayCountMinimumPercent = 90.0f;
   m_videoVDPAUScaling = -1;
@@ -159,6 +164,7 @@ void CAdvancedSettings::Initialize()
   m_DXVAAllowHqScaling = true;
   m_videoFpsDetect = 1;
   m_videoBusyDialogDelay_ms = 500;
+  m_videoDecodeAhead = 4;
 
   m_mediacodecForceSoftwareRendring = false;
 
@@ -358,6 +364,7 @@ void CAdvancedSettings::Initialize()
   m_bPVRChannelIconsAutoScan       = true;
   m_bPVRAutoScanIconsUserSet       = false;
   m_iPVRNumericChannelSwitchTimeout = 1000;
+  m_iPVRClientTimeout              = 60;
 
   m_cacheMemSize = 1024 * 1024 * 20;
   m_cacheBufferMode = CACHE_BUFFER_MODE_INTERNET; // Default (buffer all internet streams/filesystems)
@@ -512,6 +519,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "defaultplayer", m_audioDefaultPlayer);
     // 101 on purpose - can be used to never automark as watched
     XMLUtils::GetFloat(pElement, "playcountminimumpercent", m_audioPlayCountMinimumPercent, 0.0f, 101.0f);
+    XMLUtils::GetBoolean(pElement, "prefetchnextfile", m_audioPrefetchNextFile);
+    // memory cap in KB for decoding ahead the next file
+    XMLUtils::GetInt(pElement, "prefetchbuffersize", m_audioPrefetchBufferSize, 0, 262144);
 
     XMLUtils::GetBoolean(pElement, "usetimeseeking", m_musicUseTimeSeeking);
     XMLUtils::GetInt(pElement, "timeseekforward", m_musicTimeSeekForward, 0, 6000);
@@ -561,6 +571,14 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "ignoresecondsatstart", m_videoIgnoreSecondsAtStart, 0, 900);
     XMLUtils::GetFloat(pElement, "ignorepercentatend", m_videoIgnorePercentAtEnd, 0, 100.0f);
 
+    TiXmlElement* pSeekPreviews = pElement->FirstChildElement("seekpreviews");
+    if (pSeekPreviews)
+    {
+      XMLUtils::GetInt(pSeekPreviews, "count", m_videoSeekPreviews, 0, 200);
+      XMLUtils::GetInt(pSeekPreviews, "width", m_videoSeekPreviewWidth, 64, 1920);
+    }
+    XMLUtils::GetBoolean(pElement, "fastthumbs", m_videoFastThumbs);
+
     XMLUtils::GetBoolean(pElement, "usetimeseeking", m_videoUseTimeSeeking);
     XMLUtils::GetInt(pElement, "timeseekforward", m_videoTimeSeekForward, 0, 6000);
     XMLUtils::GetInt(pElement, "timeseekbackward", m_videoTimeSeekBackward, -6000, 0);
@@ -704,6 +722,10 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     // the busy dialog is shown when starting video playback.
     XMLUtils::GetInt(pElement, "busydialogdelayms", m_videoBusyDialogDelay_ms, 0, 1000);
 
+    // the number of software decoded pictures that may be decoded ahead
+    // while the renderer has no free buffer, 0 disables decoding ahead.
+    XMLUtils::GetInt(pElement, "decodeahead", m_videoDecodeAhead, 0, 16);
+
     // Store global display latency settings
     TiXmlElement* pVideoLatency = pElement->FirstChildElement("latency");
     if (pVideoLatency)
@@ -1104,6 +1126,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pPVR, "channeliconsautoscan", m_bPVRChannelIconsAutoScan);
     XMLUtils::GetBoolean(pPVR, "autoscaniconsuserset", m_bPVRAutoScanIconsUserSet);
     XMLUtils::GetInt(pPVR, "numericchannelswitchtimeout", m_iPVRNumericChannelSwitchTimeout, 50, 60000);
+    XMLUtils::GetInt(pPVR, "clienttimeout", m_iPVRClientTimeout, 1, 600);
   }
 
   TiXmlElement* pDatabase = pRootElement->FirstChildElement("videodatabase");
@@ -147,6 +147,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     float m_ac3Gain;
     std::string m_audioDefaultPlayer;
     float m_audioPlayCountMinimumPercent;
+    bool m_audioPrefetchNextFile;
+    int m_audioPrefetchBufferSize;
     bool m_VideoPlayerIgnoreDTSinWAV;
     float m_limiterHold;
     float m_limiterRelease;
@@ -179,6 +181,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_musicPercentSeekForwardBig;
     int m_musicPercentSeekBackwardBig;
     int m_videoIgnoreSecondsAtStart;
+    int m_videoSeekPreviews; ///< number of seek bar previews extracted from a playing video, 0 to disable
+    int m_videoSeekPreviewWidth;
+    bool m_videoFastThumbs; ///< extract thumbs from a keyframe decoded at reduced resolution
     float m_videoIgnorePercentAtEnd;
     float m_audioApplyDrc;
     bool m_useFfmpegVda;
@@ -203,6 +208,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_DXVAAllowHqScaling;
     int  m_videoFpsDetect;
     int  m_videoBusyDialogDelay_ms;
+    int  m_videoDecodeAhead;
     bool m_mediacodecForceSoftwareRendring;
 
     std::string m_videoDefaultPlayer;
@@ -342,6 +348,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_bPVRChannelIconsAutoScan; /*!< @brief automatically scan user defined folder for channel icons when loading internal channel groups */
     bool m_bPVRAutoScanIconsUserSet; /*!< @brief mark channel icons populated by auto scan as "user set" */
     int m_iPVRNumericChannelSwitchTimeout; /*!< @brief time in ms before the numeric dialog auto closes when confirmchannelswitch is disabled */
+    int m_iPVRClientTimeout; /*!< @brief time in seconds to wait for a client to return its channels, timers or recordings. defaults to 60. */
 
     DatabaseSettings m_databaseMusic; // advanced music database setup
     DatabaseSettings m_databaseVideo; // advanced video database setup
@@ -0,0 +1,68 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "SettingRef.h"
+
+#include "settings/Settings.h"
+#include "settings/lib/Setting.h"
+#include "utils/log.h"
+
+namespace
+{
+template<typename T>
+struct SettingRefTraits;
+
+template<>
+struct SettingRefTraits<bool>
+{
+  typedef CSettingBool SettingType;
+  static const int Type = SettingTypeBool;
+};
+
+template<>
+struct SettingRefTraits<int>
+{
+  typedef CSettingInt SettingType;
+  static const int Type = SettingTypeInteger;
+};
+}
+
+template<typename T>
+CSettingRef<T>::CSettingRef() :
+  m_value(std::make_shared<std::atomic<T>>(T()))
+{
+}
+
+template<typename T>
+CSettingRef<T>::CSettingRef(const std::string &settingId)
+{
+  const CSetting *setting = CSettings::GetInstance().GetSetting(settingId);
+  if (setting != NULL && setting->GetType() == SettingRefTraits<T>::Type)
+  {
+    m_value = static_cast<const typename SettingRefTraits<T>::SettingType*>(setting)->GetSharedValue();
+    return;
+  }
+
+  CLog::Log(LOGERROR, "CSettingRef: unknown setting \"%s\" or not of the requested type", settingId.c_str());
+  m_value = std::make_shared<std::atomic<T>>(T());
+}
+
+template class CSettingRef<bool>;
+template class CSettingRef<int>;
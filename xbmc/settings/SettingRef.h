@@ -0,0 +1,52 @@
+#pragma once
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+/*!
+ \brief Handle for reading a boolean or integer setting on hot paths.
+
+ The setting is looked up by its id once, when the handle is created. Reading
+ it is an atomic load of a value the setting updates whenever a change has been
+ accepted, instead of a lookup in the settings manager under its lock.
+
+ Handles must be created after CSettings::Initialize(). They can still be read
+ after CSettings::Uninitialize() but keep the last value then. Default
+ constructed handles, and handles of settings that don't exist or are of
+ another type, read T().
+
+ Only available for bool and int.
+ */
+template<typename T>
+class CSettingRef
+{
+public:
+  CSettingRef();
+  explicit CSettingRef(const std::string &settingId);
+
+  T Get() const { return m_value->load(std::memory_order_relaxed); }
+  operator T() const { return Get(); }
+
+private:
+  std::shared_ptr<const std::atomic<T>> m_value;
+};
@@ -582,18 +582,21 @@ std::string CSettingList::toString(const SettingPtrList &values) const
   
 CSettingBool::CSettingBool(const std::string &id, CSettingsManager *settingsManager /* = NULL */)
   : CSetting(id, settingsManager),
-    m_value(false), m_default(false)
+    m_value(false), m_default(false),
+    m_sharedValue(std::make_shared<std::atomic<bool>>(false))
 { }
   
 CSettingBool::CSettingBool(const std::string &id, const CSettingBool &setting)
-  : CSetting(id, setting)
+  : CSetting(id, setting),
+    m_sharedValue(std::make_shared<std::atomic<bool>>(false))
 {
   copy(setting);
 }
 
 CSettingBool::CSettingBool(const std::string &id, int label, bool value, CSettingsManager *settingsManager /* = NULL */)
   : CSetting(id, settingsManager),
-    m_value(value), m_default(value)
+    m_value(value), m_default(value),
+    m_sharedValue(std::make_shared<std::atomic<bool>>(value))
 {
   m_label = label;
 }
@@ -613,7 +616,10 @@ bool CSettingBool::Deserialize(const TiXmlNode *node, bool update /* = false */)
   // get the default value
   bool value;
   if (XMLUtils::GetBoolean(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    m_sharedValue->store(m_value);
+  }
   else if (!update)
   {
     CLog::Log(LOGERROR, "CSettingBool: error reading the default value of \"%s\"", m_id.c_str());
@@ -672,6 +678,7 @@ bool CSettingBool::SetValue(bool value)
   }
 
   m_changed = m_value != m_default;
+  m_sharedValue->store(m_value);
   OnSettingChanged(this);
   return true;
 }
@@ -682,7 +689,10 @@ void CSettingBool::SetDefault(bool value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    m_sharedValue->store(m_value);
+  }
 }
 
 void CSettingBool::copy(const CSettingBool &setting)
@@ -691,6 +701,7 @@ void CSettingBool::copy(const CSettingBool &setting)
 
   m_value = setting.m_value;
   m_default = setting.m_default;
+  m_sharedValue->store(m_value);
 }
   
 bool CSettingBool::fromString(const std::string &strValue, bool &value) const
@@ -712,6 +723,7 @@ bool CSettingBool::fromString(const std::string &strValue, bool &value) const
 CSettingInt::CSettingInt(const std::string &id, CSettingsManager *settingsManager /* = NULL */)
   : CSetting(id, settingsManager),
     m_value(0), m_default(0),
+    m_sharedValue(std::make_shared<std::atomic<int>>(0)),
     m_min(0), m_step(1), m_max(0),
     m_optionsFiller(NULL),
     m_optionsFillerData(NULL)
@@ -719,6 +731,7 @@ CSettingInt::CSettingInt(const std::string &id, CSettingsManager *settingsManage
   
 CSettingInt::CSettingInt(const std::string &id, const CSettingInt &setting)
   : CSetting(id, setting),
+    m_sharedValue(std::make_shared<std::atomic<int>>(0)),
     m_optionsFiller(NULL),
     m_optionsFillerData(NULL)
 {
@@ -728,6 +741,7 @@ CSettingInt::CSettingInt(const std::string &id, const CSettingInt &setting)
 CSettingInt::CSettingInt(const std::string &id, int label, int value, CSettingsManager *settingsManager /* = NULL */)
   : CSetting(id, settingsManager),
     m_value(value), m_default(value),
+    m_sharedValue(std::make_shared<std::atomic<int>>(value)),
     m_min(0), m_step(1), m_max(0),
     m_optionsFiller(NULL),
     m_optionsFillerData(NULL)
@@ -738,6 +752,7 @@ CSettingInt::CSettingInt(const std::string &id, int label, int value, CSettingsM
 CSettingInt::CSettingInt(const std::string &id, int label, int value, int minimum, int step, int maximum, CSettingsManager *settingsManager /* = NULL */)
   : CSetting(id, settingsManager),
     m_value(value), m_default(value),
+    m_sharedValue(std::make_shared<std::atomic<int>>(value)),
     m_min(minimum), m_step(step), m_max(maximum),
     m_optionsFiller(NULL),
     m_optionsFillerData(NULL)
@@ -748,6 +763,7 @@ CSettingInt::CSettingInt(const std::string &id, int label, int value, int minimu
 CSettingInt::CSettingInt(const std::string &id, int label, int value, const StaticIntegerSettingOptions &options, CSettingsManager *settingsManager /* = NULL */)
   : CSetting(id, settingsManager),
     m_value(value), m_default(value),
+    m_sharedValue(std::make_shared<std::atomic<int>>(value)),
     m_min(0), m_step(1), m_max(0),
     m_options(options),
     m_optionsFiller(NULL),
@@ -771,7 +787,10 @@ bool CSettingInt::Deserialize(const TiXmlNode *node, bool update /* = false */)
   // get the default value
   int value;
   if (XMLUtils::GetInt(node, SETTING_XML_ELM_DEFAULT, value))
+  {
     m_value = m_default = value;
+    m_sharedValue->store(m_value);
+  }
   else if (!update)
   {
     CLog::Log(LOGERROR, "CSettingInt: error reading the default value of \"%s\"", m_id.c_str());
@@ -907,6 +926,7 @@ bool CSettingInt::SetValue(int value)
   }
 
   m_changed = m_value != m_default;
+  m_sharedValue->store(m_value);
   OnSettingChanged(this);
   return true;
 }
@@ -917,7 +937,10 @@ void CSettingInt::SetDefault(int value)
 
   m_default = value;
   if (!m_changed)
+  {
     m_value = m_default;
+    m_sharedValue->store(m_value);
+  }
 }
 
 SettingOptionsType CSettingInt::GetOptionsType() const
@@ -983,6 +1006,7 @@ void CSettingInt::copy(const CSettingInt &setting)
 
   m_value = setting.m_value;
   m_default = setting.m_default;
+  m_sharedValue->store(m_value);
   m_min = setting.m_min;
   m_step = setting.m_step;
   m_max = setting.m_max;
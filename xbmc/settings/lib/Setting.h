@@ -19,6 +19,7 @@
  *
  */
 
+#include <atomic>
 #include <map>
 #include <set>
 #include <string>
@@ -224,6 +225,12 @@ public:
 
   bool GetValue() const { CSharedLock lock(m_critical); return m_value; }
   bool SetValue(bool value);
+  /*!
+   \brief Get the value for lock-free reading, it's updated once a change has been accepted.
+   It remains valid after the setting is gone but isn't updated anymore.
+   \sa CSettingRef
+   */
+  std::shared_ptr<const std::atomic<bool>> GetSharedValue() const { return m_sharedValue; }
   bool GetDefault() const { return m_default; }
   void SetDefault(bool value);
 
@@ -233,6 +240,7 @@ private:
 
   bool m_value;
   bool m_default;
+  std::shared_ptr<std::atomic<bool>> m_sharedValue;
 };
 
 /*!
@@ -264,6 +272,12 @@ public:
 
   int GetValue() const { CSharedLock lock(m_critical); return m_value; }
   bool SetValue(int value);
+  /*!
+   \brief Get the value for lock-free reading, it's updated once a change has been accepted.
+   It remains valid after the setting is gone but isn't updated anymore.
+   \sa CSettingRef
+   */
+  std::shared_ptr<const std::atomic<int>> GetSharedValue() const { return m_sharedValue; }
   int GetDefault() const { return m_default; }
   void SetDefault(int value);
 
@@ -296,6 +310,7 @@ private:
 
   int m_value;
   int m_default;
+  std::shared_ptr<std::atomic<int>> m_sharedValue;
   int m_min;
   int m_step;
   int m_max;
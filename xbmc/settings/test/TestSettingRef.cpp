@@ -0,0 +1,64 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "settings/Settings.h"
+#include "settings/SettingRef.h"
+
+#include "gtest/gtest.h"
+
+TEST(TestSettingRef, ReadsChangedValues)
+{
+  CSettings &settings = CSettings::GetInstance();
+
+  CSettingRef<bool> parseCaptions(CSettings::SETTING_SUBTITLES_PARSECAPTIONS);
+  bool original = settings.GetBool(CSettings::SETTING_SUBTITLES_PARSECAPTIONS);
+  EXPECT_EQ(original, parseCaptions.Get());
+  ASSERT_TRUE(settings.SetBool(CSettings::SETTING_SUBTITLES_PARSECAPTIONS, !original));
+  EXPECT_EQ(!original, parseCaptions.Get());
+  settings.SetBool(CSettings::SETTING_SUBTITLES_PARSECAPTIONS, original);
+  EXPECT_EQ(original, parseCaptions.Get());
+
+  CSettingRef<int> errorInAspect(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT);
+  int originalInt = settings.GetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT);
+  EXPECT_EQ(originalInt, errorInAspect.Get());
+  ASSERT_TRUE(settings.SetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT, originalInt == 10 ? 5 : 10));
+  EXPECT_EQ(originalInt == 10 ? 5 : 10, errorInAspect.Get());
+  settings.SetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT, originalInt);
+}
+
+TEST(TestSettingRef, RejectedChangesAreNotRead)
+{
+  CSettingRef<int> errorInAspect(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT);
+  int original = errorInAspect;
+
+  // out of the allowed range
+  EXPECT_FALSE(CSettings::GetInstance().SetInt(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT, 1000));
+  EXPECT_EQ(original, errorInAspect.Get());
+}
+
+TEST(TestSettingRef, InvalidSettingsReadDefault)
+{
+  EXPECT_FALSE(CSettingRef<bool>().Get());
+  EXPECT_FALSE(CSettingRef<bool>("nosuchsetting").Get());
+  // not a boolean setting
+  EXPECT_FALSE(CSettingRef<bool>(CSettings::SETTING_VIDEOPLAYER_ERRORINASPECT).Get());
+  EXPECT_EQ(0, CSettingRef<int>(CSettings::SETTING_SUBTITLES_PARSECAPTIONS).Get());
+}
@@ -20,10 +20,18 @@
 
 #include "FileItem.h"
 #include "URL.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
 #include "settings/AdvancedSettings.h"
+#include "utils/Archive.h"
+#include "utils/auto_buffer.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "video/VideoInfoTag.h"
 
 #include "gtest/gtest.h"
 
+
 using ::testing::Test;
 using ::testing::WithParamInterface;
 using ::testing::ValuesIn;
@@ -136,3 +144,191 @@ const TestFileData BaseMovies[] = {{ "c:\\dir\\filename.avi", false, "c:\\dir\\f
                                    { "/home/user/movies/movie_name/BDMV/index.bdmv", true, "/home/user/movies/movie_name/" }};
 
 INSTANTIATE_TEST_CASE_P(BaseNameMovies, TestFileItemBasePath, ValuesIn(BaseMovies));
+
+namespace
+{
+// a movie as the video database lists it
+CFileItemPtr CreateMovieItem(int i)
+{
+  CVideoInfoTag movie;
+  movie.m_iDbId = i;
+  movie.m_type = "movie";
+  movie.m_strTitle = StringUtils::Format("Movie %d", i);
+  movie.m_strPlot = std::string(400, 'p');
+  movie.m_strFileNameAndPath = StringUtils::Format("smb://server/movies/Movie %d/movie.mkv", i);
+  movie.m_genre.push_back("Drama");
+  movie.m_director.push_back("Director");
+
+  CFileItemPtr item(new CFileItem(movie));
+  item->SetArt("thumb", StringUtils::Format("image://movie-%d-poster.jpg/", i));
+  item->SetArt("fanart", StringUtils::Format("image://movie-%d-fanart.jpg/", i));
+  item->SetProperty("original_listitem_url", movie.m_strFileNameAndPath);
+  item->SetProperty("IsPlayable", true);
+  return item;
+}
+
+void CreateMovieList(CFileItemList &items, int iSize)
+{
+  items.SetPath("videodb://movies/titles/");
+  items.SetContent("movies");
+  items.AddSortMethod(SortByTitle, 556, LABEL_MASKS("%T", "%Y"));
+  for (int i = 0; i < iSize; i++)
+    items.Add(CreateMovieItem(i));
+}
+}
+
+TEST(TestFileItem, CopySharesInfoTagUntilChanged)
+{
+  CFileItem item("/movies/movie.mkv", false);
+  item.GetVideoInfoTag()->m_strTitle = "Movie";
+
+  CFileItem copy(item);
+  const CFileItem &constCopy = copy;
+  EXPECT_EQ(static_cast<const CFileItem&>(item).GetVideoInfoTag(), constCopy.GetVideoInfoTag());
+
+  copy.GetVideoInfoTag()->m_strTitle = "Other";
+  EXPECT_NE(static_cast<const CFileItem&>(item).GetVideoInfoTag(), constCopy.GetVideoInfoTag());
+  EXPECT_EQ("Movie", item.GetVideoInfoTag()->m_strTitle);
+  EXPECT_EQ("Other", copy.GetVideoInfoTag()->m_strTitle);
+}
+
+TEST(TestFileItem, AssignmentKeepsOwnInfoTag)
+{
+  CFileItem item("/movies/movie.mkv", false);
+  CVideoInfoTag *tag = item.GetVideoInfoTag();
+  tag->m_strTitle = "Movie";
+
+  CFileItem other("/movies/other.mkv", false);
+  other.GetVideoInfoTag()->m_strTitle = "Other";
+
+  // a tag the item doesn't share is assigned to, so the pointer stays valid
+  item = other;
+  EXPECT_EQ(tag, item.GetVideoInfoTag());
+  EXPECT_EQ("Other", tag->m_strTitle);
+
+  tag->m_strTitle = "Changed";
+  EXPECT_EQ("Other", other.GetVideoInfoTag()->m_strTitle);
+}
+
+TEST(TestFileItem, CopySharesArtUntilChanged)
+{
+  CFileItem item("/movies/movie.mkv", false);
+  item.SetArt("thumb", "thumb.jpg");
+  item.SetArtFallback("poster", "thumb");
+
+  CFileItem copy(item);
+  EXPECT_EQ(&item.GetArt(), &copy.GetArt());
+  EXPECT_EQ("thumb.jpg", copy.GetArt("poster"));
+
+  copy.SetArt("fanart", "fanart.jpg");
+  EXPECT_NE(&item.GetArt(), &copy.GetArt());
+  EXPECT_FALSE(item.HasArt("fanart"));
+  EXPECT_TRUE(copy.HasArt("fanart"));
+}
+
+TEST(TestFileItem, PropertiesIgnoreCase)
+{
+  CFileItem item;
+  EXPECT_FALSE(item.HasProperty("never set on any item"));
+  EXPECT_TRUE(item.GetProperty("never set on any item").isNull());
+
+  item.SetProperty("TotalEpisodes", 10);
+  item.SetProperty("totalepisodes", 12);
+  item.SetProperty("WatchedEpisodes", 3);
+  EXPECT_TRUE(item.HasProperty("TOTALEPISODES"));
+  EXPECT_EQ(12, item.GetProperty("TotalEpisodes").asInteger());
+
+  item.IncrementProperty("watchedepisodes", 1);
+  EXPECT_EQ(4, item.GetProperty("WatchedEpisodes").asInteger());
+
+  CFileItem other;
+  other.AppendProperties(item);
+  EXPECT_EQ(12, other.GetProperty("totalepisodes").asInteger());
+
+  item.ClearProperty("TotalEpisodes");
+  EXPECT_FALSE(item.HasProperty("TotalEpisodes"));
+  EXPECT_TRUE(item.HasProperty("WatchedEpisodes"));
+  EXPECT_TRUE(other.HasProperty("TotalEpisodes"));
+}
+
+TEST(TestFileItem, PropertiesKeepTheirCase)
+{
+  CGUIListItem item;
+  item.SetProperty("SortTitle", "a");
+  CGUIListItem other;
+  other.SetProperty("sorttitle", "b");
+
+  CVariant value;
+  other.Serialize(value);
+  EXPECT_TRUE(value["properties"].isMember("sorttitle"));
+  EXPECT_FALSE(value["properties"].isMember("SortTitle"));
+}
+
+TEST(TestFileItem, DiscCacheRoundTrip)
+{
+  ASSERT_TRUE(XFILE::CDirectory::Create("special://temp/archive_cache/"));
+
+  // enough items to be decoded on several threads
+  CFileItemList items;
+  CreateMovieList(items, 5000);
+  ASSERT_TRUE(items.Save());
+
+  CFileItemList loaded;
+  loaded.SetPath(items.GetPath());
+  CFileItemPtr parent(new CFileItem(".."));
+  parent->SetPath("videodb://movies/");
+  loaded.Add(parent);
+  ASSERT_TRUE(loaded.Load());
+  items.RemoveDiscCache();
+
+  // the parent folder item is kept
+  ASSERT_EQ(items.Size() + 1, loaded.Size());
+  EXPECT_TRUE(loaded[0]->IsParentFolder());
+  EXPECT_EQ("movies", loaded.GetContent());
+  ASSERT_EQ(1u, loaded.GetSortDetails().size());
+  EXPECT_EQ(SortByTitle, loaded.GetSortDetails()[0].m_sortDescription.sortBy);
+  for (int i = 0; i < items.Size(); i++)
+  {
+    const CFileItemPtr &item = loaded[i + 1];
+    EXPECT_EQ(items[i]->GetPath(), item->GetPath());
+    EXPECT_EQ(items[i]->GetVideoInfoTag()->m_strTitle, item->GetVideoInfoTag()->m_strTitle);
+    EXPECT_EQ(items[i]->GetArt("fanart"), item->GetArt("fanart"));
+    EXPECT_TRUE(item->GetProperty("IsPlayable").asBoolean());
+  }
+}
+
+TEST(TestFileItem, OutdatedDiscCacheIsIgnored)
+{
+  ASSERT_TRUE(XFILE::CDirectory::Create("special://temp/archive_cache/"));
+
+  CFileItemList items;
+  CreateMovieList(items, 10);
+
+  // a cache written through CArchive, before the cache had a version
+  std::string path = items.GetDiscFileCache(0);
+  XFILE::CFile file;
+  ASSERT_TRUE(file.OpenForWrite(path, true));
+  {
+    CArchive ar(&file, CArchive::store);
+    ar << items;
+  }
+  file.Close();
+
+  CFileItemList loaded;
+  loaded.SetPath(items.GetPath());
+  EXPECT_FALSE(loaded.Load());
+  EXPECT_EQ(0, loaded.Size());
+
+  // and one cut short
+  ASSERT_TRUE(items.Save());
+  EXPECT_FALSE(XFILE::CFile::Exists(path + ".tmp"));
+  XFILE::auto_buffer buffer;
+  ASSERT_GT(file.LoadFile(path, buffer), 100);
+  ASSERT_TRUE(file.OpenForWrite(path, true));
+  file.Write(buffer.get(), buffer.size() - 100);
+  file.Close();
+
+  EXPECT_FALSE(loaded.Load());
+  EXPECT_EQ(0, loaded.Size());
+  items.RemoveDiscCache();
+}
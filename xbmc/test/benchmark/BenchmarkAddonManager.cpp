@@ -0,0 +1,133 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "DatabaseManager.h"
+#include "addons/AddonManager.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "profiles/ProfilesManager.h"
+#include "threads/SystemClock.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+using namespace ADDON;
+
+namespace
+{
+const unsigned int ADDONS = 500;
+
+std::string AddonId(unsigned int i)
+{
+  return StringUtils::Format("plugin.video.benchmark%03u", i);
+}
+
+bool WriteAddon(const std::string& folder, unsigned int i)
+{
+  std::string path = URIUtils::AddFileToFolder(folder, AddonId(i));
+  if (!XFILE::CDirectory::Create(path))
+    return false;
+
+  std::string xml = StringUtils::Format(
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+    "<addon id=\"%s\" name=\"Benchmark %u\" version=\"1.0.%u\" provider-name=\"Team Kodi\">\n"
+    "  <requires>\n"
+    "    <import addon=\"xbmc.python\" version=\"2.25.0\"/>\n"
+    "  </requires>\n"
+    "  <extension point=\"xbmc.python.pluginsource\" library=\"default.py\">\n"
+    "    <provides>video</provides>\n"
+    "  </extension>\n"
+    "  <extension point=\"xbmc.addon.metadata\">\n",
+    AddonId(i).c_str(), i, i);
+  const char* languages[] = { "en_GB", "de_DE", "fr_FR", "es_ES", "it_IT", "nl_NL" };
+  for (const char* language : languages)
+  {
+    xml += StringUtils::Format("    <summary lang=\"%s\">Summary of benchmark add-on %u</summary>\n", language, i);
+    xml += StringUtils::Format("    <description lang=\"%s\">A description of benchmark add-on %u, long enough to be"
+                               " representative of the add-ons found in the repositories.</description>\n", language, i);
+  }
+  xml += "    <platform>all</platform>\n"
+         "    <license>GNU GENERAL PUBLIC LICENSE. Version 2, June 1991</license>\n"
+         "  </extension>\n"
+         "</addon>\n";
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(URIUtils::AddFileToFolder(path, "addon.xml"), true))
+    return false;
+  return file.Write(xml.c_str(), xml.size()) == static_cast<ssize_t>(xml.size());
+}
+}
+
+/*
+ Installs 500 add-ons into a home folder of its own, then starts the add-on
+ manager with an empty manifest, starts it again with the manifest of the
+ first start and requests all of them, and prints the time taken.
+ */
+TEST(BenchmarkAddonManager, Startup)
+{
+  std::string home = CSpecialProtocol::TranslatePath("special://home/");
+  std::string masterProfile = CSpecialProtocol::TranslatePath("special://masterprofile/");
+
+  std::string root = CSpecialProtocol::TranslatePath("special://temp/addonbenchmark/");
+  CSpecialProtocol::SetHomePath(root);
+  CSpecialProtocol::SetMasterProfilePath(URIUtils::AddFileToFolder(root, "userdata"));
+  ASSERT_TRUE(XFILE::CDirectory::Create("special://home/addons"));
+  ASSERT_TRUE(XFILE::CDirectory::Create("special://masterprofile/Database"));
+  if (CProfilesManager::GetInstance().GetNumberOfProfiles() == 0)
+    CProfilesManager::GetInstance().AddProfile(CProfile("special://masterprofile/", "Master user", 0));
+  CDatabaseManager::GetInstance().Initialize(true);
+
+  std::string folder = CSpecialProtocol::TranslatePath("special://home/addons");
+  for (unsigned int i = 0; i < ADDONS; ++i)
+    ASSERT_TRUE(WriteAddon(folder, i));
+
+  const char* starts[] = { "first start", "second start" };
+  for (const char* name : starts)
+  {
+    CAddonMgr manager;
+    unsigned int start = XbmcThreads::SystemClockMillis();
+    EXPECT_TRUE(manager.Init());
+    unsigned int init = XbmcThreads::SystemClockMillis() - start;
+
+    start = XbmcThreads::SystemClockMillis();
+    unsigned int found = 0;
+    for (unsigned int i = 0; i < ADDONS; ++i)
+    {
+      AddonPtr addon;
+      if (manager.GetAddon(AddonId(i), addon, ADDON_PLUGIN, false))
+        ++found;
+    }
+    unsigned int access = XbmcThreads::SystemClockMillis() - start;
+    manager.DeInit();
+
+    EXPECT_EQ(ADDONS, found);
+    printf("%u add-ons, %s: %u ms to start, %u ms for the first access of all\n", ADDONS, name, init, access);
+  }
+
+  CDatabaseManager::GetInstance().Deinitialize();
+  CSpecialProtocol::SetHomePath(home);
+  CSpecialProtocol::SetMasterProfilePath(masterProfile);
+  XFILE::CDirectory::RemoveRecursive(root);
+}
@@ -0,0 +1,70 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include "cores/VideoPlayer/DVDFileInfo.h"
+#include "FileItem.h"
+#include "TextureCacheJob.h"
+#include "filesystem/Directory.h"
+#include "settings/AdvancedSettings.h"
+#include "threads/SystemClock.h"
+#include "utils/StringUtils.h"
+
+#include "gtest/gtest.h"
+
+/*
+ Extracts the thumbs of all videos in the folder named by KODI_THUMB_BENCHMARK_DIR
+ with full and low cost decoding and prints the throughput.
+ */
+TEST(BenchmarkDVDFileInfo, ExtractThumbs)
+{
+  const char *folder = getenv("KODI_THUMB_BENCHMARK_DIR");
+  if (folder == NULL)
+    return;
+
+  CFileItemList items;
+  ASSERT_TRUE(XFILE::CDirectory::GetDirectory(folder, items, g_advancedSettings.m_videoExtensions, XFILE::DIR_FLAG_NO_FILE_DIRS));
+
+  for (int lowCost = 0; lowCost < 2; lowCost++)
+  {
+    unsigned int files = 0;
+    unsigned int extracted = 0;
+    unsigned int start = XbmcThreads::SystemClockMillis();
+    for (int i = 0; i < items.Size(); i++)
+    {
+      if (items[i]->m_bIsFolder)
+        continue;
+
+      CTextureDetails details;
+      details.file = StringUtils::Format("benchmark/%s-%d.jpg", lowCost ? "lowcost" : "full", i);
+      files++;
+      if (CDVDFileInfo::ExtractThumb(items[i]->GetPath(), details, nullptr, -1, lowCost != 0))
+        extracted++;
+    }
+    unsigned int elapsed = std::max(1u, XbmcThreads::SystemClockMillis() - start);
+    ASSERT_GT(files, 0u);
+
+    printf("%s: %u of %u thumbs in %u ms, %.2f files/s\n",
+           lowCost ? "low cost" : "full", extracted, files, elapsed, files * 1000.0 / elapsed);
+  }
+}
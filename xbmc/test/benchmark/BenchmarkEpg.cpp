@@ -0,0 +1,56 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstdio>
+
+#include "epg/Epg.h"
+#include "epg/test/TestHelpers.h"
+#include "threads/SystemClock.h"
+
+#include "gtest/gtest.h"
+
+/*
+ Transfers a 14 day guide for 600 channels from a synthetic client one by one
+ and in batches and prints the time taken.
+ */
+TEST(BenchmarkEpg, Transfer)
+{
+  const unsigned int iChannels = 600;
+  CSyntheticEpgClient client(14 * 48, 1483228800);
+
+  for (int batched = 0; batched < 2; ++batched)
+  {
+    unsigned int start = XbmcThreads::SystemClockMillis();
+    size_t iTags = 0;
+    for (unsigned int iChannel = 0; iChannel < iChannels; ++iChannel)
+    {
+      EPG::CEpg epg(iChannel + 1);
+      ADDON_HANDLE_STRUCT handle = CreateEpgHandle(epg);
+      if (batched)
+        client.TransferBatched(&handle, 1000);
+      else
+        client.TransferOneByOne(&handle);
+      iTags += epg.Size();
+    }
+    unsigned int elapsed = XbmcThreads::SystemClockMillis() - start;
+
+    printf("%s: %u tags in %u ms\n", batched ? "batched" : "one by one", (unsigned int)iTags, elapsed);
+  }
+}
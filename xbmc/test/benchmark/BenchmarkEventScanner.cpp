@@ -0,0 +1,84 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "peripherals/EventScanner.h"
+#include "peripherals/test/TestHelpers.h"
+#ifdef TARGET_POSIX
+#include "linux/XTimeUtils.h"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace PERIPHERALS;
+
+namespace
+{
+std::vector<long long> MeasureLatencies(bool bNeedsScanning, unsigned int iPresses)
+{
+  CVirtualInput input(bNeedsScanning);
+  CEventScanner scanner(&input);
+  scanner.Start();
+
+  for (unsigned int i = 0; i < iPresses; ++i)
+  {
+    // don't line up with the scan interval
+    Sleep(3 + i % 7);
+    input.Press(scanner);
+    EXPECT_TRUE(input.WaitProcessed(1000));
+  }
+
+  scanner.Stop();
+
+  std::vector<long long> latencies = input.Latencies();
+  std::sort(latencies.begin(), latencies.end());
+  return latencies;
+}
+
+void PrintHistogram(const char *strName, const std::vector<long long> &latenciesUs)
+{
+  const long long limitsUs[] = { 100, 500, 1000, 2000, 5000, 10000, 20000 };
+
+  printf("%s: input to action latency of %u presses\n", strName, (unsigned int)latenciesUs.size());
+  long long lowerUs = 0;
+  for (long long limitUs : limitsUs)
+  {
+    long long count = std::count_if(latenciesUs.begin(), latenciesUs.end(),
+      [lowerUs, limitUs](long long latencyUs) { return latencyUs >= lowerUs && latencyUs < limitUs; });
+    printf("  %6lld - %6lld us: %lld\n", lowerUs, limitUs, count);
+    lowerUs = limitUs;
+  }
+  long long count = std::count_if(latenciesUs.begin(), latenciesUs.end(),
+    [lowerUs](long long latencyUs) { return latencyUs >= lowerUs; });
+  printf("  %6lld -        us: %lld\n", lowerUs, count);
+}
+}
+
+/*
+ Prints the input to action latency histograms of woken and scanned input.
+ */
+TEST(BenchmarkEventScanner, LatencyHistogram)
+{
+  PrintHistogram("woken", MeasureLatencies(false, 500));
+  PrintHistogram("scanned at 60 Hz", MeasureLatencies(true, 500));
+}
@@ -0,0 +1,139 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "FileItem.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "threads/SystemClock.h"
+#include "utils/Archive.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "video/VideoInfoTag.h"
+
+#include "gtest/gtest.h"
+
+#if defined(TARGET_LINUX)
+#include <malloc.h>
+#endif
+#include <cstdio>
+
+namespace
+{
+// a movie as the video database lists it
+CFileItemPtr CreateMovieItem(int i)
+{
+  CVideoInfoTag movie;
+  movie.m_iDbId = i;
+  movie.m_type = "movie";
+  movie.m_strTitle = StringUtils::Format("Movie %d", i);
+  movie.m_strPlot = std::string(400, 'p');
+  movie.m_strFileNameAndPath = StringUtils::Format("smb://server/movies/Movie %d/movie.mkv", i);
+  movie.m_genre.push_back("Drama");
+  movie.m_director.push_back("Director");
+
+  CFileItemPtr item(new CFileItem(movie));
+  item->SetArt("thumb", StringUtils::Format("image://movie-%d-poster.jpg/", i));
+  item->SetArt("fanart", StringUtils::Format("image://movie-%d-fanart.jpg/", i));
+  item->SetProperty("original_listitem_url", movie.m_strFileNameAndPath);
+  item->SetProperty("IsPlayable", true);
+  return item;
+}
+
+void CreateMovieList(CFileItemList &items, int iSize)
+{
+  items.SetPath("videodb://movies/titles/");
+  items.SetContent("movies");
+  items.AddSortMethod(SortByTitle, 556, LABEL_MASKS("%T", "%Y"));
+  for (int i = 0; i < iSize; i++)
+    items.Add(CreateMovieItem(i));
+}
+}
+
+/*
+ Builds a list of 50000 library items the way the video database does and a
+ copy of it as a filtered view would, printing the heap used by each.
+ */
+TEST(BenchmarkFileItem, LibraryListMemory)
+{
+#if defined(TARGET_LINUX)
+  size_t start = mallinfo().uordblks;
+
+  CFileItemList items;
+  for (int i = 0; i < 50000; i++)
+    items.Add(CreateMovieItem(i));
+  size_t list = mallinfo().uordblks;
+
+  CFileItemList filtered;
+  filtered.Copy(items);
+  size_t copy = mallinfo().uordblks;
+
+  printf("50000 items: %zu kB, copy: %zu kB\n", (list - start) / 1024, (copy - list) / 1024);
+#endif
+}
+
+/*
+ Saves and loads a list of 50000 library items through CArchive and as a
+ window cache, printing the time taken by each.
+ */
+TEST(BenchmarkFileItem, DiscCache)
+{
+  ASSERT_TRUE(XFILE::CDirectory::Create("special://temp/archive_cache/"));
+
+  CFileItemList items;
+  CreateMovieList(items, 50000);
+
+  std::string path = "special://temp/archive_cache/benchmark.fi";
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  XFILE::CFile file;
+  ASSERT_TRUE(file.OpenForWrite(path, true));
+  {
+    CArchive ar(&file, CArchive::store);
+    ar << items;
+  }
+  file.Close();
+  unsigned int archiveSave = XbmcThreads::SystemClockMillis() - start;
+
+  start = XbmcThreads::SystemClockMillis();
+  CFileItemList archived;
+  ASSERT_TRUE(file.Open(path));
+  {
+    CArchive ar(&file, CArchive::load);
+    ar >> archived;
+  }
+  file.Close();
+  unsigned int archiveLoad = XbmcThreads::SystemClockMillis() - start;
+  XFILE::CFile::Delete(path);
+
+  start = XbmcThreads::SystemClockMillis();
+  ASSERT_TRUE(items.Save());
+  unsigned int cacheSave = XbmcThreads::SystemClockMillis() - start;
+
+  start = XbmcThreads::SystemClockMillis();
+  CFileItemList cached;
+  cached.SetPath(items.GetPath());
+  ASSERT_TRUE(cached.Load());
+  unsigned int cacheLoad = XbmcThreads::SystemClockMillis() - start;
+  items.RemoveDiscCache();
+
+  EXPECT_EQ(items.Size(), archived.Size());
+  EXPECT_EQ(items.Size(), cached.Size());
+  printf("50000 items, CArchive: save %u ms, load %u ms, window cache: save %u ms, load %u ms\n",
+         archiveSave, archiveLoad, cacheSave, cacheLoad);
+}
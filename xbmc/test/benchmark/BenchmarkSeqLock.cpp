@@ -0,0 +1,137 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "threads/SeqLock.h"
+#include "threads/SystemClock.h"
+#include "threads/test/TestHelpers.h"
+
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#define NUMWRITERS 2
+#define NUMREADS 1000000
+
+namespace
+{
+struct SInfo
+{
+  int a;
+  int b;
+  char name[64];
+};
+
+class SeqLockWriter : public IRunnable
+{
+  CSeqLock<SInfo>& m_info;
+  std::atomic<bool>& m_stop;
+public:
+  SeqLockWriter(CSeqLock<SInfo>& info, std::atomic<bool>& stop) : m_info(info), m_stop(stop) {}
+
+  virtual void Run()
+  {
+    for (int i = 0; !m_stop; i++)
+    {
+      m_info.Update([i](SInfo& info)
+      {
+        info.a = i;
+        info.b = -i;
+        snprintf(info.name, sizeof(info.name), "%d", i);
+      });
+    }
+  }
+};
+
+class LockedWriter : public IRunnable
+{
+  CCriticalSection& m_section;
+  SInfo& m_info;
+  std::atomic<bool>& m_stop;
+public:
+  LockedWriter(CCriticalSection& section, SInfo& info, std::atomic<bool>& stop) :
+    m_section(section), m_info(info), m_stop(stop) {}
+
+  virtual void Run()
+  {
+    for (int i = 0; !m_stop; i++)
+    {
+      CSingleLock lock(m_section);
+      m_info.a = i;
+      m_info.b = -i;
+      snprintf(m_info.name, sizeof(m_info.name), "%d", i);
+    }
+  }
+};
+}
+
+// reports the cost of a read while writers are hammering the value, for a
+// sequence lock and for a critical section
+TEST(BenchmarkSeqLock, ReaderCost)
+{
+  unsigned int seqLockTime;
+  {
+    CSeqLock<SInfo> info;
+    std::atomic<bool> stop(false);
+    SeqLockWriter writer(info, stop);
+    std::vector<thread> writers;
+    for (int i = 0; i < NUMWRITERS; i++)
+      writers.push_back(thread(writer));
+
+    unsigned int start = XbmcThreads::SystemClockMillis();
+    int64_t sum = 0;
+    for (int i = 0; i < NUMREADS; i++)
+      sum += info.Get().a;
+    seqLockTime = XbmcThreads::SystemClockMillis() - start;
+
+    stop = true;
+    for (auto& w : writers)
+      w.join();
+    EXPECT_GE(sum, 0);
+  }
+
+  unsigned int lockedTime;
+  {
+    CCriticalSection section;
+    SInfo info = {};
+    std::atomic<bool> stop(false);
+    LockedWriter writer(section, info, stop);
+    std::vector<thread> writers;
+    for (int i = 0; i < NUMWRITERS; i++)
+      writers.push_back(thread(writer));
+
+    unsigned int start = XbmcThreads::SystemClockMillis();
+    int64_t sum = 0;
+    for (int i = 0; i < NUMREADS; i++)
+    {
+      CSingleLock lock(section);
+      sum += info.a;
+    }
+    lockedTime = XbmcThreads::SystemClockMillis() - start;
+
+    stop = true;
+    for (auto& w : writers)
+      w.join();
+    EXPECT_GE(sum, 0);
+  }
+
+  std::cout << NUMREADS << " reads with " << NUMWRITERS << " concurrent writers: "
+            << "CSeqLock " << seqLockTime << " ms, CCriticalSection " << lockedTime << " ms" << std::endl;
+}
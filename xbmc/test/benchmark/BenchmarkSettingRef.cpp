@@ -0,0 +1,53 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include "settings/Settings.h"
+#include "settings/SettingRef.h"
+
+#include "gtest/gtest.h"
+
+/*
+ Prints the time a read takes through CSettings and through a handle.
+ */
+TEST(BenchmarkSettingRef, Read)
+{
+  typedef std::chrono::steady_clock Clock;
+  const unsigned int iReads = 10000000;
+  CSettingRef<bool> parseCaptions(CSettings::SETTING_SUBTITLES_PARSECAPTIONS);
+
+  unsigned int iTrue = 0;
+  Clock::time_point start = Clock::now();
+  for (unsigned int i = 0; i < iReads; ++i)
+    iTrue += CSettings::GetInstance().GetBool(CSettings::SETTING_SUBTITLES_PARSECAPTIONS) ? 1 : 0;
+  Clock::duration settings = Clock::now() - start;
+
+  start = Clock::now();
+  for (unsigned int i = 0; i < iReads; ++i)
+    iTrue += parseCaptions ? 1 : 0;
+  Clock::duration handle = Clock::now() - start;
+
+  printf("CSettings::GetBool(): %.2f ns per read\n", std::chrono::duration<double, std::nano>(settings).count() / iReads);
+  printf("CSettingRef<bool>:    %.2f ns per read\n", std::chrono::duration<double, std::nano>(handle).count() / iReads);
+  // keep the reads from being optimized away
+  EXPECT_TRUE(iTrue == 0 || iTrue == 2 * iReads);
+}
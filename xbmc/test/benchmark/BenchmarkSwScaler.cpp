@@ -0,0 +1,100 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstdio>
+
+#include "cores/VideoPlayer/SwScaler.h"
+#include "cores/VideoPlayer/test/TestHelpers.h"
+#include "threads/SystemClock.h"
+
+extern "C" {
+#include "libavutil/pixdesc.h"
+#include "libswscale/swscale.h"
+}
+
+#include "gtest/gtest.h"
+
+/*
+ Converts 4K pictures of the common decoder formats to BGRA on one thread and
+ in bands and prints the time taken.
+ */
+TEST(BenchmarkSwScaler, Convert)
+{
+  const AVPixelFormat formats[] = { AV_PIX_FMT_YUV420P, AV_PIX_FMT_NV12, AV_PIX_FMT_P010 };
+  const int iterations = 20;
+
+  for (AVPixelFormat format : formats)
+  {
+    CImage src(3840, 2160, format);
+    CImage dst(3840, 2160, AV_PIX_FMT_BGRA);
+    ASSERT_TRUE(src.IsValid() && dst.IsValid());
+    src.Fill();
+
+    for (int threads = 1; threads >= 0; --threads)
+    {
+      CSwScaler scaler;
+      if (!scaler.Configure(3840, 2160, format, 3840, 2160, AV_PIX_FMT_BGRA, SWS_BILINEAR, threads))
+      {
+        printf("%s: not supported\n", av_get_pix_fmt_name(format));
+        break;
+      }
+
+      unsigned int start = XbmcThreads::SystemClockMillis();
+      for (int i = 0; i < iterations; ++i)
+        scaler.Scale(src.ConstData(), src.Linesize(), dst.Data(), dst.Linesize());
+      unsigned int elapsed = XbmcThreads::SystemClockMillis() - start;
+
+      printf("%s to bgra in %d bands: %.1f ms per picture\n", av_get_pix_fmt_name(format),
+             scaler.Bands(), elapsed / (double)iterations);
+    }
+  }
+}
+
+/*
+ Scales 4K pictures down to the size of a thumbnail on one thread and in
+ bands and prints the time taken.
+ */
+TEST(BenchmarkSwScaler, Thumbnail)
+{
+  const int flags[] = { SWS_FAST_BILINEAR, SWS_BICUBIC };
+  const int iterations = 20;
+
+  CImage src(3840, 2160, AV_PIX_FMT_YUV420P);
+  CImage dst(320, 180, AV_PIX_FMT_BGRA);
+  ASSERT_TRUE(src.IsValid() && dst.IsValid());
+  src.Fill();
+
+  for (int flag : flags)
+  {
+    for (int threads = 1; threads >= 0; --threads)
+    {
+      CSwScaler scaler;
+      ASSERT_TRUE(scaler.Configure(3840, 2160, AV_PIX_FMT_YUV420P, 320, 180, AV_PIX_FMT_BGRA, flag, threads));
+
+      unsigned int start = XbmcThreads::SystemClockMillis();
+      for (int i = 0; i < iterations; ++i)
+        scaler.Scale(src.ConstData(), src.Linesize(), dst.Data(), dst.Linesize());
+      unsigned int elapsed = XbmcThreads::SystemClockMillis() - start;
+
+      printf("yuv420p 3840x2160 to bgra 320x180 with %s in %d bands: %.1f ms per picture\n",
+             flag == SWS_BICUBIC ? "bicubic" : "fast bilinear", scaler.Bands(), elapsed / (double)iterations);
+    }
+  }
+}
@@ -0,0 +1,90 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+
+#include "system.h"
+#include "URL.h"
+#include "filesystem/CurlFile.h"
+#include "filesystem/File.h"
+#include "network/WebServer.h"
+#include "network/httprequesthandler/HTTPVfsHandler.h"
+#include "settings/MediaSourceSettings.h"
+#include "test/TestUtils.h"
+#include "threads/SystemClock.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+
+#include "gtest/gtest.h"
+
+// a different port than the unit tests so both can run at the same time
+#define WEBSERVER_PORT 23457
+
+/*
+ Downloads a large local file through the VFS handler of the webserver and
+ prints the throughput.
+ */
+TEST(BenchmarkWebServer, GetLargeLocalFile)
+{
+  const size_t blockSize = 1024 * 1024;
+  const size_t blockCount = 256;
+
+  XFILE::CFile *file = XBMC_CREATETEMPFILE(".bin");
+  ASSERT_TRUE(file != NULL);
+  std::string block(blockSize, 'x');
+  for (size_t i = 0; i < blockCount; i++)
+    ASSERT_EQ(static_cast<ssize_t>(blockSize), file->Write(block.c_str(), blockSize));
+  file->Flush();
+
+  const std::string filePath = XBMC_TEMPFILEPATH(file);
+  CMediaSource source;
+  source.strName = "WebServer Benchmark Share";
+  source.strPath = URIUtils::GetDirectory(filePath);
+  source.vecPaths.push_back(source.strPath);
+  source.m_allowSharing = true;
+  source.m_iDriveType = CMediaSource::SOURCE_TYPE_LOCAL;
+  source.m_iLockMode = LOCK_MODE_EVERYONE;
+  source.m_ignore = true;
+  CMediaSourceSettings::GetInstance().AddShare("videos", source);
+
+  CWebServer webserver;
+  CHTTPVfsHandler vfsHandler;
+  ASSERT_TRUE(webserver.Start(WEBSERVER_PORT, "", ""));
+  webserver.RegisterRequestHandler(&vfsHandler);
+
+  const std::string url = StringUtils::Format("http://localhost:%d/vfs/%s", WEBSERVER_PORT, CURL::Encode(filePath).c_str());
+  for (int run = 0; run < 3; run++)
+  {
+    std::string result;
+    XFILE::CCurlFile curl;
+    unsigned int start = XbmcThreads::SystemClockMillis();
+    ASSERT_TRUE(curl.Get(url, result));
+    unsigned int duration = std::max(1u, XbmcThreads::SystemClockMillis() - start);
+    ASSERT_EQ(blockSize * blockCount, result.size());
+
+    printf("got %u MiB in %u ms (%u MiB/s)\n", (unsigned int)blockCount, duration, (unsigned int)(blockCount * 1000 / duration));
+  }
+
+  webserver.Stop();
+  webserver.UnregisterRequestHandler(&vfsHandler);
+  CMediaSourceSettings::GetInstance().Clear();
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
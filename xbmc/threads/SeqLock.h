@@ -0,0 +1,94 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+
+/*!
+ \brief Publishes a value to many readers without making them take a lock.
+
+ Writers are serialized by a critical section. They prepare the new value on
+ the side and copy it over the published one between two increments of a
+ sequence counter. Readers copy the value and retry if the counter was odd or
+ has changed meanwhile, so they never block a writer and never see a half
+ written value.
+
+ T must be trivially copyable (no std::string members, use char arrays) and
+ should be small, as every read copies it as a whole.
+ */
+template<typename T>
+class CSeqLock
+{
+  static_assert(std::is_trivially_copyable<T>::value, "CSeqLock values are copied with memcpy and must be trivially copyable");
+
+public:
+  CSeqLock() : m_sequence(0), m_value() {}
+
+  /*!
+   \brief Get a consistent copy of the published value
+   */
+  T Get() const
+  {
+    T value;
+    unsigned int sequence;
+    do
+    {
+      while ((sequence = m_sequence.load(std::memory_order_acquire)) & 1)
+        std::this_thread::yield();
+      std::memcpy(&value, &m_value, sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while (sequence != m_sequence.load(std::memory_order_relaxed));
+    return value;
+  }
+
+  /*!
+   \brief Modify the published value
+   \param modify callable receiving a reference to a copy of the current value,
+                 the modified copy is published once it returns
+   */
+  template<typename F>
+  void Update(F modify)
+  {
+    CSingleLock lock(m_writeSection);
+    T value;
+    std::memcpy(&value, &m_value, sizeof(T));
+    modify(value);
+
+    unsigned int sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&m_value, &value, sizeof(T));
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+private:
+  CSeqLock(const CSeqLock&) = delete;
+  CSeqLock& operator=(const CSeqLock&) = delete;
+
+  std::atomic<unsigned int> m_sequence;
+  T m_value;
+  CCriticalSection m_writeSection;
+};
@@ -0,0 +1,95 @@
+/*
+ *      Copyright (C) 2017 Team Kodi
+ *      http://kodi.tv
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this Program; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "TestHelpers.h"
+#include "threads/SeqLock.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define NUMWRITERS 2
+#define NUMREADS 1000000
+
+namespace
+{
+struct SInfo
+{
+  int a;
+  int b;
+  char name[64];
+};
+
+class SeqLockWriter : public IRunnable
+{
+  CSeqLock<SInfo>& m_info;
+  std::atomic<bool>& m_stop;
+public:
+  SeqLockWriter(CSeqLock<SInfo>& info, std::atomic<bool>& stop) : m_info(info), m_stop(stop) {}
+
+  virtual void Run()
+  {
+    for (int i = 0; !m_stop; i++)
+    {
+      m_info.Update([i](SInfo& info)
+      {
+        info.a = i;
+        info.b = -i;
+        snprintf(info.name, sizeof(info.name), "%d", i);
+      });
+    }
+  }
+};
+}
+
+TEST(TestSeqLock, General)
+{
+  CSeqLock<SInfo> info;
+  EXPECT_EQ(0, info.Get().a);
+  EXPECT_STREQ("", info.Get().name);
+
+  info.Update([](SInfo& i) { i.a = 1; });
+  info.Update([](SInfo& i) { strcpy(i.name, "test"); });
+  EXPECT_EQ(1, info.Get().a);
+  EXPECT_STREQ("test", info.Get().name);
+}
+
+TEST(TestSeqLock, ConsistentUnderWriters)
+{
+  CSeqLock<SInfo> info;
+  std::atomic<bool> stop(false);
+  SeqLockWriter writer(info, stop);
+  std::vector<thread> writers;
+  for (int i = 0; i < NUMWRITERS; i++)
+    writers.push_back(thread(writer));
+
+  for (int i = 0; i < NUMREADS; i++)
+  {
+    SInfo value = info.Get();
+    ASSERT_EQ(value.a, -value.b);
+    ASSERT_EQ(value.a, atoi(value.name));
+  }
+
+  stop = true;
+  for (auto& w : writers)
+    w.join();
+}
@@ -46,6 +46,7 @@ CArchive::CArchive(CFile* pFile, int mode)
 {
   m_pFile = pFile;
   m_iMode = mode;
+  m_pData = NULL;
 
   m_pBuffer = std::unique_ptr<uint8_t[]>(new uint8_t[CARCHIVE_BUFFER_MAX]);
   memset(m_pBuffer.get(), 0, CARCHIVE_BUFFER_MAX);
@@ -61,6 +62,28 @@ CArchive::CArchive(CFile* pFile, int mode)
   }
 }
 
+CArchive::CArchive(std::vector<uint8_t> &buffer)
+{
+  m_pFile = NULL;
+  m_iMode = store;
+  m_pData = &buffer;
+
+  // no buffer, so every write goes to streamout_bufferwrap()
+  m_BufferPos = NULL;
+  m_BufferRemain = 0;
+}
+
+CArchive::CArchive(const uint8_t *data, size_t size)
+{
+  m_pFile = NULL;
+  m_iMode = load;
+  m_pData = NULL;
+
+  // the whole data is the buffer, it is never refilled
+  m_BufferPos = const_cast<uint8_t*>(data);
+  m_BufferRemain = size;
+}
+
 CArchive::~CArchive()
 {
   FlushBuffer();
@@ -406,7 +429,7 @@ CArchive& CArchive::operator>>(std::vector<int>& iArray)
 
 void CArchive::FlushBuffer()
 {
-  if (m_iMode == store && m_BufferPos != m_pBuffer.get())
+  if (m_iMode == store && m_pFile && m_BufferPos != m_pBuffer.get())
   {
     if (m_pFile->Write(m_pBuffer.get(), m_BufferPos - m_pBuffer.get()) != m_BufferPos - m_pBuffer.get())
       CLog::Log(LOGERROR, "%s: Error flushing buffer", __FUNCTION__);
@@ -420,6 +443,12 @@ void CArchive::FlushBuffer()
 
 CArchive &CArchive::streamout_bufferwrap(const uint8_t *ptr, size_t size)
 {
+  if (m_pData)
+  {
+    m_pData->insert(m_pData->end(), ptr, ptr + size);
+    return *this;
+  }
+
   do
   {
     auto chunkSize = std::min(size, m_BufferRemain);
@@ -435,7 +464,7 @@ CArchive &CArchive::streamout_bufferwrap(const uint8_t *ptr, size_t size)
 
 void CArchive::FillBuffer()
 {
-  if (m_iMode == load && m_BufferRemain == 0)
+  if (m_iMode == load && m_pFile && m_BufferRemain == 0)
   {
     auto read = m_pFile->Read(m_pBuffer.get(), CARCHIVE_BUFFER_MAX);
     if (read > 0)
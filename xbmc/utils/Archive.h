@@ -38,6 +38,10 @@ class CArchive
 {
 public:
   CArchive(XFILE::CFile* pFile, int mode);
+  /*! \brief Store into memory, everything streamed out is appended to buffer right away */
+  explicit CArchive(std::vector<uint8_t> &buffer);
+  /*! \brief Load from memory, data has to stay valid for the lifetime of the archive */
+  CArchive(const uint8_t *data, size_t size);
   ~CArchive();
 
   /* CArchive support storing and loading of all C basic integer types
@@ -184,6 +188,7 @@ protected:
   std::unique_ptr<uint8_t[]> m_pBuffer;
   uint8_t *m_BufferPos;
   size_t m_BufferRemain;
+  std::vector<uint8_t> *m_pData; //non-owning
 
 private:
   void FlushBuffer();
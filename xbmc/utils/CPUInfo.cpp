@@ -22,6 +22,7 @@
 
 #include "CPUInfo.h"
 #include "utils/Temperature.h"
+#include "threads/SingleLock.h"
 #include <string>
 #include <string.h>
 
@@ -614,6 +615,8 @@ bool CCPUInfo::getTemperature(CTemperature& temperature)
   if (cmd.empty() && m_fProcTemperature == NULL)
     return false;
 
+  CSingleLock lock(m_temperatureSection);
+
   if (!cmd.empty())
   {
     p = popen (cmd.c_str(), "r");
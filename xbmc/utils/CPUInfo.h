@@ -25,6 +25,7 @@
 #include <time.h>
 #include <string>
 #include <map>
+#include "threads/CriticalSection.h"
 #include "threads/SystemClock.h"
 
 #ifdef TARGET_WINDOWS
@@ -110,6 +111,7 @@ private:
 #ifdef TARGET_POSIX
   FILE* m_fProcStat;
   FILE* m_fProcTemperature;
+  CCriticalSection m_temperatureSection; //!< the temperature is read by the gui and by jobs
   FILE* m_fCPUFreq;
   bool m_cpuInfoForFreq;
 #if defined(TARGET_DARWIN)
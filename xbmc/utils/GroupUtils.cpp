@@ -52,13 +52,14 @@ bool GroupUtils::Group(GroupBy groupBy, const std::string &baseDir, const CFileI
   {
     bool ungrouped = true;
     const CFileItemPtr item = items.Get(index);
+    // the const getter doesn't give the item its own copy of a shared tag
+    const CVideoInfoTag *tag = static_cast<const CFileItem&>(*item).GetVideoInfoTag();
 
     // group by sets
-    if ((groupBy & GroupBySet) &&
-      item->HasVideoInfoTag() && item->GetVideoInfoTag()->m_iSetId > 0)
+    if ((groupBy & GroupBySet) && tag && tag->m_iSetId > 0)
     {
       ungrouped = false;
-      setMap[item->GetVideoInfoTag()->m_iSetId].insert(item);
+      setMap[tag->m_iSetId].insert(item);
     }
 
     if (ungrouped)
@@ -22,7 +22,9 @@
 #include <algorithm>
 #include <functional>
 #include <stdexcept>
+#include <thread>
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 #ifdef TARGET_POSIX
 #include "linux/XTimeUtils.h"
@@ -37,9 +39,10 @@ bool CJob::ShouldCancel(unsigned int progress, unsigned int total) const
   return false;
 }
 
-CJobWorker::CJobWorker(CJobManager *manager) : CThread("JobWorker")
+CJobWorker::CJobWorker(CJobManager *manager, unsigned int shard) : CThread("JobWorker")
 {
   m_jobManager = manager;
+  m_shard = shard;
   Create(true); // start work immediately, and kill ourselves when we're done
 }
 
@@ -182,8 +185,22 @@ CJobManager &CJobManager::GetInstance()
 CJobManager::CJobManager()
 {
   m_jobCounter = 0;
+  m_nextShard = 0;
+  m_nextWorkerShard = 0;
   m_running = true;
   m_pauseJobs = false;
+  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+  {
+    m_queued[priority] = 0;
+    m_active[priority] = 0;
+  }
+  m_activeShared = 0;
+
+  // one shard per core keeps contention between workers and submitters low
+  // without scattering a handful of jobs over too many queues
+  unsigned int shards = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+  for (unsigned int i = 0; i < shards; ++i)
+    m_shards.emplace_back(new CJobShard);
 }
 
 void CJobManager::Restart()
@@ -197,16 +214,24 @@ void CJobManager::Restart()
 
 void CJobManager::CancelJobs()
 {
-  CSingleLock lock(m_section);
   m_running = false;
 
-  // clear any pending jobs
-  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+  // clear any pending jobs. AddJob checks m_running while holding the shard lock,
+  // so no job can be queued behind our back once a shard has been cleared.
+  for (auto& shard : m_shards)
   {
-    for_each(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), std::mem_fun_ref(&CWorkItem::FreeJob));
-    m_jobQueue[priority].clear();
+    CSingleLock shardLock(shard->m_section);
+    for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+    {
+      JobQueue& queue = shard->m_jobQueue[priority];
+      for_each(queue.begin(), queue.end(), std::mem_fun_ref(&CWorkItem::FreeJob));
+      m_queued[priority] -= queue.size();
+      queue.clear();
+    }
   }
 
+  CSingleLock lock(m_section);
+
   // cancel any callbacks on jobs still processing
   for_each(m_processing.begin(), m_processing.end(), std::mem_fun_ref(&CWorkItem::Cancel));
 
@@ -226,19 +251,26 @@ CJobManager::~CJobManager()
 
 unsigned int CJobManager::AddJob(CJob *job, IJobCallback *callback, CJob::PRIORITY priority)
 {
-  CSingleLock lock(m_section);
-
   if (!m_running)
     return 0;
 
   // increment the job counter, ensuring 0 (invalid job) is never hit
-  m_jobCounter++;
-  if (m_jobCounter == 0)
-    m_jobCounter++;
+  unsigned int id = ++m_jobCounter;
+  if (id == 0)
+    id = ++m_jobCounter;
 
   // create a work item for this job
-  CWorkItem work(job, m_jobCounter, priority, callback);
-  m_jobQueue[priority].push_back(work);
+  CWorkItem work(job, id, priority, callback);
+  work.m_queued = XbmcThreads::SystemClockMillis();
+
+  CJobShard& shard = *m_shards[m_nextShard++ % m_shards.size()];
+  {
+    CSingleLock shardLock(shard.m_section);
+    if (!m_running)
+      return 0;
+    shard.m_jobQueue[priority].push_back(work);
+    ++m_queued[priority];
+  }
 
   StartWorkers(priority);
   return work.m_id;
@@ -246,20 +278,27 @@ unsigned int CJobManager::AddJob(CJob *job, IJobCallback *callback, CJob::PRIORI
 
 void CJobManager::CancelJob(unsigned int jobID)
 {
-  CSingleLock lock(m_section);
-
   // check whether we have this job in the queue
-  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+  for (auto& shard : m_shards)
   {
-    JobQueue::iterator i = find(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), jobID);
-    if (i != m_jobQueue[priority].end())
+    CSingleLock shardLock(shard->m_section);
+    for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
     {
-      delete i->m_job;
-      m_jobQueue[priority].erase(i);
-      return;
+      JobQueue& queue = shard->m_jobQueue[priority];
+      JobQueue::iterator i = find(queue.begin(), queue.end(), jobID);
+      if (i != queue.end())
+      {
+        delete i->m_job;
+        queue.erase(i);
+        --m_queued[priority];
+        return;
+      }
     }
   }
-  // or if we're processing it
+
+  // or if we're processing it. PopJob moves a job to the processing list before
+  // releasing the shard lock, so a job can't slip through between both checks.
+  CSingleLock lock(m_section);
   Processing::iterator it = find(m_processing.begin(), m_processing.end(), jobID);
   if (it != m_processing.end())
     it->m_callback = NULL; // job is in progress, so only thing to do is to remove callback
@@ -269,8 +308,8 @@ void CJobManager::StartWorkers(CJob::PRIORITY priority)
 {
   CSingleLock lock(m_section);
 
-  // check how many free threads we have
-  if (m_processing.size() >= GetMaxWorkers(priority))
+  // check whether this priority may occupy another worker
+  if (!HasFreeSlot(priority))
     return;
 
   // do we have any sleeping threads?
@@ -281,42 +320,113 @@ void CJobManager::StartWorkers(CJob::PRIORITY priority)
   }
 
   // everyone is busy - we need more workers
-  m_workers.push_back(new CJobWorker(this));
+  m_workers.push_back(new CJobWorker(this, m_nextWorkerShard++ % m_shards.size()));
 }
 
-CJob *CJobManager::PopJob()
+bool CJobManager::HasFreeSlot(CJob::PRIORITY priority) const
+{
+  return priority == CJob::PRIORITY_DEDICATED || m_activeShared < GetMaxWorkers(priority);
+}
+
+bool CJobManager::ReserveSlot(CJob::PRIORITY priority)
+{
+  if (priority != CJob::PRIORITY_DEDICATED)
+  {
+    // all priorities share the workers, the lower ones may only take fewer of them
+    const unsigned int maxWorkers = GetMaxWorkers(priority);
+    unsigned int active = m_activeShared;
+    do
+    {
+      if (active >= maxWorkers)
+        return false;
+    } while (!m_activeShared.compare_exchange_weak(active, active + 1));
+  }
+  ++m_active[priority];
+  return true;
+}
+
+void CJobManager::ReleaseSlot(CJob::PRIORITY priority)
+{
+  --m_active[priority];
+  if (priority != CJob::PRIORITY_DEDICATED)
+    --m_activeShared;
+}
+
+CJob *CJobManager::PopJob(const CJobWorker *worker)
 {
-  CSingleLock lock(m_section);
   for (int priority = CJob::PRIORITY_DEDICATED; priority >= CJob::PRIORITY_LOW_PAUSABLE; --priority)
   {
     // Check whether we're pausing pausable jobs
     if (priority == CJob::PRIORITY_LOW_PAUSABLE && m_pauseJobs)
       continue;
 
-    if (m_jobQueue[priority].size() && m_processing.size() < GetMaxWorkers(CJob::PRIORITY(priority)))
+    if (m_queued[priority] == 0 || !ReserveSlot(CJob::PRIORITY(priority)))
+      continue;
+
+    // take from our own shard first, then steal from the others
+    for (size_t i = 0; i < m_shards.size(); ++i)
     {
+      CJobShard& shard = *m_shards[(worker->GetShard() + i) % m_shards.size()];
+      CSingleLock shardLock(shard.m_section);
+      JobQueue& queue = shard.m_jobQueue[priority];
+      if (queue.empty())
+        continue;
+
       // pop the job off the queue
-      CWorkItem job = m_jobQueue[priority].front();
-      m_jobQueue[priority].pop_front();
+      CWorkItem job = queue.front();
+      queue.pop_front();
+      --m_queued[priority];
+      job.m_started = XbmcThreads::SystemClockMillis();
+      job.m_job->m_callback = this;
 
       // add to the processing vector
-      m_processing.push_back(job);
-      job.m_job->m_callback = this;
+      {
+        CSingleLock lock(m_section);
+        m_processing.push_back(job);
+      }
+      shardLock.Leave();
+
+      // a sleeping worker may have been woken for several jobs, make sure
+      // the remaining ones get a worker of their own
+      if (m_queued[priority] > 0)
+        StartWorkers(CJob::PRIORITY(priority));
+
+      unsigned int waitTime = job.m_started - job.m_queued;
+      CSingleLock statsLock(m_statsSection);
+      for (JobStats* stats : { &m_priorityStats[priority], &m_typeStats[GetTypeName(job.m_job)] })
+      {
+        stats->totalWaitTime += waitTime;
+        stats->maxWaitTime = std::max(stats->maxWaitTime, waitTime);
+      }
       return job.m_job;
     }
+
+    // someone else got there first
+    ReleaseSlot(CJob::PRIORITY(priority));
   }
   return NULL;
 }
 
+bool CJobManager::HasRunnableJobs() const
+{
+  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+  {
+    if (priority == CJob::PRIORITY_LOW_PAUSABLE && m_pauseJobs)
+      continue;
+
+    if (m_queued[priority] > 0 && HasFreeSlot(CJob::PRIORITY(priority)))
+      return true;
+  }
+  return false;
+}
+
 void CJobManager::PauseJobs()
 {
-  CSingleLock lock(m_section);
   m_pauseJobs = true;
 }
 
 void CJobManager::UnPauseJobs()
 {
-  CSingleLock lock(m_section);
   m_pauseJobs = false;
 }
 
@@ -351,30 +461,64 @@ int CJobManager::IsProcessing(const std::string &type) const
   return jobsMatched;
 }
 
-CJob *CJobManager::GetNextJob(const CJobWorker *worker)
+void CJobManager::GetStats(std::map<std::string, JobStats> &types, std::vector<JobStats> &priorities) const
 {
+  {
+    CSingleLock statsLock(m_statsSection);
+    types = m_typeStats;
+    priorities.assign(m_priorityStats, m_priorityStats + CJob::PRIORITY_DEDICATED + 1);
+  }
+
+  for (auto& shard : m_shards)
+  {
+    CSingleLock shardLock(shard->m_section);
+    for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+    {
+      const JobQueue& queue = shard->m_jobQueue[priority];
+      priorities[priority].queued += queue.size();
+      for (JobQueue::const_iterator it = queue.begin(); it != queue.end(); ++it)
+        types[GetTypeName(it->m_job)].queued++;
+    }
+  }
+
   CSingleLock lock(m_section);
-  while (m_running)
+  for (Processing::const_iterator it = m_processing.begin(); it != m_processing.end(); ++it)
   {
-    // grab a job off the queue if we have one
-    CJob *job = PopJob();
-    if (job)
-      return job;
-    // no jobs are left - sleep for 30 seconds to allow new jobs to come in
-    lock.Leave();
-    bool newJob = m_jobEvent.WaitMSec(30000);
-    lock.Enter();
-    if (!newJob)
-      break;
+    priorities[it->m_priority].processing++;
+    types[GetTypeName(it->m_job)].processing++;
+  }
+}
+
+std::string CJobManager::GetTypeName(const CJob *job)
+{
+  const char *type = job->GetType();
+  return type && *type ? type : "unknown";
+}
+
+CJob *CJobManager::GetNextJob(const CJobWorker *worker)
+{
+  while (true)
+  {
+    while (m_running)
+    {
+      // grab a job off the queue if we have one
+      CJob *job = PopJob(worker);
+      if (job)
+        return job;
+      // no jobs are left - sleep for 30 seconds to allow new jobs to come in
+      if (!m_jobEvent.WaitMSec(30000))
+        break;
+    }
+    // ensure no jobs have come in during the period after timeout. AddJob
+    // queues a job before it looks for idle workers under m_section, so we
+    // either see the job here or it sees that we are gone.
+    CSingleLock lock(m_section);
+    if (m_running && HasRunnableJobs())
+      continue;
+    // have no jobs
+    RemoveWorker(worker);
+    return NULL;
   }
-  // ensure no jobs have come in during the period after
-  // timeout and before we held the lock
-  CJob *job = PopJob();
-  if (job)
-    return job;
-  // have no jobs
-  RemoveWorker(worker);
-  return NULL;
 }
 
 bool CJobManager::OnJobProgress(unsigned int progress, unsigned int total, const CJob *job) const
@@ -405,6 +549,7 @@ void CJobManager::OnJobComplete(bool success, CJob *job)
     // tell any listeners we're done with the job, then delete it
     CWorkItem item(*i);
     lock.Leave();
+    unsigned int runTime = XbmcThreads::SystemClockMillis() - item.m_started;
     try
     {
       if (item.m_callback)
@@ -417,8 +562,21 @@ void CJobManager::OnJobComplete(bool success, CJob *job)
     lock.Enter();
     Processing::iterator j = find(m_processing.begin(), m_processing.end(), job);
     if (j != m_processing.end())
+    {
       m_processing.erase(j);
+      ReleaseSlot(item.m_priority);
+    }
     lock.Leave();
+
+    {
+      CSingleLock statsLock(m_statsSection);
+      for (JobStats* stats : { &m_priorityStats[item.m_priority], &m_typeStats[GetTypeName(item.m_job)] })
+      {
+        stats->completed++;
+        stats->totalRunTime += runTime;
+        stats->maxRunTime = std::max(stats->maxRunTime, runTime);
+      }
+    }
     item.FreeJob();
   }
 }
@@ -19,6 +19,9 @@
  *
  */
 
+#include <atomic>
+#include <map>
+#include <memory>
 #include <queue>
 #include <vector>
 #include <string>
@@ -31,12 +34,18 @@ class CJobManager;
 class CJobWorker : public CThread
 {
 public:
-  CJobWorker(CJobManager *manager);
+  CJobWorker(CJobManager *manager, unsigned int shard);
   virtual ~CJobWorker();
 
   void Process();
+
+  /*!
+   \brief The job queue this worker takes jobs from before stealing from others
+   */
+  unsigned int GetShard() const { return m_shard; }
 private:
   CJobManager  *m_jobManager;
+  unsigned int  m_shard;
 };
 
 /*!
@@ -161,14 +170,34 @@ private:
   bool m_lifo;
 };
 
+/*!
+ \ingroup jobs
+ \brief Runtime statistics of the job manager for a single job type or priority
+ \sa CJobManager::GetStats()
+ */
+struct JobStats
+{
+  unsigned int queued = 0;        //!< number of jobs waiting to be processed
+  unsigned int processing = 0;    //!< number of jobs currently being processed
+  uint64_t completed = 0;         //!< number of jobs processed since startup
+  uint64_t totalWaitTime = 0;     //!< accumulated time (ms) processed jobs spent in the queue
+  unsigned int maxWaitTime = 0;   //!< longest time (ms) a processed job spent in the queue
+  uint64_t totalRunTime = 0;      //!< accumulated time (ms) spent processing completed jobs
+  unsigned int maxRunTime = 0;    //!< longest time (ms) spent processing a completed job
+};
+
 /*!
  \ingroup jobs
  \brief Job Manager class for scheduling asynchronous jobs.
 
  Controls asynchronous job execution, by allowing clients to add and cancel jobs.
  Should be accessed via CJobManager::GetInstance().  Jobs are allocated based on
- priority levels.  Lower priority jobs are executed only if there are sufficient
- spare worker threads free to allow for higher priority jobs that may arise.
+ priority levels.  Every priority level may only occupy a limited number of worker
+ threads at once, so that bulk low priority work never holds back higher priority jobs.
+
+ Queued jobs are spread over several independently locked queues (shards). Each
+ worker takes jobs from its own shard first and steals from the other shards
+ when its own has nothing to offer.
 
  \sa CJob and IJobCallback
  */
@@ -183,6 +212,8 @@ class CJobManager
       m_id = id;
       m_callback = callback;
       m_priority = priority;
+      m_queued = 0;
+      m_started = 0;
     }
     bool operator==(unsigned int jobID) const
     {
@@ -205,6 +236,17 @@ class CJobManager
     unsigned int  m_id;
     IJobCallback *m_callback;
     CJob::PRIORITY m_priority;
+    unsigned int  m_queued;  // time the job was added
+    unsigned int  m_started; // time processing of the job started
+  };
+
+  typedef std::deque<CWorkItem>    JobQueue;
+
+  class CJobShard
+  {
+  public:
+    CCriticalSection m_section;
+    JobQueue         m_jobQueue[CJob::PRIORITY_DEDICATED + 1];
   };
 
   template<typename F>
@@ -297,6 +339,20 @@ public:
    */
   bool IsProcessing(const CJob::PRIORITY &priority) const;
 
+  /*!
+   \brief Retrieve runtime statistics of the job manager
+   \param types statistics per job type, keyed by CJob::GetType()
+   \param priorities statistics per priority, indexed by CJob::PRIORITY
+   */
+  void GetStats(std::map<std::string, JobStats> &types, std::vector<JobStats> &priorities) const;
+
+  /*!
+   \brief Maximum number of jobs that may be processed at once when a job of the given priority is started.
+   The limit counts the jobs of all priorities but PRIORITY_DEDICATED, so the lower priorities leave
+   some workers to the higher ones.
+   */
+  static unsigned int GetMaxWorkers(CJob::PRIORITY priority);
+
 protected:
   friend class CJobWorker;
   friend class CJob;
@@ -335,27 +391,57 @@ private:
   CJobManager const& operator=(CJobManager const&);
   virtual ~CJobManager();
 
-  /*! \brief Pop a job off the job queue and add to the processing queue ready to process
+  /*! \brief Pop a job off the job queues and add to the processing queue ready to process
+   Jobs are taken from the worker's own shard first, then from the other shards.
+   \param worker the worker requesting a job.
    \return the job to process, NULL if no jobs are available
    */
-  CJob *PopJob();
+  CJob *PopJob(const CJobWorker *worker);
+
+  /*! \brief Check whether there are queued jobs that may be processed right away
+   */
+  bool HasRunnableJobs() const;
+
+  /*! \brief Check whether a job of the given priority may be started without exceeding the limit
+   */
+  bool HasFreeSlot(CJob::PRIORITY priority) const;
+
+  /*! \brief Reserve one of the worker slots for a job of the given priority
+   \return true if a slot was reserved, false if the priority is at its limit
+   */
+  bool ReserveSlot(CJob::PRIORITY priority);
+
+  /*! \brief Release a slot reserved by ReserveSlot
+   */
+  void ReleaseSlot(CJob::PRIORITY priority);
 
   void StartWorkers(CJob::PRIORITY priority);
   void RemoveWorker(const CJobWorker *worker);
-  static unsigned int GetMaxWorkers(CJob::PRIORITY priority);
+  static std::string GetTypeName(const CJob *job);
 
-  unsigned int m_jobCounter;
-
-  typedef std::deque<CWorkItem>    JobQueue;
   typedef std::vector<CWorkItem>   Processing;
   typedef std::vector<CJobWorker*> Workers;
 
-  JobQueue   m_jobQueue[CJob::PRIORITY_DEDICATED + 1];
-  bool       m_pauseJobs;
-  Processing m_processing;
-  Workers    m_workers;
+  std::atomic<unsigned int> m_jobCounter;
+  std::atomic<unsigned int> m_nextShard;
+  std::atomic<unsigned int> m_queued[CJob::PRIORITY_DEDICATED + 1];
+  std::atomic<unsigned int> m_active[CJob::PRIORITY_DEDICATED + 1];
+  std::atomic<unsigned int> m_activeShared; // active jobs of all priorities but PRIORITY_DEDICATED
+  std::atomic<bool>         m_pauseJobs;
+  std::atomic<bool>         m_running;
+
+  std::vector<std::unique_ptr<CJobShard>> m_shards;
+
+  // m_section guards the processing and worker lists. It may be taken while holding
+  // a shard lock, but a shard lock must never be taken while holding m_section.
+  Processing   m_processing;
+  Workers      m_workers;
+  unsigned int m_nextWorkerShard;
 
   CCriticalSection m_section;
   CEvent           m_jobEvent;
-  bool             m_running;
+
+  CCriticalSection m_statsSection;
+  JobStats m_priorityStats[CJob::PRIORITY_DEDICATED + 1];
+  std::map<std::string, JobStats> m_typeStats;
 };
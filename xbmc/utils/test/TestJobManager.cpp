@@ -21,6 +21,15 @@
 #include "utils/JobManager.h"
 #include "settings/Settings.h"
 #include "utils/SystemInfo.h"
+#include "threads/Event.h"
+#include "threads/SystemClock.h"
+
+#ifdef TARGET_POSIX
+#include "../linux/XTimeUtils.h"
+#endif
+
+#include <atomic>
+#include <functional>
 
 #include "gtest/gtest.h"
 
@@ -178,3 +187,140 @@ TEST_F(TestJobManager, IsProcessing)
 
   job->FinishAndStopBlocking();
 }
+
+namespace
+{
+class BlockingJob : public CJob
+{
+public:
+  BlockingJob(CEvent &release, std::atomic<unsigned int> &started) :
+    m_release(release),
+    m_started(started)
+  {
+  }
+
+  const char * GetType() const
+  {
+    return "BlockingJob";
+  }
+
+  bool DoWork()
+  {
+    ++m_started;
+    m_release.Wait();
+    return true;
+  }
+
+private:
+  CEvent &m_release;
+  std::atomic<unsigned int> &m_started;
+};
+
+class QuickJob : public CJob
+{
+public:
+  const char * GetType() const
+  {
+    return "QuickJob";
+  }
+
+  bool DoWork()
+  {
+    return true;
+  }
+};
+
+bool WaitFor(const std::function<bool()> &condition)
+{
+  XbmcThreads::EndTime timeout(5000);
+  while (!condition())
+  {
+    if (timeout.IsTimePast())
+      return false;
+    Sleep(10);
+  }
+  return true;
+}
+}
+
+TEST_F(TestJobManager, PriorityLimit)
+{
+  CEvent release(true);
+  std::atomic<unsigned int> started(0);
+  const unsigned int maxWorkers = CJobManager::GetMaxWorkers(CJob::PRIORITY_LOW);
+
+  for (unsigned int i = 0; i < maxWorkers + 2; ++i)
+    CJobManager::GetInstance().AddJob(new BlockingJob(release, started), NULL, CJob::PRIORITY_LOW);
+  EXPECT_TRUE(WaitFor([&]() { return started == maxWorkers; }));
+
+  // low priority jobs are at their limit, high priority jobs must still be processed
+  JobControlPackage package;
+  BroadcastingJob *job (WaitForJobToStartProcessing(CJob::PRIORITY_HIGH, package));
+
+  std::map<std::string, JobStats> types;
+  std::vector<JobStats> priorities;
+  CJobManager::GetInstance().GetStats(types, priorities);
+  EXPECT_EQ(maxWorkers, started);
+  EXPECT_EQ(maxWorkers, priorities[CJob::PRIORITY_LOW].processing);
+  EXPECT_EQ(2U, priorities[CJob::PRIORITY_LOW].queued);
+  EXPECT_EQ(1U, priorities[CJob::PRIORITY_HIGH].processing);
+  EXPECT_EQ(maxWorkers, types["BlockingJob"].processing);
+  EXPECT_EQ(2U, types["BlockingJob"].queued);
+
+  job->FinishAndStopBlocking();
+  release.Set();
+  EXPECT_TRUE(WaitFor([&]() { return started == maxWorkers + 2; }));
+}
+
+TEST_F(TestJobManager, LimitIsSharedByPriorities)
+{
+  CEvent release(true);
+  std::atomic<unsigned int> started(0);
+  const unsigned int maxNormal = CJobManager::GetMaxWorkers(CJob::PRIORITY_NORMAL);
+  const unsigned int maxHigh = CJobManager::GetMaxWorkers(CJob::PRIORITY_HIGH);
+
+  for (unsigned int i = 0; i < maxNormal; ++i)
+    CJobManager::GetInstance().AddJob(new BlockingJob(release, started), NULL, CJob::PRIORITY_NORMAL);
+  EXPECT_TRUE(WaitFor([&]() { return started == maxNormal; }));
+
+  // the normal jobs leave no worker to the low ones, but to the high ones
+  CJobManager::GetInstance().AddJob(new BlockingJob(release, started), NULL, CJob::PRIORITY_LOW);
+  for (unsigned int i = 0; i < 2; ++i)
+    CJobManager::GetInstance().AddJob(new BlockingJob(release, started), NULL, CJob::PRIORITY_HIGH);
+  EXPECT_TRUE(WaitFor([&]() { return started == maxHigh; }));
+
+  std::map<std::string, JobStats> types;
+  std::vector<JobStats> priorities;
+  CJobManager::GetInstance().GetStats(types, priorities);
+  EXPECT_EQ(maxHigh, types["BlockingJob"].processing);
+  EXPECT_EQ(maxNormal, priorities[CJob::PRIORITY_NORMAL].processing);
+  EXPECT_EQ(maxHigh - maxNormal, priorities[CJob::PRIORITY_HIGH].processing);
+  EXPECT_EQ(1U, priorities[CJob::PRIORITY_HIGH].queued);
+  EXPECT_EQ(0U, priorities[CJob::PRIORITY_LOW].processing);
+  EXPECT_EQ(1U, priorities[CJob::PRIORITY_LOW].queued);
+
+  release.Set();
+  EXPECT_TRUE(WaitFor([&]() { return started == maxNormal + 3; }));
+}
+
+TEST_F(TestJobManager, Stats)
+{
+  std::map<std::string, JobStats> types;
+  std::vector<JobStats> priorities;
+  CJobManager::GetInstance().GetStats(types, priorities);
+  uint64_t completed = types["QuickJob"].completed;
+  uint64_t completedNormal = priorities[CJob::PRIORITY_NORMAL].completed;
+
+  for (unsigned int i = 0; i < 20; ++i)
+    CJobManager::GetInstance().AddJob(new QuickJob(), NULL, CJob::PRIORITY_NORMAL);
+
+  EXPECT_TRUE(WaitFor([&]() {
+    CJobManager::GetInstance().GetStats(types, priorities);
+    return types["QuickJob"].completed == completed + 20;
+  }));
+  EXPECT_EQ(0U, types["QuickJob"].queued);
+  EXPECT_EQ(0U, types["QuickJob"].processing);
+  EXPECT_LE(completedNormal + 20, priorities[CJob::PRIORITY_NORMAL].completed);
+  EXPECT_LE(types["QuickJob"].maxWaitTime, types["QuickJob"].totalWaitTime);
+  EXPECT_EQ(CJob::PRIORITY_DEDICATED + 1U, priorities.size());
+}
@@ -24,8 +24,10 @@
 #include <utility>
 
 #include "cores/VideoPlayer/DVDFileInfo.h"
+#include "cores/VideoPlayer/DVDDemuxers/KeyframeIndex.h"
 #include "FileItem.h"
 #include "filesystem/DirectoryCache.h"
+#include "filesystem/File.h"
 #include "filesystem/StackDirectory.h"
 #include "guilib/GUIWindowManager.h"
 #include "guilib/StereoscopicsManager.h"
@@ -83,28 +85,36 @@ bool CThumbExtractor::operator==(const CJob* job) const
   return false;
 }
 
-bool CThumbExtractor::DoWork()
+static bool CanExtractFrom(const CFileItem &item)
 {
-  if (m_item.IsLiveTV()
+  if (item.IsLiveTV()
   // Due to a pvr addon api design flaw (no support for multiple concurrent streams
   // per addon instance), pvr recording thumbnail extraction does not work (reliably).
-  ||  m_item.IsPVRRecording()
-  ||  URIUtils::IsUPnP(m_item.GetPath())
-  ||  URIUtils::IsBluray(m_item.GetPath())
-  ||  m_item.IsBDFile()
-  ||  m_item.IsDVD()
-  ||  m_item.IsDiscImage()
-  ||  m_item.IsDVDFile(false, true)
-  ||  m_item.IsInternetStream()
-  ||  m_item.IsDiscStub()
-  ||  m_item.IsPlayList())
+  ||  item.IsPVRRecording()
+  ||  URIUtils::IsUPnP(item.GetPath())
+  ||  URIUtils::IsBluray(item.GetPath())
+  ||  item.IsBDFile()
+  ||  item.IsDVD()
+  ||  item.IsDiscImage()
+  ||  item.IsDVDFile(false, true)
+  ||  item.IsInternetStream()
+  ||  item.IsDiscStub()
+  ||  item.IsPlayList())
     return false;
 
   // For HTTP/FTP we only allow extraction when on a LAN
-  if (URIUtils::IsRemote(m_item.GetPath()) &&
-     !URIUtils::IsOnLAN(m_item.GetPath())  &&
-     (URIUtils::IsFTP(m_item.GetPath())    ||
-      URIUtils::IsHTTP(m_item.GetPath())))
+  if (URIUtils::IsRemote(item.GetPath()) &&
+     !URIUtils::IsOnLAN(item.GetPath())  &&
+     (URIUtils::IsFTP(item.GetPath())    ||
+      URIUtils::IsHTTP(item.GetPath())))
+    return false;
+
+  return true;
+}
+
+bool CThumbExtractor::DoWork()
+{
+  if (!CanExtractFrom(m_item))
     return false;
 
   bool result=false;
@@ -114,7 +124,8 @@ bool CThumbExtractor::DoWork()
     // construct the thumb cache file
     CTextureDetails details;
     details.file = CTextureCache::GetCacheFile(m_target) + ".jpg";
-    result = CDVDFileInfo::ExtractThumb(m_item.GetPath(), details, m_fillStreamDetails ? &m_item.GetVideoInfoTag()->m_streamDetails : NULL, (int) m_pos);
+    result = CDVDFileInfo::ExtractThumb(m_item.GetPath(), details, m_fillStreamDetails ? &m_item.GetVideoInfoTag()->m_streamDetails : NULL, (int) m_pos,
+                                        g_advancedSettings.m_videoFastThumbs);
     if(result)
     {
       CTextureCache::GetInstance().AddCachedTexture(m_target, details);
@@ -182,6 +193,39 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
+CSeekPreviewExtractor::CSeekPreviewExtractor(const CFileItem& item, unsigned int count, unsigned int width)
+  : m_item(item),
+    m_count(count),
+    m_width(width)
+{
+  if (item.IsVideoDb() && item.HasVideoInfoTag())
+    m_item.SetPath(item.GetVideoInfoTag()->m_strFileNameAndPath);
+}
+
+bool CSeekPreviewExtractor::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) == 0)
+  {
+    const CSeekPreviewExtractor* jobExtract = dynamic_cast<const CSeekPreviewExtractor*>(job);
+    if (jobExtract && jobExtract->m_item.GetPath() == m_item.GetPath())
+      return true;
+  }
+  return false;
+}
+
+bool CSeekPreviewExtractor::DoWork()
+{
+  if (m_count == 0 || m_item.IsStack() || !CanExtractFrom(m_item))
+    return false;
+
+  // extracted while playing the file before
+  if (CFile::Exists(CKeyframeIndex::GetPreviewPath(m_item.GetPath(), m_count - 1)))
+    return true;
+
+  CLog::Log(LOGDEBUG, "%s - extracting %u seek previews from %s", __FUNCTION__, m_count, CURL::GetRedacted(m_item.GetPath()).c_str());
+  return CDVDFileInfo::ExtractSeekPreviews(m_item.GetPath(), m_count, m_width);
+}
+
 CVideoThumbLoader::CVideoThumbLoader() :
   CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
 {
@@ -279,9 +323,11 @@ bool CVideoThumbLoader::LoadItemCached(CFileItem* pItem)
 
   m_videoDatabase->Open();
 
-  if (!pItem->HasVideoInfoTag() || !pItem->GetVideoInfoTag()->HasStreamDetails()) // no stream details
+  // reads go through the const getters, which don't give the item its own copy of a shared tag
+  const CFileItem &constItem = *pItem;
+  if (!constItem.HasVideoInfoTag() || !constItem.GetVideoInfoTag()->HasStreamDetails()) // no stream details
   {
-    if ((pItem->HasVideoInfoTag() && pItem->GetVideoInfoTag()->m_iFileId >= 0) // file (or maybe folder) is in the database
+    if ((constItem.HasVideoInfoTag() && constItem.GetVideoInfoTag()->m_iFileId >= 0) // file (or maybe folder) is in the database
     || (!pItem->m_bIsFolder && pItem->IsVideo())) // Some other video file for which we haven't yet got any database details
     {
       if (m_videoDatabase->GetStreamDetails(*pItem))
@@ -294,11 +340,12 @@ bool CVideoThumbLoader::LoadItemCached(CFileItem* pItem)
   {
     FillLibraryArt(*pItem);
 
-    if (!pItem->GetVideoInfoTag()->m_type.empty()                &&
-         pItem->GetVideoInfoTag()->m_type != MediaTypeMovie      &&
-         pItem->GetVideoInfoTag()->m_type != MediaTypeTvShow     &&
-         pItem->GetVideoInfoTag()->m_type != MediaTypeEpisode    &&
-         pItem->GetVideoInfoTag()->m_type != MediaTypeMusicVideo)
+    const std::string &type = constItem.GetVideoInfoTag()->m_type;
+    if (!type.empty()                &&
+         type != MediaTypeMovie      &&
+         type != MediaTypeTvShow     &&
+         type != MediaTypeEpisode    &&
+         type != MediaTypeMusicVideo)
     {
       m_videoDatabase->Close();
       return true; // nothing else to be done
@@ -309,7 +356,7 @@ bool CVideoThumbLoader::LoadItemCached(CFileItem* pItem)
   std::map<std::string, std::string> artwork = pItem->GetArt();
   if (artwork.empty())
   {
-    std::vector<std::string> artTypes = GetArtTypes(pItem->HasVideoInfoTag() ? pItem->GetVideoInfoTag()->m_type : "");
+    std::vector<std::string> artTypes = GetArtTypes(constItem.HasVideoInfoTag() ? constItem.GetVideoInfoTag()->m_type : "");
     if (find(artTypes.begin(), artTypes.end(), "thumb") == artTypes.end())
       artTypes.push_back("thumb"); // always look for "thumb" art for files
     for (std::vector<std::string>::const_iterator i = artTypes.begin(); i != artTypes.end(); ++i)
@@ -332,12 +379,14 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
   if (pItem->m_bIsShareOrDrive || pItem->IsParentFolder() || pItem->GetPath() == "add")
     return false;
 
-  if (pItem->HasVideoInfoTag()                                &&
-     !pItem->GetVideoInfoTag()->m_type.empty()                &&
-      pItem->GetVideoInfoTag()->m_type != MediaTypeMovie      &&
-      pItem->GetVideoInfoTag()->m_type != MediaTypeTvShow     &&
-      pItem->GetVideoInfoTag()->m_type != MediaTypeEpisode    &&
-      pItem->GetVideoInfoTag()->m_type != MediaTypeMusicVideo)
+  // const, so a shared tag isn't copied, see LoadItemCached()
+  const CFileItem &constItem = *pItem;
+  if (constItem.HasVideoInfoTag()                                &&
+     !constItem.GetVideoInfoTag()->m_type.empty()                &&
+      constItem.GetVideoInfoTag()->m_type != MediaTypeMovie      &&
+      constItem.GetVideoInfoTag()->m_type != MediaTypeTvShow     &&
+      constItem.GetVideoInfoTag()->m_type != MediaTypeEpisode    &&
+      constItem.GetVideoInfoTag()->m_type != MediaTypeMusicVideo)
     return false; // Nothing to do here
 
   DetectAndAddMissingItemData(*pItem);
@@ -345,7 +394,7 @@ bool CVideoThumbLoader::LoadItemLookup(CFileItem* pItem)
   m_videoDatabase->Open();
 
   std::map<std::string, std::string> artwork = pItem->GetArt();
-  std::vector<std::string> artTypes = GetArtTypes(pItem->HasVideoInfoTag() ? pItem->GetVideoInfoTag()->m_type : "");
+  std::vector<std::string> artTypes = GetArtTypes(constItem.HasVideoInfoTag() ? constItem.GetVideoInfoTag()->m_type : "");
   if (find(artTypes.begin(), artTypes.end(), "thumb") == artTypes.end())
     artTypes.push_back("thumb"); // always look for "thumb" art for files
   for (std::vector<std::string>::const_iterator i = artTypes.begin(); i != artTypes.end(); ++i)
@@ -439,7 +488,11 @@ void CVideoThumbLoader::SetArt(CFileItem &item, const std::map<std::string, std:
 
 bool CVideoThumbLoader::FillLibraryArt(CFileItem &item)
 {
-  CVideoInfoTag &tag = *item.GetVideoInfoTag();
+  if (!item.HasVideoInfoTag())
+    return !item.GetArt().empty();
+
+  // only read, so a tag shared with copies of the item isn't copied
+  const CVideoInfoTag &tag = *static_cast<const CFileItem&>(item).GetVideoInfoTag();
   if (tag.m_iDbId > -1 && !tag.m_type.empty())
   {
     std::map<std::string, std::string> artwork;
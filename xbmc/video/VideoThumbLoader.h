@@ -62,6 +62,31 @@ public:
   bool m_fillStreamDetails; ///< fill in stream details? 
 };
 
+/*!
+ \ingroup thumbs,jobs
+ \brief Extracts the pictures shown on the seek bar while a video plays
+
+ \sa CDVDFileInfo::ExtractSeekPreviews and CJob
+ */
+class CSeekPreviewExtractor : public CJob
+{
+public:
+  CSeekPreviewExtractor(const CFileItem& item, unsigned int count, unsigned int width);
+
+  virtual bool DoWork();
+
+  virtual const char* GetType() const
+  {
+    return kJobTypeMediaFlags;
+  }
+
+  virtual bool operator==(const CJob* job) const;
+
+  CFileItem    m_item;
+  unsigned int m_count; ///< number of previews
+  unsigned int m_width; ///< width of a preview
+};
+
 class CVideoThumbLoader : public CThumbLoader, public CJobQueue
 {
 public:
@@ -507,8 +507,8 @@ void CGUIWindowVideoBase::AddItemToPlayList(const CFileItemPtr &pItem, CFileItem
         }
       }
       else if (items[i]->HasVideoInfoTag() &&
-       ((unwatchedOnly && items[i]->GetVideoInfoTag()->m_playCount > 0) ||
-        (watchedOnly && items[i]->GetVideoInfoTag()->m_playCount <= 0)))
+       ((unwatchedOnly && static_cast<const CFileItem&>(*items[i]).GetVideoInfoTag()->m_playCount > 0) ||
+        (watchedOnly && static_cast<const CFileItem&>(*items[i]).GetVideoInfoTag()->m_playCount <= 0)))
         continue;
 
       AddItemToPlayList(items[i], queuedItems);
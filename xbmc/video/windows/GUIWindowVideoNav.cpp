@@ -236,7 +236,8 @@ int CGUIWindowVideoNav::GetSettingSelecTvShow()
 
        for (int i = 0; i < m_vecItems->Size(); ++i)
        {
-         if (idShow == m_vecItems->Get(i)->GetVideoInfoTag()->m_iDbId)
+         const CFileItem &item = *m_vecItems->Get(i);
+         if (item.HasVideoInfoTag() && idShow == item.GetVideoInfoTag()->m_iDbId)
            return i;
        }
     }
@@ -395,8 +396,9 @@ bool CGUIWindowVideoNav::GetDirectory(const std::string &strDirectory, CFileItem
           int count = 0;
           for(int i = 0; i < items.Size(); i++)
           {
-            const CFileItemPtr item = items.Get(i);
-            if (item->GetProperty("unwatchedepisodes").asInteger() != 0 && item->GetVideoInfoTag()->m_iSeason > 0)
+            const CFileItem &item = *items.Get(i);
+            if (item.GetProperty("unwatchedepisodes").asInteger() != 0 &&
+                item.HasVideoInfoTag() && item.GetVideoInfoTag()->m_iSeason > 0)
               count++;
           }
           bFlatten = (count < 2); // flatten if there is only 1 unwatched season (not counting specials)
@@ -1299,9 +1301,11 @@ bool CGUIWindowVideoNav::ApplyWatchedFilter(CFileItemList &items)
 
     if (filterWatched)
     {
+      const CVideoInfoTag *tag = static_cast<const CFileItem&>(*item).GetVideoInfoTag();
+      int playCount = tag ? tag->m_playCount : 0;
       if(!item->IsParentFolder() && // Don't delete the go to parent folder
-         ((watchMode == WatchedModeWatched   && item->GetVideoInfoTag()->m_playCount == 0) ||
-          (watchMode == WatchedModeUnwatched && item->GetVideoInfoTag()->m_playCount > 0)))
+         ((watchMode == WatchedModeWatched   && playCount == 0) ||
+          (watchMode == WatchedModeUnwatched && playCount > 0)))
       {
         items.Remove(i);
         i--;